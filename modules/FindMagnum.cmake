@@ -297,10 +297,20 @@ foreach(component ${Magnum_FIND_COMPONENTS})
     elseif(${component} STREQUAL MeshTools)
         set(_MAGNUM_${_COMPONENT}_INCLUDE_PATH_NAMES CompressIndices.h)
 
+        # Parallel tipsify uses threads
+        find_package(Threads REQUIRED)
+        set(_MAGNUM_${_COMPONENT}_LIBRARIES ${CMAKE_THREAD_LIBS_INIT})
+
     # Primitives library
     elseif(${component} STREQUAL Primitives)
         set(_MAGNUM_${_COMPONENT}_INCLUDE_PATH_NAMES Cube.h)
 
+    # Scene graph library
+    elseif(${component} STREQUAL SceneGraph)
+        # Parallel transformation computation uses threads
+        find_package(Threads REQUIRED)
+        set(_MAGNUM_${_COMPONENT}_LIBRARIES ${CMAKE_THREAD_LIBS_INIT})
+
     # TextureTools library
     elseif(${component} STREQUAL TextureTools)
         set(_MAGNUM_${_COMPONENT}_INCLUDE_PATH_NAMES Atlas.h)
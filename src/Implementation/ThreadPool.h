@@ -0,0 +1,175 @@
+#ifndef Magnum_Implementation_ThreadPool_h
+#define Magnum_Implementation_ThreadPool_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <algorithm>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace Magnum { namespace Implementation {
+
+/* Persistent worker threads for data-parallel loops. The workers are created
+   on first use and then sleep until next parallelFor(), so repeated calls
+   (e.g. each frame) don't pay for thread creation. If parallelFor() is called
+   while another thread is already using the pool, the work is done on the
+   calling thread only instead of waiting for the pool. Changing thread count
+   must not be done concurrently with parallelFor(). */
+class ThreadPool {
+    public:
+        /* Count of threads including the calling thread. If `0`, count of
+           hardware threads is used. */
+        explicit ThreadPool(std::size_t threadCount = 1);
+
+        ThreadPool(const ThreadPool&) = delete;
+        ThreadPool& operator=(const ThreadPool&) = delete;
+
+        ~ThreadPool() { stop(); }
+
+        std::size_t threadCount() const { return _threadCount; }
+
+        /* Destroys all workers, new ones are created on next use */
+        void setThreadCount(std::size_t threadCount);
+
+        /* Split [0, count) into at most `threadCount` contiguous ranges and
+           call `function(begin, end)` for each of them, the calling thread
+           included. Returns after all ranges are processed. */
+        template<class Function> void parallelFor(const std::size_t count, const std::size_t threadCount, const Function& function) {
+            run(count, threadCount, &call<Function>, &function);
+        }
+
+    private:
+        typedef void(*Callback)(const void*, std::size_t, std::size_t);
+
+        template<class Function> static void call(const void* const function, const std::size_t begin, const std::size_t end) {
+            (*static_cast<const Function*>(function))(begin, end);
+        }
+
+        void run(std::size_t count, std::size_t threadCount, Callback callback, const void* function);
+        void work();
+        void stop();
+
+        /* Processes next range of current job, called with locked mutex */
+        void processRange(std::unique_lock<std::mutex>& lock);
+
+        std::size_t _threadCount;
+        std::vector<std::thread> _workers;
+        std::mutex _busyMutex, _mutex;
+        std::condition_variable _workAvailable, _workFinished;
+        bool _stopping;
+
+        /* Current job */
+        Callback _callback;
+        const void* _function;
+        std::size_t _count, _rangeSize, _rangeCount, _nextRange, _pendingRangeCount;
+};
+
+inline ThreadPool::ThreadPool(const std::size_t threadCount): _threadCount(threadCount ? threadCount : std::max(std::thread::hardware_concurrency(), 1u)), _stopping(false), _callback(nullptr), _function(nullptr), _count(0), _rangeSize(0), _rangeCount(0), _nextRange(0), _pendingRangeCount(0) {}
+
+inline void ThreadPool::setThreadCount(const std::size_t threadCount) {
+    stop();
+    _threadCount = threadCount ? threadCount : std::max(std::thread::hardware_concurrency(), 1u);
+}
+
+inline void ThreadPool::stop() {
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _stopping = true;
+    }
+    _workAvailable.notify_all();
+    for(std::thread& worker: _workers) worker.join();
+    _workers.clear();
+    _stopping = false;
+}
+
+inline void ThreadPool::run(const std::size_t count, std::size_t threadCount, const Callback callback, const void* const function) {
+    threadCount = std::max(std::min(std::min(threadCount, _threadCount), count), std::size_t(1));
+
+    /* Nothing to distribute */
+    if(threadCount == 1) {
+        callback(function, 0, count);
+        return;
+    }
+
+    /* Somebody else is using the workers, do everything here */
+    std::unique_lock<std::mutex> busy(_busyMutex, std::try_to_lock);
+    if(!busy.owns_lock()) {
+        callback(function, 0, count);
+        return;
+    }
+
+    /* Create missing workers, the calling thread is working too */
+    while(_workers.size() < threadCount - 1)
+        _workers.emplace_back(&ThreadPool::work, this);
+
+    const std::size_t rangeSize = (count + threadCount - 1)/threadCount;
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _callback = callback;
+        _function = function;
+        _count = count;
+        _rangeSize = rangeSize;
+        _rangeCount = threadCount;
+        _nextRange = 1;
+        _pendingRangeCount = threadCount - 1;
+    }
+    for(std::size_t i = 1; i != threadCount; ++i)
+        _workAvailable.notify_one();
+
+    /* Process the first range here, then help with ranges which weren't
+       picked up yet and wait for the rest */
+    callback(function, 0, rangeSize);
+    std::unique_lock<std::mutex> lock(_mutex);
+    while(_nextRange != _rangeCount) processRange(lock);
+    _workFinished.wait(lock, [this]() { return !_pendingRangeCount; });
+}
+
+inline void ThreadPool::processRange(std::unique_lock<std::mutex>& lock) {
+    const std::size_t range = _nextRange++;
+    const Callback callback = _callback;
+    const void* const function = _function;
+    const std::size_t begin = std::min(range*_rangeSize, _count);
+    const std::size_t end = std::min((range + 1)*_rangeSize, _count);
+
+    lock.unlock();
+    callback(function, begin, end);
+    lock.lock();
+
+    if(!--_pendingRangeCount) _workFinished.notify_one();
+}
+
+inline void ThreadPool::work() {
+    std::unique_lock<std::mutex> lock(_mutex);
+    for(;;) {
+        _workAvailable.wait(lock, [this]() { return _stopping || _nextRange != _rangeCount; });
+        if(_stopping) return;
+        processRange(lock);
+    }
+}
+
+}}
+
+#endif
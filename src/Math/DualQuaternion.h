@@ -94,6 +94,21 @@ template<class T> class DualQuaternion: public Dual<Quaternion<T>> {
             return {q, Quaternion<T>(matrix.translation()/2)*q};
         }
 
+        /**
+         * @brief Screw linear interpolation of two dual quaternions
+         * @param normalizedA   First dual quaternion
+         * @param normalizedB   Second dual quaternion
+         * @param t             Interpolation phase (from range @f$ [0; 1] @f$)
+         *
+         * Expects that both dual quaternions are normalized. Interpolates
+         * both rotation and translation with constant speed along the screw
+         * axis and always along the shortest path. @f[
+         *      \hat q_{ScLERP} = \hat q_A (\hat q_A^* \hat q_B)^t
+         * @f]
+         * @see isNormalized(), Quaternion::slerp()
+         */
+        static DualQuaternion<T> sclerp(const DualQuaternion<T>& normalizedA, const DualQuaternion<T>& normalizedB, T t);
+
         /**
          * @brief Default constructor
          *
@@ -314,6 +329,33 @@ template<class T> class DualQuaternion: public Dual<Quaternion<T>> {
         MAGNUM_DUAL_SUBCLASS_IMPLEMENTATION(DualQuaternion, Quaternion)
 };
 
+template<class T> DualQuaternion<T> DualQuaternion<T>::sclerp(const DualQuaternion<T>& normalizedA, const DualQuaternion<T>& normalizedB, const T t) {
+    CORRADE_ASSERT(normalizedA.isNormalized() && normalizedB.isNormalized(),
+        "Math::DualQuaternion::sclerp(): dual quaternions must be normalized", DualQuaternion<T>({}, {{}, std::numeric_limits<T>::quiet_NaN()}));
+
+    /* Difference between the two, negated to go along the shortest path */
+    DualQuaternion<T> difference = normalizedA.quaternionConjugated()*normalizedB;
+    if(difference.real().scalar() < T(0)) difference = -difference;
+
+    /* Screw parameters of the difference. Without rotation it is pure
+       translation, which is interpolated linearly. */
+    const T halfAngleSin = difference.real().vector().length();
+    if(halfAngleSin < TypeTraits<T>::epsilon())
+        return normalizedA*DualQuaternion<T>({}, {difference.dual().vector()*t, T(0)});
+
+    const Vector3<T> direction = difference.real().vector()/halfAngleSin;
+    const T halfAngle = std::atan2(halfAngleSin, difference.real().scalar());
+    const T halfPitch = -difference.dual().scalar()/halfAngleSin;
+    const Vector3<T> moment = (difference.dual().vector() - direction*(halfPitch*difference.real().scalar()))/halfAngleSin;
+
+    /* Power of the difference, i.e. the screw motion scaled by t */
+    const T angleSin = std::sin(halfAngle*t);
+    const T angleCos = std::cos(halfAngle*t);
+    const T pitch = halfPitch*t;
+    return normalizedA*DualQuaternion<T>({direction*angleSin, angleCos},
+        {moment*angleSin + direction*(pitch*angleCos), -pitch*angleSin});
+}
+
 /** @debugoperator{Magnum::Math::DualQuaternion} */
 template<class T> Corrade::Utility::Debug operator<<(Corrade::Utility::Debug debug, const DualQuaternion<T>& value) {
     debug << "DualQuaternion({{";
@@ -28,6 +28,10 @@
  * @brief Class Magnum::Math::Geometry::Intersection
  */
 
+#include <algorithm>
+#include <limits>
+
+#include "Math/Range.h"
 #include "Math/Vector3.h"
 
 namespace Magnum { namespace Math { namespace Geometry {
@@ -123,6 +127,38 @@ class Intersection {
             const T f = Vector3<T>::dot(planePosition, planeNormal);
             return (f-Vector3<T>::dot(planeNormal, p))/Vector3<T>::dot(planeNormal, r);
         }
+
+        /**
+         * @brief %Intersection of a range and line
+         * @param range         Range
+         * @param p             Starting point of the line
+         * @param r             Direction of the line
+         * @return %Intersection point positions `t`, `u` on the line where
+         *      it enters and leaves the range. %Intersection points can be
+         *      then computed with `p + t*r` and `p + u*r`. If `t` is larger
+         *      than `u`, the line doesn't intersect the range.
+         *
+         * The line is clipped by pairs of parallel planes bounding the
+         * range in each dimension. Line intersects planes of dimension *i*
+         * at: @f[
+         *      t_i = \cfrac{min_i - p_i}{r_i} ~~~~~ u_i = \cfrac{max_i - p_i}{r_i}
+         * @f]
+         * The resulting `t` is maximum of all minimal parameters and `u` is
+         * minimum of all maximal parameters. If the line is parallel to some
+         * pair of planes, the parameters for that dimension are infinite.
+         */
+        template<UnsignedInt dimensions, class T> static std::pair<T, T> rangeLine(const Range<dimensions, T>& range, const typename Range<dimensions, T>::VectorType& p, const typename Range<dimensions, T>::VectorType& r) {
+            T t = -std::numeric_limits<T>::infinity(),
+              u = std::numeric_limits<T>::infinity();
+            for(std::size_t i = 0; i != dimensions; ++i) {
+                const T a = (range.min()[i] - p[i])/r[i];
+                const T b = (range.max()[i] - p[i])/r[i];
+                t = std::max(t, std::min(a, b));
+                u = std::min(u, std::max(a, b));
+            }
+
+            return {t, u};
+        }
 };
 
 }}}
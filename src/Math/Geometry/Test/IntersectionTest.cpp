@@ -35,14 +35,17 @@ class IntersectionTest: public Corrade::TestSuite::Tester {
 
         void planeLine();
         void lineLine();
+        void rangeLine();
 };
 
 typedef Math::Vector2<Float> Vector2;
 typedef Math::Vector3<Float> Vector3;
+typedef Math::Range3D<Float> Range3D;
 
 IntersectionTest::IntersectionTest() {
     addTests({&IntersectionTest::planeLine,
-              &IntersectionTest::lineLine});
+              &IntersectionTest::lineLine,
+              &IntersectionTest::rangeLine});
 }
 
 void IntersectionTest::planeLine() {
@@ -98,6 +101,29 @@ void IntersectionTest::lineLine() {
         {0.0f, 0.0f}, {1.0f, 2.0f}), std::numeric_limits<Float>::infinity());
 }
 
+void IntersectionTest::rangeLine() {
+    const Range3D range({-1.0f, 0.0f, 1.0f}, {1.0f, 2.0f, 3.0f});
+
+    /* Crossing the range */
+    CORRADE_COMPARE(Intersection::rangeLine(range,
+        Vector3(-2.0f, 1.0f, 2.0f), Vector3(4.0f, 0.0f, 0.0f)), std::make_pair(0.25f, 0.75f));
+
+    /* Crossing the range diagonally, starting inside */
+    CORRADE_COMPARE(Intersection::rangeLine(range,
+        Vector3(0.0f, 1.0f, 2.0f), Vector3(1.0f, 2.0f, 1.0f)), std::make_pair(-0.5f, 0.5f));
+
+    /* Missing the range */
+    const auto tu = Intersection::rangeLine(range,
+        Vector3(-2.0f, 3.0f, 2.0f), Vector3(1.0f, 1.0f, 0.0f));
+    CORRADE_VERIFY(tu.first > tu.second);
+
+    /* Parallel to the range side outside of it */
+    const auto tuParallel = Intersection::rangeLine(range,
+        Vector3(-2.0f, 3.0f, 2.0f), Vector3(1.0f, 0.0f, 0.0f));
+    CORRADE_COMPARE(tuParallel.second, -std::numeric_limits<Float>::infinity());
+    CORRADE_VERIFY(tuParallel.first > tuParallel.second);
+}
+
 }}}}
 
 CORRADE_TEST_MAIN(Magnum::Math::Geometry::Test::IntersectionTest)
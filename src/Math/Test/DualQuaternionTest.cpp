@@ -56,6 +56,7 @@ class DualQuaternionTest: public Corrade::TestSuite::Tester {
         void matrix();
         void transformPoint();
         void transformPointNormalized();
+        void sclerp();
 
         void debug();
 };
@@ -92,6 +93,7 @@ DualQuaternionTest::DualQuaternionTest() {
               &DualQuaternionTest::matrix,
               &DualQuaternionTest::transformPoint,
               &DualQuaternionTest::transformPointNormalized,
+              &DualQuaternionTest::sclerp,
 
               &DualQuaternionTest::debug});
 }
@@ -295,6 +297,35 @@ void DualQuaternionTest::transformPointNormalized() {
     CORRADE_COMPARE(transformedB, Vector3(-1.0f, -2.918512f, 2.780698f));
 }
 
+void DualQuaternionTest::sclerp() {
+    DualQuaternion a = DualQuaternion::translation({1.0f, 2.0f, 0.0f})*DualQuaternion::rotation(Deg(15.0f), Vector3::zAxis());
+    DualQuaternion b = DualQuaternion::translation({1.0f, 2.0f, 4.0f})*DualQuaternion::rotation(Deg(105.0f), Vector3::zAxis());
+
+    std::ostringstream o;
+    Corrade::Utility::Error::setOutput(&o);
+    DualQuaternion notInterpolated = DualQuaternion::sclerp(a*Dual(2), b, 0.3f);
+    CORRADE_VERIFY(notInterpolated != notInterpolated);
+    CORRADE_COMPARE(o.str(), "Math::DualQuaternion::sclerp(): dual quaternions must be normalized\n");
+
+    /* End points */
+    CORRADE_COMPARE(DualQuaternion::sclerp(a, b, 0.0f), a);
+    CORRADE_COMPARE(DualQuaternion::sclerp(a, b, 1.0f), b);
+
+    /* Screw motion along Z axis, rotation and translation are interpolated
+       together, the result is normalized */
+    DualQuaternion c = DualQuaternion::sclerp(a, b, 0.25f);
+    CORRADE_VERIFY(c.isNormalized());
+    CORRADE_COMPARE(c, DualQuaternion::translation({1.0f, 2.0f, 1.0f})*DualQuaternion::rotation(Deg(37.5f), Vector3::zAxis()));
+
+    /* Shortest path */
+    CORRADE_COMPARE(DualQuaternion::sclerp(a, -b, 0.25f), c);
+
+    /* Pure translation is interpolated linearly */
+    DualQuaternion d = DualQuaternion::translation({1.0f, 2.0f, 3.0f});
+    DualQuaternion e = DualQuaternion::translation({3.0f, -2.0f, 5.0f});
+    CORRADE_COMPARE(DualQuaternion::sclerp(d, e, 0.25f), DualQuaternion::translation({1.5f, 1.0f, 3.5f}));
+}
+
 void DualQuaternionTest::debug() {
     std::ostringstream o;
 
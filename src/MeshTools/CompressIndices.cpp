@@ -25,12 +25,22 @@
 #include "CompressIndices.h"
 
 #include <cstring>
-#include <algorithm>
+#include <limits>
 #include <Containers/Array.h>
 
-#include "Math/Functions.h"
 #include "Buffer.h"
 
+/* SSE2 is baseline on all x86-64 CPUs, AVX2 is picked at runtime. Target
+   attributes usable together with intrinsics headers need GCC 4.9. */
+#if (defined(__GNUC__) || defined(__clang__)) && !defined(CORRADE_TARGET_NACL) && (defined(__x86_64__) || (defined(__i386__) && defined(__SSE2__)))
+#define MAGNUM_MESHTOOLS_USE_SSE2
+#include <emmintrin.h>
+#if !defined(__clang__) && __GNUC__*100 + __GNUC_MINOR__ >= 409
+#define MAGNUM_MESHTOOLS_USE_AVX2
+#include <immintrin.h>
+#endif
+#endif
+
 namespace Magnum { namespace MeshTools {
 
 namespace {
@@ -40,49 +50,232 @@ template<> constexpr Mesh::IndexType indexType<UnsignedByte>() { return Mesh::In
 template<> constexpr Mesh::IndexType indexType<UnsignedShort>() { return Mesh::IndexType::UnsignedShort; }
 template<> constexpr Mesh::IndexType indexType<UnsignedInt>() { return Mesh::IndexType::UnsignedInt; }
 
-template<class T> inline std::tuple<std::size_t, Mesh::IndexType, Containers::Array<char>> compress(const std::vector<UnsignedInt>& indices) {
-    Containers::Array<char> buffer(indices.size()*sizeof(T));
-    for(std::size_t i = 0; i != indices.size(); ++i) {
-        T index = static_cast<T>(indices[i]);
-        std::memcpy(buffer.begin()+i*sizeof(T), &index, sizeof(T));
+/* Scalar fallbacks, also used for the remaining elements after SIMD loops */
+void minMaxScalar(const UnsignedInt* const data, const std::size_t size, UnsignedInt& min, UnsignedInt& max) {
+    for(std::size_t i = 0; i != size; ++i) {
+        if(data[i] < min) min = data[i];
+        if(data[i] > max) max = data[i];
     }
+}
 
-    return std::make_tuple(indices.size(), indexType<T>(), std::move(buffer));
+template<class T> void narrowScalar(const UnsignedInt* const data, const std::size_t size, const UnsignedInt offset, T* const out) {
+    for(std::size_t i = 0; i != size; ++i)
+        out[i] = T(data[i] - offset);
 }
 
-std::tuple<std::size_t, Mesh::IndexType, Containers::Array<char>> compressIndicesInternal(const std::vector<UnsignedInt>& indices, UnsignedInt max) {
-    switch(Math::log(256, max)) {
-        case 0:
-            return compress<UnsignedByte>(indices);
-        case 1:
-            return compress<UnsignedShort>(indices);
-        case 2:
-        case 3:
-            return compress<UnsignedInt>(indices);
+#ifdef MAGNUM_MESHTOOLS_USE_SSE2
+/* SSE2 has only signed 32bit comparison, the values are biased to make it
+   work for unsigned ones */
+void minMaxSse2(const UnsignedInt* const data, const std::size_t size, UnsignedInt& min, UnsignedInt& max) {
+    const __m128i bias = _mm_set1_epi32(std::numeric_limits<Int>::min());
+    __m128i vmin = _mm_set1_epi32(std::numeric_limits<Int>::max());
+    __m128i vmax = bias;
 
-        default:
-            CORRADE_ASSERT(false, "MeshTools::compressIndices(): no type able to index" << max << "elements.", {});
+    std::size_t i = 0;
+    for(; i + 4 <= size; i += 4) {
+        const __m128i v = _mm_xor_si128(_mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i)), bias);
+        const __m128i lt = _mm_cmplt_epi32(v, vmin);
+        vmin = _mm_or_si128(_mm_and_si128(lt, v), _mm_andnot_si128(lt, vmin));
+        const __m128i gt = _mm_cmpgt_epi32(v, vmax);
+        vmax = _mm_or_si128(_mm_and_si128(gt, v), _mm_andnot_si128(gt, vmax));
     }
+
+    UnsignedInt mins[4], maxs[4];
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(mins), _mm_xor_si128(vmin, bias));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(maxs), _mm_xor_si128(vmax, bias));
+    for(std::size_t j = 0; j != 4; ++j) {
+        if(mins[j] < min) min = mins[j];
+        if(maxs[j] > max) max = maxs[j];
+    }
+    minMaxScalar(data + i, size - i, min, max);
+}
+
+/* Values are shifted to signed 16bit range, packed with signed saturation
+   (which doesn't saturate anything) and shifted back */
+inline __m128i packShortSse2(const UnsignedInt* const data, const __m128i offset) {
+    const __m128i a = _mm_sub_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(data)), offset);
+    const __m128i b = _mm_sub_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(data + 4)), offset);
+    return _mm_xor_si128(_mm_packs_epi32(a, b), _mm_set1_epi16(std::numeric_limits<Short>::min()));
+}
+
+void narrowShortSse2(const UnsignedInt* const data, const std::size_t size, const UnsignedInt offset, UnsignedShort* const out) {
+    const __m128i shiftedOffset = _mm_set1_epi32(Int(offset + 32768));
+
+    std::size_t i = 0;
+    for(; i + 8 <= size; i += 8)
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i), packShortSse2(data + i, shiftedOffset));
+
+    narrowScalar(data + i, size - i, offset, out + i);
+}
+
+void narrowByteSse2(const UnsignedInt* const data, const std::size_t size, const UnsignedInt offset, UnsignedByte* const out) {
+    const __m128i shiftedOffset = _mm_set1_epi32(Int(offset + 32768));
+
+    std::size_t i = 0;
+    for(; i + 16 <= size; i += 16)
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i), _mm_packus_epi16(
+            packShortSse2(data + i, shiftedOffset),
+            packShortSse2(data + i + 8, shiftedOffset)));
+
+    narrowScalar(data + i, size - i, offset, out + i);
+}
+#endif
+
+#ifdef MAGNUM_MESHTOOLS_USE_AVX2
+__attribute__((target("avx2"))) void minMaxAvx2(const UnsignedInt* const data, const std::size_t size, UnsignedInt& min, UnsignedInt& max) {
+    __m256i vmin = _mm256_set1_epi32(-1);
+    __m256i vmax = _mm256_setzero_si256();
+
+    std::size_t i = 0;
+    for(; i + 8 <= size; i += 8) {
+        const __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i));
+        vmin = _mm256_min_epu32(vmin, v);
+        vmax = _mm256_max_epu32(vmax, v);
+    }
+
+    UnsignedInt mins[8], maxs[8];
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(mins), vmin);
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(maxs), vmax);
+    for(std::size_t j = 0; j != 8; ++j) {
+        if(mins[j] < min) min = mins[j];
+        if(maxs[j] > max) max = maxs[j];
+    }
+    minMaxScalar(data + i, size - i, min, max);
+}
+
+/* The packs operate on 128bit lanes, so the result needs to be permuted */
+__attribute__((target("avx2"))) inline __m256i packShortAvx2(const UnsignedInt* const data, const __m256i offset) {
+    const __m256i a = _mm256_sub_epi32(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(data)), offset);
+    const __m256i b = _mm256_sub_epi32(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + 8)), offset);
+    return _mm256_packus_epi32(a, b);
+}
+
+__attribute__((target("avx2"))) void narrowShortAvx2(const UnsignedInt* const data, const std::size_t size, const UnsignedInt offset, UnsignedShort* const out) {
+    const __m256i voffset = _mm256_set1_epi32(Int(offset));
+
+    std::size_t i = 0;
+    for(; i + 16 <= size; i += 16)
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i), _mm256_permute4x64_epi64(packShortAvx2(data + i, voffset), 0xd8));
+
+    narrowScalar(data + i, size - i, offset, out + i);
+}
+
+__attribute__((target("avx2"))) void narrowByteAvx2(const UnsignedInt* const data, const std::size_t size, const UnsignedInt offset, UnsignedByte* const out) {
+    const __m256i voffset = _mm256_set1_epi32(Int(offset));
+    const __m256i permutation = _mm256_setr_epi32(0, 4, 1, 5, 2, 6, 3, 7);
+
+    std::size_t i = 0;
+    for(; i + 32 <= size; i += 32) {
+        const __m256i packed = _mm256_packus_epi16(
+            packShortAvx2(data + i, voffset),
+            packShortAvx2(data + i + 16, voffset));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i), _mm256_permutevar8x32_epi32(packed, permutation));
+    }
+
+    narrowScalar(data + i, size - i, offset, out + i);
+}
+#endif
+
+/* Implementations picked based on CPU features on first use */
+struct Implementation {
+    Implementation();
+
+    void(*minMax)(const UnsignedInt*, std::size_t, UnsignedInt&, UnsignedInt&);
+    void(*narrowShort)(const UnsignedInt*, std::size_t, UnsignedInt, UnsignedShort*);
+    void(*narrowByte)(const UnsignedInt*, std::size_t, UnsignedInt, UnsignedByte*);
+};
+
+Implementation::Implementation(): minMax(minMaxScalar), narrowShort(narrowScalar<UnsignedShort>), narrowByte(narrowScalar<UnsignedByte>) {
+    #ifdef MAGNUM_MESHTOOLS_USE_SSE2
+    minMax = minMaxSse2;
+    narrowShort = narrowShortSse2;
+    narrowByte = narrowByteSse2;
+    #endif
+
+    #ifdef MAGNUM_MESHTOOLS_USE_AVX2
+    __builtin_cpu_init();
+    if(__builtin_cpu_supports("avx2")) {
+        minMax = minMaxAvx2;
+        narrowShort = narrowShortAvx2;
+        narrowByte = narrowByteAvx2;
+    }
+    #endif
+}
+
+const Implementation& implementation() {
+    static const Implementation instance;
+    return instance;
+}
+
+std::tuple<UnsignedInt, UnsignedInt> minMax(const std::vector<UnsignedInt>& indices) {
+    if(indices.empty()) return std::make_tuple(0, 0);
+
+    UnsignedInt min = ~UnsignedInt(0), max = 0;
+    implementation().minMax(indices.data(), indices.size(), min, max);
+    return std::make_tuple(min, max);
+}
+
+template<class T> void narrow(const std::vector<UnsignedInt>& indices, UnsignedInt offset, char* out);
+
+template<> void narrow<UnsignedByte>(const std::vector<UnsignedInt>& indices, const UnsignedInt offset, char* const out) {
+    implementation().narrowByte(indices.data(), indices.size(), offset, reinterpret_cast<UnsignedByte*>(out));
+}
+
+template<> void narrow<UnsignedShort>(const std::vector<UnsignedInt>& indices, const UnsignedInt offset, char* const out) {
+    implementation().narrowShort(indices.data(), indices.size(), offset, reinterpret_cast<UnsignedShort*>(out));
+}
+
+template<> void narrow<UnsignedInt>(const std::vector<UnsignedInt>& indices, const UnsignedInt offset, char* const out) {
+    if(!offset) std::memcpy(out, indices.data(), indices.size()*sizeof(UnsignedInt));
+    else narrowScalar(indices.data(), indices.size(), offset, reinterpret_cast<UnsignedInt*>(out));
+}
+
+template<class T> inline std::tuple<std::size_t, Mesh::IndexType, Containers::Array<char>> compress(const std::vector<UnsignedInt>& indices, const UnsignedInt offset) {
+    Containers::Array<char> buffer(indices.size()*sizeof(T));
+    narrow<T>(indices, offset, buffer.begin());
+
+    return std::make_tuple(indices.size(), indexType<T>(), std::move(buffer));
+}
+
+std::tuple<std::size_t, Mesh::IndexType, Containers::Array<char>> compressIndicesInternal(const std::vector<UnsignedInt>& indices, const UnsignedInt offset, const UnsignedInt max) {
+    if(max - offset <= std::numeric_limits<UnsignedByte>::max())
+        return compress<UnsignedByte>(indices, offset);
+    if(max - offset <= std::numeric_limits<UnsignedShort>::max())
+        return compress<UnsignedShort>(indices, offset);
+    return compress<UnsignedInt>(indices, offset);
 }
 
 }
 
 std::tuple<std::size_t, Mesh::IndexType, Containers::Array<char>> compressIndices(const std::vector<UnsignedInt>& indices) {
-    return compressIndicesInternal(indices, *std::max_element(indices.begin(), indices.end()));
+    return compressIndicesInternal(indices, 0, std::get<1>(minMax(indices)));
+}
+
+std::tuple<std::size_t, Mesh::IndexType, Containers::Array<char>, UnsignedInt, UnsignedInt> compressIndicesRange(const std::vector<UnsignedInt>& indices, const bool rebase) {
+    UnsignedInt min, max;
+    std::tie(min, max) = minMax(indices);
+
+    std::size_t indexCount;
+    Mesh::IndexType indexType;
+    Containers::Array<char> data;
+    std::tie(indexCount, indexType, data) = compressIndicesInternal(indices, rebase ? min : 0, max);
+
+    return std::make_tuple(indexCount, indexType, std::move(data), min, max);
 }
 
 void compressIndices(Mesh& mesh, Buffer& buffer, BufferUsage usage, const std::vector<UnsignedInt>& indices) {
-    auto minmax = std::minmax_element(indices.begin(), indices.end());
+    UnsignedInt min, max;
+    std::tie(min, max) = minMax(indices);
 
     /** @todo Performance hint when range can be represented by smaller value? */
 
     std::size_t indexCount;
     Mesh::IndexType indexType;
     Containers::Array<char> data;
-    std::tie(indexCount, indexType, data) = compressIndicesInternal(indices, *minmax.second);
+    std::tie(indexCount, indexType, data) = compressIndicesInternal(indices, 0, max);
 
     mesh.setIndexCount(indices.size())
-        .setIndexBuffer(buffer, 0, indexType, *minmax.first, *minmax.second);
+        .setIndexBuffer(buffer, 0, indexType, min, max);
     buffer.setData(data, usage);
 }
 
@@ -25,7 +25,7 @@
 */
 
 /** @file
- * @brief Function @ref Magnum::MeshTools::compressIndices()
+ * @brief Function @ref Magnum::MeshTools::compressIndices(), @ref Magnum::MeshTools::compressIndicesRange()
  */
 
 #include <tuple>
@@ -52,11 +52,46 @@ Containers::Array<char> data;
 std::tie(indexCount, indexType, data) = MeshTools::compressIndices(indices);
 @endcode
 
+On x86 the index range scan and the conversion are done using SSE2 or AVX2,
+depending on what the CPU supports.
+
 See also @ref compressIndices(Mesh&, Buffer&, BufferUsage, const std::vector<UnsignedInt>&),
-which writes the compressed data directly into index buffer of given mesh.
+which writes the compressed data directly into index buffer of given mesh, and
+@ref compressIndicesRange(), which additionally returns index range.
 */
 std::tuple<std::size_t, Mesh::IndexType, Containers::Array<char>> MAGNUM_MESHTOOLS_EXPORT compressIndices(const std::vector<UnsignedInt>& indices);
 
+/**
+@brief Compress vertex indices and return their range
+@param indices  Index array
+@param rebase   Whether to subtract the minimal index from all indices
+@return Index count, type, compressed index array, minimal and maximal index
+
+The same as @ref compressIndices(const std::vector<UnsignedInt>&), but
+additionally returns range of original indices, which can be passed to
+@ref Mesh::setIndexBuffer(Buffer&, GLintptr, IndexType, UnsignedInt, UnsignedInt)
+without scanning the array again. If @p rebase is `true`, the minimal index is
+subtracted from all indices before compression, so e.g. indices in range
+@f$ [ 70000, 70400 ] @f$ fit into 16bit type. It's then up to you to offset
+the vertex data accordingly (for example by adding the minimal index
+multiplied by vertex stride to vertex buffer offset). The returned minimal and
+maximal index are always the original ones, i.e. before rebasing, so in the
+above case the range is still @f$ [ 70000, 70400 ] @f$ and the compressed
+indices are in range @f$ [ 0, 400 ] @f$. Example usage:
+@code
+std::size_t indexCount;
+Mesh::IndexType indexType;
+Containers::Array<char> data;
+UnsignedInt indexStart, indexEnd;
+std::tie(indexCount, indexType, data, indexStart, indexEnd) = MeshTools::compressIndicesRange(indices);
+
+indexBuffer.setData(data, BufferUsage::StaticDraw);
+mesh.setIndexCount(indexCount)
+    .setIndexBuffer(indexBuffer, 0, indexType, indexStart, indexEnd);
+@endcode
+*/
+std::tuple<std::size_t, Mesh::IndexType, Containers::Array<char>, UnsignedInt, UnsignedInt> MAGNUM_MESHTOOLS_EXPORT compressIndicesRange(const std::vector<UnsignedInt>& indices, bool rebase = false);
+
 /**
 @brief Compress vertex indices and write them to index buffer
 @param mesh     Output mesh
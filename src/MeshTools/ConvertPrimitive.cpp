@@ -0,0 +1,208 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "ConvertPrimitive.h"
+
+#include <algorithm>
+#include <limits>
+#include <Containers/Array.h>
+#include <Utility/Assert.h>
+
+namespace Magnum { namespace MeshTools {
+
+void triangleStripToTriangles(std::vector<UnsignedInt>& indices) {
+    if(indices.size() < 3) {
+        indices.clear();
+        return;
+    }
+
+    /* Expand from the back, so no input index is overwritten before it's
+       read. Every odd triangle has swapped first two vertices to preserve
+       the winding. */
+    const std::size_t triangleCount = indices.size() - 2;
+    indices.resize(triangleCount*3);
+    for(std::size_t i = triangleCount; i != 0; --i) {
+        const std::size_t triangle = i - 1;
+        const UnsignedInt a = indices[triangle];
+        const UnsignedInt b = indices[triangle + 1];
+        const UnsignedInt c = indices[triangle + 2];
+        const bool odd = triangle & 1;
+        indices[triangle*3] = odd ? b : a;
+        indices[triangle*3 + 1] = odd ? a : b;
+        indices[triangle*3 + 2] = c;
+    }
+
+    /* Remove degenerate triangles */
+    std::size_t out = 0;
+    for(std::size_t i = 0; i != indices.size(); i += 3) {
+        if(indices[i] == indices[i+1] || indices[i+1] == indices[i+2] || indices[i+2] == indices[i])
+            continue;
+
+        indices[out++] = indices[i];
+        indices[out++] = indices[i+1];
+        indices[out++] = indices[i+2];
+    }
+    indices.resize(out);
+}
+
+void triangleFanToTriangles(std::vector<UnsignedInt>& indices) {
+    if(indices.size() < 3) {
+        indices.clear();
+        return;
+    }
+
+    /* Expand from the back, the first index is never overwritten before the
+       last triangle is written */
+    const std::size_t triangleCount = indices.size() - 2;
+    indices.resize(triangleCount*3);
+    for(std::size_t i = triangleCount; i != 0; --i) {
+        const std::size_t triangle = i - 1;
+        const UnsignedInt b = indices[triangle + 1];
+        const UnsignedInt c = indices[triangle + 2];
+        indices[triangle*3] = indices[0];
+        indices[triangle*3 + 1] = b;
+        indices[triangle*3 + 2] = c;
+    }
+}
+
+void quadsToTriangles(std::vector<UnsignedInt>& indices) {
+    CORRADE_ASSERT(!(indices.size()%4), "MeshTools::quadsToTriangles(): index count is not divisible by 4!", );
+
+    /* Expand from the back */
+    const std::size_t quadCount = indices.size()/4;
+    indices.resize(quadCount*6);
+    for(std::size_t i = quadCount; i != 0; --i) {
+        const std::size_t quad = i - 1;
+        const UnsignedInt a = indices[quad*4];
+        const UnsignedInt b = indices[quad*4 + 1];
+        const UnsignedInt c = indices[quad*4 + 2];
+        const UnsignedInt d = indices[quad*4 + 3];
+        indices[quad*6] = a;
+        indices[quad*6 + 1] = b;
+        indices[quad*6 + 2] = c;
+        indices[quad*6 + 3] = a;
+        indices[quad*6 + 4] = c;
+        indices[quad*6 + 5] = d;
+    }
+}
+
+namespace {
+
+/* Find not yet used triangle with directed edge a -> b, returns its third
+   vertex and marks the triangle as used */
+bool findNextTriangle(const std::vector<UnsignedInt>& indices, const std::vector<UnsignedInt>& triangleOffset, const std::vector<UnsignedInt>& triangles, std::vector<bool>& used, const UnsignedInt a, const UnsignedInt b, UnsignedInt& next) {
+    for(std::size_t i = triangleOffset[a]; i != triangleOffset[a+1]; ++i) {
+        const UnsignedInt triangle = triangles[i];
+        if(used[triangle]) continue;
+
+        for(std::size_t j = 0; j != 3; ++j) {
+            if(indices[triangle*3 + j] != a || indices[triangle*3 + (j+1)%3] != b)
+                continue;
+
+            used[triangle] = true;
+            next = indices[triangle*3 + (j+2)%3];
+            return true;
+        }
+    }
+
+    return false;
+}
+
+template<class T> Containers::Array<char> narrowStrip(const std::vector<UnsignedInt>& strip) {
+    Containers::Array<char> data(strip.size()*sizeof(T));
+    T* out = reinterpret_cast<T*>(data.begin());
+    for(std::size_t i = 0; i != strip.size(); ++i)
+        out[i] = strip[i] == ~UnsignedInt(0) ? std::numeric_limits<T>::max() : T(strip[i]);
+
+    return data;
+}
+
+}
+
+std::tuple<std::size_t, Mesh::IndexType, Containers::Array<char>> trianglesToTriangleStrip(const std::vector<UnsignedInt>& indices, const UnsignedInt vertexCount) {
+    CORRADE_ASSERT(!(indices.size()%3), "MeshTools::trianglesToTriangleStrip(): index count is not divisible by 3!", std::make_tuple(0, Mesh::IndexType::UnsignedByte, nullptr));
+
+    /* Triangles adjacent to each vertex, in compressed form */
+    std::vector<UnsignedInt> triangleOffset(vertexCount + 1);
+    for(UnsignedInt index: indices) ++triangleOffset[index + 1];
+    for(std::size_t i = 0; i != vertexCount; ++i)
+        triangleOffset[i + 1] += triangleOffset[i];
+    std::vector<UnsignedInt> triangles(indices.size());
+    {
+        std::vector<UnsignedInt> position(triangleOffset.begin(), triangleOffset.end() - 1);
+        for(std::size_t i = 0; i != indices.size(); ++i)
+            triangles[position[indices[i]]++] = i/3;
+    }
+
+    /* Build the strips, separated with ~UnsignedInt(0) */
+    std::vector<UnsignedInt> strip;
+    strip.reserve(indices.size());
+    std::vector<bool> used(indices.size()/3);
+    UnsignedInt max = 0;
+    for(std::size_t start = 0; start != used.size(); ++start) {
+        if(used[start]) continue;
+        used[start] = true;
+
+        /* Rotate the first triangle so the strip continues over an edge
+           with unused neighbor, if there is any */
+        const UnsignedInt* triangle = indices.data() + start*3;
+        std::size_t rotation = 0;
+        UnsignedInt next = 0;
+        bool hasNext = false;
+        for(; rotation != 3 && !hasNext; ++rotation)
+            hasNext = findNextTriangle(indices, triangleOffset, triangles, used, triangle[(rotation+2)%3], triangle[(rotation+1)%3], next);
+        if(hasNext) --rotation;
+        else rotation = 0;
+
+        if(!strip.empty()) strip.push_back(~UnsignedInt(0));
+        const std::size_t stripStart = strip.size();
+        for(std::size_t i = 0; i != 3; ++i) {
+            strip.push_back(triangle[(rotation+i)%3]);
+            max = std::max(max, strip.back());
+        }
+
+        /* Extend the strip as long as possible. Even triangles continue over
+           the edge with the same orientation as the last two vertices, odd
+           with the opposite. */
+        while(hasNext) {
+            strip.push_back(next);
+            max = std::max(max, next);
+
+            const std::size_t size = strip.size();
+            const bool odd = (size - stripStart - 2) & 1;
+            hasNext = odd ?
+                findNextTriangle(indices, triangleOffset, triangles, used, strip[size-1], strip[size-2], next) :
+                findNextTriangle(indices, triangleOffset, triangles, used, strip[size-2], strip[size-1], next);
+        }
+    }
+
+    /* Output in smallest type which can contain also the restart index */
+    if(max < std::numeric_limits<UnsignedByte>::max())
+        return std::make_tuple(strip.size(), Mesh::IndexType::UnsignedByte, narrowStrip<UnsignedByte>(strip));
+    if(max < std::numeric_limits<UnsignedShort>::max())
+        return std::make_tuple(strip.size(), Mesh::IndexType::UnsignedShort, narrowStrip<UnsignedShort>(strip));
+    return std::make_tuple(strip.size(), Mesh::IndexType::UnsignedInt, narrowStrip<UnsignedInt>(strip));
+}
+
+}}
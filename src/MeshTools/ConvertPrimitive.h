@@ -0,0 +1,100 @@
+#ifndef Magnum_MeshTools_ConvertPrimitive_h
+#define Magnum_MeshTools_ConvertPrimitive_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Function @ref Magnum::MeshTools::triangleStripToTriangles(), @ref Magnum::MeshTools::triangleFanToTriangles(), @ref Magnum::MeshTools::quadsToTriangles(), @ref Magnum::MeshTools::trianglesToTriangleStrip()
+ */
+
+#include <tuple>
+#include <vector>
+
+#include "Mesh.h"
+
+#include "magnumMeshToolsVisibility.h"
+
+namespace Magnum { namespace MeshTools {
+
+/**
+@brief Convert triangle strip to triangle list
+@param[in,out] indices  Index array to operate on
+
+Converts indices of @ref MeshPrimitive::TriangleStrip to indices of
+@ref MeshPrimitive::Triangles, preserving face winding. Degenerate triangles
+(e.g. the ones used for joining multiple strips together) are removed. The
+conversion is done in-place, the resulting list can be then directly passed to
+@ref tipsify() or @ref compressIndices(). If there is less than three indices,
+the output is empty.
+@see @ref trianglesToTriangleStrip()
+*/
+void MAGNUM_MESHTOOLS_EXPORT triangleStripToTriangles(std::vector<UnsignedInt>& indices);
+
+/**
+@brief Convert triangle fan to triangle list
+@param[in,out] indices  Index array to operate on
+
+Converts indices of @ref MeshPrimitive::TriangleFan to indices of
+@ref MeshPrimitive::Triangles, preserving face winding. The conversion is done
+in-place. If there is less than three indices, the output is empty.
+*/
+void MAGNUM_MESHTOOLS_EXPORT triangleFanToTriangles(std::vector<UnsignedInt>& indices);
+
+/**
+@brief Convert quad list to triangle list
+@param[in,out] indices  Index array to operate on
+
+Splits each quad `a b c d` into triangles `a b c` and `a c d`, preserving face
+winding. The conversion is done in-place.
+
+@attention Index count must be divisible by 4.
+*/
+void MAGNUM_MESHTOOLS_EXPORT quadsToTriangles(std::vector<UnsignedInt>& indices);
+
+/**
+@brief Convert triangle list to triangle strips with primitive restart
+@param indices      Triangle index array
+@param vertexCount  Vertex count
+@return Index count, type and compressed index array
+
+Greedily joins neighboring triangles into strips, in the order in which they
+appear in the index array (so it's advisable to call @ref tipsify() first).
+The strips are separated with primitive restart index, which is the maximal
+value of the returned index type, i.e. `0xff` for
+@ref Mesh::IndexType::UnsignedByte, `0xffff` for
+@ref Mesh::IndexType::UnsignedShort and `0xffffffff` for
+@ref Mesh::IndexType::UnsignedInt. This corresponds to
+@def_gl{PRIMITIVE_RESTART_FIXED_INDEX} behavior, on desktop GL the restart
+index needs to be set explicitly. The output is directly in the smallest index
+type able to contain both the indices and the restart index, similarly to
+@ref compressIndices(). Face winding is preserved, triangles which aren't
+consistently wound with their neighbors are put into separate strips.
+
+@attention Index count must be divisible by 3.
+*/
+std::tuple<std::size_t, Mesh::IndexType, Containers::Array<char>> MAGNUM_MESHTOOLS_EXPORT trianglesToTriangleStrip(const std::vector<UnsignedInt>& indices, UnsignedInt vertexCount);
+
+}}
+
+#endif
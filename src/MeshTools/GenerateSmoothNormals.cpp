@@ -0,0 +1,138 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "GenerateSmoothNormals.h"
+
+#include <cmath>
+
+#include "Math/Vector3.h"
+#include "MeshTools/Implementation/SharedThreadPool.h"
+#include "MeshTools/Implementation/VertexAdjacency.h"
+
+namespace Magnum { namespace MeshTools {
+
+namespace {
+
+/* Compute weighted contribution of each face to each of its corners and
+   unit normal of each face, for faces in range [begin, end) */
+void faceNormals(const std::vector<UnsignedInt>& indices, const std::vector<Vector3>& positions, const NormalWeighting weighting, const std::size_t begin, const std::size_t end, Vector3* const cornerNormals, Vector3* const unitNormals) {
+    for(std::size_t face = begin; face != end; ++face) {
+        const UnsignedInt* const triangle = indices.data() + face*3;
+        const Vector3 cross = Vector3::cross(positions[triangle[1]]-positions[triangle[0]],
+                                             positions[triangle[2]]-positions[triangle[0]]);
+
+        /* Degenerate faces don't contribute anything */
+        const Float length = cross.length();
+        const Vector3 normal = length ? cross/length : Vector3();
+        if(unitNormals) unitNormals[face] = normal;
+
+        /* Cross product length is twice the area */
+        if(weighting == NormalWeighting::Area) {
+            for(std::size_t i = 0; i != 3; ++i)
+                cornerNormals[face*3 + i] = cross;
+            continue;
+        }
+
+        /* Angle at each corner, robust also for very thin triangles */
+        for(std::size_t i = 0; i != 3; ++i) {
+            const Vector3& position = positions[triangle[i]];
+            const Float angle = std::atan2(length, Vector3::dot(
+                positions[triangle[(i + 1)%3]] - position,
+                positions[triangle[(i + 2)%3]] - position));
+            cornerNormals[face*3 + i] = normal*angle;
+        }
+    }
+}
+
+}
+
+void generateSmoothNormalsInto(const std::vector<UnsignedInt>& indices, const std::vector<Vector3>& positions, std::vector<Vector3>& normals, const NormalWeighting weighting, const std::size_t threadCount) {
+    CORRADE_ASSERT(!(indices.size()%3), "MeshTools::generateSmoothNormalsInto(): index count is not divisible by 3!", );
+
+    std::vector<UnsignedInt> cornerOffset, corners;
+    Implementation::buildVertexCornerAdjacency(indices, positions.size(), cornerOffset, corners);
+
+    Magnum::Implementation::ThreadPool& threadPool = Implementation::sharedThreadPool();
+
+    std::vector<Vector3> cornerNormals(indices.size());
+    threadPool.parallelFor(indices.size()/3, Implementation::sharedThreadCount(threadCount, indices.size()/3), [&](std::size_t begin, std::size_t end) {
+        faceNormals(indices, positions, weighting, begin, end, cornerNormals.data(), nullptr);
+    });
+
+    /* Each vertex gathers contributions of all its corners */
+    normals.resize(positions.size());
+    threadPool.parallelFor(positions.size(), Implementation::sharedThreadCount(threadCount, positions.size()), [&](std::size_t begin, std::size_t end) {
+        for(std::size_t vertex = begin; vertex != end; ++vertex) {
+            Vector3 normal;
+            for(std::size_t i = cornerOffset[vertex]; i != cornerOffset[vertex + 1]; ++i)
+                normal += cornerNormals[corners[i]];
+
+            const Float length = normal.length();
+            normals[vertex] = length ? normal/length : Vector3();
+        }
+    });
+}
+
+std::tuple<std::vector<UnsignedInt>, std::vector<Vector3>> generateSmoothNormals(const std::vector<UnsignedInt>& indices, const std::vector<Vector3>& positions, const Rad creaseAngle, const NormalWeighting weighting) {
+    CORRADE_ASSERT(!(indices.size()%3), "MeshTools::generateSmoothNormals(): index count is not divisible by 3!", (std::tuple<std::vector<UnsignedInt>, std::vector<Vector3>>()));
+
+    std::vector<UnsignedInt> cornerOffset, corners;
+    Implementation::buildVertexCornerAdjacency(indices, positions.size(), cornerOffset, corners);
+
+    std::vector<Vector3> cornerNormals(indices.size());
+    std::vector<Vector3> unitNormals(indices.size()/3);
+    faceNormals(indices, positions, weighting, 0, indices.size()/3, cornerNormals.data(), unitNormals.data());
+
+    /* Each corner gathers contributions of corners of the same vertex which
+       are in faces with angle not larger than crease angle. Corners with the
+       same set of neighbors produce the same normal, which is then shared. */
+    const Float cosCreaseAngle = std::cos(Float(creaseAngle));
+    std::vector<UnsignedInt> normalIndices(indices.size());
+    std::vector<Vector3> normals;
+    normals.reserve(positions.size());
+    for(std::size_t vertex = 0; vertex != positions.size(); ++vertex) {
+        const std::size_t firstNormal = normals.size();
+        for(std::size_t i = cornerOffset[vertex]; i != cornerOffset[vertex + 1]; ++i) {
+            const Vector3& faceNormal = unitNormals[corners[i]/3];
+
+            Vector3 normal;
+            for(std::size_t j = cornerOffset[vertex]; j != cornerOffset[vertex + 1]; ++j)
+                if(Vector3::dot(faceNormal, unitNormals[corners[j]/3]) >= cosCreaseAngle)
+                    normal += cornerNormals[corners[j]];
+
+            const Float length = normal.length();
+            if(length) normal /= length;
+
+            /* Reuse normal already generated for this vertex, if any */
+            std::size_t found = firstNormal;
+            while(found != normals.size() && normals[found] != normal) ++found;
+            if(found == normals.size()) normals.push_back(normal);
+            normalIndices[corners[i]] = found;
+        }
+    }
+
+    return std::make_tuple(std::move(normalIndices), std::move(normals));
+}
+
+}}
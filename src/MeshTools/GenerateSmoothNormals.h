@@ -0,0 +1,128 @@
+#ifndef Magnum_MeshTools_GenerateSmoothNormals_h
+#define Magnum_MeshTools_GenerateSmoothNormals_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Function @ref Magnum::MeshTools::generateSmoothNormals(), @ref Magnum::MeshTools::generateSmoothNormalsInto(), enum @ref Magnum::MeshTools::NormalWeighting
+ */
+
+#include <tuple>
+#include <vector>
+
+#include "Magnum.h"
+
+#include "magnumMeshToolsVisibility.h"
+
+namespace Magnum { namespace MeshTools {
+
+/**
+@brief Normal weighting
+
+@see @ref generateSmoothNormals(), @ref generateSmoothNormalsInto()
+*/
+enum class NormalWeighting: UnsignedByte {
+    /** Face normals are weighted by face area */
+    Area,
+
+    /**
+     * Face normals are weighted by angle of the face at given vertex. The
+     * result doesn't depend on how the surface is triangulated.
+     */
+    Angle
+};
+
+/**
+@brief Generate smooth normals into existing array
+@param[in] indices      Array of triangle face indices
+@param[in] positions    Array of vertex positions
+@param[out] normals     Output array of vertex normals
+@param[in] weighting    Face normal weighting
+@param[in] threadCount  Count of worker threads. If `0`, count of hardware
+    threads is used.
+
+Generates one normal for each vertex as weighted average of normals of all
+faces sharing given vertex, the normals are indexed with the same @p indices
+as @p positions. Face normals are computed once, vertex normals then gather
+them over vertex-to-corner adjacency, so both passes are split into
+contiguous ranges processed on @p threadCount threads without any
+synchronization. The worker threads are shared by all calls and kept for
+subsequent ones, if they are busy with a call from another thread, all work
+is done on the calling thread. The output array is resized to size of @p positions,
+reusing its allocation, which makes this suitable for recomputing normals of
+deformed mesh each frame. Vertices which aren't referenced by any
+non-degenerate face get zero normal.
+
+@attention Index count must be divisible by 3, otherwise nothing is done.
+@see @ref generateFlatNormals()
+*/
+void MAGNUM_MESHTOOLS_EXPORT generateSmoothNormalsInto(const std::vector<UnsignedInt>& indices, const std::vector<Vector3>& positions, std::vector<Vector3>& normals, NormalWeighting weighting = NormalWeighting::Angle, std::size_t threadCount = 1);
+
+/**
+@brief Generate smooth normals
+@param indices      Array of triangle face indices
+@param positions    Array of vertex positions
+@param weighting    Face normal weighting
+@return Array of vertex normals
+
+Convenience alternative to @ref generateSmoothNormalsInto(), which returns
+newly allocated array.
+*/
+inline std::vector<Vector3> generateSmoothNormals(const std::vector<UnsignedInt>& indices, const std::vector<Vector3>& positions, NormalWeighting weighting = NormalWeighting::Angle) {
+    std::vector<Vector3> normals;
+    generateSmoothNormalsInto(indices, positions, normals, weighting);
+    return normals;
+}
+
+/**
+@brief Generate smooth normals with crease angle
+@param indices      Array of triangle face indices
+@param positions    Array of vertex positions
+@param creaseAngle  Crease angle
+@param weighting    Face normal weighting
+@return Normal indices and vectors
+
+Similar to @ref generateSmoothNormals(const std::vector<UnsignedInt>&, const std::vector<Vector3>&, NormalWeighting),
+but normals of faces which make larger angle than @p creaseAngle with given
+face don't contribute to its vertex normals, so sharp edges stay sharp. A
+vertex can thus have more than one normal. Example usage:
+@code
+std::vector<UnsignedInt> vertexIndices;
+std::vector<Vector3> positions;
+
+std::vector<UnsignedInt> normalIndices;
+std::vector<Vector3> normals;
+std::tie(normalIndices, normals) = MeshTools::generateSmoothNormals(vertexIndices, positions, Deg(60.0f));
+@endcode
+You can then use @ref combineIndexedArrays() to combine normal and vertex
+array to use the same indices.
+
+@attention Index count must be divisible by 3, otherwise zero length result
+    is generated.
+*/
+std::tuple<std::vector<UnsignedInt>, std::vector<Vector3>> MAGNUM_MESHTOOLS_EXPORT generateSmoothNormals(const std::vector<UnsignedInt>& indices, const std::vector<Vector3>& positions, Rad creaseAngle, NormalWeighting weighting = NormalWeighting::Angle);
+
+}}
+
+#endif
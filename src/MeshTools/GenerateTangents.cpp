@@ -0,0 +1,120 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "GenerateTangents.h"
+
+#include <cmath>
+
+#include "Math/Vector4.h"
+#include "MeshTools/Implementation/SharedThreadPool.h"
+#include "MeshTools/Implementation/VertexAdjacency.h"
+
+namespace Magnum { namespace MeshTools {
+
+namespace {
+
+struct FaceTangent {
+    Vector3 tangent, bitangent;
+    Float angle[3];
+};
+
+inline Vector3 orthogonalize(const Vector3& vector, const Vector3& normal) {
+    return vector - normal*Vector3::dot(normal, vector);
+}
+
+}
+
+void generateTangentsInto(const std::vector<UnsignedInt>& indices, const std::vector<Vector3>& positions, const std::vector<Vector3>& normals, const std::vector<Vector2>& textureCoordinates, std::vector<Vector4>& tangents, const std::size_t threadCount) {
+    CORRADE_ASSERT(!(indices.size()%3), "MeshTools::generateTangentsInto(): index count is not divisible by 3!", );
+    CORRADE_ASSERT(normals.size() == positions.size() && textureCoordinates.size() == positions.size(), "MeshTools::generateTangentsInto(): vertex arrays don't have the same length, nothing done.", );
+
+    std::vector<UnsignedInt> cornerOffset, corners;
+    Implementation::buildVertexCornerAdjacency(indices, positions.size(), cornerOffset, corners);
+
+    Magnum::Implementation::ThreadPool& threadPool = Implementation::sharedThreadPool();
+
+    /* Tangent direction of each face, scaled only by sign of texture space
+       orientation so very small faces don't get huge weight */
+    std::vector<FaceTangent> faces(indices.size()/3);
+    threadPool.parallelFor(faces.size(), Implementation::sharedThreadCount(threadCount, faces.size()), [&](std::size_t begin, std::size_t end) {
+        for(std::size_t face = begin; face != end; ++face) {
+            const UnsignedInt* const triangle = indices.data() + face*3;
+            const Vector3 e1 = positions[triangle[1]] - positions[triangle[0]];
+            const Vector3 e2 = positions[triangle[2]] - positions[triangle[0]];
+            const Vector2 uv1 = textureCoordinates[triangle[1]] - textureCoordinates[triangle[0]];
+            const Vector2 uv2 = textureCoordinates[triangle[2]] - textureCoordinates[triangle[0]];
+
+            const Float orientation = uv1.x()*uv2.y() - uv2.x()*uv1.y();
+            const Float sign = orientation > 0.0f ? 1.0f : orientation < 0.0f ? -1.0f : 0.0f;
+            faces[face].tangent = (e1*uv2.y() - e2*uv1.y())*sign;
+            faces[face].bitangent = (e2*uv1.x() - e1*uv2.x())*sign;
+
+            const Float length = Vector3::cross(e1, e2).length();
+            for(std::size_t i = 0; i != 3; ++i) {
+                const Vector3& position = positions[triangle[i]];
+                faces[face].angle[i] = std::atan2(length, Vector3::dot(
+                    positions[triangle[(i + 1)%3]] - position,
+                    positions[triangle[(i + 2)%3]] - position));
+            }
+        }
+    });
+
+    tangents.resize(positions.size());
+    threadPool.parallelFor(positions.size(), Implementation::sharedThreadCount(threadCount, positions.size()), [&](std::size_t begin, std::size_t end) {
+        for(std::size_t vertex = begin; vertex != end; ++vertex) {
+            const Vector3& normal = normals[vertex];
+
+            /* Project face tangents to tangent plane of the vertex and
+               average them weighted by angle */
+            Vector3 tangent, bitangent;
+            for(std::size_t i = cornerOffset[vertex]; i != cornerOffset[vertex + 1]; ++i) {
+                const FaceTangent& face = faces[corners[i]/3];
+                const Float angle = face.angle[corners[i]%3];
+
+                const Vector3 faceTangent = orthogonalize(face.tangent, normal);
+                const Vector3 faceBitangent = orthogonalize(face.bitangent, normal);
+                const Float tangentLength = faceTangent.length();
+                const Float bitangentLength = faceBitangent.length();
+                if(tangentLength) tangent += faceTangent*(angle/tangentLength);
+                if(bitangentLength) bitangent += faceBitangent*(angle/bitangentLength);
+            }
+
+            tangent = orthogonalize(tangent, normal);
+            Float length = tangent.length();
+
+            /* No usable texture mapping, pick any direction perpendicular to
+               the normal */
+            if(!length) {
+                tangent = orthogonalize(std::abs(normal.x()) < 0.9f ? Vector3::xAxis() : Vector3::yAxis(), normal);
+                length = tangent.length();
+            }
+
+            if(length) tangent /= length;
+            const Float sign = Vector3::dot(Vector3::cross(normal, tangent), bitangent) < 0.0f ? -1.0f : 1.0f;
+            tangents[vertex] = Vector4(tangent, sign);
+        }
+    });
+}
+
+}}
@@ -0,0 +1,92 @@
+#ifndef Magnum_MeshTools_GenerateTangents_h
+#define Magnum_MeshTools_GenerateTangents_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Function @ref Magnum::MeshTools::generateTangents(), @ref Magnum::MeshTools::generateTangentsInto()
+ */
+
+#include <vector>
+
+#include "Magnum.h"
+
+#include "magnumMeshToolsVisibility.h"
+
+namespace Magnum { namespace MeshTools {
+
+/**
+@brief Generate tangents into existing array
+@param[in] indices              Array of triangle face indices
+@param[in] positions            Array of vertex positions
+@param[in] normals              Array of vertex normals
+@param[in] textureCoordinates   Array of vertex texture coordinates
+@param[out] tangents            Output array of vertex tangents
+@param[in] threadCount          Count of worker threads. If `0`, count of
+    hardware threads is used.
+
+Generates one tangent for each vertex. Per-face tangent and bitangent
+directions are projected onto the tangent plane of each vertex, weighted by
+face angle at the vertex, averaged and orthogonalized against the vertex
+normal. The fourth component is bitangent sign, thus the bitangent can be
+reconstructed in shader as
+@code
+vec3 bitangent = tangent.w*cross(normal, tangent.xyz);
+@endcode
+
+All arrays are expected to be indexed with the same @p indices, i.e.
+vertices on texture seams already have to be split, see
+@ref combineIndexedArrays(). Vertices aren't split when the tangent space of
+adjacent faces differs too much, so the output isn't compatible with tangents
+baked by MikkTSpace-based tools. Vertices without any usable texture mapping
+get arbitrary tangent perpendicular to the normal. Like in
+@ref generateSmoothNormalsInto(), both the per-face and the per-vertex pass
+are split into contiguous ranges processed on @p threadCount threads and the
+output array allocation is reused.
+
+@attention Index count must be divisible by 3 and all vertex arrays must have
+    the same size, otherwise nothing is done.
+*/
+void MAGNUM_MESHTOOLS_EXPORT generateTangentsInto(const std::vector<UnsignedInt>& indices, const std::vector<Vector3>& positions, const std::vector<Vector3>& normals, const std::vector<Vector2>& textureCoordinates, std::vector<Vector4>& tangents, std::size_t threadCount = 1);
+
+/**
+@brief Generate tangents
+@param indices              Array of triangle face indices
+@param positions            Array of vertex positions
+@param normals              Array of vertex normals
+@param textureCoordinates   Array of vertex texture coordinates
+@return Array of vertex tangents with bitangent sign in fourth component
+
+Convenience alternative to @ref generateTangentsInto(), which returns newly
+allocated array.
+*/
+inline std::vector<Vector4> generateTangents(const std::vector<UnsignedInt>& indices, const std::vector<Vector3>& positions, const std::vector<Vector3>& normals, const std::vector<Vector2>& textureCoordinates) {
+    std::vector<Vector4> tangents;
+    generateTangentsInto(indices, positions, normals, textureCoordinates, tangents);
+    return tangents;
+}
+
+}}
+
+#endif
@@ -0,0 +1,53 @@
+#ifndef Magnum_MeshTools_Implementation_SharedThreadPool_h
+#define Magnum_MeshTools_Implementation_SharedThreadPool_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <algorithm>
+#include <limits>
+#include <thread>
+
+#include "Implementation/ThreadPool.h"
+
+namespace Magnum { namespace MeshTools { namespace Implementation {
+
+/* Workers shared by all parallel algorithms, created on first use and kept
+   for subsequent calls, so the thread count is limited only by what's passed
+   to parallelFor(). If another thread is using the pool, the work is done on
+   the calling thread only. */
+inline Magnum::Implementation::ThreadPool& sharedThreadPool() {
+    static Magnum::Implementation::ThreadPool threadPool(std::numeric_limits<std::size_t>::max());
+    return threadPool;
+}
+
+/* Count of threads for given count of work items, more threads are used only
+   if there's enough work for them. If `threadCount` is `0`, count of hardware
+   threads is used. */
+inline std::size_t sharedThreadCount(const std::size_t threadCount, const std::size_t count) {
+    return std::min(threadCount ? threadCount : std::size_t(std::max(std::thread::hardware_concurrency(), 1u)), count/1024);
+}
+
+}}}
+
+#endif
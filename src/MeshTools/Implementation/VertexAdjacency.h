@@ -0,0 +1,50 @@
+#ifndef Magnum_MeshTools_Implementation_VertexAdjacency_h
+#define Magnum_MeshTools_Implementation_VertexAdjacency_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <vector>
+
+#include "Types.h"
+
+namespace Magnum { namespace MeshTools { namespace Implementation {
+
+/* Corners (positions in the index array) adjacent to each vertex, in
+   compressed form. Corners of vertex `i` are in range
+   `[cornerOffset[i], cornerOffset[i + 1])` of `corners`, sorted. */
+inline void buildVertexCornerAdjacency(const std::vector<UnsignedInt>& indices, const std::size_t vertexCount, std::vector<UnsignedInt>& cornerOffset, std::vector<UnsignedInt>& corners) {
+    cornerOffset.assign(vertexCount + 1, 0);
+    for(UnsignedInt index: indices) ++cornerOffset[index + 1];
+    for(std::size_t i = 0; i != vertexCount; ++i)
+        cornerOffset[i + 1] += cornerOffset[i];
+
+    corners.resize(indices.size());
+    std::vector<UnsignedInt> position(cornerOffset.begin(), cornerOffset.end() - 1);
+    for(std::size_t i = 0; i != indices.size(); ++i)
+        corners[position[indices[i]]++] = i;
+}
+
+}}}
+
+#endif
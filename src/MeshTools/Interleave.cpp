@@ -0,0 +1,54 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "Interleave.h"
+
+namespace Magnum { namespace MeshTools {
+
+std::size_t interleaveInto(Containers::ArrayReference<char> data, const std::size_t stride, const std::vector<InterleavedAttribute>& attributes) {
+    if(attributes.empty()) return 0;
+
+    /* Verify the layout first so nothing is written on failure */
+    const std::size_t attributeCount = attributes.front().count();
+    for(const InterleavedAttribute& attribute: attributes) {
+        CORRADE_ASSERT(attribute.count() == attributeCount,
+            "MeshTools::interleaveInto(): attribute arrays don't have the same length, expected" << attributeCount << "but got" << attribute.count(), 0);
+        CORRADE_ASSERT(attribute.offset() + attribute.size() <= stride,
+            "MeshTools::interleaveInto(): attribute at offset" << attribute.offset() << "with size" << attribute.size() << "doesn't fit into stride" << stride, 0);
+    }
+    CORRADE_ASSERT(data.size() >= attributeCount*stride,
+        "MeshTools::interleaveInto(): output size" << data.size() << "is too small, expected at least" << attributeCount*stride, 0);
+
+    /* Copy one attribute at a time to have sequential reads */
+    for(const InterleavedAttribute& attribute: attributes) {
+        const char* input = static_cast<const char*>(attribute.data());
+        char* output = data.begin() + attribute.offset();
+        for(std::size_t i = 0; i != attributeCount; ++i, input += attribute.stride(), output += stride)
+            std::memcpy(output, input, attribute.size());
+    }
+
+    return attributeCount;
+}
+
+}}
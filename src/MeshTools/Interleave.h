@@ -25,7 +25,7 @@
 */
 
 /** @file
- * @brief Function @ref Magnum::MeshTools::interleave()
+ * @brief Function @ref Magnum::MeshTools::interleave(), @ref Magnum::MeshTools::interleaveInto(), class @ref Magnum::MeshTools::InterleavedAttribute
  */
 
 #include <cstring>
@@ -36,6 +36,8 @@
 #include "Mesh.h"
 #include "Buffer.h"
 
+#include "magnumMeshToolsVisibility.h"
+
 namespace Magnum { namespace MeshTools {
 
 namespace Implementation {
@@ -61,6 +63,24 @@ class Interleave {
             return std::make_tuple(_attributeCount, _stride, std::move(data));
         }
 
+        template<class ...T> std::size_t operator()(Containers::ArrayReference<char> data, std::size_t stride, const T&... attributes) {
+            /* Nothing to do if there are no arrays or they have different
+               size */
+            _attributeCount = attributeCount(attributes...);
+            if(!_attributeCount || _attributeCount == ~std::size_t(0))
+                return 0;
+
+            CORRADE_ASSERT(stride >= Interleave::stride(attributes...),
+                "MeshTools::interleaveInto(): stride" << stride << "is too small, expected at least" << Interleave::stride(attributes...), 0);
+            CORRADE_ASSERT(data.size() >= _attributeCount*stride,
+                "MeshTools::interleaveInto(): output size" << data.size() << "is too small, expected at least" << _attributeCount*stride, 0);
+
+            /* Save the data */
+            _stride = stride;
+            write(data.begin(), attributes...);
+            return _attributeCount;
+        }
+
         template<class ...T> void operator()(Mesh& mesh, Buffer& buffer, BufferUsage usage, const T&... attributes) {
             Containers::Array<char> data;
             std::tie(std::ignore, std::ignore, data) = operator()(attributes...);
@@ -130,6 +150,54 @@ class Interleave {
 
 }
 
+/**
+@brief Runtime description of interleaved attribute
+
+Describes one attribute array for
+@ref interleaveInto(Containers::ArrayReference<char>, std::size_t, const std::vector<InterleavedAttribute>&),
+useful when the vertex layout is known only at runtime (e.g. when it comes
+from imported file).
+*/
+class InterleavedAttribute {
+    public:
+        /**
+         * @brief Constructor
+         * @param data      Attribute data
+         * @param count     Attribute count
+         * @param size      Size of one attribute in bytes
+         * @param offset    Offset of the attribute in output vertex
+         * @param stride    Stride of the input data. If set to `0`, the
+         *      input data are expected to be tightly packed.
+         */
+        constexpr explicit InterleavedAttribute(const void* data, std::size_t count, std::size_t size, std::size_t offset, std::size_t stride = 0): _data(data), _count(count), _size(size), _offset(offset), _stride(stride ? stride : size) {}
+
+        /**
+         * @brief Construct from attribute array
+         * @param attribute Attribute array
+         * @param offset    Offset of the attribute in output vertex
+         */
+        template<class T> explicit InterleavedAttribute(const std::vector<T>& attribute, std::size_t offset): _data(attribute.data()), _count(attribute.size()), _size(sizeof(T)), _offset(offset), _stride(sizeof(T)) {}
+
+        /** @brief Attribute data */
+        constexpr const void* data() const { return _data; }
+
+        /** @brief Attribute count */
+        constexpr std::size_t count() const { return _count; }
+
+        /** @brief Size of one attribute in bytes */
+        constexpr std::size_t size() const { return _size; }
+
+        /** @brief Offset of the attribute in output vertex */
+        constexpr std::size_t offset() const { return _offset; }
+
+        /** @brief Stride of input data */
+        constexpr std::size_t stride() const { return _stride; }
+
+    private:
+        const void* _data;
+        std::size_t _count, _size, _offset, _stride;
+};
+
 /**
 @brief %Interleave vertex attributes
 
@@ -172,7 +240,8 @@ possible performance loss.
     will be `std::vector` or `std::array`.
 
 See also @ref interleave(Mesh&, Buffer&, BufferUsage, const T&...),
-which writes the interleaved array directly into buffer of given mesh.
+which writes the interleaved array directly into buffer of given mesh, and
+@ref interleaveInto(), which writes into user-provided memory.
 */
 /* enable_if to avoid clash with overloaded function below */
 template<class T, class ...U> inline typename std::enable_if<!std::is_same<T, Mesh>::value, std::tuple<std::size_t, std::size_t, Containers::Array<char>>>::type interleave(const T& first, const U&... next) {
@@ -207,6 +276,63 @@ template<class ...T> inline void interleave(Mesh& mesh, Buffer& buffer, BufferUs
     return Implementation::Interleave()(mesh, buffer, usage, attributes...);
 }
 
+/**
+@brief %Interleave vertex attributes into existing memory
+@param data         Output memory
+@param stride       Output vertex stride
+@param attributes   Attribute arrays and gaps
+@return Attribute count
+
+The same as @ref interleave(const T&, const U&...), but instead of allocating
+new array the data are written into @p data, which can be e.g. mapped buffer
+memory or a reused staging block. Gaps between attributes are specified the
+same way and are filled with zeros, @p stride must be at least the sum of all
+attribute sizes and gaps, the remaining bytes at the end of each vertex are
+left untouched. Size of @p data must be at least attribute count multiplied
+by @p stride. Example usage, uploading the data without any temporary copy:
+@code
+std::vector<Vector3> positions;
+std::vector<Vector2> textureCoordinates;
+const std::size_t stride = sizeof(Vector3) + sizeof(Vector2);
+
+buffer.setData({nullptr, positions.size()*stride}, BufferUsage::StaticDraw);
+char* data = static_cast<char*>(buffer.map(0, positions.size()*stride, Buffer::MapFlag::Write|Buffer::MapFlag::InvalidateBuffer));
+MeshTools::interleaveInto({data, positions.size()*stride}, stride, positions, textureCoordinates);
+CORRADE_INTERNAL_ASSERT_OUTPUT(buffer.unmap());
+@endcode
+
+If the arrays don't have the same size, nothing is done and `0` is returned.
+@see @ref interleaveInto(Containers::ArrayReference<char>, std::size_t, const std::vector<InterleavedAttribute>&)
+*/
+template<class ...T> inline std::size_t interleaveInto(Containers::ArrayReference<char> data, std::size_t stride, const T&... attributes) {
+    return Implementation::Interleave()(data, stride, attributes...);
+}
+
+/**
+@brief %Interleave vertex attributes with runtime layout into existing memory
+@param data         Output memory
+@param stride       Output vertex stride
+@param attributes   Attribute descriptions
+@return Attribute count
+
+Non-templated alternative to @ref interleaveInto(Containers::ArrayReference<char>, std::size_t, const T&...)
+for cases where the vertex layout is known only at runtime. Each attribute is
+copied to its offset in every vertex, bytes not covered by any attribute are
+left untouched. All attributes must have the same count, must fit into
+@p stride and size of @p data must be at least attribute count multiplied by
+@p stride, otherwise nothing is done and `0` is returned. Example usage:
+@code
+std::vector<Vector3> positions;
+std::vector<Color3<UnsignedByte>> colors;
+
+const std::size_t stride = 16;
+MeshTools::interleaveInto(data, stride, {
+    MeshTools::InterleavedAttribute(positions, 0),
+    MeshTools::InterleavedAttribute(colors, 12)});
+@endcode
+*/
+std::size_t MAGNUM_MESHTOOLS_EXPORT interleaveInto(Containers::ArrayReference<char> data, std::size_t stride, const std::vector<InterleavedAttribute>& attributes);
+
 }}
 
 #endif
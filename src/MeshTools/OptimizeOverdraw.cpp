@@ -0,0 +1,111 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "OptimizeOverdraw.h"
+
+#include <algorithm>
+#include <numeric>
+
+#include "Math/Vector3.h"
+
+namespace Magnum { namespace MeshTools {
+
+void optimizeOverdraw(std::vector<UnsignedInt>& indices, const std::vector<Vector3>& positions, const std::size_t cacheSize) {
+    CORRADE_ASSERT(!(indices.size()%3), "MeshTools::optimizeOverdraw(): index count is not divisible by 3!", );
+
+    /* Split the index buffer at triangles with three cache misses, simulating
+       FIFO cache the same way as tipsify() does */
+    std::vector<UnsignedInt> clusterOffset;
+    {
+        std::vector<UnsignedInt> timestamp(positions.size());
+        UnsignedInt time = cacheSize+1;
+        for(std::size_t i = 0; i != indices.size(); i += 3) {
+            UnsignedInt misses = 0;
+            for(std::size_t vi = 0; vi != 3; ++vi) {
+                const UnsignedInt v = indices[i+vi];
+                if(time-timestamp[v] > cacheSize) {
+                    timestamp[v] = time++;
+                    ++misses;
+                }
+            }
+
+            if(misses == 3) clusterOffset.push_back(i);
+        }
+    }
+
+    /* Nothing to reorder */
+    if(clusterOffset.size() < 2) return;
+    clusterOffset.push_back(indices.size());
+
+    /* Area-weighted normal and centroid of each cluster and the whole mesh.
+       Cross product length is twice the triangle area, which doesn't matter
+       for the weighting. */
+    const std::size_t clusterCount = clusterOffset.size()-1;
+    std::vector<Vector3> clusterNormal(clusterCount), clusterCentroid(clusterCount);
+    Vector3 meshCentroid;
+    Float meshArea = 0.0f;
+    for(std::size_t cluster = 0; cluster != clusterCount; ++cluster) {
+        Float clusterArea = 0.0f;
+        for(std::size_t i = clusterOffset[cluster]; i != clusterOffset[cluster+1]; i += 3) {
+            const Vector3& a = positions[indices[i]];
+            const Vector3& b = positions[indices[i+1]];
+            const Vector3& c = positions[indices[i+2]];
+            const Vector3 normal = Vector3::cross(b - a, c - a);
+            const Float area = normal.length();
+
+            clusterNormal[cluster] += normal;
+            clusterCentroid[cluster] += (a + b + c)*(area/3.0f);
+            clusterArea += area;
+        }
+
+        meshCentroid += clusterCentroid[cluster];
+        meshArea += clusterArea;
+        if(clusterArea != 0.0f) clusterCentroid[cluster] /= clusterArea;
+    }
+    if(meshArea != 0.0f) meshCentroid /= meshArea;
+
+    /* Sort key is distance of the cluster from the centroid along its normal,
+       clusters facing outwards go first */
+    std::vector<Float> sortKey(clusterCount);
+    for(std::size_t c = 0; c != clusterCount; ++c) {
+        const Float length = clusterNormal[c].length();
+        sortKey[c] = length == 0.0f ? 0.0f :
+            Vector3::dot(clusterNormal[c]/length, clusterCentroid[c] - meshCentroid);
+    }
+
+    std::vector<UnsignedInt> clusters(clusterCount);
+    std::iota(clusters.begin(), clusters.end(), 0);
+    std::stable_sort(clusters.begin(), clusters.end(), [&sortKey](UnsignedInt a, UnsignedInt b) {
+        return sortKey[a] > sortKey[b];
+    });
+
+    /* Write the clusters in sorted order */
+    std::vector<UnsignedInt> output;
+    output.reserve(indices.size());
+    for(UnsignedInt c: clusters)
+        output.insert(output.end(), indices.begin()+clusterOffset[c], indices.begin()+clusterOffset[c+1]);
+    std::swap(indices, output);
+}
+
+}}
@@ -0,0 +1,70 @@
+#ifndef Magnum_MeshTools_OptimizeOverdraw_h
+#define Magnum_MeshTools_OptimizeOverdraw_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Function Magnum::MeshTools::optimizeOverdraw()
+ */
+
+#include <vector>
+
+#include "Magnum.h"
+
+#include "magnumMeshToolsVisibility.h"
+
+namespace Magnum { namespace MeshTools {
+
+/**
+@brief Reorder triangles to reduce overdraw
+@param[in,out] indices  Index array to operate on
+@param[in] positions    Vertex positions
+@param[in] cacheSize    Post-transform vertex cache size
+
+Expects index array already optimized with tipsify(). Splits it into clusters
+at triangles which miss the post-transform vertex cache with all three
+vertices (i.e. where tipsify() started fanning from new place), thus
+reordering the clusters doesn't affect vertex cache efficiency. The clusters
+are then sorted so those facing away from the mesh centroid are drawn first,
+as they are likely to occlude the rest of the mesh from most viewpoints.
+Algorithm used: *Pedro V. Sander, Diego Nehab, and Joshua Barczak - Fast
+Triangle Reordering for Vertex Locality and Reduced Overdraw, SIGGRAPH 2007,
+http://gfx.cs.princeton.edu/pubs/Sander_2007_%3ETR/index.php*. Example
+usage:
+@code
+std::vector<UnsignedInt> indices;
+std::vector<Vector3> positions;
+
+MeshTools::tipsify(indices, positions.size(), 24);
+MeshTools::optimizeOverdraw(indices, positions, 24);
+MeshTools::optimizeVertexFetch(indices, positions);
+@endcode
+
+@attention Index count must be divisible by 3, otherwise nothing is done.
+*/
+void MAGNUM_MESHTOOLS_EXPORT optimizeOverdraw(std::vector<UnsignedInt>& indices, const std::vector<Vector3>& positions, std::size_t cacheSize);
+
+}}
+
+#endif
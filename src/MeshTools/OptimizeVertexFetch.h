@@ -0,0 +1,121 @@
+#ifndef Magnum_MeshTools_OptimizeVertexFetch_h
+#define Magnum_MeshTools_OptimizeVertexFetch_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Function Magnum::MeshTools::optimizeVertexFetch()
+ */
+
+#include <vector>
+#include <Utility/Assert.h>
+
+#include "Magnum.h"
+
+namespace Magnum { namespace MeshTools {
+
+namespace Implementation {
+
+class OptimizeVertexFetch {
+    public:
+        template<class ...T> std::size_t operator()(std::vector<UnsignedInt>& indices, std::vector<T>&... attributes) {
+            /* Vertex count is given by attribute arrays, if there are any */
+            std::size_t vertexCount = attributeCount(attributes...);
+            if(vertexCount == ~std::size_t(0)) {
+                vertexCount = 0;
+                for(UnsignedInt index: indices)
+                    if(index >= vertexCount) vertexCount = index+1;
+            } else if(!vertexCount && !indices.empty()) return 0;
+
+            /* Number vertices in order of first use */
+            std::vector<UnsignedInt> remap(vertexCount, 0xFFFFFFFFu);
+            UnsignedInt newVertexCount = 0;
+            for(UnsignedInt& index: indices) {
+                CORRADE_ASSERT(index < vertexCount, "MeshTools::optimizeVertexFetch(): index" << index << "out of bounds for" << vertexCount << "vertices", 0);
+                if(remap[index] == 0xFFFFFFFFu) remap[index] = newVertexCount++;
+                index = remap[index];
+            }
+
+            permute(remap, newVertexCount, attributes...);
+            return newVertexCount;
+        }
+
+    private:
+        template<class T, class ...U> static std::size_t attributeCount(const std::vector<T>& first, const std::vector<U>&... next) {
+            CORRADE_ASSERT(sizeof...(next) == 0 || attributeCount(next...) == first.size(), "MeshTools::optimizeVertexFetch(): attribute arrays don't have the same length, nothing done.", 0);
+
+            return first.size();
+        }
+
+        template<class T, class ...U> static void permute(const std::vector<UnsignedInt>& remap, std::size_t newVertexCount, std::vector<T>& first, std::vector<U>&... next) {
+            /* Write each used vertex to its new place, drop unused ones */
+            std::vector<T> output(newVertexCount);
+            for(std::size_t i = 0; i != remap.size(); ++i)
+                if(remap[i] != 0xFFFFFFFFu) output[remap[i]] = first[i];
+            std::swap(output, first);
+
+            permute(remap, newVertexCount, next...);
+        }
+
+        /* Terminator functions for recursive calls */
+        static std::size_t attributeCount() { return ~std::size_t(0); }
+        static void permute(const std::vector<UnsignedInt>&, std::size_t) {}
+};
+
+}
+
+/**
+@brief Optimize vertex order for memory locality
+@param[in,out] indices      Index array to operate on
+@param[in,out] attributes   Attribute arrays to reorder
+@return New vertex count
+
+Renumbers vertices in order in which they are first referenced by the index
+array and reorders all attribute arrays accordingly, so vertex fetches (both
+on the GPU and in CPU-side processing such as skinning) go sequentially
+through memory. Vertices which aren't referenced by any index are removed.
+Call this function as the last step, after the triangles are reordered with
+tipsify() and optimizeOverdraw(). Example usage:
+@code
+std::vector<UnsignedInt> indices;
+std::vector<Vector3> positions;
+std::vector<Vector3> normals;
+std::vector<Vector2> textureCoordinates;
+
+MeshTools::tipsify(indices, positions.size(), 24);
+MeshTools::optimizeVertexFetch(indices, positions, normals, textureCoordinates);
+@endcode
+
+If no attribute arrays are passed, only the index array is renumbered and
+vertex count is taken from the largest index.
+
+@attention The function expects that all attribute arrays have the same size.
+*/
+template<class ...T> inline std::size_t optimizeVertexFetch(std::vector<UnsignedInt>& indices, std::vector<T>&... attributes) {
+    return Implementation::OptimizeVertexFetch()(indices, attributes...);
+}
+
+}}
+
+#endif
@@ -25,47 +25,132 @@
 */
 
 /** @file
- * @brief Function Magnum::MeshTools::removeDuplicates()
+ * @brief Function Magnum::MeshTools::removeDuplicates(), Magnum::MeshTools::findDuplicates(), Magnum::MeshTools::remapVertices()
  */
 
 #include <limits>
-#include <unordered_map>
+#include <tuple>
 #include <vector>
-#include <Utility/MurmurHash2.h>
+#include <Utility/Assert.h>
 
 #include "Math/Functions.h"
 #include "Magnum.h"
+#include "MeshTools/OptimizeVertexFetch.h"
 
 namespace Magnum { namespace MeshTools {
 
 namespace Implementation {
 
-template<class Vertex, std::size_t vertexSize = Vertex::Size> class RemoveDuplicates {
+template<class Vertex, std::size_t vertexSize = Vertex::Size> class FindDuplicates {
     public:
-        RemoveDuplicates(std::vector<UnsignedInt>& indices, std::vector<Vertex>& vertices): indices(indices), vertices(vertices) {}
+        typedef typename Vertex::Type Type;
 
-        void operator()(typename Vertex::Type epsilon = Math::TypeTraits<typename Vertex::Type>::epsilon());
+        FindDuplicates(const std::vector<Vertex>& vertices): vertices(vertices) {}
+
+        std::tuple<std::vector<UnsignedInt>, std::size_t> operator()(Type epsilon = Math::TypeTraits<Type>::epsilon());
 
     private:
-        class IndexHash {
-            public:
-                std::size_t operator()(const Math::Vector<vertexSize, std::size_t>& data) const {
-                    return *reinterpret_cast<const std::size_t*>(Utility::MurmurHash2()(reinterpret_cast<const char*>(&data), sizeof(data)).byteArray());
-                }
+        /* Open-addressing table entry. Full hash is stored to avoid fetching
+           vertex data for entries from different cells. */
+        struct Entry {
+            UnsignedInt hash, vertex;
         };
 
-        struct HashedVertex {
-            UnsignedInt oldIndex, newIndex;
+        static UnsignedInt hash(const Long(&cell)[vertexSize]) {
+            UnsignedLong h = 0;
+            for(std::size_t i = 0; i != vertexSize; ++i)
+                h = (h ^ UnsignedLong(cell[i]))*0x9e3779b97f4a7c15ull;
+            return UnsignedInt(h >> 32);
+        }
 
-            HashedVertex(UnsignedInt oldIndex, UnsignedInt newIndex): oldIndex(oldIndex), newIndex(newIndex) {}
-        };
+        bool equals(const Vertex& a, const Vertex& b, Type epsilon) const {
+            for(std::size_t i = 0; i != vertexSize; ++i)
+                if((a[i] < b[i] ? b[i] - a[i] : a[i] - b[i]) >= epsilon) return false;
+            return true;
+        }
+
+        const std::vector<Vertex>& vertices;
+};
+
+class RemapVertices {
+    public:
+        template<class ...T> void operator()(std::vector<UnsignedInt>& indices, const std::vector<UnsignedInt>& remap, std::size_t uniqueCount, std::vector<T>&... attributes) {
+            for(UnsignedInt& index: indices) index = remap[index];
+            compact(remap, uniqueCount, attributes...);
+        }
+
+    private:
+        template<class T, class ...U> static void compact(const std::vector<UnsignedInt>& remap, std::size_t uniqueCount, std::vector<T>& first, std::vector<U>&... next) {
+            CORRADE_ASSERT(first.size() == remap.size(), "MeshTools::remapVertices(): expected" << remap.size() << "attributes but got" << first.size(), );
+
+            /* Unique vertices are numbered in order of their first occurence,
+               so the first vertex mapped to given index is always the next
+               one to be written */
+            std::vector<T> output;
+            output.reserve(uniqueCount);
+            for(std::size_t i = 0; i != remap.size(); ++i)
+                if(remap[i] == output.size()) output.push_back(first[i]);
+            std::swap(output, first);
+
+            compact(remap, uniqueCount, next...);
+        }
 
-        std::vector<UnsignedInt>& indices;
-        std::vector<Vertex>& vertices;
+        /* Terminator function for recursive calls */
+        static void compact(const std::vector<UnsignedInt>&, std::size_t) {}
 };
 
 }
 
+/**
+@brief Find duplicate vertices
+@tparam Vertex          Vertex data type
+@tparam vertexSize      How many initial vertex fields are important
+@param vertices         Vertex array
+@param epsilon          Epsilon value, vertices nearer than this distance in
+    all fields will be melt together.
+@return Remap table and unique vertex count
+
+Goes through the vertex array once, putting each vertex into spatial hash
+grid with cell size twice the epsilon, so for each vertex only the nearest
+2<sup>vertexSize</sup> cells need to be checked for duplicates. Returns
+table mapping each vertex to index of unique vertex (unique vertices are
+numbered in order of their first occurence in @p vertices) and count of unique
+vertices. Pass the result to remapVertices() to update index array and
+compact any number of attribute arrays consistently:
+@code
+std::vector<UnsignedInt> indices;
+std::vector<Vector3> positions;
+std::vector<Vector2> textureCoordinates;
+
+std::vector<UnsignedInt> remap;
+std::size_t uniqueCount;
+std::tie(remap, uniqueCount) = MeshTools::findDuplicates(positions);
+MeshTools::remapVertices(indices, remap, uniqueCount, positions, textureCoordinates);
+@endcode
+@see removeDuplicates()
+*/
+template<class Vertex, std::size_t vertexSize = Vertex::Size> inline std::tuple<std::vector<UnsignedInt>, std::size_t> findDuplicates(const std::vector<Vertex>& vertices, typename Vertex::Type epsilon = Math::TypeTraits<typename Vertex::Type>::epsilon()) {
+    return Implementation::FindDuplicates<Vertex, vertexSize>(vertices)(epsilon);
+}
+
+/**
+@brief Remap vertices using remap table
+@param[in,out] indices      Index array to operate on
+@param[in] remap            Remap table
+@param[in] uniqueCount      Unique vertex count
+@param[in,out] attributes   Attribute arrays to compact
+
+Replaces each index with its value in @p remap and compacts all attribute
+arrays so they contain @p uniqueCount items, keeping the first vertex mapped
+to given index. See findDuplicates() for an example.
+
+@attention The function expects that all attribute arrays have the same size
+    as the remap table.
+*/
+template<class ...T> inline void remapVertices(std::vector<UnsignedInt>& indices, const std::vector<UnsignedInt>& remap, std::size_t uniqueCount, std::vector<T>&... attributes) {
+    Implementation::RemapVertices()(indices, remap, uniqueCount, attributes...);
+}
+
 /**
 @brief %Remove duplicate vertices from the mesh
 @tparam Vertex          Vertex data type
@@ -77,21 +162,30 @@ template<class Vertex, std::size_t vertexSize = Vertex::Size> class RemoveDuplic
 @param[in] epsilon      Epsilon value, vertices nearer than this distance will
     be melt together.
 
-Removes duplicate vertices from the mesh.
+Removes duplicate vertices from the mesh using findDuplicates() and
+remapVertices(). Vertices which are not referenced by the index array are
+removed too and the remaining ones are sorted in order of their first use, see
+optimizeVertexFetch().
 @see duplicate()
 
-@todo Different (no cycle) implementation for integral vertices
 @todo Interpolate vertices, not collapse them to first in the cell
 @todo Ability to specify other attributes for interpolation
 */
 template<class Vertex, std::size_t vertexSize = Vertex::Size> inline void removeDuplicates(std::vector<UnsignedInt>& indices, std::vector<Vertex>& vertices, typename Vertex::Type epsilon = Math::TypeTraits<typename Vertex::Type>::epsilon()) {
-    Implementation::RemoveDuplicates<Vertex, vertexSize>(indices, vertices)(epsilon);
+    if(indices.empty()) return;
+
+    std::vector<UnsignedInt> remap;
+    std::size_t uniqueCount;
+    std::tie(remap, uniqueCount) = findDuplicates<Vertex, vertexSize>(vertices, epsilon);
+    remapVertices(indices, remap, uniqueCount, vertices);
+    optimizeVertexFetch(indices, vertices);
 }
 
 namespace Implementation {
 
-template<class Vertex, std::size_t vertexSize> void RemoveDuplicates<Vertex, vertexSize>::operator()(typename Vertex::Type epsilon) {
-    if(indices.empty()) return;
+template<class Vertex, std::size_t vertexSize> std::tuple<std::vector<UnsignedInt>, std::size_t> FindDuplicates<Vertex, vertexSize>::operator()(Type epsilon) {
+    std::vector<UnsignedInt> remap(vertices.size());
+    if(vertices.empty()) return std::make_tuple(std::move(remap), 0);
 
     /* Get mesh bounds */
     Vertex min = vertices[0], max = vertices[0];
@@ -100,53 +194,68 @@ template<class Vertex, std::size_t vertexSize> void RemoveDuplicates<Vertex, ver
         max = Math::max(v, max);
     }
 
-    /* Make epsilon so large that std::size_t can index all vertices inside
-       mesh bounds. */
-    epsilon = Math::max(epsilon, static_cast<typename Vertex::Type>((max-min).max()/std::numeric_limits<std::size_t>::max()));
-
-    /* First go with original vertex coordinates, then move them by
-       epsilon/2 in each direction. */
-    Vertex moved;
-    for(std::size_t moving = 0; moving <= vertexSize; ++moving) {
-
-        /* Under each index is pointer to face which contains given vertex
-           and index of vertex in the face. */
-        std::unordered_map<Math::Vector<vertexSize, std::size_t>, HashedVertex, IndexHash> table;
-
-        /* Reserve space for all vertices */
-        table.reserve(vertices.size());
+    /* Cell is twice the epsilon so a vertex can have duplicates in at most
+       two neighboring cells in each direction. Make it so large that cell
+       coordinates fit into Long. */
+    Type bounds(0);
+    for(std::size_t i = 0; i != vertexSize; ++i)
+        bounds = Math::max(bounds, Type(max[i] - min[i]));
+    Type cellSize = Math::max(Type(2*epsilon), Type(Double(bounds)/1.0e18));
+
+    /* Zero epsilon and all vertices in one point, any cell size works */
+    if(cellSize == Type(0)) cellSize = Type(1);
+
+    /* Power-of-two table with at least twice as many slots as there are
+       vertices */
+    std::size_t capacity = 16;
+    while(capacity < 2*vertices.size()) capacity <<= 1;
+    const std::size_t mask = capacity - 1;
+    std::vector<Entry> table(capacity, Entry{0, 0xFFFFFFFFu});
+
+    UnsignedInt uniqueCount = 0;
+    for(std::size_t i = 0; i != vertices.size(); ++i) {
+        const Vertex& v = vertices[i];
+
+        /* Cell of the vertex, and which neighbor cell in each direction is
+           near enough to contain a duplicate */
+        Long cell[vertexSize];
+        Long direction[vertexSize];
+        for(std::size_t ii = 0; ii != vertexSize; ++ii) {
+            const Type position = v[ii] - min[ii];
+            cell[ii] = Long(position/cellSize);
+            direction[ii] = position - Type(cell[ii])*cellSize < epsilon ? -1 : 1;
+        }
 
-        /* Go through all faces' vertices */
-        for(auto it = indices.begin(); it != indices.end(); ++it) {
-            /* Index of a vertex in vertexSize-dimensional table */
-            std::size_t index[vertexSize];
+        /* Check all 2^vertexSize cells for already added vertex */
+        UnsignedInt found = 0xFFFFFFFFu;
+        for(std::size_t neighbor = 0; neighbor != (std::size_t(1) << vertexSize) && found == 0xFFFFFFFFu; ++neighbor) {
+            Long neighborCell[vertexSize];
             for(std::size_t ii = 0; ii != vertexSize; ++ii)
-                index[ii] = std::size_t((vertices[*it][ii]+moved[ii]-min[ii])/epsilon);
-
-            /* Try inserting the vertex into table, if it already
-               exists, change vertex pointer of the face to already
-               existing vertex */
-            HashedVertex v(*it, table.size());
-            #ifndef CORRADE_GCC46_COMPATIBILITY
-            auto result = table.emplace(Math::Vector<vertexSize, std::size_t>::from(index), v);
-            #else
-            auto result = table.insert({Math::Vector<vertexSize, std::size_t>::from(index), v});
-            #endif
-            *it = result.first->second.newIndex;
+                neighborCell[ii] = cell[ii] + ((neighbor >> ii) & 1 ? direction[ii] : 0);
+
+            const UnsignedInt h = hash(neighborCell);
+            for(std::size_t slot = h & mask; table[slot].vertex != 0xFFFFFFFFu; slot = (slot + 1) & mask) {
+                if(table[slot].hash != h || !equals(v, vertices[table[slot].vertex], epsilon)) continue;
+                found = table[slot].vertex;
+                break;
+            }
         }
 
-        /* Shrink vertices array */
-        std::vector<Vertex> newVertices(table.size());
-        for(auto it = table.cbegin(); it != table.cend(); ++it)
-            newVertices[it->second.newIndex] = vertices[it->second.oldIndex];
-        std::swap(newVertices, vertices);
-
-        /* Move vertex coordinates by epsilon/2 in next direction */
-        if(moving != Vertex::Size) {
-            moved = Vertex();
-            moved[moving] = epsilon/2;
+        /* Duplicate found, map to it */
+        if(found != 0xFFFFFFFFu) {
+            remap[i] = remap[found];
+            continue;
         }
+
+        /* Otherwise add new unique vertex to its cell */
+        remap[i] = uniqueCount++;
+        const UnsignedInt h = hash(cell);
+        std::size_t slot = h & mask;
+        while(table[slot].vertex != 0xFFFFFFFFu) slot = (slot + 1) & mask;
+        table[slot] = Entry{h, UnsignedInt(i)};
     }
+
+    return std::make_tuple(std::move(remap), std::size_t(uniqueCount));
 }
 
 }
@@ -0,0 +1,327 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "Simplify.h"
+
+#include <algorithm>
+#include <limits>
+#include <queue>
+
+#include "Math/Vector3.h"
+#include "MeshTools/RemoveDuplicates.h"
+
+namespace Magnum { namespace MeshTools {
+
+namespace {
+
+/* Symmetric 4x4 matrix, upper triangle */
+struct Quadric {
+    Quadric(): a00(0.0), a01(0.0), a02(0.0), a03(0.0), a11(0.0), a12(0.0), a13(0.0), a22(0.0), a23(0.0), a33(0.0) {}
+
+    /* Quadric of plane with unit normal `normal` going through `point` */
+    explicit Quadric(const Vector3& normal, const Vector3& point, const Double weight) {
+        const Double a = normal.x(), b = normal.y(), c = normal.z();
+        const Double d = -Vector3::dot(normal, point);
+        a00 = weight*a*a; a01 = weight*a*b; a02 = weight*a*c; a03 = weight*a*d;
+        a11 = weight*b*b; a12 = weight*b*c; a13 = weight*b*d;
+        a22 = weight*c*c; a23 = weight*c*d;
+        a33 = weight*d*d;
+    }
+
+    Quadric& operator+=(const Quadric& other) {
+        a00 += other.a00; a01 += other.a01; a02 += other.a02; a03 += other.a03;
+        a11 += other.a11; a12 += other.a12; a13 += other.a13;
+        a22 += other.a22; a23 += other.a23;
+        a33 += other.a33;
+        return *this;
+    }
+
+    Double error(const Vector3& point) const {
+        const Double x = point.x(), y = point.y(), z = point.z();
+        return x*(a00*x + 2.0*(a01*y + a02*z + a03)) +
+               y*(a11*y + 2.0*(a12*z + a13)) +
+               z*(a22*z + 2.0*a23) + a33;
+    }
+
+    Double a00, a01, a02, a03, a11, a12, a13, a22, a23, a33;
+};
+
+/* Cheapest collapse of given vertex, with version of the vertex at the time
+   of computing the cost to detect stale entries */
+struct Collapse {
+    Double cost;
+    UnsignedInt vertex, version;
+
+    bool operator>(const Collapse& other) const { return cost > other.cost; }
+};
+
+/* Weight of plane quadrics preserving the boundary */
+constexpr Double BoundaryWeight = 10.0;
+
+class Simplifier {
+    public:
+        explicit Simplifier(const std::vector<UnsignedInt>& indices, const std::vector<Vector3>& positions);
+
+        std::vector<std::vector<UnsignedInt>> operator()(const std::vector<std::size_t>& targetIndexCounts, Float targetError);
+
+    private:
+        bool isBoundaryEdge(UnsignedInt vertex, UnsignedInt other) const;
+        void gatherNeighbors(UnsignedInt vertex);
+        void updateCollapse(UnsignedInt vertex);
+        bool isFlipping(UnsignedInt from, UnsignedInt to);
+        std::vector<UnsignedInt> output();
+
+        /* Copy of the indices, updated on each collapse */
+        std::vector<UnsignedInt> indices;
+        const std::vector<Vector3>& positions;
+
+        std::vector<bool> removed;
+        /* Target of the cheapest collapse for each vertex */
+        std::vector<UnsignedInt> target, version, positionId, neighbors, affected;
+        std::vector<Quadric> quadrics;
+        std::vector<bool> locked, boundary, liveFaces;
+        std::vector<std::vector<UnsignedInt>> vertexFaces;
+        std::priority_queue<Collapse, std::vector<Collapse>, std::greater<Collapse>> queue;
+        std::size_t liveFaceCount;
+};
+
+Simplifier::Simplifier(const std::vector<UnsignedInt>& indices, const std::vector<Vector3>& positions): indices(indices), positions(positions), removed(positions.size()), target(positions.size()), version(positions.size()), quadrics(positions.size()), locked(positions.size()), boundary(positions.size()), liveFaces(indices.size()/3, true), vertexFaces(positions.size()), liveFaceCount(indices.size()/3) {
+    /* Vertices sharing position with other vertices are on attribute seams,
+       lock them */
+    std::size_t uniquePositionCount;
+    std::tie(positionId, uniquePositionCount) = findDuplicates(positions);
+    {
+        std::vector<UnsignedInt> positionUseCount(uniquePositionCount);
+        for(UnsignedInt id: positionId) ++positionUseCount[id];
+        for(std::size_t i = 0; i != positions.size(); ++i)
+            locked[i] = positionUseCount[positionId[i]] > 1;
+    }
+
+    /* Directed edges by position, boundary edges of the original mesh are
+       those without their opposite, thus edges on the seams aren't boundary */
+    std::vector<UnsignedLong> directedEdges;
+    directedEdges.reserve(indices.size());
+    for(std::size_t i = 0; i != indices.size(); i += 3) for(std::size_t j = 0; j != 3; ++j)
+        directedEdges.push_back(UnsignedLong(positionId[indices[i + j]]) << 32 | positionId[indices[i + (j + 1)%3]]);
+    std::sort(directedEdges.begin(), directedEdges.end());
+
+    /* Plane quadrics of faces, perpendicular plane quadrics on boundary
+       edges */
+    for(std::size_t face = 0; face != indices.size()/3; ++face) {
+        const UnsignedInt* const triangle = indices.data() + face*3;
+        const Vector3 cross = Vector3::cross(positions[triangle[1]] - positions[triangle[0]],
+                                             positions[triangle[2]] - positions[triangle[0]]);
+        const Float length = cross.length();
+        const Vector3 normal = length ? cross/length : Vector3();
+
+        const Quadric quadric(normal, positions[triangle[0]], 1.0);
+        for(std::size_t j = 0; j != 3; ++j) {
+            quadrics[triangle[j]] += quadric;
+            vertexFaces[triangle[j]].push_back(face);
+        }
+
+        for(std::size_t j = 0; j != 3; ++j) {
+            const UnsignedInt a = triangle[j], b = triangle[(j + 1)%3];
+            if(std::binary_search(directedEdges.begin(), directedEdges.end(), UnsignedLong(positionId[b]) << 32 | positionId[a]))
+                continue;
+
+            boundary[a] = boundary[b] = true;
+            const Vector3 edgeNormal = Vector3::cross(positions[b] - positions[a], normal);
+            const Float edgeLength = edgeNormal.length();
+            if(!edgeLength) continue;
+
+            const Quadric edgeQuadric(edgeNormal/edgeLength, positions[a], BoundaryWeight);
+            quadrics[a] += edgeQuadric;
+            quadrics[b] += edgeQuadric;
+        }
+    }
+
+    for(std::size_t vertex = 0; vertex != positions.size(); ++vertex)
+        updateCollapse(vertex);
+}
+
+/* Collapses create edges which weren't in the original mesh, so the edge is
+   checked on the current faces. It's on the boundary if only one live face
+   contains it. The vertex must not be locked, so all faces containing the
+   edge are referencing it and not its duplicate. */
+bool Simplifier::isBoundaryEdge(const UnsignedInt vertex, const UnsignedInt other) const {
+    std::size_t faceCount = 0;
+    for(UnsignedInt face: vertexFaces[vertex]) {
+        if(!liveFaces[face]) continue;
+
+        for(std::size_t j = 0; j != 3; ++j) if(positionId[indices[face*3 + j]] == positionId[other]) {
+            ++faceCount;
+            break;
+        }
+    }
+
+    return faceCount == 1;
+}
+
+void Simplifier::gatherNeighbors(const UnsignedInt vertex) {
+    neighbors.clear();
+    for(UnsignedInt face: vertexFaces[vertex]) {
+        if(!liveFaces[face]) continue;
+
+        for(std::size_t j = 0; j != 3; ++j) {
+            const UnsignedInt other = indices[face*3 + j];
+            if(other != vertex && std::find(neighbors.begin(), neighbors.end(), other) == neighbors.end())
+                neighbors.push_back(other);
+        }
+    }
+}
+
+/* Find the cheapest collapse of given vertex into any of its neighbors and
+   put it into the queue, invalidating the previous one */
+void Simplifier::updateCollapse(const UnsignedInt vertex) {
+    ++version[vertex];
+    if(locked[vertex]) return;
+
+    gatherNeighbors(vertex);
+    Double minCost = std::numeric_limits<Double>::max();
+    for(UnsignedInt other: neighbors) {
+        /* Boundary vertices can move only along boundary edges */
+        if(boundary[vertex] && (!boundary[other] || !isBoundaryEdge(vertex, other)))
+            continue;
+
+        Quadric quadric = quadrics[vertex];
+        quadric += quadrics[other];
+        const Double cost = std::max(quadric.error(positions[other]), 0.0);
+        if(cost < minCost) {
+            minCost = cost;
+            target[vertex] = other;
+        }
+    }
+
+    if(minCost != std::numeric_limits<Double>::max())
+        queue.push({minCost, vertex, version[vertex]});
+}
+
+bool Simplifier::isFlipping(const UnsignedInt from, const UnsignedInt to) {
+    for(UnsignedInt face: vertexFaces[from]) {
+        if(!liveFaces[face]) continue;
+
+        UnsignedInt triangle[3];
+        bool hasTo = false;
+        for(std::size_t j = 0; j != 3; ++j) {
+            triangle[j] = indices[face*3 + j];
+            if(triangle[j] == to) hasTo = true;
+        }
+
+        /* Faces containing the edge will be removed */
+        if(hasTo) continue;
+
+        const Vector3 before = Vector3::cross(positions[triangle[1]] - positions[triangle[0]],
+                                              positions[triangle[2]] - positions[triangle[0]]);
+        for(UnsignedInt& vertex: triangle) if(vertex == from) vertex = to;
+        const Vector3 after = Vector3::cross(positions[triangle[1]] - positions[triangle[0]],
+                                             positions[triangle[2]] - positions[triangle[0]]);
+
+        /* Reject also large rotations, repeated collapses would otherwise
+           gradually tilt the faces into slivers */
+        if(Vector3::dot(before, after) <= 0.25f*before.length()*after.length())
+            return true;
+    }
+
+    return false;
+}
+
+std::vector<UnsignedInt> Simplifier::output() {
+    std::vector<UnsignedInt> out;
+    out.reserve(liveFaceCount*3);
+    for(std::size_t face = 0; face != liveFaces.size(); ++face) {
+        if(!liveFaces[face]) continue;
+        for(std::size_t j = 0; j != 3; ++j)
+            out.push_back(indices[face*3 + j]);
+    }
+
+    return out;
+}
+
+std::vector<std::vector<UnsignedInt>> Simplifier::operator()(const std::vector<std::size_t>& targetIndexCounts, const Float targetError) {
+    std::vector<std::vector<UnsignedInt>> levels;
+    levels.reserve(targetIndexCounts.size());
+
+    for(std::size_t targetIndexCount: targetIndexCounts) {
+        while(liveFaceCount*3 > targetIndexCount && !queue.empty()) {
+            const Collapse collapse = queue.top();
+            if(collapse.cost > targetError) break;
+            queue.pop();
+
+            /* Skip stale collapses, updated ones were pushed when the
+               vertex or its neighborhood changed */
+            const UnsignedInt from = collapse.vertex, to = target[from];
+            if(removed[from] || collapse.version != version[from]) continue;
+            if(removed[to]) {
+                updateCollapse(from);
+                continue;
+            }
+
+            /* If the collapse would flip any face, the vertex gets another
+               chance only after its neighborhood changes */
+            if(isFlipping(from, to)) continue;
+
+            /* Collapse, remove faces containing the edge */
+            removed[from] = true;
+            quadrics[to] += quadrics[from];
+            for(UnsignedInt face: vertexFaces[from]) {
+                if(!liveFaces[face]) continue;
+
+                UnsignedInt* const triangle = indices.data() + face*3;
+                for(std::size_t j = 0; j != 3; ++j)
+                    if(triangle[j] == from) triangle[j] = to;
+                if(triangle[0] == triangle[1] || triangle[1] == triangle[2] || triangle[2] == triangle[0]) {
+                    liveFaces[face] = false;
+                    --liveFaceCount;
+                } else vertexFaces[to].push_back(face);
+            }
+            std::vector<UnsignedInt>().swap(vertexFaces[from]);
+
+            /* Remove dead faces from the target */
+            std::vector<UnsignedInt>& faces = vertexFaces[to];
+            faces.erase(std::remove_if(faces.begin(), faces.end(), [this](UnsignedInt face) { return !liveFaces[face]; }), faces.end());
+
+            /* Quadric of the target changed, update collapses of the target
+               and all its neighbors */
+            gatherNeighbors(to);
+            affected.assign(neighbors.begin(), neighbors.end());
+            updateCollapse(to);
+            for(UnsignedInt vertex: affected) updateCollapse(vertex);
+        }
+
+        levels.push_back(output());
+    }
+
+    return levels;
+}
+
+}
+
+std::vector<std::vector<UnsignedInt>> simplifyChain(const std::vector<UnsignedInt>& indices, const std::vector<Vector3>& positions, const std::vector<std::size_t>& targetIndexCounts, const Float targetError) {
+    CORRADE_ASSERT(!(indices.size()%3), "MeshTools::simplifyChain(): index count is not divisible by 3!", {});
+
+    return Simplifier(indices, positions)(targetIndexCounts, targetError);
+}
+
+}}
@@ -0,0 +1,106 @@
+#ifndef Magnum_MeshTools_Simplify_h
+#define Magnum_MeshTools_Simplify_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Function @ref Magnum::MeshTools::simplify(), @ref Magnum::MeshTools::simplifyChain()
+ */
+
+#include <limits>
+#include <vector>
+
+#include "Magnum.h"
+
+#include "magnumMeshToolsVisibility.h"
+
+namespace Magnum { namespace MeshTools {
+
+/**
+@brief Generate chain of simplified meshes
+@param indices              Array of triangle face indices
+@param positions            Array of vertex positions
+@param targetIndexCounts    Target index counts of the levels, in
+    decreasing order
+@param targetError          Maximal allowed error
+@return Index array for each level
+
+Simplifies the mesh using edge collapses ordered by quadric error metric.
+Each collapse moves one vertex into its neighbor, thus the resulting indices
+reference the original vertex array and all vertex attributes stay valid.
+The quadrics are computed only once and the collapsing continues from one
+level to the next, so generating the whole chain costs about the same as
+generating the coarsest level alone.
+
+Vertices on mesh boundary can be moved only along the boundary, so the
+outline is preserved. Vertices which share position with other vertices
+(e.g. on texture coordinate or normal seams) are never moved, so the
+attribute seams stay intact. Collapses which would flip any face or rotate
+its normal by more than about 75 degrees are rejected.
+
+The simplification stops when index count drops to given level target or
+when error of next collapse would exceed @p targetError, which is
+squared distance from planes of original faces around the vertex. If the
+target cannot be reached, the level contains the simplest mesh achieved, so
+it may have more indices than requested. All levels index the original
+vertex arrays. Example usage, generating three levels of detail and then
+creating separate vertex arrays without the unused vertices for the smallest
+one. The original arrays are still used by the other levels, so they are
+copied first:
+@code
+std::vector<UnsignedInt> indices;
+std::vector<Vector3> positions;
+std::vector<Vector3> normals;
+
+std::vector<std::vector<UnsignedInt>> lods = MeshTools::simplifyChain(indices, positions,
+    {indices.size()/2, indices.size()/4, indices.size()/8});
+std::vector<Vector3> smallestPositions = positions;
+std::vector<Vector3> smallestNormals = normals;
+MeshTools::optimizeVertexFetch(lods.back(), smallestPositions, smallestNormals);
+@endcode
+
+@attention Index count must be divisible by 3, otherwise empty result is
+    returned.
+@see @ref optimizeVertexFetch(), @ref tipsify()
+*/
+std::vector<std::vector<UnsignedInt>> MAGNUM_MESHTOOLS_EXPORT simplifyChain(const std::vector<UnsignedInt>& indices, const std::vector<Vector3>& positions, const std::vector<std::size_t>& targetIndexCounts, Float targetError = std::numeric_limits<Float>::max());
+
+/**
+@brief Simplify the mesh
+@param indices          Array of triangle face indices
+@param positions        Array of vertex positions
+@param targetIndexCount Target index count
+@param targetError      Maximal allowed error
+@return Simplified index array
+
+Convenience alternative to @ref simplifyChain() for only one level.
+*/
+inline std::vector<UnsignedInt> simplify(const std::vector<UnsignedInt>& indices, const std::vector<Vector3>& positions, std::size_t targetIndexCount, Float targetError = std::numeric_limits<Float>::max()) {
+    std::vector<std::vector<UnsignedInt>> levels = simplifyChain(indices, positions, {targetIndexCount}, targetError);
+    return levels.empty() ? std::vector<UnsignedInt>() : std::move(levels.front());
+}
+
+}}
+
+#endif
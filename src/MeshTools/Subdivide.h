@@ -25,11 +25,13 @@
 */
 
 /** @file
- * @brief Function Magnum::MeshTools::subdivide()
+ * @brief Function Magnum::MeshTools::subdivide(), Magnum::MeshTools::subdivideShared()
  */
 
 #include <vector>
-#include <Utility/Debug.h>
+#include <Utility/Assert.h>
+
+#include "Types.h"
 
 namespace Magnum { namespace MeshTools {
 
@@ -57,6 +59,26 @@ template<class Vertex, class Interpolator> class Subdivide {
         }
 };
 
+template<class Vertex, class Interpolator> class SubdivideShared {
+    public:
+        SubdivideShared(std::vector<UnsignedInt>& indices, std::vector<Vertex>& vertices): indices(indices), vertices(vertices) {}
+
+        void operator()(std::size_t levels, Interpolator interpolator);
+
+    private:
+        /* Flat open-addressing table entry, edge is key (sorted index pair)
+           and index of the midpoint vertex is value */
+        struct Edge {
+            UnsignedLong key;
+            UnsignedInt vertex;
+        };
+
+        void subdivide(Interpolator& interpolator);
+
+        std::vector<UnsignedInt>& indices;
+        std::vector<Vertex>& vertices;
+};
+
 }
 
 /**
@@ -70,11 +92,34 @@ template<class Vertex, class Interpolator> class Subdivide {
 
 Goes through all triangle faces and subdivides them into four new. Removing
 duplicate vertices in the mesh is up to user.
+@see subdivideShared()
 */
 template<class Vertex, class Interpolator> inline void subdivide(std::vector<UnsignedInt>& indices, std::vector<Vertex>& vertices, Interpolator interpolator) {
     Implementation::Subdivide<Vertex, Interpolator>(indices, vertices)(interpolator);
 }
 
+/**
+@brief %Subdivide the mesh without duplicating vertices on shared edges
+@tparam Vertex          Vertex data type
+@tparam Interpolator    See `interpolator` function parameter
+@param[in,out] indices  Index array to operate on
+@param[in,out] vertices Vertex array to operate on
+@param levels           Subdivision level count
+@param interpolator     Functor or function pointer which interpolates
+    two adjacent vertices: `Vertex interpolator(Vertex a, Vertex b)`
+
+Subdivides each triangle face into four new @p levels times. Unlike
+subdivide(), midpoint vertices are stored in hash table keyed by the edge
+(sorted index pair), so each edge is interpolated only once and the mesh
+doesn't contain any duplicate vertices afterwards, thus there is no need to
+call removeDuplicates(). Capacity of both arrays is reserved for their final
+size at the beginning (exact for the index array, for the vertex array it
+assumes closed mesh), so they are not reallocated on every level.
+*/
+template<class Vertex, class Interpolator> inline void subdivideShared(std::vector<UnsignedInt>& indices, std::vector<Vertex>& vertices, std::size_t levels, Interpolator interpolator) {
+    Implementation::SubdivideShared<Vertex, Interpolator>(indices, vertices)(levels, interpolator);
+}
+
 namespace Implementation {
 
 template<class Vertex, class Interpolator> void Subdivide<Vertex, Interpolator>::operator()(Interpolator interpolator) {
@@ -111,6 +156,75 @@ template<class Vertex, class Interpolator> void Subdivide<Vertex, Interpolator>:
     }
 }
 
+template<class Vertex, class Interpolator> void SubdivideShared<Vertex, Interpolator>::operator()(const std::size_t levels, Interpolator interpolator) {
+    CORRADE_ASSERT(!(indices.size()%3), "MeshTools::subdivideShared(): index count is not divisible by 3!", );
+
+    /* Compute final index count and vertex count for closed mesh, where each
+       edge is shared by two faces */
+    std::size_t indexCount = indices.size();
+    std::size_t vertexCount = vertices.size();
+    std::size_t edgeCount = indices.size()/2;
+    for(std::size_t i = 0; i != levels; ++i) {
+        vertexCount += edgeCount;
+        edgeCount = 2*edgeCount + indexCount;
+        indexCount *= 4;
+    }
+    indices.reserve(indexCount);
+    vertices.reserve(vertexCount);
+
+    for(std::size_t i = 0; i != levels; ++i)
+        subdivide(interpolator);
+}
+
+template<class Vertex, class Interpolator> void SubdivideShared<Vertex, Interpolator>::subdivide(Interpolator& interpolator) {
+    const std::size_t indexCount = indices.size();
+    indices.resize(indexCount*4);
+
+    /* Power-of-two table which stays at most 3/4 full even if no edges are
+       shared */
+    std::size_t capacity = 16;
+    while(capacity*3 < indexCount*4) capacity <<= 1;
+    const std::size_t mask = capacity - 1;
+    std::vector<Edge> edges(capacity, Edge{~UnsignedLong(0), 0});
+
+    /* Subdivide each face to four new, the original face is replaced with
+       the middle one and three new are put at the end */
+    UnsignedInt* const newFaces = indices.data() + indexCount;
+    for(std::size_t i = 0; i != indexCount; i += 3) {
+        /* Interpolate each side, if not already done for neighboring face */
+        UnsignedInt newVertices[3];
+        for(std::size_t j = 0; j != 3; ++j) {
+            const UnsignedInt a = indices[i+j], b = indices[i+(j+1)%3];
+            const UnsignedLong key = a < b ? (UnsignedLong(a) << 32)|b : (UnsignedLong(b) << 32)|a;
+
+            std::size_t slot = std::size_t((key*0x9e3779b97f4a7c15ull) >> 32) & mask;
+            while(edges[slot].key != key && edges[slot].key != ~UnsignedLong(0))
+                slot = (slot + 1) & mask;
+
+            if(edges[slot].key == key) newVertices[j] = edges[slot].vertex;
+            else {
+                vertices.push_back(interpolator(vertices[a], vertices[b]));
+                newVertices[j] = vertices.size()-1;
+                edges[slot] = Edge{key, newVertices[j]};
+            }
+        }
+
+        /* Same face layout as in subdivide() */
+        UnsignedInt* const faces = newFaces + i*3;
+        faces[0] = indices[i];
+        faces[1] = newVertices[0];
+        faces[2] = newVertices[2];
+        faces[3] = newVertices[0];
+        faces[4] = indices[i+1];
+        faces[5] = newVertices[1];
+        faces[6] = newVertices[2];
+        faces[7] = newVertices[1];
+        faces[8] = indices[i+2];
+        for(std::size_t j = 0; j != 3; ++j)
+            indices[i+j] = newVertices[j];
+    }
+}
+
 }
 
 }}
@@ -37,12 +37,20 @@ class CompressIndicesTest: public TestSuite::Tester {
         void compressChar();
         void compressShort();
         void compressInt();
+        void compressEmpty();
+        void compressRange();
+        void compressRangeRebase();
+        void compressLarge();
 };
 
 CompressIndicesTest::CompressIndicesTest() {
     addTests({&CompressIndicesTest::compressChar,
               &CompressIndicesTest::compressShort,
-              &CompressIndicesTest::compressInt});
+              &CompressIndicesTest::compressInt,
+              &CompressIndicesTest::compressEmpty,
+              &CompressIndicesTest::compressRange,
+              &CompressIndicesTest::compressRangeRebase,
+              &CompressIndicesTest::compressLarge});
 }
 
 void CompressIndicesTest::compressChar() {
@@ -105,6 +113,94 @@ void CompressIndicesTest::compressInt() {
     }
 }
 
+void CompressIndicesTest::compressEmpty() {
+    std::size_t indexCount;
+    Mesh::IndexType indexType;
+    Containers::Array<char> data;
+    UnsignedInt start, end;
+    std::tie(indexCount, indexType, data, start, end) = MeshTools::compressIndicesRange(
+        std::vector<UnsignedInt>{});
+
+    CORRADE_COMPARE(indexCount, 0);
+    CORRADE_VERIFY(indexType == Mesh::IndexType::UnsignedByte);
+    CORRADE_VERIFY(!data);
+    CORRADE_COMPARE(start, 0);
+    CORRADE_COMPARE(end, 0);
+}
+
+void CompressIndicesTest::compressRange() {
+    std::size_t indexCount;
+    Mesh::IndexType indexType;
+    Containers::Array<char> data;
+    UnsignedInt start, end;
+    std::tie(indexCount, indexType, data, start, end) = MeshTools::compressIndicesRange(
+        std::vector<UnsignedInt>{75000, 75003, 75255, 75001});
+
+    CORRADE_COMPARE(indexCount, 4);
+    CORRADE_VERIFY(indexType == Mesh::IndexType::UnsignedInt);
+    CORRADE_COMPARE(data.size(), 16);
+    CORRADE_COMPARE(start, 75000);
+    CORRADE_COMPARE(end, 75255);
+}
+
+void CompressIndicesTest::compressRangeRebase() {
+    std::size_t indexCount;
+    Mesh::IndexType indexType;
+    Containers::Array<char> data;
+    UnsignedInt start, end;
+    std::tie(indexCount, indexType, data, start, end) = MeshTools::compressIndicesRange(
+        std::vector<UnsignedInt>{75000, 75003, 75255, 75001}, true);
+
+    /* Range is of original indices, data are rebased */
+    CORRADE_COMPARE(indexCount, 4);
+    CORRADE_VERIFY(indexType == Mesh::IndexType::UnsignedByte);
+    CORRADE_COMPARE(start, 75000);
+    CORRADE_COMPARE(end, 75255);
+    CORRADE_COMPARE(std::vector<char>(data.begin(), data.end()),
+        (std::vector<char>{ 0x00, 0x03, char(0xff), 0x01 }));
+}
+
+void CompressIndicesTest::compressLarge() {
+    /* Sizes not divisible by any vector width, so both the vectorized and the
+       scalar part is tested */
+    for(UnsignedInt range: {200u, 60000u, 100000u}) {
+        std::vector<UnsignedInt> indices(1037);
+        for(std::size_t i = 0; i != indices.size(); ++i)
+            indices[i] = 5000 + (i*7919)%range;
+        indices[611] = 5000 + range - 1;
+
+        for(bool rebase: {false, true}) {
+            std::size_t indexCount;
+            Mesh::IndexType indexType;
+            Containers::Array<char> data;
+            UnsignedInt start, end;
+            std::tie(indexCount, indexType, data, start, end) = MeshTools::compressIndicesRange(indices, rebase);
+
+            CORRADE_COMPARE(indexCount, indices.size());
+            CORRADE_COMPARE(start, 5000);
+            CORRADE_COMPARE(end, 5000 + range - 1);
+
+            const UnsignedInt offset = rebase ? 5000 : 0;
+            std::vector<UnsignedInt> decompressed(indices.size());
+            if(indexType == Mesh::IndexType::UnsignedByte) {
+                CORRADE_VERIFY(rebase && range == 200);
+                for(std::size_t i = 0; i != indices.size(); ++i)
+                    decompressed[i] = reinterpret_cast<const UnsignedByte*>(data.begin())[i] + offset;
+            } else if(indexType == Mesh::IndexType::UnsignedShort) {
+                CORRADE_VERIFY(range != 100000 || rebase);
+                for(std::size_t i = 0; i != indices.size(); ++i)
+                    decompressed[i] = reinterpret_cast<const UnsignedShort*>(data.begin())[i] + offset;
+            } else {
+                CORRADE_VERIFY(range == 100000);
+                for(std::size_t i = 0; i != indices.size(); ++i)
+                    decompressed[i] = reinterpret_cast<const UnsignedInt*>(data.begin())[i] + offset;
+            }
+
+            CORRADE_COMPARE(decompressed, indices);
+        }
+    }
+}
+
 }}}
 
 CORRADE_TEST_MAIN(Magnum::MeshTools::Test::CompressIndicesTest)
@@ -0,0 +1,219 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <algorithm>
+#include <sstream>
+#include <Containers/Array.h>
+#include <TestSuite/Tester.h>
+
+#include "MeshTools/ConvertPrimitive.h"
+
+namespace Magnum { namespace MeshTools { namespace Test {
+
+class ConvertPrimitiveTest: public TestSuite::Tester {
+    public:
+        ConvertPrimitiveTest();
+
+        void triangleStrip();
+        void triangleStripDegenerate();
+        void triangleStripTooShort();
+        void triangleFan();
+        void quads();
+        void quadsWrongIndexCount();
+        void trianglesToStrip();
+        void trianglesToStripRestart();
+        void trianglesToStripRoundTrip();
+        void trianglesToStripIndexType();
+        void trianglesToStripWrongIndexCount();
+};
+
+ConvertPrimitiveTest::ConvertPrimitiveTest() {
+    addTests({&ConvertPrimitiveTest::triangleStrip,
+              &ConvertPrimitiveTest::triangleStripDegenerate,
+              &ConvertPrimitiveTest::triangleStripTooShort,
+              &ConvertPrimitiveTest::triangleFan,
+              &ConvertPrimitiveTest::quads,
+              &ConvertPrimitiveTest::quadsWrongIndexCount,
+              &ConvertPrimitiveTest::trianglesToStrip,
+              &ConvertPrimitiveTest::trianglesToStripRestart,
+              &ConvertPrimitiveTest::trianglesToStripRoundTrip,
+              &ConvertPrimitiveTest::trianglesToStripIndexType,
+              &ConvertPrimitiveTest::trianglesToStripWrongIndexCount});
+}
+
+void ConvertPrimitiveTest::triangleStrip() {
+    std::vector<UnsignedInt> indices{0, 1, 2, 3, 4};
+    MeshTools::triangleStripToTriangles(indices);
+
+    CORRADE_COMPARE(indices, (std::vector<UnsignedInt>{0, 1, 2,
+                                                       2, 1, 3,
+                                                       2, 3, 4}));
+}
+
+void ConvertPrimitiveTest::triangleStripDegenerate() {
+    /* Two strips joined with degenerate triangles */
+    std::vector<UnsignedInt> indices{0, 1, 2, 3, 3, 4, 4, 5, 6, 7};
+    MeshTools::triangleStripToTriangles(indices);
+
+    CORRADE_COMPARE(indices, (std::vector<UnsignedInt>{0, 1, 2,
+                                                       2, 1, 3,
+                                                       4, 5, 6,
+                                                       6, 5, 7}));
+}
+
+void ConvertPrimitiveTest::triangleStripTooShort() {
+    std::vector<UnsignedInt> indices{0, 1};
+    MeshTools::triangleStripToTriangles(indices);
+
+    CORRADE_VERIFY(indices.empty());
+}
+
+void ConvertPrimitiveTest::triangleFan() {
+    std::vector<UnsignedInt> indices{0, 1, 2, 3, 4};
+    MeshTools::triangleFanToTriangles(indices);
+
+    CORRADE_COMPARE(indices, (std::vector<UnsignedInt>{0, 1, 2,
+                                                       0, 2, 3,
+                                                       0, 3, 4}));
+}
+
+void ConvertPrimitiveTest::quads() {
+    std::vector<UnsignedInt> indices{0, 1, 2, 3,
+                                     4, 5, 6, 7};
+    MeshTools::quadsToTriangles(indices);
+
+    CORRADE_COMPARE(indices, (std::vector<UnsignedInt>{0, 1, 2, 0, 2, 3,
+                                                       4, 5, 6, 4, 6, 7}));
+}
+
+void ConvertPrimitiveTest::quadsWrongIndexCount() {
+    std::stringstream ss;
+    Error::setOutput(&ss);
+
+    std::vector<UnsignedInt> indices{0, 1, 2};
+    MeshTools::quadsToTriangles(indices);
+
+    CORRADE_COMPARE(ss.str(), "MeshTools::quadsToTriangles(): index count is not divisible by 4!\n");
+}
+
+void ConvertPrimitiveTest::trianglesToStrip() {
+    std::size_t indexCount;
+    Mesh::IndexType indexType;
+    Containers::Array<char> data;
+    std::tie(indexCount, indexType, data) = MeshTools::trianglesToTriangleStrip(
+        std::vector<UnsignedInt>{0, 1, 2,
+                                 2, 1, 3,
+                                 2, 3, 4}, 5);
+
+    CORRADE_COMPARE(indexCount, 5);
+    CORRADE_VERIFY(indexType == Mesh::IndexType::UnsignedByte);
+    CORRADE_COMPARE(std::vector<char>(data.begin(), data.end()),
+        (std::vector<char>{0, 1, 2, 3, 4}));
+}
+
+void ConvertPrimitiveTest::trianglesToStripRestart() {
+    /* Two disconnected triangles */
+    std::size_t indexCount;
+    Mesh::IndexType indexType;
+    Containers::Array<char> data;
+    std::tie(indexCount, indexType, data) = MeshTools::trianglesToTriangleStrip(
+        std::vector<UnsignedInt>{0, 1, 2,
+                                 3, 4, 5}, 6);
+
+    CORRADE_COMPARE(indexCount, 7);
+    CORRADE_VERIFY(indexType == Mesh::IndexType::UnsignedByte);
+    CORRADE_COMPARE(std::vector<char>(data.begin(), data.end()),
+        (std::vector<char>{0, 1, 2, char(0xff), 3, 4, 5}));
+}
+
+void ConvertPrimitiveTest::trianglesToStripRoundTrip() {
+    /* 4x4 grid of quads */
+    std::vector<UnsignedInt> indices;
+    for(UnsignedInt y = 0; y != 4; ++y) for(UnsignedInt x = 0; x != 4; ++x) {
+        const UnsignedInt i = y*5 + x;
+        indices.insert(indices.end(), {i, i + 1, i + 6, i, i + 6, i + 5});
+    }
+
+    std::size_t indexCount;
+    Mesh::IndexType indexType;
+    Containers::Array<char> data;
+    std::tie(indexCount, indexType, data) = MeshTools::trianglesToTriangleStrip(indices, 25);
+    CORRADE_VERIFY(indexType == Mesh::IndexType::UnsignedByte);
+    CORRADE_VERIFY(indexCount < indices.size());
+
+    /* Convert each strip back to triangles */
+    std::vector<UnsignedInt> triangles;
+    std::vector<UnsignedInt> strip;
+    for(std::size_t i = 0; i <= indexCount; ++i) {
+        if(i != indexCount && UnsignedByte(data[i]) != 0xff) {
+            strip.push_back(UnsignedByte(data[i]));
+            continue;
+        }
+
+        MeshTools::triangleStripToTriangles(strip);
+        triangles.insert(triangles.end(), strip.begin(), strip.end());
+        strip.clear();
+    }
+
+    /* All triangles must be there exactly once with the same winding, rotate
+       them so the smallest index is first to have them comparable */
+    auto normalize = [](std::vector<UnsignedInt>& indices) {
+        std::vector<std::tuple<UnsignedInt, UnsignedInt, UnsignedInt>> out;
+        for(std::size_t i = 0; i != indices.size(); i += 3) {
+            std::size_t first = i;
+            if(indices[i+1] < indices[first]) first = i+1;
+            if(indices[i+2] < indices[first]) first = i+2;
+            out.emplace_back(indices[first], indices[i + (first - i + 1)%3], indices[i + (first - i + 2)%3]);
+        }
+        std::sort(out.begin(), out.end());
+        return out;
+    };
+    CORRADE_VERIFY(normalize(triangles) == normalize(indices));
+}
+
+void ConvertPrimitiveTest::trianglesToStripIndexType() {
+    /* 255 is the restart index for bytes, so it needs to be short */
+    std::size_t indexCount;
+    Mesh::IndexType indexType;
+    Containers::Array<char> data;
+    std::tie(indexCount, indexType, data) = MeshTools::trianglesToTriangleStrip(
+        std::vector<UnsignedInt>{0, 1, 255}, 256);
+
+    CORRADE_COMPARE(indexCount, 3);
+    CORRADE_VERIFY(indexType == Mesh::IndexType::UnsignedShort);
+    CORRADE_COMPARE(data.size(), 6);
+}
+
+void ConvertPrimitiveTest::trianglesToStripWrongIndexCount() {
+    std::stringstream ss;
+    Error::setOutput(&ss);
+
+    MeshTools::trianglesToTriangleStrip(std::vector<UnsignedInt>{0, 1}, 2);
+
+    CORRADE_COMPARE(ss.str(), "MeshTools::trianglesToTriangleStrip(): index count is not divisible by 3!\n");
+}
+
+}}}
+
+CORRADE_TEST_MAIN(Magnum::MeshTools::Test::ConvertPrimitiveTest)
@@ -0,0 +1,191 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <sstream>
+#include <TestSuite/Tester.h>
+
+#include "Math/Vector3.h"
+#include "MeshTools/GenerateSmoothNormals.h"
+
+namespace Magnum { namespace MeshTools { namespace Test {
+
+class GenerateSmoothNormalsTest: public TestSuite::Tester {
+    public:
+        GenerateSmoothNormalsTest();
+
+        void wrongIndexCount();
+        void generate();
+        void weighting();
+        void degenerate();
+        void crease();
+        void parallel();
+};
+
+namespace {
+
+/* Roof with ridge along X axis, faces on both sides in 45 degrees */
+const std::vector<UnsignedInt> roofIndices{
+    0, 1, 2,
+    1, 3, 2,
+    0, 4, 1,
+    1, 4, 5
+};
+
+const std::vector<Vector3> roofPositions{
+    {0.0f, 0.0f, 1.0f},
+    {1.0f, 0.0f, 1.0f},
+    {0.0f, 1.0f, 0.0f},
+    {1.0f, 1.0f, 0.0f},
+    {0.0f, -1.0f, 0.0f},
+    {1.0f, -1.0f, 0.0f}
+};
+
+}
+
+GenerateSmoothNormalsTest::GenerateSmoothNormalsTest() {
+    addTests({&GenerateSmoothNormalsTest::wrongIndexCount,
+              &GenerateSmoothNormalsTest::generate,
+              &GenerateSmoothNormalsTest::weighting,
+              &GenerateSmoothNormalsTest::degenerate,
+              &GenerateSmoothNormalsTest::crease,
+              &GenerateSmoothNormalsTest::parallel});
+}
+
+void GenerateSmoothNormalsTest::wrongIndexCount() {
+    std::stringstream ss;
+    Error::setOutput(&ss);
+
+    std::vector<UnsignedInt> indices;
+    std::vector<Vector3> normals;
+    std::tie(indices, normals) = MeshTools::generateSmoothNormals({0, 1}, std::vector<Vector3>{}, Rad(1.0f));
+    MeshTools::generateSmoothNormalsInto({0, 1}, std::vector<Vector3>{}, normals);
+
+    CORRADE_COMPARE(indices.size(), 0);
+    CORRADE_COMPARE(normals.size(), 0);
+    CORRADE_COMPARE(ss.str(), "MeshTools::generateSmoothNormals(): index count is not divisible by 3!\n"
+                              "MeshTools::generateSmoothNormalsInto(): index count is not divisible by 3!\n");
+}
+
+void GenerateSmoothNormalsTest::generate() {
+    const Vector3 side = Vector3(0.0f, 1.0f, 1.0f).normalized();
+    const std::vector<Vector3> expected{
+        Vector3::zAxis(),
+        Vector3::zAxis(),
+        side,
+        side,
+        {0.0f, -side.y(), side.z()},
+        {0.0f, -side.y(), side.z()}
+    };
+
+    /* The roof is symmetric, so both weightings give the same result */
+    CORRADE_COMPARE(MeshTools::generateSmoothNormals(roofIndices, roofPositions), expected);
+    CORRADE_COMPARE(MeshTools::generateSmoothNormals(roofIndices, roofPositions, NormalWeighting::Area), expected);
+}
+
+void GenerateSmoothNormalsTest::weighting() {
+    /* Large face facing Z and small face facing X, both having right angle
+       at vertex 0 */
+    const std::vector<UnsignedInt> indices{
+        0, 1, 2,
+        0, 3, 4
+    };
+    const std::vector<Vector3> positions{
+        {0.0f, 0.0f, 0.0f},
+        {2.0f, 0.0f, 0.0f},
+        {0.0f, 2.0f, 0.0f},
+        {0.0f, 1.0f, 0.0f},
+        {0.0f, 0.0f, 1.0f}
+    };
+
+    CORRADE_COMPARE(MeshTools::generateSmoothNormals(indices, positions, NormalWeighting::Angle)[0],
+        Vector3(1.0f, 0.0f, 1.0f).normalized());
+    CORRADE_COMPARE(MeshTools::generateSmoothNormals(indices, positions, NormalWeighting::Area)[0],
+        Vector3(1.0f, 0.0f, 4.0f).normalized());
+}
+
+void GenerateSmoothNormalsTest::degenerate() {
+    /* Degenerate face doesn't contribute, unreferenced vertex has zero
+       normal */
+    const std::vector<UnsignedInt> indices{
+        0, 1, 2,
+        0, 1, 1
+    };
+    const std::vector<Vector3> positions{
+        {0.0f, 0.0f, 0.0f},
+        {1.0f, 0.0f, 0.0f},
+        {0.0f, 1.0f, 0.0f},
+        {5.0f, 5.0f, 5.0f}
+    };
+
+    CORRADE_COMPARE(MeshTools::generateSmoothNormals(indices, positions), (std::vector<Vector3>{
+        Vector3::zAxis(),
+        Vector3::zAxis(),
+        Vector3::zAxis(),
+        {}
+    }));
+}
+
+void GenerateSmoothNormalsTest::crease() {
+    const Vector3 side = Vector3(0.0f, 1.0f, 1.0f).normalized();
+    const Vector3 otherSide = {0.0f, -side.y(), side.z()};
+
+    /* The faces have 90 degrees between them, so the ridge is sharp */
+    std::vector<UnsignedInt> normalIndices;
+    std::vector<Vector3> normals;
+    std::tie(normalIndices, normals) = MeshTools::generateSmoothNormals(roofIndices, roofPositions, Deg(60.0f));
+
+    CORRADE_COMPARE(normals.size(), 8);
+    CORRADE_COMPARE(normalIndices.size(), 12);
+    for(std::size_t i = 0; i != 6; ++i)
+        CORRADE_COMPARE(normals[normalIndices[i]], side);
+    for(std::size_t i = 6; i != 12; ++i)
+        CORRADE_COMPARE(normals[normalIndices[i]], otherSide);
+
+    /* Larger crease angle gives the same result as smooth normals */
+    std::tie(normalIndices, normals) = MeshTools::generateSmoothNormals(roofIndices, roofPositions, Deg(100.0f));
+    CORRADE_COMPARE(normalIndices, roofIndices);
+    CORRADE_COMPARE(normals, MeshTools::generateSmoothNormals(roofIndices, roofPositions));
+}
+
+void GenerateSmoothNormalsTest::parallel() {
+    /* Wavy 64x64 grid */
+    std::vector<Vector3> positions;
+    std::vector<UnsignedInt> indices;
+    for(UnsignedInt y = 0; y != 64; ++y) for(UnsignedInt x = 0; x != 64; ++x) {
+        positions.push_back({Float(x), Float(y), Float((x*7 + y*13)%5)});
+        if(x == 63 || y == 63) continue;
+
+        const UnsignedInt i = y*64 + x;
+        indices.insert(indices.end(), {i, i + 1, i + 65, i, i + 65, i + 64});
+    }
+
+    std::vector<Vector3> expected, normals;
+    MeshTools::generateSmoothNormalsInto(indices, positions, expected);
+    MeshTools::generateSmoothNormalsInto(indices, positions, normals, NormalWeighting::Angle, 3);
+    CORRADE_COMPARE(normals, expected);
+}
+
+}}}
+
+CORRADE_TEST_MAIN(Magnum::MeshTools::Test::GenerateSmoothNormalsTest)
@@ -0,0 +1,143 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <sstream>
+#include <TestSuite/Tester.h>
+
+#include "Math/Vector4.h"
+#include "MeshTools/GenerateTangents.h"
+
+namespace Magnum { namespace MeshTools { namespace Test {
+
+class GenerateTangentsTest: public TestSuite::Tester {
+    public:
+        GenerateTangentsTest();
+
+        void wrongIndexCount();
+        void wrongArraySize();
+        void generate();
+        void mirrored();
+        void orthogonalized();
+        void noTextureMapping();
+};
+
+namespace {
+
+/* Quad in XY plane */
+const std::vector<UnsignedInt> quadIndices{
+    0, 1, 2,
+    0, 2, 3
+};
+
+const std::vector<Vector3> quadPositions{
+    {0.0f, 0.0f, 0.0f},
+    {1.0f, 0.0f, 0.0f},
+    {1.0f, 1.0f, 0.0f},
+    {0.0f, 1.0f, 0.0f}
+};
+
+const std::vector<Vector3> quadNormals(4, Vector3::zAxis());
+
+}
+
+GenerateTangentsTest::GenerateTangentsTest() {
+    addTests({&GenerateTangentsTest::wrongIndexCount,
+              &GenerateTangentsTest::wrongArraySize,
+              &GenerateTangentsTest::generate,
+              &GenerateTangentsTest::mirrored,
+              &GenerateTangentsTest::orthogonalized,
+              &GenerateTangentsTest::noTextureMapping});
+}
+
+void GenerateTangentsTest::wrongIndexCount() {
+    std::stringstream ss;
+    Error::setOutput(&ss);
+
+    CORRADE_VERIFY(MeshTools::generateTangents({0, 1}, {}, {}, {}).empty());
+    CORRADE_COMPARE(ss.str(), "MeshTools::generateTangentsInto(): index count is not divisible by 3!\n");
+}
+
+void GenerateTangentsTest::wrongArraySize() {
+    std::stringstream ss;
+    Error::setOutput(&ss);
+
+    CORRADE_VERIFY(MeshTools::generateTangents(quadIndices, quadPositions, quadNormals, {{}, {}}).empty());
+    CORRADE_COMPARE(ss.str(), "MeshTools::generateTangentsInto(): vertex arrays don't have the same length, nothing done.\n");
+}
+
+void GenerateTangentsTest::generate() {
+    const std::vector<Vector2> textureCoordinates{
+        {0.0f, 0.0f},
+        {1.0f, 0.0f},
+        {1.0f, 1.0f},
+        {0.0f, 1.0f}
+    };
+
+    CORRADE_COMPARE(MeshTools::generateTangents(quadIndices, quadPositions, quadNormals, textureCoordinates),
+        std::vector<Vector4>(4, {1.0f, 0.0f, 0.0f, 1.0f}));
+}
+
+void GenerateTangentsTest::mirrored() {
+    /* Texture mirrored in U, bitangent stays in the same direction, thus the
+       sign is negative */
+    const std::vector<Vector2> textureCoordinates{
+        {1.0f, 0.0f},
+        {0.0f, 0.0f},
+        {0.0f, 1.0f},
+        {1.0f, 1.0f}
+    };
+
+    CORRADE_COMPARE(MeshTools::generateTangents(quadIndices, quadPositions, quadNormals, textureCoordinates),
+        std::vector<Vector4>(4, {-1.0f, 0.0f, 0.0f, -1.0f}));
+}
+
+void GenerateTangentsTest::orthogonalized() {
+    /* Texture rotated by 90 degrees, normals tilted */
+    const std::vector<Vector2> textureCoordinates{
+        {0.0f, 0.0f},
+        {0.0f, 1.0f},
+        {-1.0f, 1.0f},
+        {-1.0f, 0.0f}
+    };
+    const std::vector<Vector3> normals(4, Vector3(0.0f, 1.0f, 1.0f).normalized());
+
+    const std::vector<Vector4> tangents = MeshTools::generateTangents(quadIndices, quadPositions, normals, textureCoordinates);
+    const Vector3 expected = Vector3(0.0f, -1.0f, 1.0f).normalized();
+    for(const Vector4& tangent: tangents)
+        CORRADE_COMPARE(tangent, Vector4(expected, 1.0f));
+}
+
+void GenerateTangentsTest::noTextureMapping() {
+    const std::vector<Vector4> tangents = MeshTools::generateTangents(quadIndices, quadPositions, quadNormals, std::vector<Vector2>(4));
+
+    /* Some unit vector perpendicular to the normal */
+    for(const Vector4& tangent: tangents) {
+        CORRADE_VERIFY(tangent.xyz().isNormalized());
+        CORRADE_COMPARE(Vector3::dot(tangent.xyz(), Vector3::zAxis()), 0.0f);
+    }
+}
+
+}}}
+
+CORRADE_TEST_MAIN(Magnum::MeshTools::Test::GenerateTangentsTest)
@@ -22,6 +22,7 @@
     DEALINGS IN THE SOFTWARE.
 */
 
+#include <algorithm>
 #include <sstream>
 #include <TestSuite/Tester.h>
 
@@ -41,6 +42,11 @@ class InterleaveTest: public Corrade::TestSuite::Tester {
         void strideGaps();
         void write();
         void writeGaps();
+        void writeInto();
+        void writeIntoStride();
+        void writeIntoTooSmall();
+        void writeIntoRuntime();
+        void writeIntoRuntimeInvalid();
 };
 
 InterleaveTest::InterleaveTest() {
@@ -49,7 +55,12 @@ InterleaveTest::InterleaveTest() {
               &InterleaveTest::stride,
               &InterleaveTest::strideGaps,
               &InterleaveTest::write,
-              &InterleaveTest::writeGaps});
+              &InterleaveTest::writeGaps,
+              &InterleaveTest::writeInto,
+              &InterleaveTest::writeIntoStride,
+              &InterleaveTest::writeIntoTooSmall,
+              &InterleaveTest::writeIntoRuntime,
+              &InterleaveTest::writeIntoRuntimeInvalid});
 }
 
 void InterleaveTest::attributeCount() {
@@ -136,6 +147,110 @@ void InterleaveTest::writeGaps() {
     }
 }
 
+void InterleaveTest::writeInto() {
+    char data[21];
+    CORRADE_COMPARE(MeshTools::interleaveInto(data, 7,
+        std::vector<Byte>{0, 1, 2},
+        std::vector<Int>{3, 4, 5},
+        std::vector<Short>{6, 7, 8}), std::size_t(3));
+
+    if(!Utility::Endianness::isBigEndian()) {
+        CORRADE_COMPARE(std::vector<char>(data, data + 21), (std::vector<char>{
+            0x00, 0x03, 0x00, 0x00, 0x00, 0x06, 0x00,
+            0x01, 0x04, 0x00, 0x00, 0x00, 0x07, 0x00,
+            0x02, 0x05, 0x00, 0x00, 0x00, 0x08, 0x00
+        }));
+    } else {
+        CORRADE_COMPARE(std::vector<char>(data, data + 21), (std::vector<char>{
+            0x00, 0x00, 0x00, 0x00, 0x03, 0x00, 0x06,
+            0x01, 0x00, 0x00, 0x00, 0x04, 0x00, 0x07,
+            0x02, 0x00, 0x00, 0x00, 0x05, 0x00, 0x08
+        }));
+    }
+}
+
+void InterleaveTest::writeIntoStride() {
+    /* Gap is zero-filled, space at the end of the stride is untouched */
+    char data[18];
+    std::fill_n(data, 18, 0x7f);
+    CORRADE_COMPARE(MeshTools::interleaveInto(data, 6,
+        std::vector<Byte>{0, 1, 2}, 1,
+        std::vector<Short>{3, 4, 5}), std::size_t(3));
+
+    if(!Utility::Endianness::isBigEndian()) {
+        CORRADE_COMPARE(std::vector<char>(data, data + 18), (std::vector<char>{
+            0x00, 0x00, 0x03, 0x00, 0x7f, 0x7f,
+            0x01, 0x00, 0x04, 0x00, 0x7f, 0x7f,
+            0x02, 0x00, 0x05, 0x00, 0x7f, 0x7f
+        }));
+    } else {
+        CORRADE_COMPARE(std::vector<char>(data, data + 18), (std::vector<char>{
+            0x00, 0x00, 0x00, 0x03, 0x7f, 0x7f,
+            0x01, 0x00, 0x00, 0x04, 0x7f, 0x7f,
+            0x02, 0x00, 0x00, 0x05, 0x7f, 0x7f
+        }));
+    }
+}
+
+void InterleaveTest::writeIntoTooSmall() {
+    std::stringstream ss;
+    Error::setOutput(&ss);
+
+    char data[12];
+    CORRADE_COMPARE(MeshTools::interleaveInto(data, 2,
+        std::vector<Byte>{0, 1, 2},
+        std::vector<Short>{3, 4, 5}), std::size_t(0));
+    CORRADE_COMPARE(MeshTools::interleaveInto(data, 5,
+        std::vector<Byte>{0, 1, 2},
+        std::vector<Short>{3, 4, 5}), std::size_t(0));
+    CORRADE_COMPARE(ss.str(), "MeshTools::interleaveInto(): stride 2 is too small, expected at least 3\n"
+                              "MeshTools::interleaveInto(): output size 12 is too small, expected at least 15\n");
+}
+
+void InterleaveTest::writeIntoRuntime() {
+    const std::vector<Short> shorts{3, 4, 5};
+    const Byte bytes[]{0, 10, 1, 11, 2, 12};
+
+    char data[15];
+    std::fill_n(data, 15, 0x7f);
+    CORRADE_COMPARE(MeshTools::interleaveInto(data, 5, {
+        MeshTools::InterleavedAttribute(shorts, 2),
+        MeshTools::InterleavedAttribute(bytes, 3, 1, 0, 2)}), std::size_t(3));
+
+    if(!Utility::Endianness::isBigEndian()) {
+        CORRADE_COMPARE(std::vector<char>(data, data + 15), (std::vector<char>{
+            0x00, 0x7f, 0x03, 0x00, 0x7f,
+            0x01, 0x7f, 0x04, 0x00, 0x7f,
+            0x02, 0x7f, 0x05, 0x00, 0x7f
+        }));
+    } else {
+        CORRADE_COMPARE(std::vector<char>(data, data + 15), (std::vector<char>{
+            0x00, 0x7f, 0x00, 0x03, 0x7f,
+            0x01, 0x7f, 0x00, 0x04, 0x7f,
+            0x02, 0x7f, 0x00, 0x05, 0x7f
+        }));
+    }
+}
+
+void InterleaveTest::writeIntoRuntimeInvalid() {
+    std::stringstream ss;
+    Error::setOutput(&ss);
+
+    const std::vector<Short> shorts{3, 4, 5};
+    const std::vector<Byte> bytes{0, 1};
+    char data[12];
+    CORRADE_COMPARE(MeshTools::interleaveInto(data, 4, {
+        MeshTools::InterleavedAttribute(shorts, 0),
+        MeshTools::InterleavedAttribute(bytes, 2)}), std::size_t(0));
+    CORRADE_COMPARE(MeshTools::interleaveInto(data, 4, {
+        MeshTools::InterleavedAttribute(shorts, 3)}), std::size_t(0));
+    CORRADE_COMPARE(MeshTools::interleaveInto(data, 5, {
+        MeshTools::InterleavedAttribute(shorts, 0)}), std::size_t(0));
+    CORRADE_COMPARE(ss.str(), "MeshTools::interleaveInto(): attribute arrays don't have the same length, expected 3 but got 2\n"
+                              "MeshTools::interleaveInto(): attribute at offset 3 with size 2 doesn't fit into stride 4\n"
+                              "MeshTools::interleaveInto(): output size 12 is too small, expected at least 15\n");
+}
+
 }}}
 
 CORRADE_TEST_MAIN(Magnum::MeshTools::Test::InterleaveTest)
@@ -0,0 +1,103 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <sstream>
+#include <TestSuite/Tester.h>
+
+#include "Math/Vector3.h"
+#include "MeshTools/OptimizeOverdraw.h"
+
+namespace Magnum { namespace MeshTools { namespace Test {
+
+class OptimizeOverdrawTest: public TestSuite::Tester {
+    public:
+        OptimizeOverdrawTest();
+
+        void wrongIndexCount();
+        void optimize();
+        void singleCluster();
+};
+
+OptimizeOverdrawTest::OptimizeOverdrawTest() {
+    addTests({&OptimizeOverdrawTest::wrongIndexCount,
+              &OptimizeOverdrawTest::optimize,
+              &OptimizeOverdrawTest::singleCluster});
+}
+
+void OptimizeOverdrawTest::wrongIndexCount() {
+    std::stringstream ss;
+    Error::setOutput(&ss);
+    std::vector<UnsignedInt> indices{0, 1};
+    MeshTools::optimizeOverdraw(indices, {{}, {}}, 16);
+
+    CORRADE_COMPARE(indices, (std::vector<UnsignedInt>{0, 1}));
+    CORRADE_COMPARE(ss.str(), "MeshTools::optimizeOverdraw(): index count is not divisible by 3!\n");
+}
+
+void OptimizeOverdrawTest::optimize() {
+    /* Two disconnected triangles, both facing +Z. The first one is facing
+       towards mesh centroid, so it should be drawn last. */
+    std::vector<UnsignedInt> indices{
+        0, 1, 2,
+        3, 4, 5
+    };
+    MeshTools::optimizeOverdraw(indices, {
+        {0.0f, 0.0f, -1.0f},
+        {1.0f, 0.0f, -1.0f},
+        {0.0f, 1.0f, -1.0f},
+
+        {0.0f, 0.0f, 1.0f},
+        {1.0f, 0.0f, 1.0f},
+        {0.0f, 1.0f, 1.0f}
+    }, 16);
+
+    CORRADE_COMPARE(indices, (std::vector<UnsignedInt>{
+        3, 4, 5,
+        0, 1, 2
+    }));
+}
+
+void OptimizeOverdrawTest::singleCluster() {
+    /* Second triangle shares vertices with the first, reordering would make
+       vertex cache usage worse */
+    std::vector<UnsignedInt> indices{
+        0, 1, 2,
+        2, 1, 3
+    };
+    MeshTools::optimizeOverdraw(indices, {
+        {0.0f, 0.0f, -1.0f},
+        {1.0f, 0.0f, -1.0f},
+        {0.0f, 1.0f, -1.0f},
+        {1.0f, 1.0f, 1.0f}
+    }, 16);
+
+    CORRADE_COMPARE(indices, (std::vector<UnsignedInt>{
+        0, 1, 2,
+        2, 1, 3
+    }));
+}
+
+}}}
+
+CORRADE_TEST_MAIN(Magnum::MeshTools::Test::OptimizeOverdrawTest)
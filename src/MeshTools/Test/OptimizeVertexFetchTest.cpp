@@ -0,0 +1,91 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <sstream>
+#include <TestSuite/Tester.h>
+
+#include "Math/Vector2.h"
+#include "MeshTools/OptimizeVertexFetch.h"
+
+namespace Magnum { namespace MeshTools { namespace Test {
+
+class OptimizeVertexFetchTest: public TestSuite::Tester {
+    public:
+        OptimizeVertexFetchTest();
+
+        void wrongAttributeCount();
+        void optimize();
+        void optimizeNoAttributes();
+};
+
+OptimizeVertexFetchTest::OptimizeVertexFetchTest() {
+    addTests({&OptimizeVertexFetchTest::wrongAttributeCount,
+              &OptimizeVertexFetchTest::optimize,
+              &OptimizeVertexFetchTest::optimizeNoAttributes});
+}
+
+void OptimizeVertexFetchTest::wrongAttributeCount() {
+    std::stringstream ss;
+    Error::setOutput(&ss);
+    std::vector<UnsignedInt> indices{0, 1, 2};
+    std::vector<UnsignedInt> a{0, 1, 2};
+    std::vector<UnsignedInt> b{0, 1};
+    CORRADE_COMPARE(MeshTools::optimizeVertexFetch(indices, a, b), 0);
+
+    CORRADE_COMPARE(indices, (std::vector<UnsignedInt>{0, 1, 2}));
+    CORRADE_COMPARE(ss.str(), "MeshTools::optimizeVertexFetch(): attribute arrays don't have the same length, nothing done.\n");
+}
+
+void OptimizeVertexFetchTest::optimize() {
+    std::vector<UnsignedInt> indices{
+        4, 2, 0,
+        2, 4, 5,
+        0, 5, 4
+    };
+
+    /* Vertex 1 and 3 are not used */
+    std::vector<UnsignedInt> a{10, 11, 12, 13, 14, 15};
+    std::vector<Vector2> b{{0.0f, 0.0f}, {1.0f, 1.0f}, {2.0f, 2.0f},
+                           {3.0f, 3.0f}, {4.0f, 4.0f}, {5.0f, 5.0f}};
+    CORRADE_COMPARE(MeshTools::optimizeVertexFetch(indices, a, b), 4);
+
+    CORRADE_COMPARE(indices, (std::vector<UnsignedInt>{
+        0, 1, 2,
+        1, 0, 3,
+        2, 3, 0
+    }));
+    CORRADE_COMPARE(a, (std::vector<UnsignedInt>{14, 12, 10, 15}));
+    CORRADE_COMPARE(b, (std::vector<Vector2>{{4.0f, 4.0f}, {2.0f, 2.0f},
+                                             {0.0f, 0.0f}, {5.0f, 5.0f}}));
+}
+
+void OptimizeVertexFetchTest::optimizeNoAttributes() {
+    std::vector<UnsignedInt> indices{7, 3, 7, 1};
+    CORRADE_COMPARE(MeshTools::optimizeVertexFetch(indices), 3);
+    CORRADE_COMPARE(indices, (std::vector<UnsignedInt>{0, 1, 0, 2}));
+}
+
+}}}
+
+CORRADE_TEST_MAIN(Magnum::MeshTools::Test::OptimizeVertexFetchTest)
@@ -0,0 +1,150 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <chrono>
+#include <random>
+#include <unordered_map>
+#include <TestSuite/Tester.h>
+#include <Utility/MurmurHash2.h>
+
+#include "Math/Vector3.h"
+#include "MeshTools/RemoveDuplicates.h"
+
+namespace Magnum { namespace MeshTools { namespace Test {
+
+class RemoveDuplicatesBenchmark: public TestSuite::Tester {
+    public:
+        RemoveDuplicatesBenchmark();
+
+        void multiPass();
+        void singlePass();
+
+    private:
+        std::vector<UnsignedInt> indices;
+        std::vector<Vector3> positions;
+};
+
+namespace {
+    enum: UnsignedInt { GridSize = 256 };
+    constexpr Float Epsilon = 1.0e-4f;
+
+    typedef std::chrono::high_resolution_clock Clock;
+
+    /* Previous implementation, doing vertexSize+1 passes over the data, each
+       with different offset of the grid */
+    class IndexHash {
+        public:
+            std::size_t operator()(const Math::Vector<3, std::size_t>& data) const {
+                return *reinterpret_cast<const std::size_t*>(Utility::MurmurHash2()(reinterpret_cast<const char*>(&data), sizeof(data)).byteArray());
+            }
+    };
+
+    struct HashedVertex {
+        UnsignedInt oldIndex, newIndex;
+
+        HashedVertex(UnsignedInt oldIndex, UnsignedInt newIndex): oldIndex(oldIndex), newIndex(newIndex) {}
+    };
+
+    void removeDuplicatesMultiPass(std::vector<UnsignedInt>& indices, std::vector<Vector3>& vertices, Float epsilon) {
+        Vector3 min = vertices[0], max = vertices[0];
+        for(const auto& v: vertices) {
+            min = Math::min(v, min);
+            max = Math::max(v, max);
+        }
+
+        epsilon = Math::max(epsilon, Float((max-min).max()/std::numeric_limits<std::size_t>::max()));
+
+        Vector3 moved;
+        for(std::size_t moving = 0; moving <= 3; ++moving) {
+            std::unordered_map<Math::Vector<3, std::size_t>, HashedVertex, IndexHash> table;
+            table.reserve(vertices.size());
+
+            for(auto it = indices.begin(); it != indices.end(); ++it) {
+                std::size_t index[3];
+                for(std::size_t ii = 0; ii != 3; ++ii)
+                    index[ii] = std::size_t((vertices[*it][ii]+moved[ii]-min[ii])/epsilon);
+
+                HashedVertex v(*it, table.size());
+                auto result = table.insert({Math::Vector<3, std::size_t>::from(index), v});
+                *it = result.first->second.newIndex;
+            }
+
+            std::vector<Vector3> newVertices(table.size());
+            for(auto it = table.cbegin(); it != table.cend(); ++it)
+                newVertices[it->second.newIndex] = vertices[it->second.oldIndex];
+            std::swap(newVertices, vertices);
+
+            if(moving != 3) {
+                moved = Vector3();
+                moved[moving] = epsilon/2;
+            }
+        }
+    }
+}
+
+RemoveDuplicatesBenchmark::RemoveDuplicatesBenchmark() {
+    addTests({&RemoveDuplicatesBenchmark::multiPass,
+              &RemoveDuplicatesBenchmark::singlePass});
+
+    /* Non-indexed triangulated grid with slightly jittered positions, similar
+       to what comes out of scanning software */
+    std::mt19937 random;
+    std::uniform_real_distribution<Float> jitter(-Epsilon/4, Epsilon/4);
+    for(UnsignedInt y = 0; y != GridSize; ++y) for(UnsignedInt x = 0; x != GridSize; ++x) {
+        const Vector3 a(Float(x), Float(y), 0.0f);
+        for(const Vector3& v: {a, a + Vector3::xAxis(), a + Vector3(1.0f, 1.0f, 0.0f),
+                               a, a + Vector3(1.0f, 1.0f, 0.0f), a + Vector3::yAxis()}) {
+            indices.push_back(positions.size());
+            positions.push_back(v + Vector3(jitter(random), jitter(random), jitter(random)));
+        }
+    }
+}
+
+void RemoveDuplicatesBenchmark::multiPass() {
+    std::vector<UnsignedInt> resultIndices = indices;
+    std::vector<Vector3> resultPositions = positions;
+
+    const auto begin = Clock::now();
+    removeDuplicatesMultiPass(resultIndices, resultPositions, Epsilon);
+    const Double time = std::chrono::duration<Double>(Clock::now() - begin).count();
+
+    Debug() << "Multi-pass removal of" << positions.size() << "vertices:" << time << "s, vertices per second:" << positions.size()/time;
+    Debug() << "Unique vertices:" << resultPositions.size();
+}
+
+void RemoveDuplicatesBenchmark::singlePass() {
+    std::vector<UnsignedInt> resultIndices = indices;
+    std::vector<Vector3> resultPositions = positions;
+
+    const auto begin = Clock::now();
+    MeshTools::removeDuplicates(resultIndices, resultPositions, Epsilon);
+    const Double time = std::chrono::duration<Double>(Clock::now() - begin).count();
+
+    Debug() << "Single-pass removal of" << positions.size() << "vertices:" << time << "s, vertices per second:" << positions.size()/time;
+    Debug() << "Unique vertices:" << resultPositions.size();
+}
+
+}}}
+
+CORRADE_TEST_MAIN(Magnum::MeshTools::Test::RemoveDuplicatesBenchmark)
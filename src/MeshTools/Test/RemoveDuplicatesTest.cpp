@@ -22,8 +22,10 @@
     DEALINGS IN THE SOFTWARE.
 */
 
+#include <random>
 #include <TestSuite/Tester.h>
 
+#include "Math/Vector3.h"
 #include "MeshTools/RemoveDuplicates.h"
 
 namespace Magnum { namespace MeshTools { namespace Test {
@@ -33,12 +35,24 @@ class RemoveDuplicatesTest: public TestSuite::Tester {
         RemoveDuplicatesTest();
 
         void cleanMesh();
+        void cleanMeshJittered();
+        void findDuplicates();
+        void findDuplicatesNeighborCell();
+        void findDuplicatesEmpty();
+        void findDuplicatesZeroEpsilon();
+        void remapVertices();
 };
 
 typedef Math::Vector<1, int> Vector1;
 
 RemoveDuplicatesTest::RemoveDuplicatesTest() {
-    addTests({&RemoveDuplicatesTest::cleanMesh});
+    addTests({&RemoveDuplicatesTest::cleanMesh,
+              &RemoveDuplicatesTest::cleanMeshJittered,
+              &RemoveDuplicatesTest::findDuplicates,
+              &RemoveDuplicatesTest::findDuplicatesNeighborCell,
+              &RemoveDuplicatesTest::findDuplicatesEmpty,
+              &RemoveDuplicatesTest::findDuplicatesZeroEpsilon,
+              &RemoveDuplicatesTest::remapVertices});
 }
 
 void RemoveDuplicatesTest::cleanMesh() {
@@ -51,6 +65,94 @@ void RemoveDuplicatesTest::cleanMesh() {
     CORRADE_COMPARE(indices, (std::vector<UnsignedInt>{0, 1, 0, 1, 0, 2}));
 }
 
+void RemoveDuplicatesTest::cleanMeshJittered() {
+    /* Non-indexed triangulated grid with slightly jittered positions, similar
+       to what comes out of scanning software */
+    std::mt19937 random;
+    std::uniform_real_distribution<Float> jitter(-0.25e-4f, 0.25e-4f);
+    std::vector<UnsignedInt> indices;
+    std::vector<Vector3> positions;
+    for(UnsignedInt y = 0; y != 16; ++y) for(UnsignedInt x = 0; x != 16; ++x) {
+        const Vector3 a(Float(x), Float(y), 0.0f);
+        for(const Vector3& v: {a, a + Vector3::xAxis(), a + Vector3(1.0f, 1.0f, 0.0f),
+                               a, a + Vector3(1.0f, 1.0f, 0.0f), a + Vector3::yAxis()}) {
+            indices.push_back(positions.size());
+            positions.push_back(v + Vector3(jitter(random), jitter(random), jitter(random)));
+        }
+    }
+
+    MeshTools::removeDuplicates(indices, positions, 1.0e-4f);
+
+    /* All duplicates are found */
+    CORRADE_COMPARE(positions.size(), 17*17);
+    CORRADE_COMPARE(indices.size(), 16*16*6);
+}
+
+void RemoveDuplicatesTest::findDuplicates() {
+    std::vector<UnsignedInt> remap;
+    std::size_t uniqueCount;
+    std::tie(remap, uniqueCount) = MeshTools::findDuplicates(std::vector<Vector3>{
+        {1.0f, 0.0f, 0.0f},
+        {0.0f, 1.0f, 0.0f},
+        {1.0f, 0.0f, 0.0f},
+        {0.0f, 1.05f, 0.0f},
+        {0.0f, 1.15f, 0.0f}
+    }, 0.1f);
+
+    CORRADE_COMPARE(uniqueCount, 3);
+    CORRADE_COMPARE(remap, (std::vector<UnsignedInt>{0, 1, 0, 1, 2}));
+}
+
+void RemoveDuplicatesTest::findDuplicatesNeighborCell() {
+    /* Cell size is 0.2, the vertices are in different cells, but still near
+       enough */
+    std::vector<UnsignedInt> remap;
+    std::size_t uniqueCount;
+    std::tie(remap, uniqueCount) = MeshTools::findDuplicates(std::vector<Vector3>{
+        {0.0f, 0.0f, 0.0f},
+        {0.39f, 0.39f, 0.39f},
+        {0.41f, 0.41f, 0.41f}
+    }, 0.1f);
+
+    CORRADE_COMPARE(uniqueCount, 2);
+    CORRADE_COMPARE(remap, (std::vector<UnsignedInt>{0, 1, 1}));
+}
+
+void RemoveDuplicatesTest::findDuplicatesEmpty() {
+    std::vector<UnsignedInt> remap;
+    std::size_t uniqueCount;
+    std::tie(remap, uniqueCount) = MeshTools::findDuplicates(std::vector<Vector3>{});
+
+    CORRADE_COMPARE(uniqueCount, 0);
+    CORRADE_VERIFY(remap.empty());
+}
+
+void RemoveDuplicatesTest::findDuplicatesZeroEpsilon() {
+    /* All vertices in one point, the cell size can't be derived from
+       epsilon nor from the bounds. No vertices are nearer than zero. */
+    std::vector<UnsignedInt> remap;
+    std::size_t uniqueCount;
+    std::tie(remap, uniqueCount) = MeshTools::findDuplicates(std::vector<Vector3>{
+        {1.0f, 2.0f, 3.0f},
+        {1.0f, 2.0f, 3.0f},
+        {1.0f, 2.0f, 3.0f}
+    }, 0.0f);
+
+    CORRADE_COMPARE(uniqueCount, 3);
+    CORRADE_COMPARE(remap, (std::vector<UnsignedInt>{0, 1, 2}));
+}
+
+void RemoveDuplicatesTest::remapVertices() {
+    std::vector<UnsignedInt> indices{0, 1, 2, 2, 3, 0};
+    std::vector<Vector1> positions{1, 2, 1, 3};
+    std::vector<UnsignedInt> colors{10, 11, 12, 13};
+    MeshTools::remapVertices(indices, {0, 1, 0, 2}, 3, positions, colors);
+
+    CORRADE_COMPARE(indices, (std::vector<UnsignedInt>{0, 1, 0, 0, 2, 0}));
+    CORRADE_VERIFY(positions == (std::vector<Vector1>{1, 2, 3}));
+    CORRADE_COMPARE(colors, (std::vector<UnsignedInt>{10, 11, 13}));
+}
+
 }}}
 
 CORRADE_TEST_MAIN(Magnum::MeshTools::Test::RemoveDuplicatesTest)
@@ -0,0 +1,231 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <algorithm>
+#include <cmath>
+#include <sstream>
+#include <TestSuite/Tester.h>
+
+#include "Math/Vector3.h"
+#include "MeshTools/Simplify.h"
+#include "MeshTools/Subdivide.h"
+
+namespace Magnum { namespace MeshTools { namespace Test {
+
+class SimplifyTest: public TestSuite::Tester {
+    public:
+        SimplifyTest();
+
+        void wrongIndexCount();
+        void planar();
+        void boundary();
+        void boundaryStrip();
+        void seam();
+        void chain();
+        void targetError();
+};
+
+namespace {
+
+/* Planar grid in XY plane, optionally with vertices duplicated along one
+   column */
+void grid(std::vector<UnsignedInt>& indices, std::vector<Vector3>& positions, const UnsignedInt size, const UnsignedInt seam = ~UnsignedInt(0)) {
+    for(UnsignedInt y = 0; y <= size; ++y) for(UnsignedInt x = 0; x <= size; ++x)
+        positions.push_back({Float(x), Float(y), 0.0f});
+
+    std::vector<UnsignedInt> seamVertices;
+    if(seam != ~UnsignedInt(0)) for(UnsignedInt y = 0; y <= size; ++y) {
+        seamVertices.push_back(positions.size());
+        positions.push_back({Float(seam), Float(y), 0.0f});
+    }
+
+    for(UnsignedInt y = 0; y != size; ++y) for(UnsignedInt x = 0; x != size; ++x) {
+        UnsignedInt i = y*(size + 1) + x;
+        UnsignedInt quad[]{i, i + 1, i + size + 2, i + size + 1};
+
+        /* Quads right of the seam use the duplicated vertices */
+        if(x == seam) {
+            quad[0] = seamVertices[y];
+            quad[3] = seamVertices[y + 1];
+        }
+
+        indices.insert(indices.end(), {quad[0], quad[1], quad[2], quad[0], quad[2], quad[3]});
+    }
+}
+
+Float area(const std::vector<UnsignedInt>& indices, const std::vector<Vector3>& positions) {
+    Float area = 0.0f;
+    for(std::size_t i = 0; i != indices.size(); i += 3)
+        area += Vector3::cross(positions[indices[i + 1]] - positions[indices[i]],
+                               positions[indices[i + 2]] - positions[indices[i]]).z()*0.5f;
+    return area;
+}
+
+}
+
+SimplifyTest::SimplifyTest() {
+    addTests({&SimplifyTest::wrongIndexCount,
+              &SimplifyTest::planar,
+              &SimplifyTest::boundary,
+              &SimplifyTest::boundaryStrip,
+              &SimplifyTest::seam,
+              &SimplifyTest::chain,
+              &SimplifyTest::targetError});
+}
+
+void SimplifyTest::wrongIndexCount() {
+    std::stringstream ss;
+    Error::setOutput(&ss);
+
+    CORRADE_VERIFY(MeshTools::simplify({0, 1}, {}, 0).empty());
+    CORRADE_COMPARE(ss.str(), "MeshTools::simplifyChain(): index count is not divisible by 3!\n");
+}
+
+void SimplifyTest::planar() {
+    std::vector<UnsignedInt> indices;
+    std::vector<Vector3> positions;
+    grid(indices, positions, 16);
+
+    /* Flat surface with straight boundary can be simplified without any
+       error down to two triangles, faces aren't flipped */
+    const std::vector<UnsignedInt> simplified = MeshTools::simplify(indices, positions, 0, 1.0e-4f);
+    CORRADE_COMPARE(simplified.size(), 6);
+    CORRADE_COMPARE(area(simplified, positions), 256.0f);
+}
+
+void SimplifyTest::boundary() {
+    std::vector<UnsignedInt> indices;
+    std::vector<Vector3> positions;
+    grid(indices, positions, 8);
+
+    /* Move one boundary vertex out of line, it must stay there */
+    positions[4] = {4.0f, -1.0f, 0.0f};
+
+    const std::vector<UnsignedInt> simplified = MeshTools::simplify(indices, positions, 0, 1.0e-4f);
+    CORRADE_VERIFY(simplified.size() < indices.size()/4);
+    CORRADE_VERIFY(std::find(simplified.begin(), simplified.end(), 4) != simplified.end());
+    CORRADE_COMPARE(area(simplified, positions), area(indices, positions));
+}
+
+void SimplifyTest::boundaryStrip() {
+    /* Narrow wavy strip with two rows of vertices, all of them on the
+       boundary. Collapses create new edges across the strip, if they were
+       treated as boundary edges, the strip would get pinched. */
+    std::vector<UnsignedInt> indices;
+    std::vector<Vector3> positions;
+    for(UnsignedInt y = 0; y != 2; ++y) for(UnsignedInt x = 0; x <= 32; ++x)
+        positions.push_back({Float(x), y*0.1f, 0.5f*std::sin(Float(x))});
+    for(UnsignedInt x = 0; x != 32; ++x)
+        indices.insert(indices.end(), {x, x + 1, x + 34, x, x + 34, x + 33});
+
+    for(std::size_t targetIndexCount = indices.size(); targetIndexCount >= 6; targetIndexCount -= 6) {
+        const std::vector<UnsignedInt> simplified = MeshTools::simplify(indices, positions, targetIndexCount);
+
+        std::vector<std::pair<UnsignedInt, UnsignedInt>> edges;
+        for(std::size_t i = 0; i != simplified.size(); i += 3) for(std::size_t j = 0; j != 3; ++j)
+            edges.push_back(std::minmax(simplified[i + j], simplified[i + (j + 1)%3]));
+        std::sort(edges.begin(), edges.end());
+
+        /* Edges used by one face only are on the boundary, no vertex can have
+           more than two of them */
+        std::vector<UnsignedInt> boundaryEdgeCount(positions.size());
+        for(std::size_t i = 0; i != edges.size(); ++i) {
+            if((i && edges[i - 1] == edges[i]) || (i + 1 != edges.size() && edges[i + 1] == edges[i])) continue;
+            ++boundaryEdgeCount[edges[i].first];
+            ++boundaryEdgeCount[edges[i].second];
+        }
+        CORRADE_VERIFY(*std::max_element(boundaryEdgeCount.begin(), boundaryEdgeCount.end()) <= 2);
+    }
+}
+
+void SimplifyTest::seam() {
+    std::vector<UnsignedInt> indices;
+    std::vector<Vector3> positions;
+    grid(indices, positions, 8, 4);
+
+    /* All vertices on the seam stay */
+    const std::vector<UnsignedInt> simplified = MeshTools::simplify(indices, positions, 0, 1.0e-4f);
+    CORRADE_VERIFY(simplified.size() < indices.size()/2);
+    for(UnsignedInt y = 0; y <= 8; ++y) {
+        CORRADE_VERIFY(std::find(simplified.begin(), simplified.end(), y*9 + 4) != simplified.end());
+        CORRADE_VERIFY(std::find(simplified.begin(), simplified.end(), 81 + y) != simplified.end());
+    }
+    CORRADE_COMPARE(area(simplified, positions), 64.0f);
+}
+
+void SimplifyTest::chain() {
+    /* Sphere subdivided from octahedron */
+    std::vector<UnsignedInt> indices{
+        0, 2, 4, 2, 1, 4, 1, 3, 4, 3, 0, 4,
+        2, 0, 5, 1, 2, 5, 3, 1, 5, 0, 3, 5
+    };
+    std::vector<Vector3> positions{
+        Vector3::xAxis(), -Vector3::xAxis(),
+        Vector3::yAxis(), -Vector3::yAxis(),
+        Vector3::zAxis(), -Vector3::zAxis()
+    };
+    MeshTools::subdivideShared(indices, positions, 4, [](const Vector3& a, const Vector3& b) {
+        return (a+b).normalized();
+    });
+    CORRADE_COMPARE(indices.size(), 6144);
+
+    const std::vector<std::vector<UnsignedInt>> levels = MeshTools::simplifyChain(indices, positions, {3072, 768, 96});
+    CORRADE_COMPARE(levels.size(), 3);
+    CORRADE_COMPARE(levels[0].size(), 3072);
+    CORRADE_COMPARE(levels[1].size(), 768);
+    CORRADE_COMPARE(levels[2].size(), 96);
+
+    /* No degenerate or flipped faces */
+    for(const std::vector<UnsignedInt>& level: levels) {
+        for(std::size_t i = 0; i != level.size(); i += 3) {
+            const Vector3 center = positions[level[i]] + positions[level[i + 1]] + positions[level[i + 2]];
+            const Vector3 normal = Vector3::cross(positions[level[i + 1]] - positions[level[i]],
+                                                  positions[level[i + 2]] - positions[level[i]]);
+            CORRADE_VERIFY(Vector3::dot(center, normal) > 0.0f);
+        }
+    }
+
+    /* The same as separate call */
+    CORRADE_COMPARE(MeshTools::simplify(indices, positions, 768), levels[1]);
+}
+
+void SimplifyTest::targetError() {
+    std::vector<UnsignedInt> indices{
+        0, 2, 4, 2, 1, 4, 1, 3, 4, 3, 0, 4,
+        2, 0, 5, 1, 2, 5, 3, 1, 5, 0, 3, 5
+    };
+    std::vector<Vector3> positions{
+        Vector3::xAxis(), -Vector3::xAxis(),
+        Vector3::yAxis(), -Vector3::yAxis(),
+        Vector3::zAxis(), -Vector3::zAxis()
+    };
+
+    /* Every collapse on octahedron has nonzero error */
+    CORRADE_COMPARE(MeshTools::simplify(indices, positions, 0, 1.0e-4f), indices);
+    CORRADE_VERIFY(MeshTools::simplify(indices, positions, 0).size() < indices.size());
+}
+
+}}}
+
+CORRADE_TEST_MAIN(Magnum::MeshTools::Test::SimplifyTest)
@@ -36,6 +36,9 @@ class SubdivideTest: public TestSuite::Tester {
 
         void wrongIndexCount();
         void subdivide();
+        void subdivideSharedWrongIndexCount();
+        void subdivideShared();
+        void subdivideSharedLevels();
 };
 
 namespace {
@@ -48,7 +51,10 @@ inline Vector1 interpolator(Vector1 a, Vector1 b) { return (a[0]+b[0])/2; }
 
 SubdivideTest::SubdivideTest() {
     addTests({&SubdivideTest::wrongIndexCount,
-              &SubdivideTest::subdivide});
+              &SubdivideTest::subdivide,
+              &SubdivideTest::subdivideSharedWrongIndexCount,
+              &SubdivideTest::subdivideShared,
+              &SubdivideTest::subdivideSharedLevels});
 }
 
 void SubdivideTest::wrongIndexCount() {
@@ -77,6 +83,46 @@ void SubdivideTest::subdivide() {
     CORRADE_COMPARE(positions.size(), 9);
 }
 
+void SubdivideTest::subdivideSharedWrongIndexCount() {
+    std::stringstream ss;
+    Error::setOutput(&ss);
+
+    std::vector<Vector1> positions;
+    std::vector<UnsignedInt> indices{0, 1};
+    MeshTools::subdivideShared(indices, positions, 1, interpolator);
+    CORRADE_COMPARE(ss.str(), "MeshTools::subdivideShared(): index count is not divisible by 3!\n");
+}
+
+void SubdivideTest::subdivideShared() {
+    std::vector<Vector1> positions{0, 2, 6, 8};
+    std::vector<UnsignedInt> indices{0, 1, 2, 1, 2, 3};
+    MeshTools::subdivideShared(indices, positions, 1, interpolator);
+
+    /* Midpoint of shared edge 1-2 is created only once */
+    CORRADE_VERIFY(positions == (std::vector<Vector1>{0, 2, 6, 8, 1, 4, 3, 7, 5}));
+    CORRADE_COMPARE(indices, (std::vector<UnsignedInt>{4, 5, 6, 5, 7, 8, 0, 4, 6, 4, 1, 5, 6, 5, 2, 1, 5, 8, 5, 2, 7, 8, 7, 3}));
+}
+
+void SubdivideTest::subdivideSharedLevels() {
+    std::vector<Vector1> positions{0, 16, 48, 64};
+    std::vector<UnsignedInt> indices{0, 1, 2, 1, 2, 3};
+    MeshTools::subdivideShared(indices, positions, 2, interpolator);
+
+    /* Two levels in one call are the same as two separate calls */
+    std::vector<Vector1> positions2{0, 16, 48, 64};
+    std::vector<UnsignedInt> indices2{0, 1, 2, 1, 2, 3};
+    MeshTools::subdivideShared(indices2, positions2, 1, interpolator);
+    MeshTools::subdivideShared(indices2, positions2, 1, interpolator);
+
+    CORRADE_COMPARE(indices.size(), 96);
+    CORRADE_COMPARE(indices, indices2);
+    CORRADE_VERIFY(positions == positions2);
+
+    /* Planar mesh of two triangles: 4 + 5 vertices after first level, 16
+       edges subdivided in second level */
+    CORRADE_COMPARE(positions.size(), 25);
+}
+
 }}}
 
 CORRADE_TEST_MAIN(Magnum::MeshTools::Test::SubdivideTest)
@@ -0,0 +1,148 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <algorithm>
+#include <chrono>
+#include <random>
+#include <thread>
+#include <TestSuite/Tester.h>
+
+#include "Magnum.h"
+#include "MeshTools/Tipsify.h"
+
+namespace Magnum { namespace MeshTools { namespace Test {
+
+class TipsifyBenchmark: public TestSuite::Tester {
+    public:
+        TipsifyBenchmark();
+
+        void acmr();
+        void trianglesPerSecond();
+        void parallel();
+
+    private:
+        std::vector<UnsignedInt> indices;
+        UnsignedInt vertexCount;
+};
+
+namespace {
+    enum: UnsignedInt { GridSize = 256 };
+    enum: std::size_t { CacheSize = 24, Repeats = 5, ClusterSize = 16384 };
+
+    /* Average cache miss ratio, simulating FIFO cache of given size */
+    Float averageCacheMissRatio(const std::vector<UnsignedInt>& indices, UnsignedInt vertexCount, std::size_t cacheSize) {
+        std::vector<UnsignedInt> timestamp(vertexCount);
+        UnsignedInt time = cacheSize+1;
+        std::size_t misses = 0;
+        for(UnsignedInt v: indices) if(time-timestamp[v] > cacheSize) {
+            timestamp[v] = time++;
+            ++misses;
+        }
+
+        return Float(misses)/(indices.size()/3);
+    }
+}
+
+TipsifyBenchmark::TipsifyBenchmark(): vertexCount((GridSize+1)*(GridSize+1)) {
+    addTests({&TipsifyBenchmark::acmr,
+              &TipsifyBenchmark::trianglesPerSecond,
+              &TipsifyBenchmark::parallel});
+
+    /* Triangulated grid with triangles in random order, similar to what
+       comes out of scanning software */
+    std::vector<UnsignedInt> grid;
+    grid.reserve(GridSize*GridSize*6);
+    for(UnsignedInt y = 0; y != GridSize; ++y) for(UnsignedInt x = 0; x != GridSize; ++x) {
+        const UnsignedInt i = y*(GridSize+1)+x;
+        grid.insert(grid.end(), {i, i+1, i+GridSize+2,
+                                 i, i+GridSize+2, i+GridSize+1});
+    }
+
+    std::vector<UnsignedInt> triangles(grid.size()/3);
+    for(std::size_t i = 0; i != triangles.size(); ++i) triangles[i] = i;
+    std::shuffle(triangles.begin(), triangles.end(), std::mt19937());
+
+    indices.reserve(grid.size());
+    for(UnsignedInt t: triangles)
+        indices.insert(indices.end(), {grid[t*3], grid[t*3+1], grid[t*3+2]});
+}
+
+void TipsifyBenchmark::acmr() {
+    std::vector<UnsignedInt> optimized = indices;
+    MeshTools::tipsify(optimized, vertexCount, CacheSize);
+
+    const Float before = averageCacheMissRatio(indices, vertexCount, CacheSize);
+    const Float after = averageCacheMissRatio(optimized, vertexCount, CacheSize);
+    Debug() << "ACMR for" << indices.size()/3 << "triangles and cache size" << CacheSize << "before:" << before << "after:" << after;
+}
+
+void TipsifyBenchmark::trianglesPerSecond() {
+    typedef std::chrono::high_resolution_clock Clock;
+
+    /* Allocating all scratch memory on each call */
+    Clock::duration allocating{};
+    for(std::size_t i = 0; i != Repeats; ++i) {
+        std::vector<UnsignedInt> optimized = indices;
+        const auto begin = Clock::now();
+        MeshTools::tipsify(optimized, vertexCount, CacheSize);
+        allocating += Clock::now() - begin;
+    }
+
+    /* Reusing the workspace */
+    TipsifyWorkspace workspace;
+    Clock::duration reusing{};
+    for(std::size_t i = 0; i != Repeats; ++i) {
+        std::vector<UnsignedInt> optimized = indices;
+        const auto begin = Clock::now();
+        MeshTools::tipsify(optimized, vertexCount, CacheSize, workspace);
+        reusing += Clock::now() - begin;
+    }
+
+    const Double triangles = Double(Repeats*indices.size()/3);
+    Debug() << "Triangles per second with allocation:" << triangles/std::chrono::duration<Double>(allocating).count();
+    Debug() << "Triangles per second with reused workspace:" << triangles/std::chrono::duration<Double>(reusing).count();
+}
+
+void TipsifyBenchmark::parallel() {
+    typedef std::chrono::high_resolution_clock Clock;
+
+    std::vector<UnsignedInt> serial = indices;
+    auto begin = Clock::now();
+    MeshTools::tipsify(serial, vertexCount, CacheSize);
+    const Double serialTime = std::chrono::duration<Double>(Clock::now() - begin).count();
+
+    std::vector<UnsignedInt> parallel = indices;
+    begin = Clock::now();
+    MeshTools::parallelTipsify(parallel, vertexCount, CacheSize, ClusterSize);
+    const Double parallelTime = std::chrono::duration<Double>(Clock::now() - begin).count();
+
+    const Float serialAcmr = averageCacheMissRatio(serial, vertexCount, CacheSize);
+    const Float parallelAcmr = averageCacheMissRatio(parallel, vertexCount, CacheSize);
+    Debug() << "Serial ACMR:" << serialAcmr << "time:" << serialTime << "s";
+    Debug() << "Parallel ACMR with cluster size" << ClusterSize << "on" << std::thread::hardware_concurrency() << "threads:" << parallelAcmr << "time:" << parallelTime << "s";
+}
+
+}}}
+
+CORRADE_TEST_MAIN(Magnum::MeshTools::Test::TipsifyBenchmark)
@@ -22,6 +22,8 @@
     DEALINGS IN THE SOFTWARE.
 */
 
+#include <algorithm>
+#include <random>
 #include <TestSuite/Tester.h>
 
 #include "Magnum.h"
@@ -34,7 +36,12 @@ class TipsifyTest: public TestSuite::Tester {
         TipsifyTest();
 
         void buildAdjacency();
+        void buildClusters();
+        void parallelTipsify();
         void tipsify();
+        void tipsifyWorkspace();
+        void tipsifyCacheMissRatio();
+        void parallelTipsifyCacheMissRatio();
 
     private:
         std::vector<UnsignedInt> indices;
@@ -81,7 +88,49 @@ TipsifyTest::TipsifyTest(): indices{
     16, 17, 18
 }, vertexCount(19) {
     addTests({&TipsifyTest::buildAdjacency,
-              &TipsifyTest::tipsify});
+              &TipsifyTest::buildClusters,
+              &TipsifyTest::parallelTipsify,
+              &TipsifyTest::tipsify,
+              &TipsifyTest::tipsifyWorkspace,
+              &TipsifyTest::tipsifyCacheMissRatio,
+              &TipsifyTest::parallelTipsifyCacheMissRatio});
+}
+
+namespace {
+    /* Triangulated grid with triangles in random order, similar to what
+       comes out of scanning software */
+    std::vector<UnsignedInt> shuffledGrid(const UnsignedInt size) {
+        std::vector<UnsignedInt> grid;
+        grid.reserve(size*size*6);
+        for(UnsignedInt y = 0; y != size; ++y) for(UnsignedInt x = 0; x != size; ++x) {
+            const UnsignedInt i = y*(size+1)+x;
+            grid.insert(grid.end(), {i, i+1, i+size+2,
+                                     i, i+size+2, i+size+1});
+        }
+
+        std::vector<UnsignedInt> triangles(grid.size()/3);
+        for(std::size_t i = 0; i != triangles.size(); ++i) triangles[i] = i;
+        std::shuffle(triangles.begin(), triangles.end(), std::mt19937());
+
+        std::vector<UnsignedInt> indices;
+        indices.reserve(grid.size());
+        for(UnsignedInt t: triangles)
+            indices.insert(indices.end(), {grid[t*3], grid[t*3+1], grid[t*3+2]});
+        return indices;
+    }
+
+    /* Average cache miss ratio, simulating FIFO cache of given size */
+    Float averageCacheMissRatio(const std::vector<UnsignedInt>& indices, UnsignedInt vertexCount, std::size_t cacheSize) {
+        std::vector<UnsignedInt> timestamp(vertexCount);
+        UnsignedInt time = cacheSize+1;
+        std::size_t misses = 0;
+        for(UnsignedInt v: indices) if(time-timestamp[v] > cacheSize) {
+            timestamp[v] = time++;
+            ++misses;
+        }
+
+        return Float(misses)/(indices.size()/3);
+    }
 }
 
 void TipsifyTest::buildAdjacency() {
@@ -129,6 +178,57 @@ void TipsifyTest::buildAdjacency() {
     }));
 }
 
+void TipsifyTest::buildClusters() {
+    std::vector<UnsignedInt> order, clusterOffset;
+    Implementation::Tipsify(indices, vertexCount).buildClusters(6, order, clusterOffset);
+
+    CORRADE_COMPARE(order, (std::vector<UnsignedInt>{
+        0, 3, 11, 14, 7, 1,
+        4, 9, 16, 8, 10, 15,
+        17, 6, 5, 12, 2, 13,
+        18 /* not connected, seeded from arbitrary vertex */
+    }));
+
+    CORRADE_COMPARE(clusterOffset, (std::vector<UnsignedInt>{
+        0, 6, 12, 18, 19
+    }));
+}
+
+void TipsifyTest::parallelTipsify() {
+    std::vector<UnsignedInt> serial = indices;
+    MeshTools::parallelTipsify(serial, vertexCount, 3, 6, 1);
+
+    CORRADE_COMPARE(serial, (std::vector<UnsignedInt>{
+        4, 1, 0,
+        9, 5, 4,
+        1, 4, 5,
+        9, 4, 8,
+        2, 1, 5,
+        10, 9, 13,
+
+        12, 9, 8,
+        13, 9, 12,
+        10, 5, 9,
+        10, 6, 5,
+        13, 14, 10,
+        6, 10, 11,
+
+        14, 11, 10,
+        14, 15, 11,
+        11, 7, 6,
+        7, 3, 6,
+        6, 3, 2,
+        6, 2, 5,
+
+        16, 17, 18
+    }));
+
+    /* Result doesn't depend on thread count */
+    std::vector<UnsignedInt> parallel = indices;
+    MeshTools::parallelTipsify(parallel, vertexCount, 3, 6, 3);
+    CORRADE_COMPARE(parallel, serial);
+}
+
 void TipsifyTest::tipsify() {
     MeshTools::tipsify(indices, vertexCount, 3);
 
@@ -155,6 +255,54 @@ void TipsifyTest::tipsify() {
     }));
 }
 
+void TipsifyTest::tipsifyWorkspace() {
+    std::vector<UnsignedInt> expected = indices;
+    MeshTools::tipsify(expected, vertexCount, 3);
+
+    /* First use allocates the memory */
+    TipsifyWorkspace workspace;
+    CORRADE_COMPARE(workspace.size(), 0);
+    std::vector<UnsignedInt> first = indices;
+    MeshTools::tipsify(first, vertexCount, 3, workspace);
+    CORRADE_COMPARE(first, expected);
+    const std::size_t size = workspace.size();
+    CORRADE_VERIFY(size != 0);
+
+    /* Second use reuses it, stale data don't affect the result */
+    std::vector<UnsignedInt> second = indices;
+    MeshTools::tipsify(second, vertexCount, 3, workspace);
+    CORRADE_COMPARE(second, expected);
+    CORRADE_COMPARE(workspace.size(), size);
+}
+
+void TipsifyTest::tipsifyCacheMissRatio() {
+    const std::vector<UnsignedInt> indices = shuffledGrid(64);
+    std::vector<UnsignedInt> optimized = indices;
+    MeshTools::tipsify(optimized, 65*65, 24);
+
+    /* Regular grid can't go below 0.5, random order is near 3 */
+    const Float before = averageCacheMissRatio(indices, 65*65, 24);
+    const Float after = averageCacheMissRatio(optimized, 65*65, 24);
+    CORRADE_VERIFY(after < 0.7f);
+    CORRADE_VERIFY(after < before);
+
+    /* Only the order changed */
+    std::vector<UnsignedInt> sortedIndices = indices;
+    std::sort(sortedIndices.begin(), sortedIndices.end());
+    std::sort(optimized.begin(), optimized.end());
+    CORRADE_VERIFY(optimized == sortedIndices);
+}
+
+void TipsifyTest::parallelTipsifyCacheMissRatio() {
+    std::vector<UnsignedInt> serial = shuffledGrid(64);
+    std::vector<UnsignedInt> parallel = serial;
+    MeshTools::tipsify(serial, 65*65, 24);
+    MeshTools::parallelTipsify(parallel, 65*65, 24, 4096, 2);
+
+    /* Only boundaries of the clusters should be worse */
+    CORRADE_VERIFY(averageCacheMissRatio(parallel, 65*65, 24) < averageCacheMissRatio(serial, 65*65, 24)*1.05f);
+}
+
 }}}
 
 CORRADE_TEST_MAIN(Magnum::MeshTools::Test::TipsifyTest)
@@ -24,49 +24,82 @@
 
 #include "Tipsify.h"
 
-#include <stack>
+#include <algorithm>
+#include <atomic>
+#include <thread>
+#include <Utility/Assert.h>
 
-namespace Magnum { namespace MeshTools { namespace Implementation {
+namespace Magnum { namespace MeshTools {
 
-void Tipsify::operator()(std::size_t cacheSize) {
-    /* Neighboring triangles for each vertex, per-vertex live triangle count */
-    std::vector<UnsignedInt> liveTriangleCount, neighborPosition, neighbors;
-    buildAdjacency(liveTriangleCount, neighborPosition, neighbors);
+TipsifyWorkspace::TipsifyWorkspace() = default;
 
-    /* Global time, per-vertex caching timestamps, per-triangle emmited flag */
-    UnsignedInt time = cacheSize+1;
-    std::vector<UnsignedInt> timestamp(vertexCount);
-    std::vector<bool> emitted(indices.size()/3);
+UnsignedInt* TipsifyWorkspace::reserve(const std::size_t size) {
+    /* Grow only, the contents don't need to be preserved */
+    if(_data.size() < size) _data = Containers::Array<UnsignedInt>(size);
+    return _data.begin();
+}
+
+namespace Implementation {
+
+void Tipsify::operator()(const std::size_t cacheSize) {
+    TipsifyWorkspace workspace;
+    operator()(cacheSize, workspace);
+}
+
+void Tipsify::operator()(const std::size_t cacheSize, TipsifyWorkspace& workspace) {
+    if(indices.empty()) return;
 
-    /* Dead-end vertex stack */
-    std::stack<UnsignedInt> deadEndStack;
+    /* Carve all scratch arrays out of the workspace: per-vertex live triangle
+       count, neighbor offsets and caching timestamps, neighboring triangles
+       for each vertex, per-triangle emmited bits, dead-end vertex stack and
+       output index buffer */
+    const std::size_t triangleCount = indices.size()/3;
+    const std::size_t emittedSize = (triangleCount+31)/32;
+    const std::size_t deadEndStackCapacity = deadEndStackSize(cacheSize);
+    UnsignedInt* const liveTriangleCount = workspace.reserve(3*std::size_t(vertexCount) + 1 + 2*indices.size() + emittedSize + deadEndStackCapacity);
+    UnsignedInt* const neighborOffset = liveTriangleCount + vertexCount;
+    UnsignedInt* const timestamp = neighborOffset + vertexCount + 1;
+    UnsignedInt* const neighbors = timestamp + vertexCount;
+    UnsignedInt* const emitted = neighbors + indices.size();
+    UnsignedInt* const deadEndStack = emitted + emittedSize;
+    UnsignedInt* const outputIndices = deadEndStack + deadEndStackCapacity;
 
-    /* Output index buffer */
-    std::vector<UnsignedInt> outputIndices;
-    outputIndices.reserve(indices.size());
+    buildAdjacency(liveTriangleCount, neighborOffset, neighbors);
+    std::fill_n(timestamp, vertexCount, 0);
+    std::fill_n(emitted, emittedSize, 0);
 
-    /* Starting vertex for fanning, cursor */
+    /* Global time, dead-end stack is a ring buffer overwriting the oldest
+       entries when full */
+    UnsignedInt time = cacheSize+1;
+    std::size_t deadEndStackTop = 0, deadEndStackCount = 0;
+
+    /* Starting vertex for fanning, cursor, output position */
     UnsignedInt fanningVertex = 0;
     UnsignedInt i = 0;
+    std::size_t output = 0;
     while(fanningVertex != 0xFFFFFFFFu) {
-        /* Array with candidates for next fanning vertex (in 1-ring around
-           fanning vertex) */
-        std::vector<UnsignedInt> candidates;
+        /* Candidates for next fanning vertex (in 1-ring around fanning
+           vertex) are exactly the vertices emitted in this step, so they
+           don't need to be stored anywhere else */
+        const std::size_t candidatesBegin = output;
 
         /* For all neighbors of fanning vertex */
-        for(UnsignedInt ti = neighborPosition[fanningVertex], t = neighbors[ti]; ti != neighborPosition[fanningVertex+1]; t = neighbors[++ti]) {
+        for(UnsignedInt ti = neighborOffset[fanningVertex]; ti != neighborOffset[fanningVertex+1]; ++ti) {
+            const UnsignedInt t = neighbors[ti];
+
             /* Continue if already emitted */
-            if(emitted[t]) continue;
-            emitted[t] = true;
+            if(emitted[t >> 5] & (1u << (t & 31))) continue;
+            emitted[t >> 5] |= 1u << (t & 31);
 
             /* Write all vertices of the triangle to output buffer */
-            for(UnsignedInt vi = 0, v = indices[t*3]; vi != 3; v = indices[++vi+t*3]) {
-                outputIndices.push_back(v);
+            for(UnsignedInt vi = 0; vi != 3; ++vi) {
+                const UnsignedInt v = indices[t*3+vi];
+                outputIndices[output++] = v;
 
-                /* Add to dead end stack and candidates array */
-                /** @todo Limit size of dead end stack to cache size */
-                deadEndStack.push(v);
-                candidates.push_back(v);
+                /* Add to dead end stack */
+                deadEndStack[deadEndStackTop] = v;
+                if(++deadEndStackTop == deadEndStackCapacity) deadEndStackTop = 0;
+                if(deadEndStackCount != deadEndStackCapacity) ++deadEndStackCount;
 
                 /* Decrease live triangle count */
                 --liveTriangleCount[v];
@@ -82,7 +115,9 @@ void Tipsify::operator()(std::size_t cacheSize) {
 
         /* Go through candidates in 1-ring around fanning vertex */
         Int candidatePriority = -1;
-        for(UnsignedInt v: candidates) {
+        for(std::size_t c = candidatesBegin; c != output; ++c) {
+            const UnsignedInt v = outputIndices[c];
+
             /* Skip if it doesn't have any live triangles */
             if(!liveTriangleCount[v]) continue;
 
@@ -101,18 +136,20 @@ void Tipsify::operator()(std::size_t cacheSize) {
         /* On dead-end */
         if(fanningVertex == 0xFFFFFFFFu) {
             /* Find vertex with live triangles in dead-end stack */
-            while(!deadEndStack.empty()) {
-                unsigned int d = deadEndStack.top();
-                deadEndStack.pop();
+            while(deadEndStackCount) {
+                deadEndStackTop = (deadEndStackTop ? deadEndStackTop : deadEndStackCapacity) - 1;
+                --deadEndStackCount;
 
+                const UnsignedInt d = deadEndStack[deadEndStackTop];
                 if(!liveTriangleCount[d]) continue;
                 fanningVertex = d;
                 break;
             }
 
             /* If not found, find next artbitrary vertex with live
-               triangles */
-            while(++i < vertexCount) {
+               triangles. Live triangle counts never increase, so the
+               cursor doesn't need to go back. */
+            if(fanningVertex == 0xFFFFFFFFu) while(++i < vertexCount) {
                 if(!liveTriangleCount[i]) continue;
 
                 fanningVertex = i;
@@ -121,15 +158,158 @@ void Tipsify::operator()(std::size_t cacheSize) {
         }
     }
 
-    /* Swap original index buffer with optimized */
+    /* Replace original index buffer with optimized */
+    std::copy(outputIndices, outputIndices+output, indices.begin());
+}
+
+void Tipsify::operator()(const std::size_t cacheSize, const std::size_t clusterSize, std::size_t threadCount) {
+    CORRADE_ASSERT(clusterSize, "MeshTools::parallelTipsify(): cluster size must not be zero", );
+    if(indices.empty()) return;
+
+    std::vector<UnsignedInt> order, clusterOffset;
+    buildClusters(clusterSize, order, clusterOffset);
+
+    /* Output index buffer. Each cluster has its place given by the offset, so
+       the threads don't need any synchronization when writing to it and
+       the result doesn't depend on scheduling. */
+    std::vector<UnsignedInt> outputIndices(indices.size());
+    std::atomic<std::size_t> nextCluster(0);
+    const std::size_t clusterCount = clusterOffset.size()-1;
+
+    auto worker = [&]() {
+        /* Cluster-local index buffer, mapping between global and local vertex
+           IDs */
+        TipsifyWorkspace workspace;
+        std::vector<UnsignedInt> localIndices, localToGlobal;
+        std::vector<UnsignedInt> globalToLocal(vertexCount, 0xFFFFFFFFu);
+
+        for(std::size_t cluster; (cluster = nextCluster++) < clusterCount; ) {
+            localIndices.clear();
+            localToGlobal.clear();
+            for(std::size_t i = clusterOffset[cluster]; i != clusterOffset[cluster+1]; ++i) {
+                for(UnsignedInt vi = 0; vi != 3; ++vi) {
+                    const UnsignedInt v = indices[order[i]*3+vi];
+                    if(globalToLocal[v] == 0xFFFFFFFFu) {
+                        globalToLocal[v] = localToGlobal.size();
+                        localToGlobal.push_back(v);
+                    }
+                    localIndices.push_back(globalToLocal[v]);
+                }
+            }
+
+            Tipsify(localIndices, localToGlobal.size())(cacheSize, workspace);
+
+            /* Write the result back with original vertex IDs, reset only the
+               touched part of the mapping */
+            UnsignedInt* const output = outputIndices.data() + clusterOffset[cluster]*3;
+            for(std::size_t i = 0; i != localIndices.size(); ++i)
+                output[i] = localToGlobal[localIndices[i]];
+            for(UnsignedInt v: localToGlobal)
+                globalToLocal[v] = 0xFFFFFFFFu;
+        }
+    };
+
+    /* Current thread is also working */
+    if(!threadCount) threadCount = std::max(std::thread::hardware_concurrency(), 1u);
+    threadCount = std::min(threadCount, clusterCount);
+    std::vector<std::thread> threads;
+    threads.reserve(threadCount-1);
+    for(std::size_t i = 1; i < threadCount; ++i)
+        threads.emplace_back(worker);
+    worker();
+    for(std::thread& thread: threads) thread.join();
+
     std::swap(indices, outputIndices);
 }
 
+void Tipsify::buildClusters(const std::size_t clusterSize, std::vector<UnsignedInt>& order, std::vector<UnsignedInt>& clusterOffset) const {
+    const std::size_t triangleCount = indices.size()/3;
+
+    /* Neighboring triangles for each vertex, per-vertex count of triangles
+       not yet assigned to any cluster */
+    std::vector<UnsignedInt> liveTriangleCount(vertexCount), neighborOffset(vertexCount+1), neighbors(indices.size());
+    buildAdjacency(liveTriangleCount.data(), neighborOffset.data(), neighbors.data());
+
+    /* Per-triangle assigned flag, ID of cluster in which frontier the vertex
+       was last queued to avoid queueing it more than once */
+    std::vector<UnsignedByte> assigned(triangleCount);
+    std::vector<UnsignedInt> queuedIn(vertexCount, 0xFFFFFFFFu);
+
+    order.clear();
+    order.reserve(triangleCount);
+    clusterOffset.assign(1, 0);
+
+    /* Breadth-first search goes over vertices, similarly to fanning in
+       tipsify, so each triangle is touched only from its three vertices. The
+       cursor is for finding seeds when the frontier is exhausted. */
+    std::vector<UnsignedInt> queue;
+    std::size_t queueBegin = 0;
+    UnsignedInt cursor = 0;
+    for(UnsignedInt cluster = 0; order.size() != triangleCount; ++cluster) {
+        /* Seed the cluster from frontier of the previous one, if there is
+           anything left in it, otherwise from first vertex with unassigned
+           triangles */
+        UnsignedInt seed = 0xFFFFFFFFu;
+        for(; queueBegin != queue.size(); ++queueBegin) if(liveTriangleCount[queue[queueBegin]]) {
+            seed = queue[queueBegin];
+            break;
+        }
+        if(seed == 0xFFFFFFFFu) {
+            while(!liveTriangleCount[cursor]) ++cursor;
+            seed = cursor;
+        }
+
+        queue.assign(1, seed);
+        queueBegin = 0;
+        queuedIn[seed] = cluster;
+
+        /* Grow the cluster until it is full or there is nothing connected
+           left */
+        std::size_t size = 0;
+        while(queueBegin != queue.size() && size != clusterSize) {
+            const UnsignedInt v = queue[queueBegin++];
+
+            for(UnsignedInt ti = neighborOffset[v]; ti != neighborOffset[v+1]; ++ti) {
+                const UnsignedInt t = neighbors[ti];
+                if(assigned[t]) continue;
+
+                /* Cluster is full, keep the vertex in the frontier so the
+                   next cluster continues from it */
+                if(size == clusterSize) {
+                    --queueBegin;
+                    break;
+                }
+
+                assigned[t] = 1;
+                order.push_back(t);
+                ++size;
+
+                /* Queue all its vertices which have some triangles left */
+                for(UnsignedInt vi = 0; vi != 3; ++vi) {
+                    const UnsignedInt w = indices[t*3+vi];
+                    if(--liveTriangleCount[w] && queuedIn[w] != cluster) {
+                        queuedIn[w] = cluster;
+                        queue.push_back(w);
+                    }
+                }
+            }
+        }
+
+        clusterOffset.push_back(order.size());
+    }
+}
+
 void Tipsify::buildAdjacency(std::vector<UnsignedInt>& liveTriangleCount, std::vector<UnsignedInt>& neighborOffset, std::vector<UnsignedInt>& neighbors) const {
+    liveTriangleCount.resize(vertexCount);
+    neighborOffset.resize(vertexCount+1);
+    neighbors.resize(indices.size());
+    buildAdjacency(liveTriangleCount.data(), neighborOffset.data(), neighbors.data());
+}
+
+void Tipsify::buildAdjacency(UnsignedInt* const liveTriangleCount, UnsignedInt* const neighborOffset, UnsignedInt* const neighbors) const {
     /* How many times is each vertex referenced == count of neighboring
        triangles for each vertex */
-    liveTriangleCount.clear();
-    liveTriangleCount.resize(vertexCount);
+    std::fill_n(liveTriangleCount, vertexCount, 0);
     for(std::size_t i = 0; i != indices.size(); ++i)
         ++liveTriangleCount[indices[i]];
 
@@ -137,19 +317,15 @@ void Tipsify::buildAdjacency(std::vector<UnsignedInt>& liveTriangleCount, std::v
        the end be in interval neighbors[neighborOffset[i]] ;
        neighbors[neighborOffset[i+1]]. Currently the values are shifted to
        right, because the next loop will shift them back left. */
-    neighborOffset.clear();
-    neighborOffset.reserve(vertexCount+1);
-    neighborOffset.push_back(0);
+    neighborOffset[0] = 0;
     UnsignedInt sum = 0;
     for(std::size_t i = 0; i != vertexCount; ++i) {
-        neighborOffset.push_back(sum);
+        neighborOffset[i+1] = sum;
         sum += liveTriangleCount[i];
     }
 
     /* Array of neighbors, using (and changing) neighborOffset array for
-       positioning */
-    neighbors.clear();
-    neighbors.resize(sum);
+       positioning. Sum of all counts is equal to index count. */
     for(std::size_t i = 0; i != indices.size(); ++i)
         neighbors[neighborOffset[indices[i]+1]++] = i/3;
 }
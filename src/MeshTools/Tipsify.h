@@ -25,16 +25,72 @@
 */
 
 /** @file
- * @brief Function Magnum::MeshTools::tipsify()
+ * @brief Class Magnum::MeshTools::TipsifyWorkspace, function Magnum::MeshTools::tipsify(), Magnum::MeshTools::parallelTipsify()
  */
 
 #include <vector>
+#include <Containers/Array.h>
 
-#include "Types.h"
+#include "Magnum.h"
 #include "magnumMeshToolsVisibility.h"
 
 namespace Magnum { namespace MeshTools {
 
+namespace Implementation {
+    class Tipsify;
+}
+
+/**
+@brief Scratch memory for tipsify()
+
+Holds all temporary data needed by tipsify() (vertex-triangle adjacency,
+cache timestamps, emitted flags, dead-end stack and output index buffer) in one
+contiguous allocation. The memory is allocated on first use and grown only if
+subsequent meshes need more of it, so optimizing many meshes with the same
+workspace doesn't touch the allocator at all after the first call:
+@code
+MeshTools::TipsifyWorkspace workspace;
+for(Mesh& mesh: meshes)
+    MeshTools::tipsify(mesh.indices, mesh.vertexCount, 24, workspace);
+@endcode
+@see tipsify(std::vector<UnsignedInt>&, UnsignedInt, std::size_t, TipsifyWorkspace&)
+*/
+class MAGNUM_MESHTOOLS_EXPORT TipsifyWorkspace {
+    friend class Implementation::Tipsify;
+
+    public:
+        /**
+         * @brief Constructor
+         *
+         * No memory is allocated until the workspace is used.
+         */
+        explicit TipsifyWorkspace();
+
+        /** @brief Copying is not allowed */
+        TipsifyWorkspace(const TipsifyWorkspace&) = delete;
+
+        /** @brief Move constructor */
+        TipsifyWorkspace(TipsifyWorkspace&&) = default;
+
+        /** @brief Copying is not allowed */
+        TipsifyWorkspace& operator=(const TipsifyWorkspace&) = delete;
+
+        /** @brief Move assignment */
+        TipsifyWorkspace& operator=(TipsifyWorkspace&&) = default;
+
+        /**
+         * @brief Size of allocated memory
+         *
+         * In bytes.
+         */
+        std::size_t size() const { return _data.size()*sizeof(UnsignedInt); }
+
+    private:
+        UnsignedInt* reserve(std::size_t size);
+
+        Containers::Array<UnsignedInt> _data;
+};
+
 namespace Implementation {
 
 class MAGNUM_MESHTOOLS_EXPORT Tipsify {
@@ -43,6 +99,34 @@ class MAGNUM_MESHTOOLS_EXPORT Tipsify {
 
         void operator()(std::size_t cacheSize);
 
+        void operator()(std::size_t cacheSize, TipsifyWorkspace& workspace);
+
+        void operator()(std::size_t cacheSize, std::size_t clusterSize, std::size_t threadCount);
+
+        /**
+         * @brief Partition triangles into clusters
+         *
+         * Grows each cluster from a seed triangle by breadth-first search
+         * over the vertex-triangle adjacency until it has @p clusterSize
+         * triangles, the next seed is taken from the frontier of previous
+         * cluster. Fills @p order with triangle IDs sorted by cluster and
+         * @p clusterOffset with offsets of clusters in it, the last item is
+         * triangle count (used internally).
+         * @todo Export only for unit test, hide otherwise
+         */
+        void buildClusters(std::size_t clusterSize, std::vector<UnsignedInt>& order, std::vector<UnsignedInt>& clusterOffset) const;
+
+        /**
+         * @brief Size of dead-end stack
+         *
+         * Vertices which were pushed to the stack more than cache size ago
+         * are not in the cache anymore, so there is no point in remembering
+         * them. At least one triangle is always kept.
+         */
+        static std::size_t deadEndStackSize(std::size_t cacheSize) {
+            return cacheSize < 3 ? 3 : cacheSize;
+        }
+
         /**
          * @brief Build vertex-triangle adjacency
          *
@@ -53,6 +137,10 @@ class MAGNUM_MESHTOOLS_EXPORT Tipsify {
         void buildAdjacency(std::vector<UnsignedInt>& liveTriangleCount, std::vector<UnsignedInt>& neighborOffset, std::vector<UnsignedInt>& neighbors) const;
 
     private:
+        /* `neighborOffset` has vertexCount+1 items, `neighbors` has
+           indices.size() items */
+        void buildAdjacency(UnsignedInt* liveTriangleCount, UnsignedInt* neighborOffset, UnsignedInt* neighbors) const;
+
         std::vector<UnsignedInt>& indices;
         const UnsignedInt vertexCount;
 };
@@ -70,12 +158,56 @@ array for beter usage of post-transform vertex cache. Algorithm used:
 *Pedro V. Sander, Diego Nehab, and Joshua Barczak - Fast Triangle Reordering
 for Vertex Locality and Reduced Overdraw, SIGGRAPH 2007,
 http://gfx.cs.princeton.edu/pubs/Sander_2007_%3ETR/index.php*.
+
+The algorithm runs in time linear to index count. Size of dead-end stack is
+limited to cache size, as vertices pushed to it earlier wouldn't be in the
+cache anymore anyway. All temporary data are allocated at once, see
+tipsify(std::vector<UnsignedInt>&, UnsignedInt, std::size_t, TipsifyWorkspace&)
+for a version which can reuse the memory across calls.
 @todo Ability to compute vertex count automatically
 */
 inline void tipsify(std::vector<UnsignedInt>& indices, UnsignedInt vertexCount, std::size_t cacheSize) {
     Implementation::Tipsify(indices, vertexCount)(cacheSize);
 }
 
+/**
+@brief %Tipsify the mesh using preallocated scratch memory
+@param[in,out] indices  Indices array to operate on
+@param[in] vertexCount  Vertex count
+@param[in] cacheSize    Post-transform vertex cache size
+@param[in,out] workspace Scratch memory, enlarged if needed
+
+Same as tipsify(std::vector<UnsignedInt>&, UnsignedInt, std::size_t), but
+uses memory in @p workspace for all temporary data instead of allocating it on
+every call. Useful when processing large amount of meshes.
+*/
+inline void tipsify(std::vector<UnsignedInt>& indices, UnsignedInt vertexCount, std::size_t cacheSize, TipsifyWorkspace& workspace) {
+    Implementation::Tipsify(indices, vertexCount)(cacheSize, workspace);
+}
+
+/**
+@brief %Tipsify the mesh in parallel
+@param[in,out] indices  Indices array to operate on
+@param[in] vertexCount  Vertex count
+@param[in] cacheSize    Post-transform vertex cache size
+@param[in] clusterSize  Triangle count in one cluster
+@param[in] threadCount  Count of worker threads. If `0`, count of hardware
+    threads is used.
+
+Splits the mesh into topologically connected clusters of @p clusterSize
+triangles (each grown by breadth-first search over vertex-triangle adjacency,
+starting where the previous one ended), optimizes each of them with tipsify()
+on worker threads and concatenates the results in cluster order. The output
+doesn't depend on thread count or scheduling. Only vertices on cluster
+boundaries are loaded into the cache more than once, so with large enough
+clusters the average cache miss ratio is within few percent of serial
+tipsify(). Useful for meshes with millions of triangles, for small meshes the
+serial version is faster.
+*/
+inline void parallelTipsify(std::vector<UnsignedInt>& indices, UnsignedInt vertexCount, std::size_t cacheSize, std::size_t clusterSize = 65536, std::size_t threadCount = 0) {
+    Implementation::Tipsify(indices, vertexCount)(cacheSize, clusterSize, threadCount);
+}
+
 }}
 
 #endif
@@ -28,6 +28,9 @@
  * @brief Class @ref Magnum::SceneGraph::AbstractCamera, enum @ref Magnum::SceneGraph::AspectRatioPolicy, alias @ref Magnum::SceneGraph::AbstractBasicCamera2D, @ref Magnum::SceneGraph::AbstractBasicCamera3D, typedef @ref Magnum::SceneGraph::AbstractCamera2D, @ref Magnum::SceneGraph::AbstractCamera3D
  */
 
+#include <functional>
+#include <vector>
+
 #include "Math/Matrix3.h"
 #include "Math/Matrix4.h"
 #include "AbstractFeature.h"
@@ -47,6 +50,28 @@ enum class AspectRatioPolicy: UnsignedByte {
     Clip            /**< Clip on smaller side of view */
 };
 
+/**
+@brief Camera draw order
+
+@see @ref AbstractCamera::setDrawOrder(), @ref Drawable::setSortKey()
+*/
+enum class DrawOrder: UnsignedByte {
+    Group,          /**< In order of the drawable group (default) */
+    SortKey,        /**< By sort key, the same keys in group order */
+
+    /**
+     * By sort key, the same keys front to back. Useful for opaque objects
+     * to minimize overdraw. In 2D the same as @ref DrawOrder::SortKey.
+     */
+    FrontToBack,
+
+    /**
+     * By sort key, the same keys back to front. Useful for transparent
+     * objects. In 2D the same as @ref DrawOrder::SortKey.
+     */
+    BackToFront
+};
+
 namespace Implementation {
     template<UnsignedInt dimensions, class T> typename DimensionTraits<dimensions, T>::MatrixType aspectRatioFix(AspectRatioPolicy aspectRatioPolicy, const Math::Vector2<T>& projectionScale, const Vector2i& viewport);
 }
@@ -84,6 +109,21 @@ template<UnsignedInt dimensions, class T> class AbstractCamera: public AbstractF
          */
         AbstractCamera<dimensions, T>& setAspectRatioPolicy(AspectRatioPolicy policy);
 
+        /** @brief Draw order */
+        DrawOrder drawOrder() const { return _drawOrder; }
+
+        /**
+         * @brief Set draw order
+         * @return Reference to self (for method chaining)
+         *
+         * Default is @ref DrawOrder::Group. See @ref Drawable-culling for
+         * more information.
+         */
+        AbstractCamera<dimensions, T>& setDrawOrder(DrawOrder order) {
+            _drawOrder = order;
+            return *this;
+        }
+
         /**
          * @brief Camera matrix
          *
@@ -126,13 +166,37 @@ template<UnsignedInt dimensions, class T> class AbstractCamera: public AbstractF
          */
         virtual void setViewport(const Vector2i& size);
 
+        /**
+         * @brief Drawables with transformations relative to the camera
+         *
+         * Dirty objects in the group are cleaned first, for the others their
+         * cached absolute transformation is used, so nothing needs to be
+         * recomputed if no object moved. Drawables with bounding volume
+         * outside of the frustum are omitted and the rest is sorted
+         * according to @ref drawOrder(). See @ref Drawable-culling for more
+         * information.
+         * @see @ref draw()
+         */
+        std::vector<std::pair<std::reference_wrapper<Drawable<dimensions, T>>, typename DimensionTraits<dimensions, T>::MatrixType>> drawableTransformations(DrawableGroup<dimensions, T>& group);
+
         /**
          * @brief Draw
          *
-         * Draws given group of drawables.
+         * Draws given group of drawables, equivalent to calling
+         * @ref draw(const std::vector<std::pair<std::reference_wrapper<Drawable<dimensions, T>>, typename DimensionTraits<dimensions, T>::MatrixType>>&)
+         * with result of @ref drawableTransformations().
          */
         virtual void draw(DrawableGroup<dimensions, T>& group);
 
+        /**
+         * @brief Draw given list of drawables
+         *
+         * Calls @ref Drawable::draw() on each drawable in the list with
+         * given transformation, e.g. list returned by
+         * @ref drawableTransformations() with some additional filtering.
+         */
+        void draw(const std::vector<std::pair<std::reference_wrapper<Drawable<dimensions, T>>, typename DimensionTraits<dimensions, T>::MatrixType>>& drawableTransformations);
+
     protected:
         /**
          * @brief Constructor
@@ -161,6 +225,7 @@ template<UnsignedInt dimensions, class T> class AbstractCamera: public AbstractF
         typename DimensionTraits<dimensions, T>::MatrixType _cameraMatrix;
 
         Vector2i _viewport;
+        DrawOrder _drawOrder;
 };
 
 #ifndef CORRADE_GCC46_COMPATIBILITY
@@ -30,6 +30,8 @@
 
 #include "AbstractCamera.h"
 
+#include <algorithm>
+
 #include "Drawable.h"
 
 namespace Magnum { namespace SceneGraph {
@@ -43,12 +45,22 @@ template<class T> class Camera<2, T> {
         constexpr static Math::Matrix3<T> aspectRatioScale(const Math::Vector2<T>& scale) {
             return Math::Matrix3<T>::scaling({scale.x(), scale.y()});
         }
+
+        /* No depth in 2D */
+        constexpr static T depth(const Math::Matrix3<T>&, const Math::Vector2<T>&) {
+            return T(0);
+        }
 };
 template<class T> class Camera<3, T> {
     public:
         constexpr static Math::Matrix4<T> aspectRatioScale(const Math::Vector2<T>& scale) {
             return Math::Matrix4<T>::scaling({scale.x(), scale.y(), 1.0f});
         }
+
+        /* Camera looks in direction of -Z */
+        static T depth(const Math::Matrix4<T>& transformation, const Math::Vector3<T>& center) {
+            return -transformation.transformPoint(center).z();
+        }
 };
 
 template<UnsignedInt dimensions, class T> typename DimensionTraits<dimensions, T>::MatrixType aspectRatioFix(AspectRatioPolicy aspectRatioPolicy, const Math::Vector2<T>& projectionScale, const Vector2i& viewport) {
@@ -68,7 +80,7 @@ template<UnsignedInt dimensions, class T> typename DimensionTraits<dimensions, T
 
 }
 
-template<UnsignedInt dimensions, class T> AbstractCamera<dimensions, T>::AbstractCamera(AbstractObject<dimensions, T>& object): AbstractFeature<dimensions, T>(object), _aspectRatioPolicy(AspectRatioPolicy::NotPreserved) {
+template<UnsignedInt dimensions, class T> AbstractCamera<dimensions, T>::AbstractCamera(AbstractObject<dimensions, T>& object): AbstractFeature<dimensions, T>(object), _aspectRatioPolicy(AspectRatioPolicy::NotPreserved), _drawOrder(DrawOrder::Group) {
     AbstractFeature<dimensions, T>::setCachedTransformations(CachedTransformation::InvertedAbsolute);
 }
 
@@ -85,23 +97,119 @@ template<UnsignedInt dimensions, class T> void AbstractCamera<dimensions, T>::se
     fixAspectRatio();
 }
 
-template<UnsignedInt dimensions, class T> void AbstractCamera<dimensions, T>::draw(DrawableGroup<dimensions, T>& group) {
-    AbstractObject<dimensions, T>* scene = AbstractFeature<dimensions, T>::object().scene();
-    CORRADE_ASSERT(scene, "Camera::draw(): cannot draw when camera is not part of any scene", );
+template<UnsignedInt dimensions, class T> auto AbstractCamera<dimensions, T>::drawableTransformations(DrawableGroup<dimensions, T>& group) -> std::vector<std::pair<std::reference_wrapper<Drawable<dimensions, T>>, typename DimensionTraits<dimensions, T>::MatrixType>> {
+    CORRADE_ASSERT((AbstractFeature<dimensions, T>::object().scene()), "Camera::drawableTransformations(): cannot draw when camera is not part of any scene", {});
 
     /* Compute camera matrix */
     AbstractFeature<dimensions, T>::object().setClean();
 
-    /* Compute transformations of all objects in the group relative to the camera */
-    std::vector<AbstractObject<dimensions, T>*> objects(group.size());
+    /* Clean the objects, so their absolute transformations are cached and
+       only dirty ones need to be recomputed */
+    std::vector<AbstractObject<dimensions, T>*> objects;
     for(std::size_t i = 0; i != group.size(); ++i)
-        objects[i] = &group[i].object();
-    std::vector<typename DimensionTraits<dimensions, T>::MatrixType> transformations =
-        scene->transformationMatrices(objects, _cameraMatrix);
+        if(group[i].object().isDirty()) objects.push_back(&group[i].object());
+    if(!objects.empty()) AbstractObject<dimensions, T>::setClean(objects);
+
+    /* Frustum planes in camera space, pointing inside. Clip coordinates
+       are in range [-w, w], so the planes are w + x, w - x etc.,
+       normalized so the distances are in camera space units. */
+    Math::Vector<dimensions + 1, T> planes[dimensions*2];
+    for(std::size_t i = 0; i != dimensions; ++i) {
+        planes[i*2] = _projectionMatrix.row(dimensions) + _projectionMatrix.row(i);
+        planes[i*2 + 1] = _projectionMatrix.row(dimensions) - _projectionMatrix.row(i);
+    }
+    for(Math::Vector<dimensions + 1, T>& plane: planes) {
+        T length{};
+        for(std::size_t i = 0; i != dimensions; ++i) length += plane[i]*plane[i];
+        plane /= std::sqrt(length);
+    }
+
+    /* Transformations relative to the camera, omit drawables with bounding
+       volume completely outside of any frustum plane */
+    std::vector<std::pair<std::reference_wrapper<Drawable<dimensions, T>>, typename DimensionTraits<dimensions, T>::MatrixType>> drawableTransformations;
+    drawableTransformations.reserve(group.size());
+    for(std::size_t i = 0; i != group.size(); ++i) {
+        const typename DimensionTraits<dimensions, T>::MatrixType transformation = _cameraMatrix*group[i].object().absoluteTransformationMatrix();
+
+        if(group[i].hasBoundingVolume()) {
+            /* Bounding volume center and axis-aligned half-size in camera
+               space, radius scaled by the largest scaling factor */
+            const typename DimensionTraits<dimensions, T>::VectorType center = transformation.transformPoint(group[i].boundingCenter());
+            const typename DimensionTraits<dimensions, T>::VectorType halfSize = group[i].boundingHalfSize();
+            typename DimensionTraits<dimensions, T>::VectorType transformedHalfSize;
+            T scaling{};
+            for(std::size_t col = 0; col != dimensions; ++col) {
+                T columnLength{};
+                for(std::size_t row = 0; row != dimensions; ++row) {
+                    transformedHalfSize[row] += std::abs(transformation[col][row])*halfSize[col];
+                    columnLength += transformation[col][row]*transformation[col][row];
+                }
+                scaling = std::max(scaling, columnLength);
+            }
+            const T radius = group[i].boundingRadius()*std::sqrt(scaling);
+
+            bool outside = false;
+            for(const Math::Vector<dimensions + 1, T>& plane: planes) {
+                T distance = plane[dimensions], extent = radius;
+                for(std::size_t j = 0; j != dimensions; ++j) {
+                    distance += plane[j]*center[j];
+                    extent += std::abs(plane[j])*transformedHalfSize[j];
+                }
+
+                if(distance < -extent) {
+                    outside = true;
+                    break;
+                }
+            }
+
+            if(outside) continue;
+        }
+
+        drawableTransformations.emplace_back(group[i], transformation);
+    }
+
+    /* Sort by the key and then by depth, if requested, keep group order if
+       the key and depth are equal */
+    if(_drawOrder != DrawOrder::Group) {
+        struct Key {
+            UnsignedInt sortKey;
+            T depth;
+            std::size_t index;
+        };
+        std::vector<Key> keys;
+        keys.reserve(drawableTransformations.size());
+        for(std::size_t i = 0; i != drawableTransformations.size(); ++i) {
+            const Drawable<dimensions, T>& drawable = drawableTransformations[i].first;
+            T depth{};
+            if(_drawOrder == DrawOrder::FrontToBack)
+                depth = Implementation::Camera<dimensions, T>::depth(drawableTransformations[i].second, drawable.boundingCenter());
+            else if(_drawOrder == DrawOrder::BackToFront)
+                depth = -Implementation::Camera<dimensions, T>::depth(drawableTransformations[i].second, drawable.boundingCenter());
+            keys.push_back({drawable.sortKey(), depth, i});
+        }
+
+        std::sort(keys.begin(), keys.end(), [](const Key& a, const Key& b) {
+            if(a.sortKey != b.sortKey) return a.sortKey < b.sortKey;
+            if(a.depth != b.depth) return a.depth < b.depth;
+            return a.index < b.index;
+        });
+
+        std::vector<std::pair<std::reference_wrapper<Drawable<dimensions, T>>, typename DimensionTraits<dimensions, T>::MatrixType>> sorted;
+        sorted.reserve(keys.size());
+        for(const Key& key: keys) sorted.push_back(drawableTransformations[key.index]);
+        std::swap(sorted, drawableTransformations);
+    }
+
+    return drawableTransformations;
+}
+
+template<UnsignedInt dimensions, class T> void AbstractCamera<dimensions, T>::draw(DrawableGroup<dimensions, T>& group) {
+    draw(drawableTransformations(group));
+}
 
-    /* Perform the drawing */
-    for(std::size_t i = 0; i != transformations.size(); ++i)
-        group[i].draw(transformations[i], *this);
+template<UnsignedInt dimensions, class T> void AbstractCamera<dimensions, T>::draw(const std::vector<std::pair<std::reference_wrapper<Drawable<dimensions, T>>, typename DimensionTraits<dimensions, T>::MatrixType>>& drawableTransformations) {
+    for(const auto& drawableTransformation: drawableTransformations)
+        drawableTransformation.first.get().draw(drawableTransformation.second, *this);
 }
 
 }}
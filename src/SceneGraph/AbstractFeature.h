@@ -168,6 +168,8 @@ template<UnsignedInt dimensions, class T> class AbstractFeature
     friend class Containers::LinkedList<AbstractFeature<dimensions, T>>;
     friend class Containers::LinkedListItem<AbstractFeature<dimensions, T>, AbstractObject<dimensions, T>>;
     template<class Transformation> friend class Object;
+    template<class Transformation> friend class FlatObject;
+    template<class Transformation> friend void Implementation::cleanFeatures(AbstractObject<Transformation::Dimensions, typename Transformation::Type>&, const typename Transformation::DataType&);
 
     public:
         /**
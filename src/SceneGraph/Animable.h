@@ -121,11 +121,13 @@ void MyApplication::drawEvent() {
 
 @section Animable-performance Using animable groups to improve performance
 
-AnimableGroup is optimized for case when no animation is running -- it just
-puts itself to rest and waits until some animation changes its state to
-@ref AnimationState::Running again. If you put animations which are not
-pernamently running to separate group, they will not be always traversed when
-calling @ref AnimableGroup::step(), saving precious frame time.
+AnimableGroup keeps list of active animables, i.e. these which are running or
+have pending state change, separately from the group itself. Start time and
+duration of active animables are stored in contiguous arrays and
+@ref AnimableGroup::step() traverses only this list, so stopped and paused
+animables cost nothing and the group puts itself to rest if no animation is
+running. Large amount of mostly idle animables in one group thus doesn't
+affect frame time, only the count of running ones does.
 
 @section Animable-explicit-specializations Explicit template specializations
 
@@ -248,10 +250,7 @@ template<UnsignedInt dimensions, class T> class Animable: public AbstractGrouped
          * infinite non-repeating animation. Default is `0.0f`.
          */
         /* Protected so only animation implementer can change it */
-        Animable<dimensions, T>& setDuration(Float duration) {
-            _duration = duration;
-            return *this;
-        }
+        Animable<dimensions, T>& setDuration(Float duration);
 
         /**
          * @brief Perform animation step
@@ -332,6 +331,10 @@ template<UnsignedInt dimensions, class T> class Animable: public AbstractGrouped
         bool _repeated;
         UnsignedShort _repeatCount;
         UnsignedShort repeats;
+
+        /* Group in which active list this animable is and position in it */
+        AnimableGroup<dimensions, T>* activeGroup;
+        std::size_t activeIndex;
 };
 
 #ifndef CORRADE_GCC46_COMPATIBILITY
@@ -35,9 +35,11 @@
 
 namespace Magnum { namespace SceneGraph {
 
-template<UnsignedInt dimensions, class T> Animable<dimensions, T>::Animable(AbstractObject<dimensions, T>& object, AnimableGroup<dimensions, T>* group): AbstractGroupedFeature<dimensions, Animable<dimensions, T>, T>(object, group), _duration(0.0f), startTime(std::numeric_limits<Float>::infinity()), pauseTime(-std::numeric_limits<Float>::infinity()), previousState(AnimationState::Stopped), currentState(AnimationState::Stopped), _repeated(false), _repeatCount(0), repeats(0) {}
+template<UnsignedInt dimensions, class T> Animable<dimensions, T>::Animable(AbstractObject<dimensions, T>& object, AnimableGroup<dimensions, T>* group): AbstractGroupedFeature<dimensions, Animable<dimensions, T>, T>(object, group), _duration(0.0f), startTime(std::numeric_limits<Float>::infinity()), pauseTime(-std::numeric_limits<Float>::infinity()), previousState(AnimationState::Stopped), currentState(AnimationState::Stopped), _repeated(false), _repeatCount(0), repeats(0), activeGroup(nullptr), activeIndex(0) {}
 
-template<UnsignedInt dimensions, class T> Animable<dimensions, T>::~Animable() {}
+template<UnsignedInt dimensions, class T> Animable<dimensions, T>::~Animable() {
+    if(activeGroup) activeGroup->deactivate(activeIndex);
+}
 
 template<UnsignedInt dimensions, class T> Animable<dimensions, T>& Animable<dimensions, T>::setState(AnimationState state) {
     if(currentState == state) return *this;
@@ -46,9 +48,16 @@ template<UnsignedInt dimensions, class T> Animable<dimensions, T>& Animable<dime
     if(previousState == AnimationState::Stopped && state == AnimationState::Paused)
         return *this;
 
-    /* Wake up the group in case no animations are running */
-    animables()->wakeUp = true;
+    /* Put the animable into active list of the group so the state change is
+       processed in next step() */
     currentState = state;
+    if(animables()) animables()->activate(*this);
+    return *this;
+}
+
+template<UnsignedInt dimensions, class T> Animable<dimensions, T>& Animable<dimensions, T>::setDuration(Float duration) {
+    _duration = duration;
+    if(activeGroup) activeGroup->_durations[activeIndex] = duration;
     return *this;
 }
 
@@ -60,40 +69,107 @@ template<UnsignedInt dimensions, class T> const AnimableGroup<dimensions, T>* An
     return static_cast<const AnimableGroup<dimensions, T>*>(AbstractGroupedFeature<dimensions, Animable<dimensions, T>, T>::group());
 }
 
-template<UnsignedInt dimensions, class T> void AnimableGroup<dimensions, T>::step(const Float time, const Float delta) {
-    if(!_runningCount && !wakeUp) return;
-    wakeUp = false;
+template<UnsignedInt dimensions, class T> AnimableGroup<dimensions, T>::~AnimableGroup() {
+    for(std::size_t i = 0; i != _active.size(); ++i) {
+        _active[i]->startTime = _startTimes[i];
+        _active[i]->activeGroup = nullptr;
+    }
+}
+
+template<UnsignedInt dimensions, class T> AnimableGroup<dimensions, T>& AnimableGroup<dimensions, T>::add(Animable<dimensions, T>& animable) {
+    FeatureGroup<dimensions, Animable<dimensions, T>, T>::add(animable);
+
+    /* Running animable or animable with pending state change */
+    if(animable.currentState == AnimationState::Running || animable.previousState != animable.currentState)
+        activate(animable);
+
+    return *this;
+}
+
+template<UnsignedInt dimensions, class T> AnimableGroup<dimensions, T>& AnimableGroup<dimensions, T>::remove(Animable<dimensions, T>& animable) {
+    if(animable.activeGroup == this) deactivate(animable.activeIndex);
+    FeatureGroup<dimensions, Animable<dimensions, T>, T>::remove(animable);
+    return *this;
+}
+
+template<UnsignedInt dimensions, class T> void AnimableGroup<dimensions, T>::activate(Animable<dimensions, T>& animable) {
+    if(animable.activeGroup == this) return;
+
+    /* Remove from active list of previous group */
+    if(animable.activeGroup) animable.activeGroup->deactivate(animable.activeIndex);
 
-    for(std::size_t i = 0; i != AnimableGroup<dimensions, T>::size(); ++i) {
-        Animable<dimensions, T>& animable = (*this)[i];
+    animable.activeGroup = this;
+    animable.activeIndex = _active.size();
+    _active.push_back(&animable);
+    _startTimes.push_back(animable.startTime);
+    _durations.push_back(animable._duration);
+    if(animable.previousState == AnimationState::Running) ++_runningCount;
+}
+
+template<UnsignedInt dimensions, class T> void AnimableGroup<dimensions, T>::deactivate(const std::size_t index) {
+    Animable<dimensions, T>& animable = *_active[index];
+    animable.startTime = _startTimes[index];
+    animable.activeGroup = nullptr;
+    if(animable.previousState == AnimationState::Running) --_runningCount;
+
+    /* Move last active animable in place of removed one */
+    _active[index] = _active.back();
+    _startTimes[index] = _startTimes.back();
+    _durations[index] = _durations.back();
+    _active[index]->activeIndex = index;
+    _active.pop_back();
+    _startTimes.pop_back();
+    _durations.pop_back();
+}
 
-        /* The animation was stopped recently, just decrease count of running
-           animations if the animation was running before */
+template<UnsignedInt dimensions, class T> void AnimableGroup<dimensions, T>::step(const Float time, const Float delta) {
+    if(_active.empty()) return;
+
+    /* The active list can be reordered while iterating, the index is thus
+       advanced only if current animable stays in it */
+    for(std::size_t i = 0; i < _active.size(); ) {
+        Animable<dimensions, T>& animable = *_active[i];
+
+        /* The animable was removed from the group or moved to another one
+           using FeatureGroup interface, hand it over to the new group */
+        if(animable.animables() != this) {
+            AnimableGroup<dimensions, T>* const group = animable.animables();
+            deactivate(i);
+            if(group && (animable.currentState == AnimationState::Running || animable.previousState != animable.currentState))
+                group->activate(animable);
+            continue;
+        }
+
+        /* The animation was stopped recently, remove it from active list
+           (decreasing count of running animations if the animation was running
+           before) */
         if(animable.previousState != AnimationState::Stopped && animable.currentState == AnimationState::Stopped) {
-            if(animable.previousState == AnimationState::Running)
-                --_runningCount;
+            deactivate(i);
             animable.previousState = AnimationState::Stopped;
             animable.animationStopped();
             continue;
 
-        /* The animation was paused recently, set pause time to previous frame time */
+        /* The animation was paused recently, set pause time to previous frame
+           time and remove it from active list */
         } else if(animable.previousState == AnimationState::Running && animable.currentState == AnimationState::Paused) {
-            animable.previousState = AnimationState::Paused;
             animable.pauseTime = time;
-            --_runningCount;
+            deactivate(i);
+            animable.previousState = AnimationState::Paused;
             animable.animationPaused();
             continue;
 
-        /* Skip the rest for not running animations */
+        /* The state was changed and then changed back again before this step,
+           nothing to do */
         } else if(animable.currentState != AnimationState::Running) {
             CORRADE_INTERNAL_ASSERT(animable.previousState == animable.currentState);
+            deactivate(i);
             continue;
 
         /* The animation was started recently, set start time to previous frame
            time, reset repeat count */
         } else if(animable.previousState == AnimationState::Stopped) {
             animable.previousState = AnimationState::Running;
-            animable.startTime = time;
+            _startTimes[i] = time;
             animable.repeats = 0;
             ++_runningCount;
             animable.animationStarted();
@@ -101,7 +177,7 @@ template<UnsignedInt dimensions, class T> void AnimableGroup<dimensions, T>::ste
         /* The animation was resumed recently, add pause duration to start time */
         } else if(animable.previousState == AnimationState::Paused) {
             animable.previousState = AnimationState::Running;
-            animable.startTime += time - animable.pauseTime;
+            _startTimes[i] += time - animable.pauseTime;
             ++_runningCount;
             animable.animationResumed();
         }
@@ -109,30 +185,31 @@ template<UnsignedInt dimensions, class T> void AnimableGroup<dimensions, T>::ste
         CORRADE_INTERNAL_ASSERT(animable.previousState == AnimationState::Running);
 
         /* Animation time exceeded duration */
-        if(animable._duration != 0.0f && time-animable.startTime > animable._duration) {
+        if(_durations[i] != 0.0f && time-_startTimes[i] > _durations[i]) {
             /* Not repeated or repeat count exceeded, stop */
             if(!animable._repeated || animable.repeats+1 == animable._repeatCount) {
+                deactivate(i);
                 animable.previousState = AnimationState::Stopped;
                 animable.currentState = AnimationState::Stopped;
-                --_runningCount;
                 animable.animationStopped();
                 continue;
             }
 
             /* Increase repeat count and add duration to startTime */
             ++animable.repeats;
-            animable.startTime += animable._duration;
+            _startTimes[i] += _durations[i];
         }
 
         /* Animation is still running, perform animation step */
-        CORRADE_ASSERT(time-animable.startTime >= 0.0f,
+        CORRADE_ASSERT(time-_startTimes[i] >= 0.0f,
             "SceneGraph::AnimableGroup::step(): animation was started in future - probably wrong time passed", );
         CORRADE_ASSERT(delta >= 0.0f,
             "SceneGraph::AnimableGroup::step(): negative delta passed", );
-        animable.animationStep(time - animable.startTime, delta);
+        animable.animationStep(time - _startTimes[i], delta);
+        ++i;
     }
 
-    CORRADE_INTERNAL_ASSERT((_runningCount <= AnimableGroup<dimensions, T>::size()));
+    CORRADE_INTERNAL_ASSERT(_runningCount <= _active.size());
 }
 
 }}
@@ -28,6 +28,8 @@
  * @brief Class Magnum::SceneGraph::AnimableGroup, alias Magnum::SceneGraph::BasicAnimableGroup2D, Magnum::SceneGraph::BasicAnimableGroup3D, typedef Magnum::SceneGraph::AnimableGroup2D, Magnum::SceneGraph::AnimableGroup3D
  */
 
+#include <vector>
+
 #include "FeatureGroup.h"
 
 #include "magnumSceneGraphVisibility.h"
@@ -48,7 +50,15 @@ template<UnsignedInt dimensions, class T> class AnimableGroup: public FeatureGro
         /**
          * @brief Constructor
          */
-        explicit AnimableGroup(): _runningCount(0), wakeUp(false) {}
+        explicit AnimableGroup(): _runningCount(0) {}
+
+        /**
+         * @brief Destructor
+         *
+         * Removes all animables belonging to this group, but not deletes
+         * them.
+         */
+        ~AnimableGroup();
 
         /**
          * @brief Count of running animations
@@ -67,9 +77,36 @@ template<UnsignedInt dimensions, class T> class AnimableGroup: public FeatureGro
          */
         void step(const Float time, const Float delta);
 
+        /**
+         * @brief Add animable to the group
+         * @return Reference to self (for method chaining)
+         *
+         * Same as @ref FeatureGroup::add(), but also puts the animable into
+         * list of active animables if it is running or its state was changed
+         * while not being part of any group.
+         */
+        AnimableGroup<dimensions, T>& add(Animable<dimensions, T>& animable);
+
+        /**
+         * @brief Remove animable from the group
+         * @return Reference to self (for method chaining)
+         *
+         * Same as @ref FeatureGroup::remove(), but also removes the animable
+         * from list of active animables.
+         */
+        AnimableGroup<dimensions, T>& remove(Animable<dimensions, T>& animable);
+
     private:
+        void MAGNUM_SCENEGRAPH_LOCAL activate(Animable<dimensions, T>& animable);
+        void MAGNUM_SCENEGRAPH_LOCAL deactivate(std::size_t index);
+
         std::size_t _runningCount;
-        bool wakeUp;
+
+        /* Active animables, i.e. running ones and ones with pending state
+           change, with their start times and durations */
+        std::vector<Animable<dimensions, T>*> _active;
+        std::vector<Float> _startTimes;
+        std::vector<Float> _durations;
 };
 
 #ifndef CORRADE_GCC46_COMPATIBILITY
@@ -0,0 +1,135 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+
+#include "AnimationClip.hpp"
+
+/* SSE2 is baseline on all x86-64 CPUs. Each vector and quaternion fits into
+   one register, so wider instruction sets don't help here. */
+#if (defined(__GNUC__) || defined(__clang__)) && !defined(CORRADE_TARGET_NACL) && (defined(__x86_64__) || (defined(__i386__) && defined(__SSE2__)))
+#define MAGNUM_SCENEGRAPH_USE_SSE2
+#include <emmintrin.h>
+#endif
+
+namespace Magnum { namespace SceneGraph { namespace Implementation {
+
+namespace {
+
+/* Fallbacks, using the generic loops */
+void lerpScalar(const Vector3* const values, const KeyframeSegment* const segments, const std::size_t count, Vector3* const out) {
+    lerpKeyframes<Float>(values, segments, count, out);
+}
+
+void slerpScalar(const Quaternion* const values, const KeyframeSegment* const segments, const std::size_t count, Quaternion* const out) {
+    slerpKeyframes<Float>(values, segments, count, out);
+}
+
+#ifdef MAGNUM_SCENEGRAPH_USE_SSE2
+static_assert(sizeof(Vector3) == 3*sizeof(Float) && sizeof(Quaternion) == 4*sizeof(Float),
+    "unexpected vector or quaternion layout");
+
+/* Three-component vectors are loaded and stored without touching the memory
+   after them, the last component of the register is zero */
+inline __m128 loadVector3(const Vector3& value) {
+    return _mm_movelh_ps(_mm_loadl_pi(_mm_setzero_ps(), reinterpret_cast<const __m64*>(value.data())), _mm_load_ss(value.data() + 2));
+}
+
+inline void storeVector3(Vector3& value, const __m128 a) {
+    _mm_storel_pi(reinterpret_cast<__m64*>(value.data()), a);
+    _mm_store_ss(value.data() + 2, _mm_movehl_ps(a, a));
+}
+
+inline __m128 loadQuaternion(const Quaternion& value) {
+    return _mm_loadu_ps(reinterpret_cast<const Float*>(&value));
+}
+
+inline void storeQuaternion(Quaternion& value, const __m128 a) {
+    _mm_storeu_ps(reinterpret_cast<Float*>(&value), a);
+}
+
+inline Float dot(const __m128 a, const __m128 b) {
+    const __m128 m = _mm_mul_ps(a, b);
+    const __m128 s = _mm_add_ps(m, _mm_movehl_ps(m, m));
+    return _mm_cvtss_f32(_mm_add_ss(s, _mm_shuffle_ps(s, s, _MM_SHUFFLE(1, 1, 1, 1))));
+}
+
+/* (1 - t)*a + t*b, the same as Math::lerp() */
+inline __m128 lerp(const __m128 a, const __m128 b, const Float t) {
+    return _mm_add_ps(_mm_mul_ps(_mm_set1_ps(1.0f - t), a), _mm_mul_ps(_mm_set1_ps(t), b));
+}
+
+void lerpSse2(const Vector3* const values, const KeyframeSegment* const segments, const std::size_t count, Vector3* const out) {
+    for(std::size_t i = 0; i != count; ++i) {
+        const KeyframeSegment& segment = segments[i];
+        storeVector3(out[segment.target], lerp(loadVector3(values[segment.first]), loadVector3(values[segment.second]), segment.factor));
+    }
+}
+
+/* The same as slerpShortestPath(), only the angle and its sines are computed
+   with scalar code */
+void slerpSse2(const Quaternion* const values, const KeyframeSegment* const segments, const std::size_t count, Quaternion* const out) {
+    for(std::size_t i = 0; i != count; ++i) {
+        const KeyframeSegment& segment = segments[i];
+        const __m128 a = loadQuaternion(values[segment.first]);
+        __m128 b = loadQuaternion(values[segment.second]);
+
+        /* Shortest path */
+        Float cosAngle = dot(a, b);
+        if(cosAngle < 0.0f) {
+            b = _mm_xor_ps(b, _mm_set1_ps(-0.0f));
+            cosAngle = -cosAngle;
+        }
+
+        __m128 result;
+        if(cosAngle > 1.0f - Math::TypeTraits<Float>::epsilon()) {
+            result = lerp(a, b, segment.factor);
+            result = _mm_div_ps(result, _mm_set1_ps(std::sqrt(dot(result, result))));
+        } else {
+            const Float angle = std::acos(cosAngle);
+            result = _mm_div_ps(_mm_add_ps(
+                _mm_mul_ps(_mm_set1_ps(std::sin((1.0f - segment.factor)*angle)), a),
+                _mm_mul_ps(_mm_set1_ps(std::sin(segment.factor*angle)), b)),
+                _mm_set1_ps(std::sin(angle)));
+        }
+
+        storeQuaternion(out[segment.target], result);
+    }
+}
+#endif
+
+}
+
+KeyframeInterpolation::KeyframeInterpolation(): lerp(lerpScalar), slerp(slerpScalar) {
+    #ifdef MAGNUM_SCENEGRAPH_USE_SSE2
+    lerp = lerpSse2;
+    slerp = slerpSse2;
+    #endif
+}
+
+const KeyframeInterpolation& keyframeInterpolation() {
+    static const KeyframeInterpolation instance;
+    return instance;
+}
+
+}}}
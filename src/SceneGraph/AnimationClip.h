@@ -0,0 +1,222 @@
+#ifndef Magnum_SceneGraph_AnimationClip_h
+#define Magnum_SceneGraph_AnimationClip_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Class Magnum::SceneGraph::BasicAnimationClip3D, typedef Magnum::SceneGraph::AnimationClip3D
+ */
+
+#include "SceneGraph/Pose.h"
+
+#include "magnumSceneGraphVisibility.h"
+
+namespace Magnum { namespace SceneGraph {
+
+/**
+@brief Keyframe animation clip for three-dimensional objects
+
+Set of keyframe tracks, each animating translation, rotation, scaling or
+whole rigid transformation of one animation target. Keyframe times and values
+of all tracks are stored in contiguous arrays, tracks of the same kind are
+evaluated together in one pass. Translation and scaling is interpolated
+linearly, rotation using @ref Math::Quaternion::slerp() "spherical linear interpolation"
+and rigid transformation using @ref Math::DualQuaternion::sclerp() "screw linear interpolation",
+both along the shortest path.
+
+@section AnimationClip3D-usage Usage
+
+Fill the clip with tracks, then evaluate it at given time into a
+@ref BasicPose3D "pose" and apply the pose to the objects, e.g. from
+@ref Animable::animationStep() :
+@code
+SceneGraph::AnimationClip3D clip;
+clip.addTranslationTrack(0, {0.0f, 1.0f, 2.5f}, {{}, Vector3::yAxis(), {}})
+    .addRotationTrack(1, {0.0f, 2.5f}, {{}, Quaternion::rotation(90.0_degf, Vector3::zAxis())});
+
+class ClipAnimable: public SceneGraph::Animable3D {
+    // ...
+
+    void animationStep(Float time, Float) override {
+        clip.evaluate(time, cursors, pose);
+        pose.applyTo(objects);
+    }
+
+    std::vector<UnsignedInt> cursors;
+    SceneGraph::Pose3D pose;
+    std::vector<Object3D*> objects;
+};
+@endcode
+
+@section AnimationClip3D-performance Performance
+
+The clip is not modified during evaluation, position of the last used
+keyframe of each track is instead saved into cursor array passed to
+@ref evaluate(). When the time advances only a little between evaluations
+(which is the usual case in sequential playback), finding the keyframes is
+done in constant time, otherwise binary search is used. The clip can be thus
+played back by many objects at once, each of them having its own cursor
+array and pose.
+
+@section AnimationClip3D-explicit-specializations Explicit template specializations
+
+The following specialization are explicitly compiled into @ref SceneGraph
+library. For other specializations (e.g. using @ref Double type) you have to
+use @ref AnimationClip.hpp implementation file to avoid linker errors. See also
+@ref compilation-speedup-hpp for more information.
+
+-   @ref AnimationClip3D
+
+@see @ref scenegraph, @ref AnimationClip3D, @ref Animable
+*/
+template<class T> class BasicAnimationClip3D {
+    public:
+        /**
+         * @brief Constructor
+         *
+         * Creates empty clip.
+         */
+        explicit BasicAnimationClip3D();
+
+        /** @brief Count of tracks */
+        std::size_t trackCount() const;
+
+        /**
+         * @brief Count of animation targets
+         *
+         * Largest target ID used in any track plus one.
+         */
+        std::size_t targetCount() const { return _targetCount; }
+
+        /**
+         * @brief Duration
+         *
+         * Time of the last keyframe in all tracks.
+         */
+        Float duration() const { return _duration; }
+
+        /**
+         * @brief Add translation track
+         * @param target        Target ID
+         * @param times         Keyframe times
+         * @param translations  Keyframe translations
+         * @return Reference to self (for method chaining)
+         *
+         * Expects that there is at least one keyframe, the times are
+         * strictly increasing and there is the same count of times and
+         * values.
+         */
+        BasicAnimationClip3D<T>& addTranslationTrack(UnsignedInt target, const std::vector<Float>& times, const std::vector<Math::Vector3<T>>& translations);
+
+        /**
+         * @brief Add rotation track
+         * @param target        Target ID
+         * @param times         Keyframe times
+         * @param rotations     Keyframe rotations
+         * @return Reference to self (for method chaining)
+         *
+         * Expects that the rotations are normalized, see
+         * @ref addTranslationTrack() for other requirements.
+         */
+        BasicAnimationClip3D<T>& addRotationTrack(UnsignedInt target, const std::vector<Float>& times, const std::vector<Math::Quaternion<T>>& rotations);
+
+        /**
+         * @brief Add scaling track
+         * @param target        Target ID
+         * @param times         Keyframe times
+         * @param scalings      Keyframe scalings
+         * @return Reference to self (for method chaining)
+         *
+         * See @ref addTranslationTrack() for requirements.
+         */
+        BasicAnimationClip3D<T>& addScalingTrack(UnsignedInt target, const std::vector<Float>& times, const std::vector<Math::Vector3<T>>& scalings);
+
+        /**
+         * @brief Add rigid transformation track
+         * @param target            Target ID
+         * @param times             Keyframe times
+         * @param transformations   Keyframe transformations
+         * @return Reference to self (for method chaining)
+         *
+         * Sets both translation and rotation of the target. Expects that the
+         * transformations are normalized, see @ref addTranslationTrack() for
+         * other requirements.
+         */
+        BasicAnimationClip3D<T>& addTransformationTrack(UnsignedInt target, const std::vector<Float>& times, const std::vector<Math::DualQuaternion<T>>& transformations);
+
+        /**
+         * @brief Evaluate the clip
+         * @param time      Time
+         * @param cursors   Keyframe cursors
+         * @param pose      Pose to fill
+         *
+         * Sets translation, rotation and scaling of all targets animated by
+         * some track, other targets in the pose are left untouched. Before
+         * the first keyframe the track has value of the first keyframe, after
+         * the last one value of the last keyframe. The @p cursors array is
+         * resized to @ref trackCount() if it has different size, pass the same
+         * array to each evaluation of the same playback. Expects that the
+         * pose has at least @ref targetCount() targets.
+         */
+        void evaluate(Float time, std::vector<UnsignedInt>& cursors, BasicPose3D<T>& pose) const;
+
+    private:
+        struct Track {
+            UnsignedInt target;
+
+            /* Range of keyframes in times and values */
+            UnsignedInt begin, end;
+        };
+
+        template<class U> struct Tracks {
+            std::vector<Track> tracks;
+            std::vector<Float> times;
+            std::vector<U> values;
+        };
+
+        template<class U> void MAGNUM_SCENEGRAPH_LOCAL addTrack(Tracks<U>& tracks, UnsignedInt target, const std::vector<Float>& times, const std::vector<U>& values);
+        template<class U, class Function> static void MAGNUM_SCENEGRAPH_LOCAL evaluateTracks(const Tracks<U>& tracks, Float time, UnsignedInt* cursors, Function function);
+
+        Tracks<Math::Vector3<T>> _translations;
+        Tracks<Math::Quaternion<T>> _rotations;
+        Tracks<Math::Vector3<T>> _scalings;
+        Tracks<Math::DualQuaternion<T>> _transformations;
+        std::size_t _targetCount;
+        Float _duration;
+};
+
+/**
+@brief Keyframe animation clip for three-dimensional float objects
+
+@see @ref BasicAnimationClip3D
+*/
+typedef BasicAnimationClip3D<Float> AnimationClip3D;
+
+#ifdef _WIN32
+extern template class MAGNUM_SCENEGRAPH_EXPORT BasicAnimationClip3D<Float>;
+#endif
+
+}}
+
+#endif
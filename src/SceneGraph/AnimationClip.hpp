@@ -0,0 +1,239 @@
+#ifndef Magnum_SceneGraph_AnimationClip_hpp
+#define Magnum_SceneGraph_AnimationClip_hpp
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief @ref compilation-speedup-hpp "Template implementation" for @ref AnimationClip.h
+ */
+
+#include "AnimationClip.h"
+
+#include <algorithm>
+
+#include "Magnum.h"
+#include "Math/Functions.h"
+
+namespace Magnum { namespace SceneGraph {
+
+namespace Implementation {
+
+/* Finds keyframe segment containing given time, starting at the cursor.
+   Returns index of first keyframe of the segment and the interpolation factor
+   clamped to [0, 1]. Expects at least two keyframes. */
+inline std::pair<UnsignedInt, Float> keyframeSegment(const Float* const times, const UnsignedInt count, const Float time, UnsignedInt& cursor) {
+    UnsignedInt i = cursor < count - 1 ? cursor : 0;
+
+    /* Time advanced to next segment, otherwise find it with binary search */
+    if(time >= times[i + 1] && i + 2 < count) {
+        ++i;
+        if(time >= times[i + 1] && i + 2 < count)
+            i = std::min(UnsignedInt(std::upper_bound(times + i + 1, times + count, time) - times) - 1, count - 2);
+
+    /* Time went back */
+    } else if(time < times[i] && i != 0)
+        i = std::max(UnsignedInt(std::upper_bound(times, times + i, time) - times), 1u) - 1;
+
+    cursor = i;
+    return {i, Math::clamp((time - times[i])/(times[i + 1] - times[i]), 0.0f, 1.0f)};
+}
+
+/* Whether the keyframes are non-empty, strictly increasing and with the same
+   count as values */
+inline bool keyframesValid(const std::vector<Float>& times, const std::size_t valueCount) {
+    if(times.empty() || times.size() != valueCount) return false;
+    for(std::size_t i = 1; i < times.size(); ++i)
+        if(times[i] <= times[i - 1]) return false;
+    return true;
+}
+
+/* Spherical linear interpolation along the shortest path, falling back to
+   linear interpolation for (nearly) identical rotations */
+template<class T> Math::Quaternion<T> slerpShortestPath(const Math::Quaternion<T>& a, const Math::Quaternion<T>& b, const T t) {
+    const T cosAngle = Math::Quaternion<T>::dot(a, b);
+    const Math::Quaternion<T> c = cosAngle < T(0) ? -b : b;
+    return std::abs(cosAngle) > T(1) - Math::TypeTraits<T>::epsilon() ?
+        Math::Quaternion<T>::lerp(a, c, t) : Math::Quaternion<T>::slerp(a, c, t);
+}
+
+/* Pair of keyframe values of one track and interpolation factor between
+   them, the result goes to given target */
+struct KeyframeSegment {
+    UnsignedInt first, second, target;
+    Float factor;
+};
+
+/*
+Keyframe interpolation kernels:
+
+Interpolate values of all segments and write them to the targets, in order.
+For floats the kernels use SSE2, picked in AnimationClip.cpp, for other types
+the generic loops below are used.
+*/
+struct KeyframeInterpolation {
+    KeyframeInterpolation();
+
+    void(*lerp)(const Vector3* values, const KeyframeSegment* segments, std::size_t count, Vector3* out);
+    void(*slerp)(const Quaternion* values, const KeyframeSegment* segments, std::size_t count, Quaternion* out);
+};
+
+MAGNUM_SCENEGRAPH_EXPORT const KeyframeInterpolation& keyframeInterpolation();
+
+template<class T> void lerpKeyframes(const Math::Vector3<T>* const values, const KeyframeSegment* const segments, const std::size_t count, Math::Vector3<T>* const out) {
+    for(std::size_t i = 0; i != count; ++i)
+        out[segments[i].target] = Math::lerp(values[segments[i].first], values[segments[i].second], T(segments[i].factor));
+}
+
+inline void lerpKeyframes(const Vector3* const values, const KeyframeSegment* const segments, const std::size_t count, Vector3* const out) {
+    keyframeInterpolation().lerp(values, segments, count, out);
+}
+
+template<class T> void slerpKeyframes(const Math::Quaternion<T>* const values, const KeyframeSegment* const segments, const std::size_t count, Math::Quaternion<T>* const out) {
+    for(std::size_t i = 0; i != count; ++i)
+        out[segments[i].target] = slerpShortestPath(values[segments[i].first], values[segments[i].second], T(segments[i].factor));
+}
+
+inline void slerpKeyframes(const Quaternion* const values, const KeyframeSegment* const segments, const std::size_t count, Quaternion* const out) {
+    keyframeInterpolation().slerp(values, segments, count, out);
+}
+
+}
+
+template<class T> BasicAnimationClip3D<T>::BasicAnimationClip3D(): _targetCount(0), _duration(0.0f) {}
+
+template<class T> std::size_t BasicAnimationClip3D<T>::trackCount() const {
+    return _translations.tracks.size() + _rotations.tracks.size() + _scalings.tracks.size() + _transformations.tracks.size();
+}
+
+template<class T> template<class U> void BasicAnimationClip3D<T>::addTrack(Tracks<U>& tracks, const UnsignedInt target, const std::vector<Float>& times, const std::vector<U>& values) {
+    tracks.tracks.push_back({target, UnsignedInt(tracks.times.size()), UnsignedInt(tracks.times.size() + times.size())});
+    tracks.times.insert(tracks.times.end(), times.begin(), times.end());
+    tracks.values.insert(tracks.values.end(), values.begin(), values.end());
+    _targetCount = std::max(_targetCount, std::size_t(target) + 1);
+    _duration = std::max(_duration, times.back());
+}
+
+template<class T> BasicAnimationClip3D<T>& BasicAnimationClip3D<T>::addTranslationTrack(const UnsignedInt target, const std::vector<Float>& times, const std::vector<Math::Vector3<T>>& translations) {
+    CORRADE_ASSERT(Implementation::keyframesValid(times, translations.size()),
+        "SceneGraph::AnimationClip::addTranslationTrack(): expected non-empty strictly increasing times with the same count as values", *this);
+    addTrack(_translations, target, times, translations);
+    return *this;
+}
+
+template<class T> BasicAnimationClip3D<T>& BasicAnimationClip3D<T>::addRotationTrack(const UnsignedInt target, const std::vector<Float>& times, const std::vector<Math::Quaternion<T>>& rotations) {
+    CORRADE_ASSERT(Implementation::keyframesValid(times, rotations.size()),
+        "SceneGraph::AnimationClip::addRotationTrack(): expected non-empty strictly increasing times with the same count as values", *this);
+    #ifndef CORRADE_NO_ASSERT
+    for(const Math::Quaternion<T>& rotation: rotations)
+        CORRADE_ASSERT(rotation.isNormalized(),
+            "SceneGraph::AnimationClip::addRotationTrack(): the rotations are not normalized", *this);
+    #endif
+    addTrack(_rotations, target, times, rotations);
+    return *this;
+}
+
+template<class T> BasicAnimationClip3D<T>& BasicAnimationClip3D<T>::addScalingTrack(const UnsignedInt target, const std::vector<Float>& times, const std::vector<Math::Vector3<T>>& scalings) {
+    CORRADE_ASSERT(Implementation::keyframesValid(times, scalings.size()),
+        "SceneGraph::AnimationClip::addScalingTrack(): expected non-empty strictly increasing times with the same count as values", *this);
+    addTrack(_scalings, target, times, scalings);
+    return *this;
+}
+
+template<class T> BasicAnimationClip3D<T>& BasicAnimationClip3D<T>::addTransformationTrack(const UnsignedInt target, const std::vector<Float>& times, const std::vector<Math::DualQuaternion<T>>& transformations) {
+    CORRADE_ASSERT(Implementation::keyframesValid(times, transformations.size()),
+        "SceneGraph::AnimationClip::addTransformationTrack(): expected non-empty strictly increasing times with the same count as values", *this);
+    #ifndef CORRADE_NO_ASSERT
+    for(const Math::DualQuaternion<T>& transformation: transformations)
+        CORRADE_ASSERT(transformation.isNormalized(),
+            "SceneGraph::AnimationClip::addTransformationTrack(): the transformations are not normalized", *this);
+    #endif
+    addTrack(_transformations, target, times, transformations);
+    return *this;
+}
+
+template<class T> template<class U, class Function> void BasicAnimationClip3D<T>::evaluateTracks(const Tracks<U>& tracks, const Float time, UnsignedInt* const cursors, Function function) {
+    /* Segments are found for a batch of tracks, which is then interpolated at
+       once */
+    constexpr std::size_t BatchSize = 64;
+    Implementation::KeyframeSegment segments[BatchSize];
+    std::size_t segmentCount = 0;
+    for(std::size_t i = 0; i != tracks.tracks.size(); ++i) {
+        const Track& track = tracks.tracks[i];
+        const UnsignedInt count = track.end - track.begin;
+
+        /* Constant track */
+        if(count == 1) segments[segmentCount++] = {track.begin, track.begin, track.target, 0.0f};
+
+        else {
+            const std::pair<UnsignedInt, Float> segment = Implementation::keyframeSegment(tracks.times.data() + track.begin, count, time, cursors[i]);
+            segments[segmentCount++] = {track.begin + segment.first, track.begin + segment.first + 1, track.target, segment.second};
+        }
+
+        if(segmentCount == BatchSize) {
+            function(tracks.values.data(), segments, segmentCount);
+            segmentCount = 0;
+        }
+    }
+
+    if(segmentCount) function(tracks.values.data(), segments, segmentCount);
+}
+
+template<class T> void BasicAnimationClip3D<T>::evaluate(const Float time, std::vector<UnsignedInt>& cursors, BasicPose3D<T>& pose) const {
+    CORRADE_ASSERT(pose.size() >= _targetCount,
+        "SceneGraph::AnimationClip::evaluate(): expected pose with at least" << _targetCount << "targets, got" << pose.size(), );
+
+    if(cursors.size() != trackCount()) cursors.assign(trackCount(), 0);
+
+    Math::Vector3<T>* const translations = pose.translations().data();
+    Math::Quaternion<T>* const rotations = pose.rotations().data();
+    Math::Vector3<T>* const scalings = pose.scalings().data();
+    UnsignedInt* cursor = cursors.data();
+
+    evaluateTracks(_translations, time, cursor, [translations](const Math::Vector3<T>* values, const Implementation::KeyframeSegment* segments, std::size_t count) {
+        Implementation::lerpKeyframes(values, segments, count, translations);
+    });
+    cursor += _translations.tracks.size();
+
+    evaluateTracks(_rotations, time, cursor, [rotations](const Math::Quaternion<T>* values, const Implementation::KeyframeSegment* segments, std::size_t count) {
+        Implementation::slerpKeyframes(values, segments, count, rotations);
+    });
+    cursor += _rotations.tracks.size();
+
+    evaluateTracks(_scalings, time, cursor, [scalings](const Math::Vector3<T>* values, const Implementation::KeyframeSegment* segments, std::size_t count) {
+        Implementation::lerpKeyframes(values, segments, count, scalings);
+    });
+    cursor += _scalings.tracks.size();
+
+    evaluateTracks(_transformations, time, cursor, [translations, rotations](const Math::DualQuaternion<T>* values, const Implementation::KeyframeSegment* segments, std::size_t count) {
+        for(std::size_t i = 0; i != count; ++i) {
+            const Math::DualQuaternion<T> transformation = Math::DualQuaternion<T>::sclerp(values[segments[i].first], values[segments[i].second], T(segments[i].factor));
+            translations[segments[i].target] = transformation.translation();
+            rotations[segments[i].target] = transformation.rotation();
+        }
+    });
+}
+
+}}
+
+#endif
@@ -0,0 +1,191 @@
+#ifndef Magnum_SceneGraph_BoundingVolume_h
+#define Magnum_SceneGraph_BoundingVolume_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Class @ref Magnum::SceneGraph::BoundingVolume, alias @ref Magnum::SceneGraph::BasicBoundingVolume2D, @ref Magnum::SceneGraph::BasicBoundingVolume3D, typedef @ref Magnum::SceneGraph::BoundingVolume2D, @ref Magnum::SceneGraph::BoundingVolume3D
+ */
+
+#include "Math/Range.h"
+#include "SceneGraph/AbstractFeature.h"
+
+#include "magnumSceneGraphVisibility.h"
+
+namespace Magnum { namespace SceneGraph {
+
+/**
+@brief Bounding volume
+
+Axis-aligned box in object coordinates, kept indexed in
+@ref BoundingVolumeHierarchy. Example usage:
+@code
+Scene3D scene;
+SceneGraph::BoundingVolumeHierarchy3D hierarchy;
+
+Object3D* o = new Object3D(&scene);
+new SceneGraph::BoundingVolume3D(*o, hierarchy, {Vector3(-1.0f), Vector3(1.0f)});
+
+std::vector<SceneGraph::BoundingVolume3D*> near = hierarchy.intersecting({Vector3(-5.0f), Vector3(5.0f)});
+@endcode
+
+The feature caches absolute transformation of the object, so the volume is
+updated in the hierarchy each time the object is cleaned. See
+@ref BoundingVolumeHierarchy for more information.
+
+@section BoundingVolume-explicit-specializations Explicit template specializations
+
+The following specialization are explicitly compiled into @ref SceneGraph
+library. For other specializations (e.g. using @ref Double type) you have to
+use @ref BoundingVolumeHierarchy.hpp implementation file to avoid linker
+errors. See also @ref compilation-speedup-hpp for more information.
+
+-   @ref BoundingVolume2D
+-   @ref BoundingVolume3D
+
+@see @ref scenegraph, @ref BasicBoundingVolume2D, @ref BasicBoundingVolume3D,
+    @ref BoundingVolume2D, @ref BoundingVolume3D
+*/
+template<UnsignedInt dimensions, class T> class BoundingVolume: public AbstractFeature<dimensions, T> {
+    friend class BoundingVolumeHierarchy<dimensions, T>;
+
+    public:
+        /**
+         * @brief Constructor
+         * @param object    %Object holding this feature
+         * @param hierarchy Hierarchy this volume belongs to
+         * @param range     Bounding box in object coordinates
+         *
+         * The volume is added to the hierarchy once the object is clean.
+         */
+        explicit BoundingVolume(AbstractObject<dimensions, T>& object, BoundingVolumeHierarchy<dimensions, T>& hierarchy, const Math::Range<dimensions, T>& range);
+
+        /**
+         * @brief Destructor
+         *
+         * Removes the volume from the hierarchy, if it still exists.
+         */
+        ~BoundingVolume();
+
+        /**
+         * @brief Hierarchy this volume belongs to
+         *
+         * If the hierarchy was already destroyed, returns `nullptr`.
+         */
+        BoundingVolumeHierarchy<dimensions, T>* hierarchy() { return _hierarchy; }
+
+        /** @overload */
+        const BoundingVolumeHierarchy<dimensions, T>* hierarchy() const { return _hierarchy; }
+
+        /** @brief Bounding box in object coordinates */
+        Math::Range<dimensions, T> range() const { return _range; }
+
+        /**
+         * @brief Set bounding box in object coordinates
+         * @return Reference to self (for method chaining)
+         *
+         * Marks the object as dirty, so the volume is updated in the
+         * hierarchy.
+         */
+        BoundingVolume<dimensions, T>& setRange(const Math::Range<dimensions, T>& range);
+
+        /**
+         * @brief Absolute bounding box
+         *
+         * Axis-aligned box containing the object box transformed with
+         * absolute object transformation. Valid only if the object is clean.
+         */
+        Math::Range<dimensions, T> absoluteRange() const { return _absoluteRange; }
+
+    protected:
+        /** Adds the volume to list of volumes to update in the hierarchy */
+        void markDirty() override;
+
+        /** Computes absolute range and updates the hierarchy */
+        void clean(const typename DimensionTraits<dimensions, T>::MatrixType& absoluteTransformationMatrix) override;
+
+    private:
+        BoundingVolumeHierarchy<dimensions, T>* _hierarchy;
+        Math::Range<dimensions, T> _range, _absoluteRange;
+        std::size_t _node;
+        std::size_t _dirtyIndex; /* Valid only if the volume is listed */
+        bool _updated, _listed;
+};
+
+#ifndef CORRADE_GCC46_COMPATIBILITY
+/**
+@brief Bounding volume for two-dimensional scenes
+
+Convenience alternative to <tt>%BoundingVolume<2, T></tt>. See
+@ref BoundingVolume for more information.
+@note Not available on GCC < 4.7. Use <tt>%BoundingVolume<2, T></tt>
+    instead.
+@see @ref BoundingVolume2D, @ref BasicBoundingVolume3D
+*/
+template<class T> using BasicBoundingVolume2D = BoundingVolume<2, T>;
+#endif
+
+/**
+@brief Bounding volume for two-dimensional float scenes
+
+@see @ref BoundingVolume3D
+*/
+#ifndef CORRADE_GCC46_COMPATIBILITY
+typedef BasicBoundingVolume2D<Float> BoundingVolume2D;
+#else
+typedef BoundingVolume<2, Float> BoundingVolume2D;
+#endif
+
+#ifndef CORRADE_GCC46_COMPATIBILITY
+/**
+@brief Bounding volume for three-dimensional scenes
+
+Convenience alternative to <tt>%BoundingVolume<3, T></tt>. See
+@ref BoundingVolume for more information.
+@note Not available on GCC < 4.7. Use <tt>%BoundingVolume<3, T></tt>
+    instead.
+@see @ref BoundingVolume3D, @ref BasicBoundingVolume2D
+*/
+template<class T> using BasicBoundingVolume3D = BoundingVolume<3, T>;
+#endif
+
+/**
+@brief Bounding volume for three-dimensional float scenes
+
+@see @ref BoundingVolume2D
+*/
+#ifndef CORRADE_GCC46_COMPATIBILITY
+typedef BasicBoundingVolume3D<Float> BoundingVolume3D;
+#else
+typedef BoundingVolume<3, Float> BoundingVolume3D;
+#endif
+
+#ifdef _WIN32
+extern template class MAGNUM_SCENEGRAPH_EXPORT BoundingVolume<2, Float>;
+extern template class MAGNUM_SCENEGRAPH_EXPORT BoundingVolume<3, Float>;
+#endif
+
+}}
+
+#endif
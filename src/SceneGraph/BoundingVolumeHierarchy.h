@@ -0,0 +1,258 @@
+#ifndef Magnum_SceneGraph_BoundingVolumeHierarchy_h
+#define Magnum_SceneGraph_BoundingVolumeHierarchy_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Class @ref Magnum::SceneGraph::BoundingVolumeHierarchy, alias @ref Magnum::SceneGraph::BasicBoundingVolumeHierarchy2D, @ref Magnum::SceneGraph::BasicBoundingVolumeHierarchy3D, typedef @ref Magnum::SceneGraph::BoundingVolumeHierarchy2D, @ref Magnum::SceneGraph::BoundingVolumeHierarchy3D
+ */
+
+#include <vector>
+
+#include "DimensionTraits.h"
+#include "Math/Range.h"
+#include "SceneGraph/SceneGraph.h"
+
+#include "magnumSceneGraphVisibility.h"
+
+namespace Magnum { namespace SceneGraph {
+
+/**
+@brief Bounding volume hierarchy
+
+Dynamic tree of axis-aligned boxes of @ref BoundingVolume features, allowing
+spatial queries in logarithmic time instead of testing all objects. Volumes
+are inserted into the tree incrementally and when object is moved, only its
+volume is reinserted and the tree is rebalanced along the way.
+
+@section BoundingVolumeHierarchy-update Keeping the hierarchy up-to-date
+
+Volumes are updated in the hierarchy when their object is cleaned, e.g. using
+@ref Scene::setClean(). Objects which were marked as dirty since last update
+are cleaned also on each query, so the results are always up-to-date, while
+unmoved objects don't cost anything.
+
+Each leaf of the tree stores the absolute box enlarged by @ref margin(). If
+the object moves only a little, the box still fits into the enlarged one and
+the tree doesn't need to be changed at all. Bigger margin means less frequent
+updates, but less precise culling of the tree nodes. The queries always test
+the exact box of each volume.
+
+@section BoundingVolumeHierarchy-queries Queries
+
+-   @ref intersecting() returns volumes intersecting given box
+-   @ref visible() returns volumes inside given frustum, useful for culling
+-   @ref raycast() returns volumes hit by given ray sorted by distance,
+    useful for picking
+-   @ref overlappingPairs() returns all pairs of overlapping volumes, useful
+    as broadphase for collision detection
+
+@section BoundingVolumeHierarchy-explicit-specializations Explicit template specializations
+
+The following specialization are explicitly compiled into @ref SceneGraph
+library. For other specializations (e.g. using @ref Double type) you have to
+use @ref BoundingVolumeHierarchy.hpp implementation file to avoid linker
+errors. See also @ref compilation-speedup-hpp for more information.
+
+-   @ref BoundingVolumeHierarchy2D
+-   @ref BoundingVolumeHierarchy3D
+
+@see @ref scenegraph, @ref BasicBoundingVolumeHierarchy2D,
+    @ref BasicBoundingVolumeHierarchy3D, @ref BoundingVolumeHierarchy2D,
+    @ref BoundingVolumeHierarchy3D
+*/
+template<UnsignedInt dimensions, class T> class BoundingVolumeHierarchy {
+    friend class BoundingVolume<dimensions, T>;
+
+    public:
+        /** @brief Constructor */
+        explicit BoundingVolumeHierarchy();
+
+        /**
+         * @brief Destructor
+         *
+         * Removes all volumes from the hierarchy, but not deletes them.
+         */
+        ~BoundingVolumeHierarchy();
+
+        /** @brief Copying is not allowed */
+        BoundingVolumeHierarchy(const BoundingVolumeHierarchy<dimensions, T>&) = delete;
+
+        /** @brief Copying is not allowed */
+        BoundingVolumeHierarchy<dimensions, T>& operator=(const BoundingVolumeHierarchy<dimensions, T>&) = delete;
+
+        /** @brief Margin of leaf boxes */
+        T margin() const { return _margin; }
+
+        /**
+         * @brief Set margin of leaf boxes
+         * @return Reference to self (for method chaining)
+         *
+         * Default is `0`. Affects only volumes updated after this call. See
+         * @ref BoundingVolumeHierarchy-update for more information.
+         */
+        BoundingVolumeHierarchy<dimensions, T>& setMargin(T margin) {
+            _margin = margin;
+            return *this;
+        }
+
+        /**
+         * @brief Count of volumes in the tree
+         *
+         * Volumes which weren't yet cleaned are not counted.
+         */
+        std::size_t size() const { return _leafCount; }
+
+        /**
+         * @brief Tree height
+         *
+         * Height of empty tree and tree with only one volume is `0`.
+         */
+        std::size_t height() const;
+
+        /**
+         * @brief Update the hierarchy
+         *
+         * Cleans objects of all volumes which were marked as dirty since last
+         * update. Called implicitly by all queries.
+         */
+        void update();
+
+        /**
+         * @brief Volumes intersecting given box
+         *
+         * Calls @ref update() first.
+         */
+        std::vector<BoundingVolume<dimensions, T>*> intersecting(const Math::Range<dimensions, T>& range);
+
+        /**
+         * @brief Volumes inside given frustum
+         * @param transformationProjectionMatrix    Transformation from
+         *      absolute coordinates to clip coordinates, e.g. projection
+         *      matrix multiplied with camera matrix.
+         *
+         * Returns volumes which are at least partially inside the frustum.
+         * Calls @ref update() first.
+         */
+        std::vector<BoundingVolume<dimensions, T>*> visible(const typename DimensionTraits<dimensions, T>::MatrixType& transformationProjectionMatrix);
+
+        /**
+         * @brief Volumes hit by given ray
+         * @param origin        Ray origin
+         * @param direction     Ray direction
+         * @return Volumes and distances along the ray, in units of
+         *      @p direction length, sorted from the nearest. If the origin
+         *      is inside the volume, the distance is `0`.
+         *
+         * Calls @ref update() first.
+         * @see @ref Math::Geometry::Intersection::rangeLine()
+         */
+        std::vector<std::pair<BoundingVolume<dimensions, T>*, T>> raycast(const typename DimensionTraits<dimensions, T>::VectorType& origin, const typename DimensionTraits<dimensions, T>::VectorType& direction);
+
+        /**
+         * @brief All pairs of overlapping volumes
+         *
+         * Each pair is reported only once. Calls @ref update() first.
+         */
+        std::vector<std::pair<BoundingVolume<dimensions, T>*, BoundingVolume<dimensions, T>*>> overlappingPairs();
+
+    private:
+        struct Node {
+            Math::Range<dimensions, T> range;
+            std::size_t parent, children[2];
+            Int height;
+            BoundingVolume<dimensions, T>* volume;
+        };
+
+        void MAGNUM_SCENEGRAPH_LOCAL updateVolume(BoundingVolume<dimensions, T>& volume, const typename DimensionTraits<dimensions, T>::MatrixType& absoluteTransformationMatrix);
+        void MAGNUM_SCENEGRAPH_LOCAL removeVolume(BoundingVolume<dimensions, T>& volume);
+
+        std::size_t MAGNUM_SCENEGRAPH_LOCAL allocateNode();
+        void MAGNUM_SCENEGRAPH_LOCAL freeNode(std::size_t node);
+        void MAGNUM_SCENEGRAPH_LOCAL insertLeaf(std::size_t leaf);
+        void MAGNUM_SCENEGRAPH_LOCAL removeLeaf(std::size_t leaf);
+        std::size_t MAGNUM_SCENEGRAPH_LOCAL balance(std::size_t node);
+
+        std::vector<Node> _nodes;
+        std::vector<BoundingVolume<dimensions, T>*> _dirtyVolumes;
+        std::size_t _root, _freeList, _leafCount;
+        T _margin;
+};
+
+#ifndef CORRADE_GCC46_COMPATIBILITY
+/**
+@brief Bounding volume hierarchy for two-dimensional scenes
+
+Convenience alternative to <tt>%BoundingVolumeHierarchy<2, T></tt>. See
+@ref BoundingVolumeHierarchy for more information.
+@note Not available on GCC < 4.7. Use <tt>%BoundingVolumeHierarchy<2, T></tt>
+    instead.
+@see @ref BoundingVolumeHierarchy2D, @ref BasicBoundingVolumeHierarchy3D
+*/
+template<class T> using BasicBoundingVolumeHierarchy2D = BoundingVolumeHierarchy<2, T>;
+#endif
+
+/**
+@brief Bounding volume hierarchy for two-dimensional float scenes
+
+@see @ref BoundingVolumeHierarchy3D
+*/
+#ifndef CORRADE_GCC46_COMPATIBILITY
+typedef BasicBoundingVolumeHierarchy2D<Float> BoundingVolumeHierarchy2D;
+#else
+typedef BoundingVolumeHierarchy<2, Float> BoundingVolumeHierarchy2D;
+#endif
+
+#ifndef CORRADE_GCC46_COMPATIBILITY
+/**
+@brief Bounding volume hierarchy for three-dimensional scenes
+
+Convenience alternative to <tt>%BoundingVolumeHierarchy<3, T></tt>. See
+@ref BoundingVolumeHierarchy for more information.
+@note Not available on GCC < 4.7. Use <tt>%BoundingVolumeHierarchy<3, T></tt>
+    instead.
+@see @ref BoundingVolumeHierarchy3D, @ref BasicBoundingVolumeHierarchy2D
+*/
+template<class T> using BasicBoundingVolumeHierarchy3D = BoundingVolumeHierarchy<3, T>;
+#endif
+
+/**
+@brief Bounding volume hierarchy for three-dimensional float scenes
+
+@see @ref BoundingVolumeHierarchy2D
+*/
+#ifndef CORRADE_GCC46_COMPATIBILITY
+typedef BasicBoundingVolumeHierarchy3D<Float> BoundingVolumeHierarchy3D;
+#else
+typedef BoundingVolumeHierarchy<3, Float> BoundingVolumeHierarchy3D;
+#endif
+
+#ifdef _WIN32
+extern template class MAGNUM_SCENEGRAPH_EXPORT BoundingVolumeHierarchy<2, Float>;
+extern template class MAGNUM_SCENEGRAPH_EXPORT BoundingVolumeHierarchy<3, Float>;
+#endif
+
+}}
+
+#endif
@@ -0,0 +1,487 @@
+#ifndef Magnum_SceneGraph_BoundingVolumeHierarchy_hpp
+#define Magnum_SceneGraph_BoundingVolumeHierarchy_hpp
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief @ref compilation-speedup-hpp "Template implementation" for @ref BoundingVolume.h and @ref BoundingVolumeHierarchy.h
+ */
+
+#include "BoundingVolume.h"
+#include "BoundingVolumeHierarchy.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+#include "Math/Functions.h"
+#include "Math/Geometry/Intersection.h"
+#include "Math/Matrix3.h"
+#include "Math/Matrix4.h"
+#include "AbstractObject.h"
+
+namespace Magnum { namespace SceneGraph {
+
+namespace Implementation {
+    enum: std::size_t { NoNode = ~std::size_t(0) };
+
+    template<UnsignedInt dimensions, class T> Math::Range<dimensions, T> join(const Math::Range<dimensions, T>& a, const Math::Range<dimensions, T>& b) {
+        return {Math::min(a.min(), b.min()), Math::max(a.max(), b.max())};
+    }
+
+    template<UnsignedInt dimensions, class T> bool contains(const Math::Range<dimensions, T>& a, const Math::Range<dimensions, T>& b) {
+        for(std::size_t i = 0; i != dimensions; ++i)
+            if(b.min()[i] < a.min()[i] || b.max()[i] > a.max()[i]) return false;
+        return true;
+    }
+
+    template<UnsignedInt dimensions, class T> bool intersects(const Math::Range<dimensions, T>& a, const Math::Range<dimensions, T>& b) {
+        for(std::size_t i = 0; i != dimensions; ++i)
+            if(b.max()[i] < a.min()[i] || b.min()[i] > a.max()[i]) return false;
+        return true;
+    }
+
+    /* Perimeter in 2D, half of surface area in 3D. Used as insertion cost,
+       as probability of hitting the box by random ray is proportional to
+       it. */
+    template<UnsignedInt dimensions, class T> T cost(const Math::Range<dimensions, T>& range) {
+        const typename Math::Range<dimensions, T>::VectorType size = range.size();
+        T cost{};
+        for(std::size_t i = 0; i != dimensions; ++i) {
+            T product(1);
+            for(std::size_t j = 0; j != dimensions; ++j)
+                if(i != j) product *= size[j];
+            cost += product;
+        }
+        return cost;
+    }
+}
+
+template<UnsignedInt dimensions, class T> BoundingVolume<dimensions, T>::BoundingVolume(AbstractObject<dimensions, T>& object, BoundingVolumeHierarchy<dimensions, T>& hierarchy, const Math::Range<dimensions, T>& range): AbstractFeature<dimensions, T>(object), _hierarchy(&hierarchy), _range(range), _node(Implementation::NoNode), _dirtyIndex(hierarchy._dirtyVolumes.size()), _updated(false), _listed(true) {
+    AbstractFeature<dimensions, T>::setCachedTransformations(CachedTransformation::Absolute);
+    hierarchy._dirtyVolumes.push_back(this);
+}
+
+template<UnsignedInt dimensions, class T> BoundingVolume<dimensions, T>::~BoundingVolume() {
+    if(_hierarchy) _hierarchy->removeVolume(*this);
+}
+
+template<UnsignedInt dimensions, class T> BoundingVolume<dimensions, T>& BoundingVolume<dimensions, T>::setRange(const Math::Range<dimensions, T>& range) {
+    _range = range;
+    AbstractFeature<dimensions, T>::object().setDirty();
+
+    /* The object might be already dirty, in which case markDirty() wasn't
+       called */
+    markDirty();
+    return *this;
+}
+
+template<UnsignedInt dimensions, class T> void BoundingVolume<dimensions, T>::markDirty() {
+    _updated = false;
+    if(!_hierarchy || _listed) return;
+
+    _listed = true;
+    _dirtyIndex = _hierarchy->_dirtyVolumes.size();
+    _hierarchy->_dirtyVolumes.push_back(this);
+}
+
+template<UnsignedInt dimensions, class T> void BoundingVolume<dimensions, T>::clean(const typename DimensionTraits<dimensions, T>::MatrixType& absoluteTransformationMatrix) {
+    if(_hierarchy) _hierarchy->updateVolume(*this, absoluteTransformationMatrix);
+}
+
+template<UnsignedInt dimensions, class T> BoundingVolumeHierarchy<dimensions, T>::BoundingVolumeHierarchy(): _root(Implementation::NoNode), _freeList(Implementation::NoNode), _leafCount(0), _margin(0) {}
+
+template<UnsignedInt dimensions, class T> BoundingVolumeHierarchy<dimensions, T>::~BoundingVolumeHierarchy() {
+    for(const Node& node: _nodes)
+        if(node.height == 0) node.volume->_hierarchy = nullptr;
+    for(BoundingVolume<dimensions, T>* volume: _dirtyVolumes)
+        volume->_hierarchy = nullptr;
+}
+
+template<UnsignedInt dimensions, class T> std::size_t BoundingVolumeHierarchy<dimensions, T>::height() const {
+    return _root == Implementation::NoNode ? 0 : _nodes[_root].height;
+}
+
+template<UnsignedInt dimensions, class T> void BoundingVolumeHierarchy<dimensions, T>::update() {
+    if(_dirtyVolumes.empty()) return;
+
+    /* Volumes updated since they were marked as dirty were already cleaned
+       by someone else. Objects of the others need to be cleaned, or, if
+       the volume was added to already clean object (or object not being
+       part of any scene), updated directly. */
+    std::vector<AbstractObject<dimensions, T>*> objects;
+    for(BoundingVolume<dimensions, T>* volume: _dirtyVolumes) {
+        volume->_listed = false;
+        if(volume->_updated) continue;
+
+        if(volume->object().isDirty() && volume->object().scene())
+            objects.push_back(&volume->object());
+        else updateVolume(*volume, volume->object().absoluteTransformationMatrix());
+    }
+
+    _dirtyVolumes.clear();
+    if(!objects.empty()) AbstractObject<dimensions, T>::setClean(objects);
+}
+
+template<UnsignedInt dimensions, class T> void BoundingVolumeHierarchy<dimensions, T>::updateVolume(BoundingVolume<dimensions, T>& volume, const typename DimensionTraits<dimensions, T>::MatrixType& absoluteTransformationMatrix) {
+    volume._updated = true;
+
+    /* Transform box center and take maximal extent of the transformed box
+       in each direction */
+    const typename DimensionTraits<dimensions, T>::VectorType center = absoluteTransformationMatrix.transformPoint(volume._range.center());
+    const typename DimensionTraits<dimensions, T>::VectorType halfSize = volume._range.size()/T(2);
+    typename DimensionTraits<dimensions, T>::VectorType transformedHalfSize;
+    for(std::size_t col = 0; col != dimensions; ++col)
+        for(std::size_t row = 0; row != dimensions; ++row)
+            transformedHalfSize[row] += std::abs(absoluteTransformationMatrix[col][row])*halfSize[col];
+    volume._absoluteRange = {center - transformedHalfSize, center + transformedHalfSize};
+
+    /* Still fits into the enlarged box, nothing to do */
+    if(volume._node != Implementation::NoNode) {
+        if(Implementation::contains(_nodes[volume._node].range, volume._absoluteRange))
+            return;
+
+        removeLeaf(volume._node);
+
+    /* New volume */
+    } else {
+        volume._node = allocateNode();
+        _nodes[volume._node].volume = &volume;
+        _nodes[volume._node].height = 0;
+        ++_leafCount;
+    }
+
+    _nodes[volume._node].range = volume._absoluteRange.padded(typename DimensionTraits<dimensions, T>::VectorType(_margin));
+    insertLeaf(volume._node);
+}
+
+template<UnsignedInt dimensions, class T> void BoundingVolumeHierarchy<dimensions, T>::removeVolume(BoundingVolume<dimensions, T>& volume) {
+    if(volume._node != Implementation::NoNode) {
+        removeLeaf(volume._node);
+        freeNode(volume._node);
+        volume._node = Implementation::NoNode;
+        --_leafCount;
+    }
+
+    /* Order of the list doesn't matter, replace the volume with the last one
+       so the removal is constant-time */
+    if(volume._listed) {
+        BoundingVolume<dimensions, T>* const last = _dirtyVolumes.back();
+        _dirtyVolumes[volume._dirtyIndex] = last;
+        last->_dirtyIndex = volume._dirtyIndex;
+        _dirtyVolumes.pop_back();
+    }
+}
+
+template<UnsignedInt dimensions, class T> std::size_t BoundingVolumeHierarchy<dimensions, T>::allocateNode() {
+    std::size_t node;
+    if(_freeList != Implementation::NoNode) {
+        node = _freeList;
+        _freeList = _nodes[node].parent;
+    } else {
+        node = _nodes.size();
+        _nodes.emplace_back();
+    }
+
+    Node& n = _nodes[node];
+    n.parent = n.children[0] = n.children[1] = Implementation::NoNode;
+    n.height = 0;
+    n.volume = nullptr;
+    return node;
+}
+
+template<UnsignedInt dimensions, class T> void BoundingVolumeHierarchy<dimensions, T>::freeNode(const std::size_t node) {
+    _nodes[node].parent = _freeList;
+    _nodes[node].height = -1;
+    _freeList = node;
+}
+
+template<UnsignedInt dimensions, class T> void BoundingVolumeHierarchy<dimensions, T>::insertLeaf(const std::size_t leaf) {
+    if(_root == Implementation::NoNode) {
+        _root = leaf;
+        _nodes[leaf].parent = Implementation::NoNode;
+        return;
+    }
+
+    /* Find the best sibling by descending the tree. Creating new parent for
+       the leaf and current node costs the area of both combined, descending
+       to a child costs the area increase of all ancestors plus the cost of
+       pairing with the child. */
+    const Math::Range<dimensions, T> range = _nodes[leaf].range;
+    std::size_t sibling = _root;
+    while(_nodes[sibling].height != 0) {
+        const Node& node = _nodes[sibling];
+        const T combinedCost = Implementation::cost(Implementation::join(node.range, range));
+        const T pairCost = T(2)*combinedCost;
+        const T inheritanceCost = T(2)*(combinedCost - Implementation::cost(node.range));
+
+        T childCosts[2];
+        for(std::size_t i = 0; i != 2; ++i) {
+            const Node& child = _nodes[node.children[i]];
+            childCosts[i] = Implementation::cost(Implementation::join(child.range, range)) + inheritanceCost;
+            if(child.height != 0) childCosts[i] -= Implementation::cost(child.range);
+        }
+
+        if(pairCost < childCosts[0] && pairCost < childCosts[1]) break;
+        sibling = node.children[childCosts[0] < childCosts[1] ? 0 : 1];
+    }
+
+    /* Create new parent for the sibling and the leaf */
+    const std::size_t oldParent = _nodes[sibling].parent;
+    const std::size_t newParent = allocateNode();
+    _nodes[newParent].parent = oldParent;
+    _nodes[newParent].range = Implementation::join(range, _nodes[sibling].range);
+    _nodes[newParent].height = _nodes[sibling].height + 1;
+    _nodes[newParent].children[0] = sibling;
+    _nodes[newParent].children[1] = leaf;
+    _nodes[sibling].parent = _nodes[leaf].parent = newParent;
+
+    if(oldParent != Implementation::NoNode)
+        _nodes[oldParent].children[_nodes[oldParent].children[0] == sibling ? 0 : 1] = newParent;
+    else _root = newParent;
+
+    /* Refit and rebalance ancestors */
+    for(std::size_t node = _nodes[leaf].parent; node != Implementation::NoNode; node = _nodes[node].parent) {
+        node = balance(node);
+        Node& n = _nodes[node];
+        n.height = 1 + std::max(_nodes[n.children[0]].height, _nodes[n.children[1]].height);
+        n.range = Implementation::join(_nodes[n.children[0]].range, _nodes[n.children[1]].range);
+    }
+}
+
+template<UnsignedInt dimensions, class T> void BoundingVolumeHierarchy<dimensions, T>::removeLeaf(const std::size_t leaf) {
+    if(leaf == _root) {
+        _root = Implementation::NoNode;
+        return;
+    }
+
+    /* Replace the parent with the sibling */
+    const std::size_t parent = _nodes[leaf].parent;
+    const std::size_t grandParent = _nodes[parent].parent;
+    const std::size_t sibling = _nodes[parent].children[_nodes[parent].children[0] == leaf ? 1 : 0];
+    freeNode(parent);
+    _nodes[sibling].parent = grandParent;
+    if(grandParent == Implementation::NoNode) {
+        _root = sibling;
+        return;
+    }
+
+    _nodes[grandParent].children[_nodes[grandParent].children[0] == parent ? 0 : 1] = sibling;
+
+    /* Refit and rebalance ancestors */
+    for(std::size_t node = grandParent; node != Implementation::NoNode; node = _nodes[node].parent) {
+        node = balance(node);
+        Node& n = _nodes[node];
+        n.height = 1 + std::max(_nodes[n.children[0]].height, _nodes[n.children[1]].height);
+        n.range = Implementation::join(_nodes[n.children[0]].range, _nodes[n.children[1]].range);
+    }
+}
+
+template<UnsignedInt dimensions, class T> std::size_t BoundingVolumeHierarchy<dimensions, T>::balance(const std::size_t a) {
+    Node& nodeA = _nodes[a];
+    if(nodeA.height < 2) return a;
+
+    const Int difference = _nodes[nodeA.children[1]].height - _nodes[nodeA.children[0]].height;
+    if(difference >= -1 && difference <= 1) return a;
+
+    /* Rotate the higher child C up in place of A. A keeps its other child B
+       and gets the lower child of C, C keeps its higher child. */
+    const std::size_t up = difference > 0 ? 1 : 0;
+    const std::size_t b = nodeA.children[1 - up];
+    const std::size_t c = nodeA.children[up];
+    Node& nodeC = _nodes[c];
+    const bool firstHigher = _nodes[nodeC.children[0]].height > _nodes[nodeC.children[1]].height;
+    const std::size_t higher = nodeC.children[firstHigher ? 0 : 1];
+    const std::size_t lower = nodeC.children[firstHigher ? 1 : 0];
+
+    nodeC.children[0] = a;
+    nodeC.children[1] = higher;
+    nodeC.parent = nodeA.parent;
+    nodeA.parent = c;
+    if(nodeC.parent != Implementation::NoNode) {
+        Node& parent = _nodes[nodeC.parent];
+        parent.children[parent.children[0] == a ? 0 : 1] = c;
+    } else _root = c;
+
+    nodeA.children[up] = lower;
+    _nodes[lower].parent = a;
+
+    nodeA.range = Implementation::join(_nodes[b].range, _nodes[lower].range);
+    nodeA.height = 1 + std::max(_nodes[b].height, _nodes[lower].height);
+    nodeC.range = Implementation::join(nodeA.range, _nodes[higher].range);
+    nodeC.height = 1 + std::max(nodeA.height, _nodes[higher].height);
+    return c;
+}
+
+template<UnsignedInt dimensions, class T> std::vector<BoundingVolume<dimensions, T>*> BoundingVolumeHierarchy<dimensions, T>::intersecting(const Math::Range<dimensions, T>& range) {
+    update();
+
+    std::vector<BoundingVolume<dimensions, T>*> result;
+    if(_root == Implementation::NoNode) return result;
+
+    std::vector<std::size_t> stack{_root};
+    while(!stack.empty()) {
+        const Node& node = _nodes[stack.back()];
+        stack.pop_back();
+
+        if(!Implementation::intersects(node.range, range)) continue;
+
+        if(node.height != 0) {
+            stack.push_back(node.children[0]);
+            stack.push_back(node.children[1]);
+        } else if(Implementation::intersects(node.volume->_absoluteRange, range))
+            result.push_back(node.volume);
+    }
+
+    return result;
+}
+
+template<UnsignedInt dimensions, class T> std::vector<BoundingVolume<dimensions, T>*> BoundingVolumeHierarchy<dimensions, T>::visible(const typename DimensionTraits<dimensions, T>::MatrixType& transformationProjectionMatrix) {
+    update();
+
+    std::vector<BoundingVolume<dimensions, T>*> result;
+    if(_root == Implementation::NoNode) return result;
+
+    /* Frustum planes in absolute coordinates, pointing inside. Clip
+       coordinates are in range [-w, w], so the planes are w + x, w - x
+       etc. */
+    Math::Vector<dimensions + 1, T> planes[dimensions*2];
+    for(std::size_t i = 0; i != dimensions; ++i) {
+        planes[i*2] = transformationProjectionMatrix.row(dimensions) + transformationProjectionMatrix.row(i);
+        planes[i*2 + 1] = transformationProjectionMatrix.row(dimensions) - transformationProjectionMatrix.row(i);
+    }
+
+    /* Returns -1 if the box is outside of any plane, 1 if it is inside all
+       planes and 0 otherwise */
+    auto test = [&planes](const Math::Range<dimensions, T>& range) {
+        const typename DimensionTraits<dimensions, T>::VectorType center = range.center();
+        const typename DimensionTraits<dimensions, T>::VectorType halfSize = range.size()/T(2);
+        Int result = 1;
+        for(const Math::Vector<dimensions + 1, T>& plane: planes) {
+            T distance = plane[dimensions], extent{};
+            for(std::size_t i = 0; i != dimensions; ++i) {
+                distance += plane[i]*center[i];
+                extent += std::abs(plane[i])*halfSize[i];
+            }
+
+            if(distance < -extent) return -1;
+            if(distance < extent) result = 0;
+        }
+        return result;
+    };
+
+    /* Subtrees completely inside the frustum are added without further
+       testing of the nodes, volumes are then tested only for being
+       completely outside */
+    std::vector<std::pair<std::size_t, bool>> stack{{_root, false}};
+    while(!stack.empty()) {
+        const Node& node = _nodes[stack.back().first];
+        bool inside = stack.back().second;
+        stack.pop_back();
+
+        if(!inside) {
+            const Int t = test(node.range);
+            if(t == -1) continue;
+            inside = t == 1;
+        }
+
+        if(node.height != 0) {
+            stack.emplace_back(node.children[0], inside);
+            stack.emplace_back(node.children[1], inside);
+        } else if(inside || test(node.volume->_absoluteRange) != -1)
+            result.push_back(node.volume);
+    }
+
+    return result;
+}
+
+template<UnsignedInt dimensions, class T> std::vector<std::pair<BoundingVolume<dimensions, T>*, T>> BoundingVolumeHierarchy<dimensions, T>::raycast(const typename DimensionTraits<dimensions, T>::VectorType& origin, const typename DimensionTraits<dimensions, T>::VectorType& direction) {
+    update();
+
+    std::vector<std::pair<BoundingVolume<dimensions, T>*, T>> result;
+    if(_root == Implementation::NoNode) return result;
+
+    /* The ray hits the box if it enters it before leaving and leaves it
+       after the origin */
+    std::vector<std::size_t> stack{_root};
+    while(!stack.empty()) {
+        const Node& node = _nodes[stack.back()];
+        stack.pop_back();
+
+        const std::pair<T, T> tu = Math::Geometry::Intersection::rangeLine(node.range, origin, direction);
+        if(tu.first > tu.second || tu.second < T(0)) continue;
+
+        if(node.height != 0) {
+            stack.push_back(node.children[0]);
+            stack.push_back(node.children[1]);
+            continue;
+        }
+
+        const std::pair<T, T> volumeTu = Math::Geometry::Intersection::rangeLine(node.volume->_absoluteRange, origin, direction);
+        if(volumeTu.first > volumeTu.second || volumeTu.second < T(0)) continue;
+        result.emplace_back(node.volume, std::max(volumeTu.first, T(0)));
+    }
+
+    std::sort(result.begin(), result.end(), [](const std::pair<BoundingVolume<dimensions, T>*, T>& a, const std::pair<BoundingVolume<dimensions, T>*, T>& b) {
+        return a.second < b.second;
+    });
+
+    return result;
+}
+
+template<UnsignedInt dimensions, class T> std::vector<std::pair<BoundingVolume<dimensions, T>*, BoundingVolume<dimensions, T>*>> BoundingVolumeHierarchy<dimensions, T>::overlappingPairs() {
+    update();
+
+    std::vector<std::pair<BoundingVolume<dimensions, T>*, BoundingVolume<dimensions, T>*>> result;
+    if(_root == Implementation::NoNode) return result;
+
+    /* Query the tree with each leaf, report each pair only from the leaf
+       with lower index */
+    std::vector<std::size_t> stack;
+    for(std::size_t leaf = 0; leaf != _nodes.size(); ++leaf) {
+        if(_nodes[leaf].height != 0) continue;
+
+        const Math::Range<dimensions, T>& range = _nodes[leaf].volume->_absoluteRange;
+        stack.push_back(_root);
+        while(!stack.empty()) {
+            const std::size_t index = stack.back();
+            const Node& node = _nodes[index];
+            stack.pop_back();
+
+            if(!Implementation::intersects(node.range, range)) continue;
+
+            if(node.height != 0) {
+                stack.push_back(node.children[0]);
+                stack.push_back(node.children[1]);
+            } else if(index > leaf && Implementation::intersects(node.volume->_absoluteRange, range))
+                result.emplace_back(_nodes[leaf].volume, node.volume);
+        }
+    }
+
+    return result;
+}
+
+}}
+
+#endif
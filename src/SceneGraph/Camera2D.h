@@ -95,6 +95,10 @@ template<class T> class BasicCamera2D: public AbstractCamera<2, T> {
             AbstractCamera<2, T>::setAspectRatioPolicy(policy);
             return *this;
         }
+        BasicCamera2D<T>& setDrawOrder(DrawOrder order) {
+            AbstractCamera<2, T>::setDrawOrder(order);
+            return *this;
+        }
         #endif
 };
 
@@ -128,6 +128,10 @@ template<class T> class BasicCamera3D: public AbstractCamera<3, T> {
             AbstractCamera<3, T>::setAspectRatioPolicy(policy);
             return *this;
         }
+        BasicCamera3D<T>& setDrawOrder(DrawOrder order) {
+            AbstractCamera<3, T>::setDrawOrder(order);
+            return *this;
+        }
         #endif
 
     private:
@@ -28,6 +28,7 @@
  * @brief Class Magnum::SceneGraph::Drawable, Magnum::SceneGraph::DrawableGroup, alias Magnum::SceneGraph::BasicDrawable2D, Magnum::SceneGraph::BasicDrawable3D, Magnum::SceneGraph::BasicDrawableGroup2D, Magnum::SceneGraph::BasicDrawableGroup3D, typedef Magnum::SceneGraph::Drawable2D, Magnum::SceneGraph::Drawable3D, Magnum::SceneGraph::DrawableGroup2D, Magnum::SceneGraph::DrawableGroup3D
  */
 
+#include "Math/Range.h"
 #include "AbstractGroupedFeature.h"
 
 namespace Magnum { namespace SceneGraph {
@@ -114,6 +115,24 @@ void MyApplication::drawEvent() {
 }
 @endcode
 
+@section Drawable-culling Frustum culling and draw order
+
+If the drawable has bounding volume set using @ref setBoundingSphere() or
+@ref setBoundingBox(), it is drawn only if the volume is at least partially
+inside camera frustum. Drawables without bounding volume are always drawn.
+The volume is specified in object coordinates, so it doesn't need to be
+updated when the object moves:
+@code
+(new DrawableObject(&scene, &drawables))
+    ->setBoundingSphere({}, 1.0f);
+@endcode
+
+The drawables are by default drawn in the order they were added to the group.
+To minimize state changes you can assign them sort key using
+@ref setSortKey() (for example combination of shader and mesh ID) and
+change the order using @ref AbstractCamera::setDrawOrder(), which also allows
+sorting drawables with the same key by depth to minimize overdraw.
+
 @see @ref scenegraph, @ref BasicDrawable2D, @ref BasicDrawable3D,
     @ref Drawable2D, @ref Drawable3D, @ref DrawableGroup
 */
@@ -127,7 +146,7 @@ template<UnsignedInt dimensions, class T> class Drawable: public AbstractGrouped
          * Adds the feature to the object and also to the group, if specified.
          * Otherwise you can use DrawableGroup::add().
          */
-        explicit Drawable(AbstractObject<dimensions, T>& object, DrawableGroup<dimensions, T>* drawables = nullptr): AbstractGroupedFeature<dimensions, Drawable<dimensions, T>, T>(object, drawables) {}
+        explicit Drawable(AbstractObject<dimensions, T>& object, DrawableGroup<dimensions, T>* drawables = nullptr): AbstractGroupedFeature<dimensions, Drawable<dimensions, T>, T>(object, drawables), _boundingRadius(T(-1)), _sortKey(0) {}
 
         /**
          * @brief Group containing this drawable
@@ -143,6 +162,81 @@ template<UnsignedInt dimensions, class T> class Drawable: public AbstractGrouped
             return AbstractGroupedFeature<dimensions, Drawable<dimensions, T>, T>::group();
         }
 
+        /** @brief Whether the drawable has bounding volume */
+        bool hasBoundingVolume() const { return _boundingRadius >= T(0); }
+
+        /** @brief Bounding volume center in object coordinates */
+        typename DimensionTraits<dimensions, T>::VectorType boundingCenter() const { return _boundingCenter; }
+
+        /**
+         * @brief Bounding volume half-size in object coordinates
+         *
+         * For bounding sphere returns zero vector.
+         */
+        typename DimensionTraits<dimensions, T>::VectorType boundingHalfSize() const { return _boundingHalfSize; }
+
+        /**
+         * @brief Bounding volume radius
+         *
+         * For bounding box returns `0`, if the drawable doesn't have any
+         * bounding volume, returns negative value.
+         */
+        T boundingRadius() const { return _boundingRadius; }
+
+        /**
+         * @brief Set bounding sphere
+         * @param center    Sphere center in object coordinates
+         * @param radius    Sphere radius
+         * @return Reference to self (for method chaining)
+         *
+         * See @ref Drawable-culling for more information.
+         */
+        Drawable<dimensions, T>& setBoundingSphere(const typename DimensionTraits<dimensions, T>::VectorType& center, T radius) {
+            _boundingCenter = center;
+            _boundingHalfSize = {};
+            _boundingRadius = radius;
+            return *this;
+        }
+
+        /**
+         * @brief Set bounding box
+         * @param box       Box in object coordinates
+         * @return Reference to self (for method chaining)
+         *
+         * See @ref Drawable-culling for more information.
+         */
+        Drawable<dimensions, T>& setBoundingBox(const Math::Range<dimensions, T>& box) {
+            _boundingCenter = (box.min() + box.max())/T(2);
+            _boundingHalfSize = box.size()/T(2);
+            _boundingRadius = T(0);
+            return *this;
+        }
+
+        /**
+         * @brief Reset bounding volume
+         * @return Reference to self (for method chaining)
+         *
+         * The drawable will be always drawn.
+         */
+        Drawable<dimensions, T>& resetBoundingVolume() {
+            _boundingRadius = T(-1);
+            return *this;
+        }
+
+        /** @brief Sort key */
+        UnsignedInt sortKey() const { return _sortKey; }
+
+        /**
+         * @brief Set sort key
+         * @return Reference to self (for method chaining)
+         *
+         * Default is `0`. See @ref Drawable-culling for more information.
+         */
+        Drawable<dimensions, T>& setSortKey(UnsignedInt key) {
+            _sortKey = key;
+            return *this;
+        }
+
         /**
          * @brief Draw the object using given camera
          * @param transformationMatrix      %Object transformation relative
@@ -152,6 +246,11 @@ template<UnsignedInt dimensions, class T> class Drawable: public AbstractGrouped
          * Projection matrix can be retrieved from AbstractCamera::projectionMatrix().
          */
         virtual void draw(const typename DimensionTraits<dimensions, T>::MatrixType& transformationMatrix, AbstractCamera<dimensions, T>& camera) = 0;
+
+    private:
+        typename DimensionTraits<dimensions, T>::VectorType _boundingCenter, _boundingHalfSize;
+        T _boundingRadius;
+        UnsignedInt _sortKey;
 };
 
 #ifndef CORRADE_GCC46_COMPATIBILITY
@@ -0,0 +1,423 @@
+#ifndef Magnum_SceneGraph_FlatScene_h
+#define Magnum_SceneGraph_FlatScene_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Class Magnum::SceneGraph::FlatObject, Magnum::SceneGraph::FlatScene
+ */
+
+#include <vector>
+
+#include "AbstractFeature.h"
+#include "AbstractObject.h"
+#include "AbstractTransformation.h"
+
+#include "magnumSceneGraphVisibility.h"
+
+namespace Magnum { namespace SceneGraph {
+
+namespace Implementation {
+    enum class FlatObjectFlag: UnsignedByte {
+        /* Transformation changed since last setClean() */
+        Dirty = 1 << 0,
+
+        /* Cached absolute transformation needs to be recomputed */
+        Stale = 1 << 1,
+
+        /* Absolute transformation recomputed / features cleaned in current
+           sweep, used to propagate the change to children */
+        Recomputed = 1 << 2,
+        Cleaned = 1 << 3,
+
+        /* Slot of destroyed object, removed on next sweep */
+        Removed = 1 << 4,
+
+        /* Descendant of object made dirty in current setDirty(), used to
+           propagate feature notification to children */
+        Notified = 1 << 5
+    };
+
+    typedef Containers::EnumSet<FlatObjectFlag, UnsignedByte> FlatObjectFlags;
+
+    CORRADE_ENUMSET_OPERATORS(FlatObjectFlags)
+}
+
+/**
+@brief %Object in flat scene
+
+Alternative to @ref Object which doesn't store its transformation and
+relationship to other objects, everything is stored in contiguous arrays in
+@ref FlatScene and the object is only a handle to them. The object can be used
+with any feature, as it implements the whole @ref AbstractObject interface.
+
+Unlike @ref Object, the @p Transformation class is used only to describe the
+transformation type, so the convenience functions like `translate()` or
+`rotate()` are not available, use @ref transform() or @ref setTransformation()
+with transformation of given type instead:
+@code
+typedef SceneGraph::FlatScene<SceneGraph::MatrixTransformation3D> FlatScene3D;
+typedef SceneGraph::FlatObject<SceneGraph::MatrixTransformation3D> FlatObject3D;
+
+FlatScene3D scene;
+FlatObject3D* object = new FlatObject3D(scene);
+object->transform(Matrix4::translation(Vector3::yAxis()));
+@endcode
+
+Each object is part of some scene, objects without parent are not possible.
+Similarly to @ref Object, the object owns all its children, so deleting it
+deletes all its children too.
+
+@section FlatObject-caching Transformation caching
+
+Calling @ref setDirty() only marks the object itself as dirty, the dirty state
+of children is derived from their parents when needed. Features of the object
+and of all its children are notified using @ref AbstractFeature::markDirty(),
+the same as with @ref Object. As the children aren't stored next to each
+other, notifying them is linear in count of objects stored after given
+object. For objects without children and for objects which already have dirty
+parent the operation is constant-time.
+
+@section FlatObject-explicit-specializations Explicit template specializations
+
+The following specialization are explicitly compiled into @ref SceneGraph
+library. For other specializations you have to use @ref FlatScene.hpp
+implementation file to avoid linker errors. See
+@ref compilation-speedup-hpp for more information.
+
+-   @ref DualComplexTransformation "FlatObject<DualComplexTransformation>"
+-   @ref DualQuaternionTransformation "FlatObject<DualQuaternionTransformation>"
+-   @ref MatrixTransformation2D "FlatObject<MatrixTransformation2D>"
+-   @ref MatrixTransformation3D "FlatObject<MatrixTransformation3D>"
+-   @ref RigidMatrixTransformation2D "FlatObject<RigidMatrixTransformation2D>"
+-   @ref RigidMatrixTransformation3D "FlatObject<RigidMatrixTransformation3D>"
+-   @ref TranslationTransformation2D "FlatObject<TranslationTransformation2D>"
+-   @ref TranslationTransformation3D "FlatObject<TranslationTransformation3D>"
+
+@see @ref FlatScene, @ref Object
+*/
+template<class Transformation> class FlatObject: public AbstractObject<Transformation::Dimensions, typename Transformation::Type> {
+    friend class FlatScene<Transformation>;
+
+    #ifndef DOXYGEN_GENERATING_OUTPUT
+    FlatObject(const FlatObject<Transformation>&) = delete;
+    FlatObject(FlatObject<Transformation>&&) = delete;
+    FlatObject<Transformation>& operator=(const FlatObject<Transformation>&) = delete;
+    FlatObject<Transformation>& operator=(FlatObject<Transformation>&&) = delete;
+    #endif
+
+    public:
+        /** @brief Matrix type */
+        typedef typename DimensionTraits<Transformation::Dimensions, typename Transformation::Type>::MatrixType MatrixType;
+
+        /** @brief Transformation type */
+        typedef typename Transformation::DataType DataType;
+
+        /**
+         * @brief Constructor
+         * @param parent    Parent object or the scene
+         */
+        explicit FlatObject(FlatObject<Transformation>& parent);
+
+        /**
+         * @brief Destructor
+         *
+         * Removes itself from the scene and destroys all own children.
+         */
+        ~FlatObject();
+
+        /** @{ @name Scene hierarchy */
+
+        /** @copydoc AbstractObject::scene() */
+        FlatScene<Transformation>* scene() { return _scene; }
+        const FlatScene<Transformation>* scene() const { return _scene; } /**< @overload */
+
+        /** @brief Parent object or `nullptr`, if this is the scene */
+        FlatObject<Transformation>* parent();
+        const FlatObject<Transformation>* parent() const; /**< @overload */
+
+        /** @brief Whether this object has children */
+        bool hasChildren() const;
+
+        /**
+         * @brief Set parent object
+         * @return Reference to self (for method chaining)
+         *
+         * The parent must be part of the same scene and cannot be child of
+         * this object. Changing parent of the scene is not possible.
+         */
+        FlatObject<Transformation>& setParent(FlatObject<Transformation>& parent);
+
+        /*@}*/
+
+        /** @{ @name Object transformation */
+
+        /** @brief Transformation */
+        DataType transformation() const;
+
+        /**
+         * @brief Set transformation
+         * @return Reference to self (for method chaining)
+         *
+         * Transformation of the scene cannot be changed.
+         */
+        FlatObject<Transformation>& setTransformation(const DataType& transformation);
+
+        /**
+         * @brief Reset transformation
+         * @return Reference to self (for method chaining)
+         */
+        FlatObject<Transformation>& resetTransformation() {
+            return setTransformation(DataType());
+        }
+
+        /**
+         * @brief Transform object
+         * @return Reference to self (for method chaining)
+         */
+        FlatObject<Transformation>& transform(const DataType& transformation, TransformationType type = TransformationType::Global);
+
+        /**
+         * @brief Transformation matrix
+         *
+         * @see transformation()
+         */
+        MatrixType transformationMatrix() const {
+            return Implementation::Transformation<Transformation>::toMatrix(transformation());
+        }
+
+        /**
+         * @brief Transformation matrix relative to root object
+         *
+         * @see absoluteTransformation()
+         */
+        MatrixType absoluteTransformationMatrix() const {
+            return Implementation::Transformation<Transformation>::toMatrix(absoluteTransformation());
+        }
+
+        /**
+         * @brief Transformation relative to the scene
+         *
+         * If the object and all its parents are clean, returns transformation
+         * cached in the scene, otherwise computes it by going up the
+         * hierarchy.
+         * @see absoluteTransformationMatrix()
+         */
+        DataType absoluteTransformation() const;
+
+        /*@}*/
+
+        /**
+         * @{ @name Transformation caching
+         *
+         * See @ref FlatObject-caching for more information.
+         */
+
+        /** @copydoc AbstractObject::isDirty() */
+        bool isDirty() const;
+
+        /**
+         * @brief Set object absolute transformation as dirty
+         *
+         * Calls @ref AbstractFeature::markDirty() on all features of the
+         * object and its children. If the object or any of its parents is
+         * already marked as dirty, the features are not notified again.
+         * @see @ref FlatObject-caching
+         */
+        void setDirty();
+
+        /**
+         * @brief Clean object absolute transformation
+         *
+         * Cleans the whole scene, see @ref FlatScene::setClean().
+         */
+        void setClean();
+
+        /*@}*/
+
+    private:
+        /* Used by FlatScene */
+        explicit FlatObject();
+        void notifyFeatures();
+
+        AbstractObject<Transformation::Dimensions, typename Transformation::Type>* doScene() override final;
+        const AbstractObject<Transformation::Dimensions, typename Transformation::Type>* doScene() const override final;
+
+        MatrixType MAGNUM_SCENEGRAPH_LOCAL doTransformationMatrix() const override final {
+            return transformationMatrix();
+        }
+        MatrixType MAGNUM_SCENEGRAPH_LOCAL doAbsoluteTransformationMatrix() const override final {
+            return absoluteTransformationMatrix();
+        }
+
+        std::vector<MatrixType> doTransformationMatrices(const std::vector<AbstractObject<Transformation::Dimensions, typename Transformation::Type>*>& objects, const MatrixType& initialTransformationMatrix) const override final;
+
+        bool MAGNUM_SCENEGRAPH_LOCAL doIsDirty() const override final { return isDirty(); }
+        void MAGNUM_SCENEGRAPH_LOCAL doSetDirty() override final { setDirty(); }
+        void MAGNUM_SCENEGRAPH_LOCAL doSetClean() override final { setClean(); }
+        void doSetClean(const std::vector<AbstractObject<Transformation::Dimensions, typename Transformation::Type>*>& objects) override final;
+
+        FlatScene<Transformation>* _scene;
+        UnsignedInt _id;
+};
+
+/**
+@brief Flat scene
+
+Stores local transformations, parent indices, dirty flags and cached absolute
+transformations of all @ref FlatObject "objects" in contiguous arrays
+(structure of arrays), ordered by depth in the hierarchy, so parents are
+always before their children. Absolute transformations of all objects are
+then computed in one linear sweep over the arrays, with each object composing
+its transformation with already computed transformation of the parent.
+Compared to @ref Object hierarchy, where the transformations are scattered
+over the heap and found by walking linked lists, this is considerably faster
+for larger scenes.
+
+Creating objects and changing transformations is constant-time. Destroying
+objects and changing parent to object later in the array only marks the
+storage as fragmented and it is reordered on next sweep, which is linear in
+object count. Thus it's better to do structural changes in batches.
+
+The scene can be used with all features, e.g. @ref Drawable or @ref Camera3D,
+the same way as @ref Scene.
+@code
+typedef SceneGraph::FlatScene<SceneGraph::MatrixTransformation3D> FlatScene3D;
+typedef SceneGraph::FlatObject<SceneGraph::MatrixTransformation3D> FlatObject3D;
+
+FlatScene3D scene;
+FlatObject3D* cameraObject = new FlatObject3D(scene);
+SceneGraph::Camera3D* camera = new SceneGraph::Camera3D(*cameraObject);
+@endcode
+
+@section FlatScene-explicit-specializations Explicit template specializations
+
+The following specialization are explicitly compiled into @ref SceneGraph
+library. For other specializations you have to use @ref FlatScene.hpp
+implementation file to avoid linker errors. See
+@ref compilation-speedup-hpp for more information.
+
+-   @ref DualComplexTransformation "FlatScene<DualComplexTransformation>"
+-   @ref DualQuaternionTransformation "FlatScene<DualQuaternionTransformation>"
+-   @ref MatrixTransformation2D "FlatScene<MatrixTransformation2D>"
+-   @ref MatrixTransformation3D "FlatScene<MatrixTransformation3D>"
+-   @ref RigidMatrixTransformation2D "FlatScene<RigidMatrixTransformation2D>"
+-   @ref RigidMatrixTransformation3D "FlatScene<RigidMatrixTransformation3D>"
+-   @ref TranslationTransformation2D "FlatScene<TranslationTransformation2D>"
+-   @ref TranslationTransformation3D "FlatScene<TranslationTransformation3D>"
+
+@see @ref FlatObject, @ref Scene
+*/
+template<class Transformation> class FlatScene: public FlatObject<Transformation> {
+    friend class FlatObject<Transformation>;
+
+    public:
+        /** @brief Matrix type */
+        typedef typename FlatObject<Transformation>::MatrixType MatrixType;
+
+        /** @brief Transformation type */
+        typedef typename Transformation::DataType DataType;
+
+        explicit FlatScene();
+
+        /**
+         * @brief Destructor
+         *
+         * Destroys all objects in the scene.
+         */
+        ~FlatScene();
+
+        /** @brief Count of objects in the scene, excluding the scene itself */
+        std::size_t size() const { return _transformations.size() - _removedCount; }
+
+        /**
+         * @brief Reserve memory for given object count
+         *
+         * Avoids reallocations when adding large amount of objects.
+         */
+        void reserve(std::size_t size);
+
+        /**
+         * @brief Transformation matrices of given set of objects
+         *
+         * All transformations are premultiplied with @p initialTransformationMatrix,
+         * if specified.
+         * @see transformations()
+         */
+        std::vector<MatrixType> transformationMatrices(const std::vector<FlatObject<Transformation>*>& objects, const MatrixType& initialTransformationMatrix = MatrixType()) const;
+
+        /**
+         * @brief Transformations of given set of objects
+         *
+         * Recomputes cached absolute transformations of all changed objects
+         * in one sweep and then returns them, premultiplied with
+         * @p initialTransformation, if specified. Features are not cleaned,
+         * use @ref setClean() for that.
+         * @see transformationMatrices()
+         */
+        std::vector<DataType> transformations(const std::vector<FlatObject<Transformation>*>& objects, const DataType& initialTransformation = DataType()) const;
+
+        /**
+         * @brief Clean the scene
+         *
+         * Recomputes cached absolute transformations of all changed objects
+         * in one sweep and calls @ref AbstractFeature::clean() and/or
+         * @ref AbstractFeature::cleanInverted() on their features.
+         */
+        void setClean();
+
+    private:
+        /* Scene-level implementation of FlatObject functions */
+        UnsignedInt addObject(FlatObject<Transformation>* object, UnsignedInt parent);
+        void removeObject(UnsignedInt id);
+        void setObjectParent(UnsignedInt id, UnsignedInt parent);
+        bool isObjectDirty(UnsignedInt id) const;
+        DataType objectAbsoluteTransformation(UnsignedInt id) const;
+
+        /* Calls markDirty() on features of all children which don't have
+           dirty parent yet */
+        void notifyChildren(UnsignedInt id);
+
+        /* Removes slots of destroyed objects and restores the depth order */
+        void defragment();
+
+        /* Recomputes absolute transformations, optionally cleaning features */
+        void sweep(bool cleanFeatures);
+
+        enum: UnsignedInt { SceneId = ~UnsignedInt(0) };
+
+        typedef Implementation::FlatObjectFlag Flag;
+        typedef Implementation::FlatObjectFlags Flags;
+
+        std::vector<DataType> _transformations, _absoluteTransformations;
+        std::vector<UnsignedInt> _parents, _childCounts;
+        std::vector<Flags> _flags;
+        std::vector<FlatObject<Transformation>*> _objects;
+        std::size_t _removedCount;
+        bool _outOfOrder, _destroying;
+};
+
+}}
+
+#endif
@@ -0,0 +1,385 @@
+#ifndef Magnum_SceneGraph_FlatScene_hpp
+#define Magnum_SceneGraph_FlatScene_hpp
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief @ref compilation-speedup-hpp "Template implementation" for @ref FlatScene.h
+ */
+
+#include "FlatScene.h"
+
+#include "Object.hpp"
+
+namespace Magnum { namespace SceneGraph {
+
+template<class Transformation> FlatObject<Transformation>::FlatObject(FlatObject<Transformation>& parent): _scene(parent._scene) {
+    _id = _scene->addObject(this, parent._id);
+}
+
+template<class Transformation> FlatObject<Transformation>::FlatObject(): _scene(static_cast<FlatScene<Transformation>*>(this)), _id(FlatScene<Transformation>::SceneId) {}
+
+template<class Transformation> FlatObject<Transformation>::~FlatObject() {
+    if(_id != FlatScene<Transformation>::SceneId) _scene->removeObject(_id);
+}
+
+template<class Transformation> AbstractObject<Transformation::Dimensions, typename Transformation::Type>* FlatObject<Transformation>::doScene() {
+    return _scene;
+}
+
+template<class Transformation> const AbstractObject<Transformation::Dimensions, typename Transformation::Type>* FlatObject<Transformation>::doScene() const {
+    return _scene;
+}
+
+template<class Transformation> FlatObject<Transformation>* FlatObject<Transformation>::parent() {
+    if(_id == FlatScene<Transformation>::SceneId) return nullptr;
+
+    const UnsignedInt parent = _scene->_parents[_id];
+    return parent == FlatScene<Transformation>::SceneId ? _scene : _scene->_objects[parent];
+}
+
+template<class Transformation> const FlatObject<Transformation>* FlatObject<Transformation>::parent() const {
+    return const_cast<FlatObject<Transformation>*>(this)->parent();
+}
+
+template<class Transformation> bool FlatObject<Transformation>::hasChildren() const {
+    if(_id == FlatScene<Transformation>::SceneId) return _scene->size() != 0;
+    return _scene->_childCounts[_id] != 0;
+}
+
+template<class Transformation> FlatObject<Transformation>& FlatObject<Transformation>::setParent(FlatObject<Transformation>& parent) {
+    /* Skip if this is scene (which cannot have parent) */
+    if(_id == FlatScene<Transformation>::SceneId) return *this;
+
+    CORRADE_ASSERT(parent._scene == _scene, "SceneGraph::FlatObject::setParent(): the parent is not part of the same scene", *this);
+
+    /* Object cannot be parented to its child */
+    for(UnsignedInt p = parent._id; p != FlatScene<Transformation>::SceneId; p = _scene->_parents[p])
+        CORRADE_ASSERT(p != _id, "SceneGraph::FlatObject::setParent(): the object cannot be parented to itself or its child", *this);
+
+    _scene->setObjectParent(_id, parent._id);
+    return *this;
+}
+
+template<class Transformation> typename Transformation::DataType FlatObject<Transformation>::transformation() const {
+    if(_id == FlatScene<Transformation>::SceneId) return {};
+    return _scene->_transformations[_id];
+}
+
+template<class Transformation> FlatObject<Transformation>& FlatObject<Transformation>::setTransformation(const DataType& transformation) {
+    /* Setting transformation is forbidden for the scene */
+    if(_id == FlatScene<Transformation>::SceneId) return *this;
+
+    _scene->_transformations[_id] = transformation;
+    setDirty();
+    return *this;
+}
+
+template<class Transformation> FlatObject<Transformation>& FlatObject<Transformation>::transform(const DataType& transformation, const TransformationType type) {
+    return setTransformation(type == TransformationType::Global ?
+        Implementation::Transformation<Transformation>::compose(transformation, this->transformation()) :
+        Implementation::Transformation<Transformation>::compose(this->transformation(), transformation));
+}
+
+template<class Transformation> typename Transformation::DataType FlatObject<Transformation>::absoluteTransformation() const {
+    if(_id == FlatScene<Transformation>::SceneId) return {};
+    return _scene->objectAbsoluteTransformation(_id);
+}
+
+template<class Transformation> bool FlatObject<Transformation>::isDirty() const {
+    /* Scene transformation never changes */
+    return _id != FlatScene<Transformation>::SceneId && _scene->isObjectDirty(_id);
+}
+
+template<class Transformation> void FlatObject<Transformation>::setDirty() {
+    if(_id == FlatScene<Transformation>::SceneId) return;
+
+    /* The cached transformation needs to be recomputed even if the object is
+       already dirty, as it might have been recomputed since then. Features of
+       the whole subtree were already notified if the object or any of its
+       parents is dirty. */
+    const bool wasDirty = _scene->isObjectDirty(_id);
+    _scene->_flags[_id] |= Implementation::FlatObjectFlag::Dirty|Implementation::FlatObjectFlag::Stale;
+    if(wasDirty) return;
+
+    /* Make all features dirty, then features of all children */
+    notifyFeatures();
+    if(_scene->_childCounts[_id]) _scene->notifyChildren(_id);
+}
+
+template<class Transformation> void FlatObject<Transformation>::notifyFeatures() {
+    for(AbstractFeature<Transformation::Dimensions, typename Transformation::Type>* i = this->firstFeature(); i; i = i->nextFeature())
+        i->markDirty();
+}
+
+template<class Transformation> void FlatObject<Transformation>::setClean() {
+    if(!isDirty()) return;
+    _scene->sweep(true);
+}
+
+template<class Transformation> void FlatObject<Transformation>::doSetClean(const std::vector<AbstractObject<Transformation::Dimensions, typename Transformation::Type>*>&) {
+    /* Cleaning the whole scene in one sweep is cheaper than going up the
+       hierarchy from each object */
+    _scene->sweep(true);
+}
+
+template<class Transformation> auto FlatObject<Transformation>::doTransformationMatrices(const std::vector<AbstractObject<Transformation::Dimensions, typename Transformation::Type>*>& objects, const MatrixType& initialTransformationMatrix) const -> std::vector<MatrixType> {
+    CORRADE_ASSERT(_id == FlatScene<Transformation>::SceneId, "SceneGraph::FlatObject::transformationMatrices(): currently implemented only for the scene", {});
+
+    std::vector<FlatObject<Transformation>*> castObjects(objects.size());
+    for(std::size_t i = 0; i != objects.size(); ++i)
+        /** @todo Ensure this doesn't crash, somehow */
+        castObjects[i] = static_cast<FlatObject<Transformation>*>(objects[i]);
+
+    return _scene->transformationMatrices(castObjects, initialTransformationMatrix);
+}
+
+template<class Transformation> FlatScene<Transformation>::FlatScene(): _removedCount(0), _outOfOrder(false), _destroying(false) {}
+
+template<class Transformation> FlatScene<Transformation>::~FlatScene() {
+    /* Objects don't need to remove themselves from the scene, delete them
+       directly instead of recursively through their parents */
+    _destroying = true;
+    for(FlatObject<Transformation>* object: _objects) delete object;
+}
+
+template<class Transformation> void FlatScene<Transformation>::reserve(const std::size_t size) {
+    _transformations.reserve(size);
+    _absoluteTransformations.reserve(size);
+    _parents.reserve(size);
+    _childCounts.reserve(size);
+    _flags.reserve(size);
+    _objects.reserve(size);
+}
+
+template<class Transformation> UnsignedInt FlatScene<Transformation>::addObject(FlatObject<Transformation>* const object, const UnsignedInt parent) {
+    /* Appended after the parent, so the depth order is kept */
+    _transformations.emplace_back();
+    _absoluteTransformations.emplace_back();
+    _parents.push_back(parent);
+    _childCounts.push_back(0);
+    _flags.push_back(Flag::Dirty|Flag::Stale);
+    _objects.push_back(object);
+    if(parent != SceneId) ++_childCounts[parent];
+
+    return _objects.size() - 1;
+}
+
+template<class Transformation> void FlatScene<Transformation>::removeObject(const UnsignedInt id) {
+    if(_destroying) return;
+
+    if(_parents[id] != SceneId) --_childCounts[_parents[id]];
+    _flags[id] = Flag::Removed;
+    _objects[id] = nullptr;
+    ++_removedCount;
+
+    /* Destroy all children. If the order is kept, they are after the
+       object. */
+    for(std::size_t i = _outOfOrder ? 0 : id + 1; i != _objects.size() && _childCounts[id]; ++i)
+        if(_parents[i] == id && _objects[i]) delete _objects[i];
+}
+
+template<class Transformation> void FlatScene<Transformation>::setObjectParent(const UnsignedInt id, const UnsignedInt parent) {
+    if(_parents[id] == parent) return;
+
+    if(_parents[id] != SceneId) --_childCounts[_parents[id]];
+    if(parent != SceneId) {
+        ++_childCounts[parent];
+
+        /* Parent is now after the child, reorder on next sweep */
+        if(parent > id) _outOfOrder = true;
+    }
+    _parents[id] = parent;
+
+    _objects[id]->setDirty();
+}
+
+template<class Transformation> bool FlatScene<Transformation>::isObjectDirty(const UnsignedInt id) const {
+    for(UnsignedInt i = id; i != SceneId; i = _parents[i])
+        if(_flags[i] & Flag::Dirty) return true;
+
+    return false;
+}
+
+template<class Transformation> auto FlatScene<Transformation>::objectAbsoluteTransformation(const UnsignedInt id) const -> DataType {
+    /* Find topmost object with stale cached transformation */
+    UnsignedInt top = SceneId;
+    for(UnsignedInt i = id; i != SceneId; i = _parents[i])
+        if(_flags[i] & Flag::Stale) top = i;
+
+    /* Nothing is stale, cached transformation is up-to-date */
+    if(top == SceneId) return _absoluteTransformations[id];
+
+    /* Compose transformations up to the topmost stale object and then with
+       cached transformation of its parent */
+    DataType transformation = _transformations[id];
+    for(UnsignedInt i = id; i != top; ) {
+        i = _parents[i];
+        transformation = Implementation::Transformation<Transformation>::compose(_transformations[i], transformation);
+    }
+    if(_parents[top] != SceneId)
+        transformation = Implementation::Transformation<Transformation>::compose(_absoluteTransformations[_parents[top]], transformation);
+
+    return transformation;
+}
+
+template<class Transformation> auto FlatScene<Transformation>::transformationMatrices(const std::vector<FlatObject<Transformation>*>& objects, const MatrixType& initialTransformationMatrix) const -> std::vector<MatrixType> {
+    const std::vector<DataType> transformations = this->transformations(objects, Implementation::Transformation<Transformation>::fromMatrix(initialTransformationMatrix));
+    std::vector<MatrixType> transformationMatrices(transformations.size());
+    for(std::size_t i = 0; i != transformations.size(); ++i)
+        transformationMatrices[i] = Implementation::Transformation<Transformation>::toMatrix(transformations[i]);
+
+    return transformationMatrices;
+}
+
+template<class Transformation> auto FlatScene<Transformation>::transformations(const std::vector<FlatObject<Transformation>*>& objects, const DataType& initialTransformation) const -> std::vector<DataType> {
+    /* The scene is logically const, only the caches and storage order are
+       updated */
+    const_cast<FlatScene<Transformation>*>(this)->sweep(false);
+
+    std::vector<DataType> transformations(objects.size());
+    for(std::size_t i = 0; i != objects.size(); ++i) {
+        CORRADE_ASSERT(objects[i]->_scene == this, "SceneGraph::FlatScene::transformations(): the objects are not part of the same scene", {});
+
+        const UnsignedInt id = objects[i]->_id;
+        transformations[i] = id == SceneId ? initialTransformation :
+            Implementation::Transformation<Transformation>::compose(initialTransformation, _absoluteTransformations[id]);
+    }
+
+    return transformations;
+}
+
+template<class Transformation> void FlatScene<Transformation>::setClean() {
+    sweep(true);
+}
+
+template<class Transformation> void FlatScene<Transformation>::notifyChildren(UnsignedInt id) {
+    /* Children need to be after their parents to be found in one pass. The
+       object ID might change. */
+    if(_outOfOrder) {
+        FlatObject<Transformation>* const object = _objects[id];
+        defragment();
+        id = object->_id;
+    }
+
+    /* Propagate the mark down the same way as in sweep(). Children which are
+       already dirty have their subtree notified, so they are skipped. */
+    for(std::size_t i = id + 1; i != _flags.size(); ++i) {
+        const UnsignedInt parent = _parents[i];
+        if(!_objects[i] || parent == SceneId || _flags[i] & Flag::Dirty) continue;
+        if(parent != id && !(_flags[parent] & Flag::Notified)) continue;
+
+        _flags[i] |= Flag::Notified;
+        _objects[i]->notifyFeatures();
+    }
+
+    /* Clear the marks used for propagation */
+    for(std::size_t i = id + 1; i != _flags.size(); ++i)
+        _flags[i] &= ~Flag::Notified;
+}
+
+template<class Transformation> void FlatScene<Transformation>::defragment() {
+    const std::size_t oldSize = _objects.size();
+    const std::size_t newSize = oldSize - _removedCount;
+
+    /* Children of each object, scene children are at offset 0 and children of
+       object `i` at offset `i + 1` (SceneId + 1 wraps around to zero) */
+    std::vector<UnsignedInt> childOffsets(oldSize + 2);
+    for(std::size_t i = 0; i != oldSize; ++i) if(_objects[i])
+        ++childOffsets[_parents[i] + 2];
+    for(std::size_t i = 1; i != childOffsets.size(); ++i)
+        childOffsets[i] += childOffsets[i - 1];
+    std::vector<UnsignedInt> children(newSize);
+    for(std::size_t i = 0; i != oldSize; ++i) if(_objects[i])
+        children[childOffsets[_parents[i] + 1]++] = i;
+
+    /* Breadth-first traversal from the scene gives the depth order, after the
+       fill above the offsets are shifted by one */
+    std::vector<UnsignedInt> order;
+    order.reserve(newSize);
+    order.insert(order.end(), children.begin(), children.begin() + childOffsets[0]);
+    for(std::size_t i = 0; i != order.size(); ++i)
+        order.insert(order.end(), children.begin() + childOffsets[order[i]], children.begin() + childOffsets[order[i] + 1]);
+    CORRADE_INTERNAL_ASSERT(order.size() == newSize);
+
+    /* Permute the arrays */
+    std::vector<UnsignedInt> newIds(oldSize);
+    for(std::size_t i = 0; i != newSize; ++i) newIds[order[i]] = i;
+    std::vector<DataType> transformations(newSize), absoluteTransformations(newSize);
+    std::vector<UnsignedInt> parents(newSize), childCounts(newSize);
+    std::vector<Flags> flags(newSize);
+    std::vector<FlatObject<Transformation>*> objects(newSize);
+    for(std::size_t i = 0; i != newSize; ++i) {
+        const UnsignedInt old = order[i];
+        transformations[i] = _transformations[old];
+        absoluteTransformations[i] = _absoluteTransformations[old];
+        parents[i] = _parents[old] == SceneId ? SceneId : newIds[_parents[old]];
+        childCounts[i] = _childCounts[old];
+        flags[i] = _flags[old];
+        objects[i] = _objects[old];
+        objects[i]->_id = i;
+    }
+
+    std::swap(_transformations, transformations);
+    std::swap(_absoluteTransformations, absoluteTransformations);
+    std::swap(_parents, parents);
+    std::swap(_childCounts, childCounts);
+    std::swap(_flags, flags);
+    std::swap(_objects, objects);
+    _removedCount = 0;
+    _outOfOrder = false;
+}
+
+template<class Transformation> void FlatScene<Transformation>::sweep(const bool cleanFeatures) {
+    if(_removedCount || _outOfOrder) defragment();
+
+    /* Parents are always before children, so their transformation is already
+       computed and the change can be propagated down just by looking at the
+       parent flags */
+    for(std::size_t i = 0; i != _flags.size(); ++i) {
+        const UnsignedInt parent = _parents[i];
+        const Flags parentFlags = parent == SceneId ? Flags() : _flags[parent];
+        Flags flags = _flags[i];
+
+        if(flags & Flag::Stale || parentFlags & Flag::Recomputed) {
+            _absoluteTransformations[i] = parent == SceneId ? _transformations[i] :
+                Implementation::Transformation<Transformation>::compose(_absoluteTransformations[parent], _transformations[i]);
+            flags = (flags & ~Flag::Stale)|Flag::Recomputed;
+        }
+
+        if(cleanFeatures && (flags & Flag::Dirty || parentFlags & Flag::Cleaned)) {
+            Implementation::cleanFeatures<Transformation>(*_objects[i], _absoluteTransformations[i]);
+            flags = (flags & ~Flag::Dirty)|Flag::Cleaned;
+        }
+
+        _flags[i] = flags;
+    }
+
+    /* Clear the marks used for propagation */
+    for(Flags& flags: _flags) flags &= ~(Flag::Recomputed|Flag::Cleaned);
+}
+
+}}
+
+#endif
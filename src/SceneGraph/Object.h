@@ -28,6 +28,8 @@
  * @brief Class Magnum::SceneGraph::Object
  */
 
+#include <unordered_map>
+#include <unordered_set>
 #include <Containers/EnumSet.h>
 
 #include "AbstractFeature.h"
@@ -40,8 +42,7 @@ namespace Magnum { namespace SceneGraph {
 namespace Implementation {
     enum class ObjectFlag: UnsignedByte {
         Dirty = 1 << 0,
-        Visited = 1 << 1,
-        Joint = 1 << 2
+        Listed = 1 << 1
     };
 
     typedef Containers::EnumSet<ObjectFlag, UnsignedByte> ObjectFlags;
@@ -101,6 +102,7 @@ template<class Transformation> class Object: public AbstractObject<Transformatio
 {
     friend class Containers::LinkedList<Object<Transformation>>;
     friend class Containers::LinkedListItem<Object<Transformation>, Object<Transformation>>;
+    friend class Scene<Transformation>;
 
     #ifndef DOXYGEN_GENERATING_OUTPUT
     Object(const Object<Transformation>&) = delete;
@@ -122,8 +124,8 @@ template<class Transformation> class Object: public AbstractObject<Transformatio
         /**
          * @brief Destructor
          *
-         * Removes itself from parent's children list and destroys all own
-         * children.
+         * Removes itself from parent's children list and from scene dirty
+         * list and destroys all own children.
          */
         ~Object();
 
@@ -234,6 +236,9 @@ template<class Transformation> class Object: public AbstractObject<Transformatio
         /**
          * @brief Transformation relative to root object
          *
+         * If the object is clean, returns transformation cached in last call
+         * to @ref setClean(), otherwise the transformation is composed from
+         * transformations of the object and all its dirty parents.
          * @see absoluteTransformationMatrix()
          */
         typename Transformation::DataType absoluteTransformation() const;
@@ -251,7 +256,11 @@ template<class Transformation> class Object: public AbstractObject<Transformatio
          * @brief Transformations of given group of objects relative to this object
          *
          * All transformations can be premultiplied with @p initialTransformation,
-         * if specified.
+         * if specified. Transformation of each object involved is computed
+         * only once, for clean objects the cached absolute transformation is
+         * used. The objects are not modified, so it's possible to call
+         * this concurrently for different sets of objects, as long as the
+         * hierarchy isn't changed in the meantime.
          * @see transformationMatrices()
          */
         /* `objects` passed by copy intentionally (to allow move from
@@ -269,8 +278,9 @@ template<class Transformation> class Object: public AbstractObject<Transformatio
         /**
          * @brief Clean absolute transformations of given set of objects
          *
-         * Only dirty objects in the list are cleaned.
-         * @see setClean()
+         * Only dirty objects in the list are cleaned. Count of cleaned
+         * objects is added to @ref Scene::cleanedObjectCount().
+         * @see setClean(), @ref Scene::setClean()
          */
         /* `objects` passed by copy intentionally (to avoid copy internally) */
         static void setClean(std::vector<Object<Transformation>*> objects);
@@ -304,7 +314,10 @@ template<class Transformation> class Object: public AbstractObject<Transformatio
 
         std::vector<MatrixType> doTransformationMatrices(const std::vector<AbstractObject<Transformation::Dimensions, typename Transformation::Type>*>& objects, const MatrixType& initialTransformationMatrix) const override final;
 
-        typename Transformation::DataType MAGNUM_SCENEGRAPH_LOCAL computeJointTransformation(const std::vector<Object<Transformation>*>& jointObjects, std::vector<typename Transformation::DataType>& jointTransformations, const std::size_t joint, const typename Transformation::DataType& initialTransformation) const;
+        /* Scratch storage for transformations() and setClean() */
+        typedef std::unordered_map<const Object<Transformation>*, std::size_t> JointIds;
+        typedef std::unordered_set<const Object<Transformation>*> VisitedObjects;
+        enum: std::size_t { NotJoint = ~std::size_t(0) };
 
         bool MAGNUM_SCENEGRAPH_LOCAL doIsDirty() const override final { return isDirty(); }
         void MAGNUM_SCENEGRAPH_LOCAL doSetDirty() override final { setDirty(); }
@@ -313,10 +326,16 @@ template<class Transformation> class Object: public AbstractObject<Transformatio
 
         void MAGNUM_SCENEGRAPH_LOCAL setClean(const typename Transformation::DataType& absoluteTransformation);
 
+        void MAGNUM_SCENEGRAPH_LOCAL setDirtyInternal();
+        void MAGNUM_SCENEGRAPH_LOCAL addToDirtyList(Scene<Transformation>* scene = nullptr);
+        void MAGNUM_SCENEGRAPH_LOCAL addChildrenToDirtyList(Scene<Transformation>* scene);
+        void MAGNUM_SCENEGRAPH_LOCAL removeFromDirtyList(Scene<Transformation>* scene);
+
         typedef Implementation::ObjectFlag Flag;
         typedef Implementation::ObjectFlags Flags;
-        UnsignedShort counter;
         Flags flags;
+        UnsignedInt _dirtyListIndex; /* Valid only if the object is listed */
+        typename Transformation::DataType _absoluteTransformation;
 };
 
 }}
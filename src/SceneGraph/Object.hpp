@@ -25,14 +25,13 @@
 */
 
 /** @file
- * @brief @ref compilation-speedup-hpp "Template implementation" for @ref AbstractObject.h, @ref AbstractTransformation.h and @ref Object.h
+ * @brief @ref compilation-speedup-hpp "Template implementation" for @ref AbstractObject.h, @ref AbstractTransformation.h, @ref Object.h and @ref Scene.h
  */
 
 #include "AbstractTransformation.h"
 #include "Object.h"
 
 #include <algorithm>
-#include <stack>
 
 #include "Scene.h"
 
@@ -43,11 +42,17 @@ template<UnsignedInt dimensions, class T> AbstractObject<dimensions, T>::~Abstra
 
 template<UnsignedInt dimensions, class T> AbstractTransformation<dimensions, T>::AbstractTransformation() {}
 
-template<class Transformation> Object<Transformation>::Object(Object<Transformation>* parent): counter(0xFFFFu), flags(Flag::Dirty) {
+template<class Transformation> Object<Transformation>::Object(Object<Transformation>* parent): flags(Flag::Dirty) {
     setParent(parent);
 }
 
-template<class Transformation> Object<Transformation>::~Object() = default;
+template<class Transformation> Object<Transformation>::~Object() {
+    /* Destroy children while this object is still complete, so they can find
+       the scene to remove themselves from its dirty list */
+    while(Object<Transformation>* child = firstChild()) delete child;
+
+    if(flags & Flag::Listed) removeFromDirtyList(scene());
+}
 
 template<class Transformation> Scene<Transformation>* Object<Transformation>::scene() {
     Object<Transformation>* p(this);
@@ -74,20 +79,40 @@ template<class Transformation> Object<Transformation>& Object<Transformation>::s
     /** @todo Assert for setting parent to scene */
     if(this->parent() == parent || isScene()) return *this;
 
-    /* Object cannot be parented to its child */
-    Object<Transformation>* p = parent;
-    while(p) {
-        /** @todo Assert for this */
+    /* Object cannot be parented to itself or its child. Object without
+       children can't be ancestor of anything, so the check can be skipped. */
+    /** @todo Assert for this */
+    if(parent == this) return *this;
+    if(hasChildren()) for(Object<Transformation>* p = parent; p; p = p->parent())
         if(p == this) return *this;
-        p = p->parent();
-    }
 
     /* Remove the object from old parent children list */
-    if(this->parent()) this->parent()->Containers::template LinkedList<Object<Transformation>>::cut(this);
+    if(this->parent()) {
+        /* If moving to another scene, remove the object and all its children
+           from dirty list of the old one */
+        Scene<Transformation>* oldScene = scene();
+        if(oldScene && oldScene != (parent ? parent->scene() : nullptr)) {
+            auto inSubtree = [this](Object<Transformation>* o) {
+                for(; o; o = o->parent()) if(o == this) return true;
+                return false;
+            };
+            std::vector<Object<Transformation>*>& dirtyObjects = oldScene->_dirtyObjects;
+            for(Object<Transformation>* o: dirtyObjects)
+                if(inSubtree(o)) o->flags &= ~Flag::Listed;
+            dirtyObjects.erase(std::remove_if(dirtyObjects.begin(), dirtyObjects.end(), [](Object<Transformation>* o) { return !(o->flags & Flag::Listed); }), dirtyObjects.end());
+            for(std::size_t i = 0; i != dirtyObjects.size(); ++i)
+                dirtyObjects[i]->_dirtyListIndex = i;
+        }
+
+        this->parent()->Containers::template LinkedList<Object<Transformation>>::cut(this);
+    }
 
     /* Add the object to list of new parent */
     if(parent) parent->Containers::LinkedList<Object<Transformation>>::insert(this);
 
+    /* Object which was already dirty might need to be listed now (e.g. newly
+       created object or object moved under clean parent) */
+    addToDirtyList();
     setDirty();
     return *this;
 }
@@ -104,6 +129,7 @@ template<class Transformation> Object<Transformation>& Object<Transformation>::s
 }
 
 template<class Transformation> typename Transformation::DataType Object<Transformation>::absoluteTransformation() const {
+    if(!(flags & Flag::Dirty)) return _absoluteTransformation;
     if(!parent()) return Transformation::transformation();
     return Implementation::Transformation<Transformation>::compose(parent()->absoluteTransformation(), Transformation::transformation());
 }
@@ -113,18 +139,53 @@ template<class Transformation> void Object<Transformation>::setDirty() {
        nothing to do */
     if(flags & Flag::Dirty) return;
 
-    Object<Transformation>* self = static_cast<Object<Transformation>*>(this);
+    /* The parent is clean, so this is root of dirty subtree */
+    addToDirtyList();
+    setDirtyInternal();
+}
+
+template<class Transformation> void Object<Transformation>::setDirtyInternal() {
+    /* Mark object as dirty */
+    flags |= Flag::Dirty;
 
     /* Make all features dirty */
-    for(AbstractFeature<Transformation::Dimensions, typename Transformation::Type>* i = self->firstFeature(); i; i = i->nextFeature())
+    for(AbstractFeature<Transformation::Dimensions, typename Transformation::Type>* i = this->firstFeature(); i; i = i->nextFeature())
         i->markDirty();
 
-    /* Make all children dirty */
-    for(Object<Transformation>* i = self->firstChild(); i; i = i->nextSibling())
-        i->setDirty();
+    /* Make all clean children dirty, children of dirty object are already
+       dirty */
+    for(Object<Transformation>* i = firstChild(); i; i = i->nextSibling())
+        if(!i->isDirty()) i->setDirtyInternal();
+}
 
-    /* Mark object as dirty */
-    flags |= Flag::Dirty;
+template<class Transformation> void Object<Transformation>::addToDirtyList(Scene<Transformation>* scene) {
+    /* Already listed or covered by dirty parent, which is either listed or
+       has dirty parent itself */
+    if((flags & Flag::Listed) || (parent() && parent()->isDirty())) return;
+
+    /* Not part of any scene, nothing to do */
+    if(!scene && !(scene = this->scene())) return;
+
+    _dirtyListIndex = scene->_dirtyObjects.size();
+    scene->_dirtyObjects.push_back(this);
+    flags |= Flag::Listed;
+}
+
+template<class Transformation> void Object<Transformation>::removeFromDirtyList(Scene<Transformation>* const scene) {
+    /* Order of the list doesn't matter, replace the object with the last one
+       so the removal is constant-time */
+    std::vector<Object<Transformation>*>& dirtyObjects = scene->_dirtyObjects;
+    Object<Transformation>* const last = dirtyObjects.back();
+    dirtyObjects[_dirtyListIndex] = last;
+    last->_dirtyListIndex = _dirtyListIndex;
+    dirtyObjects.pop_back();
+    flags &= ~Flag::Listed;
+}
+
+template<class Transformation> void Object<Transformation>::addChildrenToDirtyList(Scene<Transformation>* scene) {
+    /* Dirty children of cleaned object are now roots of dirty subtrees */
+    for(Object<Transformation>* i = firstChild(); i; i = i->nextSibling())
+        if(i->isDirty()) i->addToDirtyList(scene);
 }
 
 template<class Transformation> void Object<Transformation>::setClean() {
@@ -132,11 +193,11 @@ template<class Transformation> void Object<Transformation>::setClean() {
     if(!(flags & Flag::Dirty)) return;
 
     /* Collect all parents, compute base transformation */
-    std::stack<Object<Transformation>*> objects;
+    std::vector<Object<Transformation>*> objects;
     typename Transformation::DataType absoluteTransformation;
     Object<Transformation>* p = static_cast<Object<Transformation>*>(this);
     for(;;) {
-        objects.push(p);
+        objects.push_back(p);
 
         p = p->parent();
 
@@ -152,9 +213,8 @@ template<class Transformation> void Object<Transformation>::setClean() {
     }
 
     /* Clean features on every collected object, going down from root object */
-    while(!objects.empty()) {
-        Object<Transformation>* o = objects.top();
-        objects.pop();
+    for(auto it = objects.rbegin(); it != objects.rend(); ++it) {
+        Object<Transformation>* o = *it;
 
         /* Compose transformation and clean object */
         absoluteTransformation = Implementation::Transformation<Transformation>::compose(absoluteTransformation, o->transformation());
@@ -162,6 +222,12 @@ template<class Transformation> void Object<Transformation>::setClean() {
         o->setClean(absoluteTransformation);
         CORRADE_ASSERT(!o->isDirty(), "SceneGraph::Object::setClean(): original implementation was not called", );
     }
+
+    /* Update scene dirty list and statistics */
+    Scene<Transformation>* scene = (p ? p : objects.back())->scene();
+    if(!scene) return;
+    for(Object<Transformation>* o: objects) o->addChildrenToDirtyList(scene);
+    scene->_cleanedObjectCount += objects.size();
 }
 
 template<class Transformation> auto Object<Transformation>::doTransformationMatrices(const std::vector<AbstractObject<Transformation::Dimensions, typename Transformation::Type>*>& objects, const MatrixType& initialTransformationMatrix) const -> std::vector<MatrixType> {
@@ -193,98 +259,166 @@ divided into two groups:
    child in the subtree
  - "non-joints", i.e. paths between joints
 
-Then for all joints their transformation (relative to parent joint) is
-computed and recursively concatenated together. Resulting transformations for
-joints which were originally in `object` list is then returned.
+The joints are found by walking up from each requested object until an
+already visited object, a joint, a clean object or the root is reached. Clean
+objects have their absolute transformation cached, so they are joints without
+parent joint. Reaching a visited
+non-joint object means it's a branch point, so it becomes a joint. Each object
+is walked over at most once, so this is linear in object count.
+
+Then for all joints their transformation relative to parent joint is computed
+by walking the non-joint path above them (again, each object is on at most one
+such path) and the joints are composed together in order from the root,
+without recursion. Both steps can be done in parallel -- the paths are
+independent and the joint tree is split into independent subtrees, each
+composed on one thread. Resulting transformations for joints which were
+originally in `object` list is then returned.
 */
 template<class Transformation> std::vector<typename Transformation::DataType> Object<Transformation>::transformations(std::vector<Object<Transformation>*> objects, const typename Transformation::DataType& initialTransformation) const {
-    CORRADE_ASSERT(objects.size() < 0xFFFFu, "SceneGraph::Object::transformations(): too large scene", std::vector<typename Transformation::DataType>{});
+    /* Scene object */
+    const Scene<Transformation>* scene = this->scene();
 
-    /* Remember object count for later */
-    std::size_t objectCount = objects.size();
+    /* Nearest common ancestor not yet implemented - assert this is done on scene */
+    CORRADE_ASSERT(scene == this, "SceneGraph::Object::transformationMatrices(): currently implemented only for Scene", std::vector<typename Transformation::DataType>{});
+
+    /* Joint indices and visited marks are stored outside of the objects, so
+       the objects aren't modified and there is no limit on their count.
+       Visited objects which are not joints have NotJoint as value. */
+    JointIds jointIds;
 
     /* Mark all original objects as joints and create initial list of joints
-       from them */
-    for(std::size_t i = 0; i != objects.size(); ++i) {
+       from them. Multiple occurences of one object in the array keep index
+       of the first one. */
+    const std::size_t objectCount = objects.size();
+    jointIds.reserve(objectCount);
+    for(std::size_t i = 0; i != objectCount; ++i) {
         CORRADE_INTERNAL_ASSERT(objects[i]);
-
-        /* Multiple occurences of one object in the array, don't overwrite it
-           with different counter */
-        if(objects[i]->counter != 0xFFFFu) continue;
-
-        objects[i]->counter = UnsignedShort(i);
-        objects[i]->flags |= Flag::Joint;
+        jointIds.emplace(objects[i], i);
     }
-    std::vector<Object<Transformation>*> jointObjects(objects);
+    std::vector<Object<Transformation>*> jointObjects(std::move(objects));
 
-    /* Scene object */
-    const Scene<Transformation>* scene = this->scene();
+    /* Walk up from each requested dirty object (first occurence only), mark
+       branch points and clean parents as joints */
+    for(std::size_t i = 0; i != objectCount; ++i) {
+        if(jointIds.find(jointObjects[i])->second != i || !jointObjects[i]->isDirty()) continue;
 
-    /* Nearest common ancestor not yet implemented - assert this is done on scene */
-    CORRADE_ASSERT(scene == this, "SceneGraph::Object::transformationMatrices(): currently implemented only for Scene", std::vector<typename Transformation::DataType>{});
+        for(Object<Transformation>* o = jointObjects[i]; ; ) {
+            Object<Transformation>* parent = o->parent();
 
-    /* Mark all objects up the hierarchy as visited */
-    auto it = objects.begin();
-    while(!objects.empty()) {
-        /* Already visited, remove and continue to next (duplicate occurence) */
-        if((*it)->flags & Flag::Visited) {
-            it = objects.erase(it);
-            continue;
-        }
+            /* Root object, done */
+            if(!parent) {
+                CORRADE_ASSERT(o == scene, "SceneGraph::Object::transformations(): the objects are not part of the same tree", std::vector<typename Transformation::DataType>{});
+                break;
+            }
 
-        /* Mark the object as visited */
-        (*it)->flags |= Flag::Visited;
+            /* Clean object has cached absolute transformation, no need to go
+               further */
+            if(!parent->isDirty()) {
+                const auto inserted = jointIds.emplace(parent, jointObjects.size());
+                if(inserted.second) jointObjects.push_back(parent);
+                break;
+            }
 
-        Object<Transformation>* parent = (*it)->parent();
+            /* Not visited yet, mark it and go up the hierarchy */
+            const auto inserted = jointIds.emplace(parent, NotJoint);
+            if(inserted.second) {
+                o = parent;
+                continue;
+            }
 
-        /* If this is root object, remove from list */
-        if(!parent) {
-            CORRADE_ASSERT(*it == scene, "SceneGraph::Object::transformations(): the objects are not part of the same tree", std::vector<typename Transformation::DataType>{});
-            it = objects.erase(it);
+            /* Visited non-joint, mark it as joint. Everything above is already
+               visited, done. */
+            if(inserted.first->second == NotJoint) {
+                inserted.first->second = jointObjects.size();
+                jointObjects.push_back(parent);
+            }
 
-        /* Parent is an joint or already visited - remove current from list */
-        } else if(parent->flags & (Flag::Visited|Flag::Joint)) {
-            it = objects.erase(it);
+            break;
+        }
+    }
 
-            /* If not already marked as joint, mark it as such and add it to
-               list of joint objects */
-            if(!(parent->flags & Flag::Joint)) {
-                CORRADE_ASSERT(jointObjects.size() < 0xFFFFu,
-                               "SceneGraph::Object::transformations(): too large scene", std::vector<typename Transformation::DataType>{});
-                CORRADE_INTERNAL_ASSERT(parent->counter == 0xFFFFu);
-                parent->counter = UnsignedShort(jointObjects.size());
-                parent->flags |= Flag::Joint;
-                jointObjects.push_back(parent);
+    /* Use more threads only if there's enough work for them */
+    const std::size_t jointCount = jointObjects.size();
+    Implementation::SceneThreadPool& threadPool = scene->_threadPool;
+    const std::size_t threadCount = std::max(std::min(threadPool.threadCount(), jointCount/1024), std::size_t(1));
+
+    /* Transformation of each joint relative to its parent joint (or
+       including the initial transformation, if there is no parent joint).
+       Each joint has its own path, so they can be computed in parallel. */
+    std::vector<typename Transformation::DataType> jointTransformations(jointCount);
+    std::vector<std::size_t> parentJoints(jointCount, NotJoint);
+    threadPool.parallelFor(jointCount, threadCount, [&](const std::size_t begin, const std::size_t end) {
+        for(std::size_t i = begin; i != end; ++i) {
+            /* Duplicate occurence, will be copied from the first one */
+            if(i < objectCount && jointIds.find(jointObjects[i])->second != i) continue;
+
+            /* Clean object, use the cached transformation */
+            if(!jointObjects[i]->isDirty()) {
+                jointTransformations[i] = Implementation::Transformation<Transformation>::compose(initialTransformation, jointObjects[i]->_absoluteTransformation);
+                continue;
             }
 
-        /* Else go up the hierarchy */
-        } else *it = parent;
+            typename Transformation::DataType transformation = jointObjects[i]->transformation();
+            Object<Transformation>* parent = jointObjects[i]->parent();
+            for(; parent; parent = parent->parent()) {
+                const std::size_t parentJoint = jointIds.find(parent)->second;
+                if(parentJoint != NotJoint) {
+                    parentJoints[i] = parentJoint;
+                    break;
+                }
 
-        /* Cycle if reached end */
-        if(it == objects.end()) it = objects.begin();
-    }
+                transformation = Implementation::Transformation<Transformation>::compose(parent->transformation(), transformation);
+            }
 
-    /* Array of absolute transformations in joints */
-    std::vector<typename Transformation::DataType> jointTransformations(jointObjects.size());
+            jointTransformations[i] = parent ? transformation :
+                Implementation::Transformation<Transformation>::compose(initialTransformation, transformation);
+        }
+    });
+
+    /* Children of each joint in the joint tree, root joints are stored at
+       the end as children of (virtual) joint `jointCount` */
+    std::vector<std::size_t> childOffsets(jointCount + 3);
+    for(std::size_t i = 0; i != jointCount; ++i)
+        ++childOffsets[(parentJoints[i] == NotJoint ? jointCount : parentJoints[i]) + 2];
+    for(std::size_t i = 2; i != childOffsets.size(); ++i)
+        childOffsets[i] += childOffsets[i - 1];
+    std::vector<std::size_t> children(jointCount);
+    for(std::size_t i = 0; i != jointCount; ++i)
+        children[childOffsets[(parentJoints[i] == NotJoint ? jointCount : parentJoints[i]) + 1]++] = i;
+
+    /* Compose joints breadth-first from the root on this thread until there
+       is enough independent subtrees to distribute among the threads. Deep
+       chains are thus processed fully here. */
+    std::vector<std::size_t> subtrees(children.begin() + childOffsets[jointCount], children.end());
+    for(std::size_t i = 0; threadCount != 1 && i != subtrees.size() && subtrees.size() - i < threadCount*16; ++i) {
+        const std::size_t joint = subtrees[i];
+        if(parentJoints[joint] != NotJoint)
+            jointTransformations[joint] = Implementation::Transformation<Transformation>::compose(jointTransformations[parentJoints[joint]], jointTransformations[joint]);
+        subtrees.insert(subtrees.end(), children.begin() + childOffsets[joint], children.begin() + childOffsets[joint + 1]);
+        subtrees[i] = NotJoint;
+    }
 
-    /* Compute transformations for all joints */
-    for(std::size_t i = 0; i != jointTransformations.size(); ++i)
-        computeJointTransformation(jointObjects, jointTransformations, i, initialTransformation);
+    /* Compose the remaining subtrees depth-first, using explicit stack. Each
+       joint depends only on its ancestors, so the result is the same
+       regardless of thread count. */
+    subtrees.erase(std::remove(subtrees.begin(), subtrees.end(), std::size_t(NotJoint)), subtrees.end());
+    threadPool.parallelFor(subtrees.size(), threadCount, [&](const std::size_t begin, const std::size_t end) {
+        std::vector<std::size_t> stack(subtrees.begin() + begin, subtrees.begin() + end);
+        while(!stack.empty()) {
+            const std::size_t joint = stack.back();
+            stack.pop_back();
+
+            if(parentJoints[joint] != NotJoint)
+                jointTransformations[joint] = Implementation::Transformation<Transformation>::compose(jointTransformations[parentJoints[joint]], jointTransformations[joint]);
+            stack.insert(stack.end(), children.begin() + childOffsets[joint], children.begin() + childOffsets[joint + 1]);
+        }
+    });
 
     /* Copy transformation for second or next occurences from first occurence
        of duplicate object */
     for(std::size_t i = 0; i != objectCount; ++i) {
-        if(jointObjects[i]->counter != i)
-            jointTransformations[i] = jointTransformations[jointObjects[i]->counter];
-    }
-
-    /* All visited marks are now cleaned, clean joint marks and counters */
-    for(auto i: jointObjects) {
-        /* All not-already cleaned objects (...duplicate occurences) should
-           have joint mark */
-        CORRADE_INTERNAL_ASSERT(i->counter == 0xFFFFu || i->flags & Flag::Joint);
-        i->flags &= ~Flag::Joint;
-        i->counter = 0xFFFFu;
+        const std::size_t first = jointIds.find(jointObjects[i])->second;
+        if(first != i) jointTransformations[i] = jointTransformations[first];
     }
 
     /* Shrink the array to contain only transformations of requested objects and return */
@@ -292,43 +426,6 @@ template<class Transformation> std::vector<typename Transformation::DataType> Ob
     return jointTransformations;
 }
 
-template<class Transformation> typename Transformation::DataType Object<Transformation>::computeJointTransformation(const std::vector<Object<Transformation>*>& jointObjects, std::vector<typename Transformation::DataType>& jointTransformations, const std::size_t joint, const typename Transformation::DataType& initialTransformation) const {
-    Object<Transformation>* o = jointObjects[joint];
-
-    /* Transformation already computed ("unvisited" by this function before
-       either due to recursion or duplicate object occurences), done */
-    if(!(o->flags & Flag::Visited)) return jointTransformations[joint];
-
-    /* Initialize transformation */
-    jointTransformations[joint] = o->transformation();
-
-    /* Go up until next joint or root */
-    for(;;) {
-        /* Clean visited mark */
-        CORRADE_INTERNAL_ASSERT(o->flags & Flag::Visited);
-        o->flags &= ~Flag::Visited;
-
-        Object<Transformation>* parent = o->parent();
-
-        /* Root object, compose transformation with initial, done */
-        if(!parent) {
-            CORRADE_INTERNAL_ASSERT(o->isScene());
-            return (jointTransformations[joint] =
-                Implementation::Transformation<Transformation>::compose(initialTransformation, jointTransformations[joint]));
-
-        /* Joint object, compose transformation with the joint, done */
-        } else if(parent->flags & Flag::Joint) {
-            return (jointTransformations[joint] =
-                Implementation::Transformation<Transformation>::compose(computeJointTransformation(jointObjects, jointTransformations, parent->counter, initialTransformation), jointTransformations[joint]));
-
-        /* Else compose transformation with parent, go up the hierarchy */
-        } else {
-            jointTransformations[joint] = Implementation::Transformation<Transformation>::compose(parent->transformation(), jointTransformations[joint]);
-            o = parent;
-        }
-    }
-}
-
 template<class Transformation> void Object<Transformation>::doSetClean(const std::vector<AbstractObject<Transformation::Dimensions, typename Transformation::Type>*>& objects) {
     std::vector<Object<Transformation>*> castObjects(objects.size());
     for(std::size_t i = 0; i != objects.size(); ++i)
@@ -346,44 +443,52 @@ template<class Transformation> void Object<Transformation>::setClean(std::vector
     /* No dirty objects left, done */
     if(objects.empty()) return;
 
-    /* Add non-clean parents to the list. Mark each added object as visited, so
-       they aren't added more than once */
+    /* Add non-clean parents to the list. Remember each added object as
+       visited, so they aren't added more than once */
+    VisitedObjects visited;
     for(std::size_t end = objects.size(), i = 0; i != end; ++i) {
         Object<Transformation>* o = objects[i];
-        o->flags |= Flag::Visited;
+        visited.insert(o);
 
         Object<Transformation>* parent = o->parent();
-        while(parent && !(parent->flags & Flag::Visited) && parent->isDirty()) {
+        while(parent && !visited.count(parent) && parent->isDirty()) {
+            visited.insert(parent);
             objects.push_back(parent);
             parent = parent->parent();
         }
     }
 
-    /* Cleanup all marks */
-    for(auto o: objects) o->flags &= ~Flag::Visited;
-
     /* Compute absolute transformations */
     Scene<Transformation>* scene = objects[0]->scene();
     CORRADE_ASSERT(scene, "Object::setClean(): objects must be part of some scene", );
     std::vector<typename Transformation::DataType> transformations(scene->transformations(objects));
 
     /* Go through all objects and clean them */
+    std::size_t cleanedCount = 0;
     for(std::size_t i = 0; i != objects.size(); ++i) {
         /* The object might be duplicated in the list, don't clean it more than once */
         if(!objects[i]->isDirty()) continue;
 
         objects[i]->setClean(transformations[i]);
         CORRADE_ASSERT(!objects[i]->isDirty(), "SceneGraph::Object::setClean(): original implementation was not called", );
+        ++cleanedCount;
     }
+
+    /* Update scene dirty list and statistics */
+    for(Object<Transformation>* o: objects) o->addChildrenToDirtyList(scene);
+    scene->_cleanedObjectCount += cleanedCount;
 }
 
-template<class Transformation> void Object<Transformation>::setClean(const typename Transformation::DataType& absoluteTransformation) {
+namespace Implementation {
+
+/* Shared with FlatObject */
+template<class Transformation> void cleanFeatures(AbstractObject<Transformation::Dimensions, typename Transformation::Type>& object, const typename Transformation::DataType& absoluteTransformation) {
     /* "Lazy storage" for transformation matrix and inverted transformation matrix */
     CachedTransformations cached;
-    MatrixType matrix, invertedMatrix;
+    typename DimensionTraits<Transformation::Dimensions, typename Transformation::Type>::MatrixType matrix, invertedMatrix;
 
     /* Clean all features */
-    for(AbstractFeature<Transformation::Dimensions, typename Transformation::Type>* i = this->firstFeature(); i; i = i->nextFeature()) {
+    for(AbstractFeature<Transformation::Dimensions, typename Transformation::Type>* i = object.firstFeature(); i; i = i->nextFeature()) {
         /* Cached absolute transformation, compute it if it wasn't
             computed already */
         if(i->cachedTransformations() & CachedTransformation::Absolute) {
@@ -407,6 +512,13 @@ template<class Transformation> void Object<Transformation>::setClean(const typen
             i->cleanInverted(invertedMatrix);
         }
     }
+}
+
+}
+
+template<class Transformation> void Object<Transformation>::setClean(const typename Transformation::DataType& absoluteTransformation) {
+    _absoluteTransformation = absoluteTransformation;
+    Implementation::cleanFeatures<Transformation>(*this, absoluteTransformation);
 
     /* Mark object as clean */
     flags &= ~Flag::Dirty;
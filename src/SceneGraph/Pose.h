@@ -0,0 +1,202 @@
+#ifndef Magnum_SceneGraph_Pose_h
+#define Magnum_SceneGraph_Pose_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Class Magnum::SceneGraph::BasicPose3D, typedef Magnum::SceneGraph::Pose3D
+ */
+
+#include <algorithm>
+#include <vector>
+#include <Utility/Assert.h>
+
+#include "Math/DualQuaternion.h"
+#include "Math/Functions.h"
+#include "Math/Matrix4.h"
+#include "SceneGraph/SceneGraph.h"
+
+namespace Magnum { namespace SceneGraph {
+
+namespace Implementation {
+    template<class> struct PoseTransformation;
+}
+
+/**
+@brief Pose of three-dimensional objects
+
+Translation, rotation and scaling of a set of animation targets, stored in
+three contiguous arrays. Filled by @ref BasicAnimationClip3D::evaluate(), the
+transformations can be then set to a list of objects in one pass using
+@ref applyTo(). Example:
+@code
+std::vector<Object3D*> objects;
+SceneGraph::Pose3D pose(objects.size());
+clip.evaluate(time, cursors, pose);
+pose.applyTo(objects);
+@endcode
+@see @ref Pose3D, @ref BasicAnimationClip3D
+*/
+template<class T> class BasicPose3D {
+    public:
+        /**
+         * @brief Constructor
+         * @param size      Count of animation targets
+         *
+         * Creates identity pose.
+         */
+        explicit BasicPose3D(std::size_t size = 0): _translations(size), _rotations(size), _scalings(size, Math::Vector3<T>(T(1))) {}
+
+        /** @brief Count of animation targets */
+        std::size_t size() const { return _translations.size(); }
+
+        /**
+         * @brief Reset the pose to identity
+         * @return Reference to self (for method chaining)
+         */
+        BasicPose3D<T>& reset() {
+            std::fill(_translations.begin(), _translations.end(), Math::Vector3<T>());
+            std::fill(_rotations.begin(), _rotations.end(), Math::Quaternion<T>());
+            std::fill(_scalings.begin(), _scalings.end(), Math::Vector3<T>(T(1)));
+            return *this;
+        }
+
+        /** @brief Translations */
+        std::vector<Math::Vector3<T>>& translations() { return _translations; }
+        const std::vector<Math::Vector3<T>>& translations() const { return _translations; } /**< @overload */
+
+        /** @brief Rotations */
+        std::vector<Math::Quaternion<T>>& rotations() { return _rotations; }
+        const std::vector<Math::Quaternion<T>>& rotations() const { return _rotations; } /**< @overload */
+
+        /** @brief Scalings */
+        std::vector<Math::Vector3<T>>& scalings() { return _scalings; }
+        const std::vector<Math::Vector3<T>>& scalings() const { return _scalings; } /**< @overload */
+
+        /**
+         * @brief Blend with another pose
+         * @param other     Other pose
+         * @param factor    Blend factor (from range @f$ [0; 1] @f$)
+         * @return Reference to self (for method chaining)
+         *
+         * Interpolates translation and scaling linearly and rotation using
+         * normalized linear interpolation along the shortest path, `0` keeps
+         * this pose, `1` results in @p other. Poses of more clips can be
+         * blended together by blending them one after another, with factor
+         * being weight of the pose divided by sum of weights of all poses
+         * blended so far:
+         * @code
+         * // 50% a, 30% b, 20% c
+         * a.blend(b, 0.3f/0.8f).blend(c, 0.2f/1.0f);
+         * @endcode
+         *
+         * Expects that both poses have the same size.
+         */
+        BasicPose3D<T>& blend(const BasicPose3D<T>& other, T factor);
+
+        /**
+         * @brief Transformation matrix of given target
+         *
+         * Scaling is applied first, then rotation and translation.
+         */
+        Math::Matrix4<T> transformationMatrix(std::size_t id) const {
+            return Implementation::PoseTransformation<Math::Matrix4<T>>::compose(_translations[id], _rotations[id], _scalings[id]);
+        }
+
+        /**
+         * @brief Dual quaternion of given target
+         *
+         * Scaling is ignored.
+         */
+        Math::DualQuaternion<T> dualQuaternion(std::size_t id) const {
+            return Implementation::PoseTransformation<Math::DualQuaternion<T>>::compose(_translations[id], _rotations[id], _scalings[id]);
+        }
+
+        /**
+         * @brief Set the pose to objects
+         * @param objects   Objects corresponding to animation targets
+         *
+         * Sets transformation of each object to transformation of the target
+         * with the same index, `nullptr` objects are skipped. Works for any
+         * @ref Object or @ref FlatObject with 3D matrix or dual quaternion
+         * transformation, scaling is ignored for the latter.
+         */
+        template<class U> void applyTo(const std::vector<U*>& objects) const;
+
+    private:
+        std::vector<Math::Vector3<T>> _translations;
+        std::vector<Math::Quaternion<T>> _rotations;
+        std::vector<Math::Vector3<T>> _scalings;
+};
+
+/**
+@brief Pose of three-dimensional float objects
+
+@see @ref BasicPose3D
+*/
+typedef BasicPose3D<Float> Pose3D;
+
+namespace Implementation {
+
+template<class T> struct PoseTransformation<Math::Matrix4<T>> {
+    static Math::Matrix4<T> compose(const Math::Vector3<T>& translation, const Math::Quaternion<T>& rotation, const Math::Vector3<T>& scaling) {
+        Math::Matrix<3, T> rotationScaling = rotation.toMatrix();
+        for(std::size_t i = 0; i != 3; ++i) rotationScaling[i] *= scaling[i];
+        return Math::Matrix4<T>::from(rotationScaling, translation);
+    }
+};
+
+template<class T> struct PoseTransformation<Math::DualQuaternion<T>> {
+    static Math::DualQuaternion<T> compose(const Math::Vector3<T>& translation, const Math::Quaternion<T>& rotation, const Math::Vector3<T>&) {
+        return {rotation, Math::Quaternion<T>(translation/T(2), T(0))*rotation};
+    }
+};
+
+}
+
+template<class T> BasicPose3D<T>& BasicPose3D<T>::blend(const BasicPose3D<T>& other, const T factor) {
+    CORRADE_ASSERT(other.size() == size(),
+        "SceneGraph::Pose::blend(): expected pose with" << size() << "targets, got" << other.size(), *this);
+
+    for(std::size_t i = 0; i != size(); ++i) {
+        _translations[i] = Math::lerp(_translations[i], other._translations[i], factor);
+        _scalings[i] = Math::lerp(_scalings[i], other._scalings[i], factor);
+        _rotations[i] = Math::Quaternion<T>::lerp(_rotations[i],
+            Math::Quaternion<T>::dot(_rotations[i], other._rotations[i]) < T(0) ? -other._rotations[i] : other._rotations[i], factor);
+    }
+
+    return *this;
+}
+
+template<class T> template<class U> void BasicPose3D<T>::applyTo(const std::vector<U*>& objects) const {
+    CORRADE_ASSERT(objects.size() <= size(),
+        "SceneGraph::Pose::applyTo(): expected at most" << size() << "objects, got" << objects.size(), );
+
+    for(std::size_t i = 0; i != objects.size(); ++i) if(objects[i])
+        objects[i]->setTransformation(Implementation::PoseTransformation<typename U::DataType>::compose(_translations[i], _rotations[i], _scalings[i]));
+}
+
+}}
+
+#endif
@@ -0,0 +1,48 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+
+#include "Scene.h"
+
+#include "Implementation/ThreadPool.h"
+
+namespace Magnum { namespace SceneGraph { namespace Implementation {
+
+SceneThreadPool::SceneThreadPool(): _pool(new Magnum::Implementation::ThreadPool) {}
+
+SceneThreadPool::~SceneThreadPool() = default;
+
+std::size_t SceneThreadPool::threadCount() const { return _pool->threadCount(); }
+
+void SceneThreadPool::setThreadCount(const std::size_t threadCount) {
+    _pool->setThreadCount(threadCount);
+}
+
+void SceneThreadPool::run(const std::size_t count, const std::size_t threadCount, const Callback callback, const void* const function) {
+    _pool->parallelFor(count, threadCount, [callback, function](const std::size_t begin, const std::size_t end) {
+        callback(function, begin, end);
+    });
+}
+
+}}}
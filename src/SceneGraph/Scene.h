@@ -28,24 +28,190 @@
  * @brief Class Magnum::SceneGraph::Scene
  */
 
+#include <memory>
+
 #include "Object.h"
 
-namespace Magnum { namespace SceneGraph {
+namespace Magnum {
+
+namespace Implementation { class ThreadPool; }
+
+namespace SceneGraph {
+
+namespace Implementation {
+    /* Wrapper around the thread pool, defined in Scene.cpp so the threading
+       headers aren't included by every scene graph user */
+    class MAGNUM_SCENEGRAPH_EXPORT SceneThreadPool {
+        public:
+            explicit SceneThreadPool();
+            ~SceneThreadPool();
+
+            std::size_t threadCount() const;
+            void setThreadCount(std::size_t threadCount);
+
+            template<class Function> void parallelFor(const std::size_t count, const std::size_t threadCount, const Function& function) {
+                run(count, threadCount, &call<Function>, &function);
+            }
+
+        private:
+            typedef void(*Callback)(const void*, std::size_t, std::size_t);
+
+            template<class Function> static void call(const void* const function, const std::size_t begin, const std::size_t end) {
+                (*static_cast<const Function*>(function))(begin, end);
+            }
+
+            void run(std::size_t count, std::size_t threadCount, Callback callback, const void* function);
+
+            std::unique_ptr<Magnum::Implementation::ThreadPool> _pool;
+    };
+}
 
 /**
 @brief %Scene
 
 Basically Object which cannot have parent or non-default transformation.
 See @ref scenegraph for introduction.
+
+@section Scene-parallel Parallel transformation computation
+
+By default absolute transformations in @ref Object::transformations(),
+@ref Object::transformationMatrices() and @ref Object::setClean(std::vector<Object<Transformation>*>)
+are computed on calling thread only. For large scenes you can spread the
+work over more threads using @ref setThreadCount(), which then affects also
+@ref AbstractCamera::draw() and @ref Shapes::ShapeGroup::setClean(). The
+result doesn't depend on thread count.
+
+@section Scene-dirty-list Dirty list
+
+The scene keeps track of roots of dirty subtrees, so @ref setClean() can clean
+all dirty objects in the scene without going through the whole hierarchy. If
+no object moved since last cleaning, it does nearly nothing. Count of objects
+cleaned (i.e. with absolute transformation recomputed) is available through
+@ref cleanedObjectCount(), e.g. for per-frame statistics:
+@code
+Scene3D scene;
+
+// each frame:
+scene.resetCleanedObjectCount()
+    .setClean();
+camera.draw(drawables);
+Debug() << "Recomputed" << scene.cleanedObjectCount() << "objects";
+@endcode
 */
 template<class Transformation> class Scene: public Object<Transformation> {
+    friend class Object<Transformation>;
+
     public:
-        explicit Scene() = default;
+        explicit Scene();
+
+        ~Scene();
+
+        /**
+         * @brief Clean all dirty objects in the scene
+         *
+         * Cleans all objects which were marked as dirty since last cleaning.
+         * Clean subtrees of the scene are not visited at all.
+         * @see @ref Scene-dirty-list, @ref Object::setClean(std::vector<Object<Transformation>*>)
+         */
+        void setClean();
+
+        #ifndef DOXYGEN_GENERATING_OUTPUT
+        using Object<Transformation>::setClean;
+        #endif
+
+        /**
+         * @brief Count of cleaned objects
+         *
+         * Count of objects cleaned since construction or last call to
+         * @ref resetCleanedObjectCount().
+         * @see @ref Scene-dirty-list
+         */
+        std::size_t cleanedObjectCount() const { return _cleanedObjectCount; }
+
+        /**
+         * @brief Reset count of cleaned objects
+         * @return Reference to self (for method chaining)
+         */
+        Scene<Transformation>& resetCleanedObjectCount() {
+            _cleanedObjectCount = 0;
+            return *this;
+        }
+
+        /**
+         * @brief Count of threads used for computing transformations
+         *
+         * @see @ref setThreadCount()
+         */
+        std::size_t threadCount() const { return _threadPool.threadCount(); }
+
+        /**
+         * @brief Set count of threads used for computing transformations
+         * @return Reference to self (for method chaining)
+         *
+         * If set to `0`, count of hardware threads is used. Default is `1`.
+         * The hierarchy is split into independent subtrees, which are
+         * then processed on worker threads without any locking, the calling
+         * thread included. Small sets of objects are always processed on
+         * calling thread only. The worker threads are created on first use
+         * and kept for all subsequent computations, changing the count
+         * destroys them. If transformations of the scene are computed from
+         * more threads at once, the worker threads are used only by one of
+         * them and the others compute on their own thread. The count must
+         * not be changed while any computation is running.
+         * @see @ref Scene-parallel
+         */
+        Scene<Transformation>& setThreadCount(std::size_t count) {
+            _threadPool.setThreadCount(count);
+            return *this;
+        }
 
     private:
         bool isScene() const override final { return true; }
+
+        mutable Implementation::SceneThreadPool _threadPool;
+        std::size_t _cleanedObjectCount = 0;
+        std::vector<Object<Transformation>*> _dirtyObjects;
 };
 
+template<class Transformation> Scene<Transformation>::Scene() {
+    /* The scene is dirty at the beginning */
+    this->_dirtyListIndex = 0;
+    _dirtyObjects.push_back(this);
+    this->flags |= Implementation::ObjectFlag::Listed;
+}
+
+template<class Transformation> Scene<Transformation>::~Scene() {
+    /* The list will be gone when the children are destroyed, so they must
+       not try to remove themselves from it */
+    for(Object<Transformation>* o: _dirtyObjects) o->flags &= ~Implementation::ObjectFlag::Listed;
+}
+
+template<class Transformation> void Scene<Transformation>::setClean() {
+    /* Collect all objects in dirty subtrees. Every dirty object has dirty path
+       to some listed object and roots of the subtrees (i.e. objects with
+       clean parent) are always listed, so other listed objects can be
+       skipped and clean subtrees don't need to be visited. */
+    std::vector<Object<Transformation>*> objects;
+    std::vector<Object<Transformation>*> stack;
+    for(Object<Transformation>* o: _dirtyObjects) {
+        o->flags &= ~Implementation::ObjectFlag::Listed;
+        if(!o->isDirty() || (o->parent() && o->parent()->isDirty())) continue;
+
+        stack.push_back(o);
+        while(!stack.empty()) {
+            Object<Transformation>* dirty = stack.back();
+            stack.pop_back();
+            objects.push_back(dirty);
+
+            for(Object<Transformation>* i = dirty->firstChild(); i; i = i->nextSibling())
+                if(i->isDirty()) stack.push_back(i);
+        }
+    }
+    _dirtyObjects.clear();
+
+    Object<Transformation>::setClean(std::move(objects));
+}
+
 }}
 
 #endif
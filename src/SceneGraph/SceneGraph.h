@@ -139,6 +139,31 @@ typedef AnimableGroup<2, Float> AnimableGroup2D;
 typedef AnimableGroup<3, Float> AnimableGroup3D;
 #endif
 
+template<class> class BasicAnimationClip3D;
+typedef BasicAnimationClip3D<Float> AnimationClip3D;
+
+template<UnsignedInt, class> class BoundingVolume;
+#ifndef CORRADE_GCC46_COMPATIBILITY
+template<class T> using BasicBoundingVolume2D = BoundingVolume<2, T>;
+template<class T> using BasicBoundingVolume3D = BoundingVolume<3, T>;
+typedef BasicBoundingVolume2D<Float> BoundingVolume2D;
+typedef BasicBoundingVolume3D<Float> BoundingVolume3D;
+#else
+typedef BoundingVolume<2, Float> BoundingVolume2D;
+typedef BoundingVolume<3, Float> BoundingVolume3D;
+#endif
+
+template<UnsignedInt, class> class BoundingVolumeHierarchy;
+#ifndef CORRADE_GCC46_COMPATIBILITY
+template<class T> using BasicBoundingVolumeHierarchy2D = BoundingVolumeHierarchy<2, T>;
+template<class T> using BasicBoundingVolumeHierarchy3D = BoundingVolumeHierarchy<3, T>;
+typedef BasicBoundingVolumeHierarchy2D<Float> BoundingVolumeHierarchy2D;
+typedef BasicBoundingVolumeHierarchy3D<Float> BoundingVolumeHierarchy3D;
+#else
+typedef BoundingVolumeHierarchy<2, Float> BoundingVolumeHierarchy2D;
+typedef BoundingVolumeHierarchy<3, Float> BoundingVolumeHierarchy3D;
+#endif
+
 template<class> class BasicCamera2D;
 template<class> class BasicCamera3D;
 typedef BasicCamera2D<Float> Camera2D;
@@ -165,6 +190,9 @@ template<class Feature> using FeatureGroup2D = BasicFeatureGroup2D<Feature, Floa
 template<class Feature> using FeatureGroup3D = BasicFeatureGroup3D<Feature, Float>;
 #endif
 
+template<class Transformation> class FlatObject;
+template<class Transformation> class FlatScene;
+
 #ifndef CORRADE_GCC46_COMPATIBILITY
 template<UnsignedInt dimensions, class T> using DrawableGroup = FeatureGroup<dimensions, Drawable<dimensions, T>, T>;
 template<class T> using BasicDrawableGroup2D = DrawableGroup<2, T>;
@@ -184,6 +212,9 @@ typedef BasicMatrixTransformation3D<Float> MatrixTransformation3D;
 
 template<class Transformation> class Object;
 
+template<class> class BasicPose3D;
+typedef BasicPose3D<Float> Pose3D;
+
 template<class> class BasicRigidMatrixTransformation2D;
 template<class> class BasicRigidMatrixTransformation3D;
 typedef BasicRigidMatrixTransformation2D<Float> RigidMatrixTransformation2D;
@@ -191,6 +222,9 @@ typedef BasicRigidMatrixTransformation3D<Float> RigidMatrixTransformation3D;
 
 template<class Transformation> class Scene;
 
+template<class> class BasicSkeleton3D;
+typedef BasicSkeleton3D<Float> Skeleton3D;
+
 template<UnsignedInt, class T, class = T> class TranslationTransformation;
 #ifndef CORRADE_GCC46_COMPATIBILITY
 template<class T, class TranslationType = T> using BasicTranslationTransformation2D = TranslationTransformation<2, T, TranslationType>;
@@ -204,6 +238,7 @@ typedef TranslationTransformation<3, Float> TranslationTransformation3D;
 
 namespace Implementation {
     template<class> struct Transformation;
+    template<class Transformation> void cleanFeatures(AbstractObject<Transformation::Dimensions, typename Transformation::Type>& object, const typename Transformation::DataType& absoluteTransformation);
 }
 
 }}
@@ -0,0 +1,167 @@
+#ifndef Magnum_SceneGraph_Skeleton_h
+#define Magnum_SceneGraph_Skeleton_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Class Magnum::SceneGraph::BasicSkeleton3D, typedef Magnum::SceneGraph::Skeleton3D
+ */
+
+#include "SceneGraph/Pose.h"
+
+#include "magnumSceneGraphVisibility.h"
+
+namespace Magnum { namespace SceneGraph {
+
+/**
+@brief Skeleton for three-dimensional skinned meshes
+
+Compact joint hierarchy stored as array of parent indices, without any
+@ref Object instances. Joint transformations relative to parent are taken from
+@ref BasicPose3D "pose", which can be filled by one or more
+@ref BasicAnimationClip3D "animation clips" and blended together. Example:
+@code
+SceneGraph::Skeleton3D skeleton(parents, inverseBindMatrices);
+
+SceneGraph::Pose3D pose(skeleton.jointCount()), pose2(skeleton.jointCount());
+walk.evaluate(time, walkCursors, pose);
+run.evaluate(time, runCursors, pose2);
+pose.blend(pose2, speed);
+
+std::vector<Matrix4> palette;
+skeleton.jointMatrices(pose, palette);
+buffer.setSubData(0, {palette.data(), palette.size()*sizeof(Matrix4)});
+@endcode
+
+@section Skeleton3D-performance Performance
+
+Joints are required to be sorted so parent is always before its children, the
+absolute transformations are thus computed in one linear pass over the
+arrays. The output is written into caller-provided array, which is resized
+only if it doesn't have the right size, so no allocations are done when the
+same array is reused every frame. The skeleton itself is not modified by any
+of the computations, one skeleton can be thus shared between many characters
+and the computations can be done from multiple threads at once.
+
+@section Skeleton3D-explicit-specializations Explicit template specializations
+
+The following specialization are explicitly compiled into @ref SceneGraph
+library. For other specializations (e.g. using @ref Double type) you have to
+use @ref Skeleton.hpp implementation file to avoid linker errors. See also
+@ref compilation-speedup-hpp for more information.
+
+-   @ref Skeleton3D
+
+@see @ref scenegraph, @ref Skeleton3D
+*/
+template<class T> class BasicSkeleton3D {
+    public:
+        enum: UnsignedInt {
+            NoParent = ~UnsignedInt(0)  /**< Parent index of root joints */
+        };
+
+        /**
+         * @brief Constructor
+         * @param parents               Parent joint index for each joint,
+         *      @ref NoParent for root joints
+         * @param inverseBindMatrices   Inverse bind pose matrix for each
+         *      joint
+         *
+         * Expects that each joint has parent index smaller than its own
+         * index. If @p inverseBindMatrices is empty, identity is used for all
+         * joints, otherwise there must be the same count of matrices as
+         * joints.
+         */
+        explicit BasicSkeleton3D(std::vector<UnsignedInt> parents, std::vector<Math::Matrix4<T>> inverseBindMatrices = {});
+
+        /** @brief Count of joints */
+        std::size_t jointCount() const { return _parents.size(); }
+
+        /** @brief Parent joint indices */
+        const std::vector<UnsignedInt>& parents() const { return _parents; }
+
+        /** @brief Inverse bind pose matrices */
+        const std::vector<Math::Matrix4<T>>& inverseBindMatrices() const {
+            return _inverseBindMatrices;
+        }
+
+        /**
+         * @brief Absolute joint transformation matrices
+         * @param pose              Joint transformations relative to parent
+         * @param[out] matrices     Absolute transformations
+         *
+         * Useful e.g. for attaching objects to joints. Expects that the pose
+         * has @ref jointCount() targets, @p matrices are resized to
+         * @ref jointCount() if they have different size.
+         * @see @ref jointMatrices()
+         */
+        void absoluteMatrices(const BasicPose3D<T>& pose, std::vector<Math::Matrix4<T>>& matrices) const;
+
+        /**
+         * @brief Joint matrix palette
+         * @param pose              Joint transformations relative to parent
+         * @param[out] matrices     Skinning matrices
+         *
+         * Computes absolute joint transformations multiplied with inverse bind
+         * pose matrices, ready to be uploaded for skinning. Expects that the
+         * pose has @ref jointCount() targets, @p matrices are resized to
+         * @ref jointCount() if they have different size.
+         * @see @ref jointDualQuaternions()
+         */
+        void jointMatrices(const BasicPose3D<T>& pose, std::vector<Math::Matrix4<T>>& matrices) const;
+
+        /**
+         * @brief Joint dual quaternion palette
+         * @param pose                  Joint transformations relative to
+         *      parent
+         * @param[out] dualQuaternions  Skinning dual quaternions
+         *
+         * Alternative to @ref jointMatrices() for dual quaternion skinning.
+         * Scaling is ignored and the inverse bind pose matrices are expected
+         * to be rigid transformations. Expects that the pose has
+         * @ref jointCount() targets, @p dualQuaternions are resized to
+         * @ref jointCount() if they have different size.
+         */
+        void jointDualQuaternions(const BasicPose3D<T>& pose, std::vector<Math::DualQuaternion<T>>& dualQuaternions) const;
+
+    private:
+        std::vector<UnsignedInt> _parents;
+        std::vector<Math::Matrix4<T>> _inverseBindMatrices;
+        std::vector<Math::DualQuaternion<T>> _inverseBindDualQuaternions;
+};
+
+/**
+@brief Skeleton for three-dimensional float skinned meshes
+
+@see @ref BasicSkeleton3D
+*/
+typedef BasicSkeleton3D<Float> Skeleton3D;
+
+#ifdef _WIN32
+extern template class MAGNUM_SCENEGRAPH_EXPORT BasicSkeleton3D<Float>;
+#endif
+
+}}
+
+#endif
@@ -0,0 +1,107 @@
+#ifndef Magnum_SceneGraph_Skeleton_hpp
+#define Magnum_SceneGraph_Skeleton_hpp
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief @ref compilation-speedup-hpp "Template implementation" for @ref Skeleton.h
+ */
+
+#include "Skeleton.h"
+
+namespace Magnum { namespace SceneGraph {
+
+template<class T> BasicSkeleton3D<T>::BasicSkeleton3D(std::vector<UnsignedInt> parents, std::vector<Math::Matrix4<T>> inverseBindMatrices): _parents(std::move(parents)), _inverseBindMatrices(std::move(inverseBindMatrices)) {
+    #ifndef CORRADE_NO_ASSERT
+    for(std::size_t i = 0; i != _parents.size(); ++i)
+        CORRADE_ASSERT(_parents[i] == NoParent || _parents[i] < i,
+            "SceneGraph::Skeleton::Skeleton(): joint" << i << "has parent" << _parents[i] << "which is not before it", );
+    #endif
+
+    if(_inverseBindMatrices.empty()) {
+        _inverseBindMatrices.resize(_parents.size());
+        _inverseBindDualQuaternions.resize(_parents.size());
+        return;
+    }
+
+    CORRADE_ASSERT(_inverseBindMatrices.size() == _parents.size(),
+        "SceneGraph::Skeleton::Skeleton(): expected" << _parents.size() << "inverse bind matrices, got" << _inverseBindMatrices.size(), );
+
+    /* Dual quaternions are available only for rigid bind pose */
+    for(const Math::Matrix4<T>& matrix: _inverseBindMatrices) {
+        if(!matrix.isRigidTransformation()) {
+            _inverseBindDualQuaternions.clear();
+            return;
+        }
+
+        _inverseBindDualQuaternions.push_back(Math::DualQuaternion<T>::fromMatrix(matrix));
+    }
+}
+
+template<class T> void BasicSkeleton3D<T>::absoluteMatrices(const BasicPose3D<T>& pose, std::vector<Math::Matrix4<T>>& matrices) const {
+    CORRADE_ASSERT(pose.size() == _parents.size(),
+        "SceneGraph::Skeleton::absoluteMatrices(): expected pose with" << _parents.size() << "targets, got" << pose.size(), );
+
+    if(matrices.size() != _parents.size()) matrices.resize(_parents.size());
+
+    /* Parents are always before children, so their absolute transformation
+       is already computed */
+    for(std::size_t i = 0; i != _parents.size(); ++i) {
+        const Math::Matrix4<T> transformation = pose.transformationMatrix(i);
+        matrices[i] = _parents[i] == NoParent ? transformation : matrices[_parents[i]]*transformation;
+    }
+}
+
+template<class T> void BasicSkeleton3D<T>::jointMatrices(const BasicPose3D<T>& pose, std::vector<Math::Matrix4<T>>& matrices) const {
+    CORRADE_ASSERT(pose.size() == _parents.size(),
+        "SceneGraph::Skeleton::jointMatrices(): expected pose with" << _parents.size() << "targets, got" << pose.size(), );
+
+    absoluteMatrices(pose, matrices);
+
+    /* Multiplying with inverse bind pose in separate pass, as children need
+       absolute transformation of their parents */
+    for(std::size_t i = 0; i != _parents.size(); ++i)
+        matrices[i] = matrices[i]*_inverseBindMatrices[i];
+}
+
+template<class T> void BasicSkeleton3D<T>::jointDualQuaternions(const BasicPose3D<T>& pose, std::vector<Math::DualQuaternion<T>>& dualQuaternions) const {
+    CORRADE_ASSERT(pose.size() == _parents.size(),
+        "SceneGraph::Skeleton::jointDualQuaternions(): expected pose with" << _parents.size() << "targets, got" << pose.size(), );
+    CORRADE_ASSERT(_inverseBindDualQuaternions.size() == _parents.size(),
+        "SceneGraph::Skeleton::jointDualQuaternions(): the inverse bind matrices are not rigid", );
+
+    if(dualQuaternions.size() != _parents.size()) dualQuaternions.resize(_parents.size());
+
+    for(std::size_t i = 0; i != _parents.size(); ++i) {
+        const Math::DualQuaternion<T> transformation = pose.dualQuaternion(i);
+        dualQuaternions[i] = _parents[i] == NoParent ? transformation : dualQuaternions[_parents[i]]*transformation;
+    }
+
+    for(std::size_t i = 0; i != _parents.size(); ++i)
+        dualQuaternions[i] = dualQuaternions[i]*_inverseBindDualQuaternions[i];
+}
+
+}}
+
+#endif
@@ -0,0 +1,88 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <chrono>
+#include <memory>
+#include <TestSuite/Tester.h>
+
+#include "SceneGraph/Animable.h"
+#include "SceneGraph/AnimableGroup.h"
+#include "SceneGraph/MatrixTransformation3D.h"
+
+namespace Magnum { namespace SceneGraph { namespace Test {
+
+class AnimableBenchmark: public TestSuite::Tester {
+    public:
+        AnimableBenchmark();
+
+        void mostlyIdle();
+};
+
+typedef SceneGraph::Object<SceneGraph::MatrixTransformation3D> Object3D;
+
+namespace {
+    enum: std::size_t { AnimableCount = 100000, RunningCount = AnimableCount/100, Repeats = 100 };
+
+    typedef std::chrono::high_resolution_clock Clock;
+
+    class CountingAnimable: public SceneGraph::Animable3D {
+        public:
+            CountingAnimable(AbstractObject3D& object, AnimableGroup3D* group): SceneGraph::Animable3D(object, group), steps(0) {}
+
+            std::size_t steps;
+
+        protected:
+            void animationStep(Float, Float) override { ++steps; }
+    };
+}
+
+AnimableBenchmark::AnimableBenchmark() {
+    addTests({&AnimableBenchmark::mostlyIdle});
+}
+
+void AnimableBenchmark::mostlyIdle() {
+    Object3D object;
+    AnimableGroup3D group;
+    std::vector<std::unique_ptr<CountingAnimable>> animables;
+    animables.reserve(AnimableCount);
+    for(std::size_t i = 0; i != AnimableCount; ++i)
+        animables.emplace_back(new CountingAnimable(object, &group));
+
+    /* Every hundredth animable is running, the rest is stopped */
+    for(std::size_t i = 0; i < AnimableCount; i += AnimableCount/RunningCount)
+        animables[i]->setState(AnimationState::Running);
+
+    Clock::duration time{};
+    for(std::size_t r = 0; r != Repeats; ++r) {
+        const auto begin = Clock::now();
+        group.step(r*0.01f, 0.01f);
+        time += Clock::now() - begin;
+    }
+
+    Debug() << "Stepping" << AnimableCount << "animables with" << RunningCount << "running:" << std::chrono::duration<Double, std::micro>(time).count()/Repeats << "us";
+}
+
+}}}
+
+CORRADE_TEST_MAIN(Magnum::SceneGraph::Test::AnimableBenchmark)
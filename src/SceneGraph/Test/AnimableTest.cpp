@@ -22,6 +22,7 @@
     DEALINGS IN THE SOFTWARE.
 */
 
+#include <memory>
 #include <sstream>
 #include <TestSuite/Tester.h>
 
@@ -41,6 +42,8 @@ class AnimableTest: public TestSuite::Tester {
         void repeat();
         void stop();
         void pause();
+        void idle();
+        void groupChange();
 
         void debug();
 };
@@ -54,6 +57,8 @@ AnimableTest::AnimableTest() {
               &AnimableTest::repeat,
               &AnimableTest::stop,
               &AnimableTest::pause,
+              &AnimableTest::idle,
+              &AnimableTest::groupChange,
 
               &AnimableTest::debug});
 }
@@ -351,6 +356,105 @@ void AnimableTest::pause() {
     CORRADE_COMPARE(animable.time, 2.0f);
 }
 
+class CountingAnimable: public SceneGraph::Animable3D {
+    public:
+        CountingAnimable(AbstractObject3D& object, AnimableGroup3D* group = nullptr): SceneGraph::Animable3D(object, group), steps(0), time(-1.0f) {}
+
+        std::size_t steps;
+        Float time;
+
+    protected:
+        void animationStep(Float time, Float) override {
+            ++steps;
+            this->time = time;
+        }
+};
+
+void AnimableTest::idle() {
+    Object3D object;
+    AnimableGroup3D group;
+    std::vector<std::unique_ptr<CountingAnimable>> animables;
+    for(std::size_t i = 0; i != 100; ++i)
+        animables.emplace_back(new CountingAnimable(object, &group));
+
+    /* Only running animables are stepped */
+    animables[3]->setState(AnimationState::Running);
+    animables[50]->setState(AnimationState::Running);
+    animables[97]->setState(AnimationState::Running);
+    group.step(1.0f, 0.5f);
+    group.step(1.5f, 0.5f);
+    CORRADE_COMPARE(group.runningCount(), 3);
+    std::size_t steps = 0;
+    for(const auto& animable: animables) steps += animable->steps;
+    CORRADE_COMPARE(steps, 6);
+
+    /* Deleting running animable removes it from running ones */
+    animables[50].reset();
+    group.step(2.0f, 0.5f);
+    CORRADE_COMPARE(group.runningCount(), 2);
+    CORRADE_COMPARE(animables[3]->steps, 3);
+    CORRADE_COMPARE(animables[97]->steps, 3);
+    CORRADE_COMPARE(animables[97]->time, 1.0f);
+
+    /* Pausing and stopping removes them from running ones too, changing the
+       state back and forth before next step does nothing */
+    animables[3]->setState(AnimationState::Paused);
+    animables[97]->setState(AnimationState::Stopped);
+    animables[10]->setState(AnimationState::Running);
+    animables[10]->setState(AnimationState::Stopped);
+    group.step(2.5f, 0.5f);
+    CORRADE_COMPARE(group.runningCount(), 0);
+    CORRADE_COMPARE(animables[3]->steps, 3);
+    CORRADE_COMPARE(animables[10]->steps, 0);
+
+    /* Resumed animation continues from paused time */
+    animables[3]->setState(AnimationState::Running);
+    group.step(4.0f, 0.5f);
+    CORRADE_COMPARE(group.runningCount(), 1);
+    CORRADE_COMPARE(animables[3]->time, 1.5f);
+}
+
+void AnimableTest::groupChange() {
+    Object3D object;
+    AnimableGroup3D a, b;
+
+    /* Changing state of animable without group */
+    CountingAnimable animable(object);
+    animable.setState(AnimationState::Running);
+    CORRADE_COMPARE(animable.state(), AnimationState::Running);
+
+    /* Adding it to a group starts it */
+    a.add(animable);
+    a.step(1.0f, 0.5f);
+    CORRADE_COMPARE(a.runningCount(), 1);
+    CORRADE_COMPARE(animable.steps, 1);
+
+    /* Moving it to another group continues the animation there */
+    b.add(animable);
+    CORRADE_COMPARE(a.runningCount(), 0);
+    CORRADE_COMPARE(b.runningCount(), 1);
+    a.step(2.0f, 0.5f);
+    b.step(2.0f, 0.5f);
+    CORRADE_COMPARE(animable.steps, 2);
+    CORRADE_COMPARE(animable.time, 1.0f);
+
+    /* Moving through the base interface is detected in next step */
+    static_cast<FeatureGroup<3, Animable3D, Float>&>(a).add(animable);
+    b.step(3.0f, 0.5f);
+    a.step(3.0f, 0.5f);
+    CORRADE_COMPARE(a.runningCount(), 1);
+    CORRADE_COMPARE(b.runningCount(), 0);
+    CORRADE_COMPARE(animable.steps, 3);
+    CORRADE_COMPARE(animable.time, 2.0f);
+
+    /* Removing running animable from the group */
+    a.remove(animable);
+    CORRADE_COMPARE(a.runningCount(), 0);
+    a.step(4.0f, 0.5f);
+    CORRADE_COMPARE(animable.steps, 3);
+    CORRADE_VERIFY(!animable.animables());
+}
+
 void AnimableTest::debug() {
     std::ostringstream o;
     Debug(&o) << AnimationState::Running;
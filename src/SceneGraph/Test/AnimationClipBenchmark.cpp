@@ -0,0 +1,92 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <chrono>
+#include <random>
+#include <TestSuite/Tester.h>
+
+#include "Magnum.h"
+#include "SceneGraph/AnimationClip.h"
+
+namespace Magnum { namespace SceneGraph { namespace Test {
+
+class AnimationClipBenchmark: public TestSuite::Tester {
+    public:
+        AnimationClipBenchmark();
+
+        void playback();
+};
+
+namespace {
+    enum: std::size_t { TargetCount = 1000, KeyframeCount = 256, FrameCount = 600 };
+
+    typedef std::chrono::high_resolution_clock Clock;
+}
+
+AnimationClipBenchmark::AnimationClipBenchmark() {
+    addTests({&AnimationClipBenchmark::playback});
+}
+
+void AnimationClipBenchmark::playback() {
+    /* Translation and rotation track with random keyframes for each target */
+    std::mt19937 random;
+    std::uniform_real_distribution<Float> distribution(-1.0f, 1.0f);
+    AnimationClip3D clip;
+    std::vector<Float> times;
+    for(std::size_t i = 0; i != KeyframeCount; ++i) times.push_back(i/30.0f);
+    for(std::size_t i = 0; i != TargetCount; ++i) {
+        std::vector<Vector3> translations;
+        std::vector<Quaternion> rotations;
+        for(std::size_t j = 0; j != KeyframeCount; ++j) {
+            translations.push_back({distribution(random), distribution(random), distribution(random)});
+            rotations.push_back(Quaternion::rotation(Rad(distribution(random)), Vector3::zAxis()));
+        }
+        clip.addTranslationTrack(i, times, translations)
+            .addRotationTrack(i, times, rotations);
+    }
+
+    /* Sequential playback at 60 FPS with cursors kept between frames and with
+       new ones each frame */
+    Pose3D pose(TargetCount), expected(TargetCount);
+    std::vector<UnsignedInt> cursors;
+    Clock::duration cachedTime{}, freshTime{};
+    for(std::size_t i = 0; i != FrameCount; ++i) {
+        const Float time = i/60.0f;
+
+        auto begin = Clock::now();
+        clip.evaluate(time, cursors, pose);
+        cachedTime += Clock::now() - begin;
+
+        std::vector<UnsignedInt> freshCursors(clip.trackCount());
+        begin = Clock::now();
+        clip.evaluate(time, freshCursors, expected);
+        freshTime += Clock::now() - begin;
+    }
+
+    Debug() << "Evaluating" << clip.trackCount() << "tracks with" << KeyframeCount << "keyframes, cached cursors:" << std::chrono::duration<Double, std::micro>(cachedTime).count()/FrameCount << "us, fresh cursors:" << std::chrono::duration<Double, std::micro>(freshTime).count()/FrameCount << "us";
+}
+
+}}}
+
+CORRADE_TEST_MAIN(Magnum::SceneGraph::Test::AnimationClipBenchmark)
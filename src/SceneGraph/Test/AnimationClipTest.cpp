@@ -0,0 +1,301 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+
+#include <sstream>
+#include <TestSuite/Tester.h>
+
+#include "SceneGraph/AnimationClip.h"
+#include "SceneGraph/DualQuaternionTransformation.h"
+#include "SceneGraph/FlatScene.h"
+#include "SceneGraph/MatrixTransformation3D.h"
+#include "SceneGraph/Scene.h"
+
+namespace Magnum { namespace SceneGraph { namespace Test {
+
+class AnimationClipTest: public TestSuite::Tester {
+    public:
+        AnimationClipTest();
+
+        void construct();
+        void invalidTrack();
+        void translation();
+        void rotation();
+        void scaling();
+        void transformation();
+        void cursors();
+        void manyTracks();
+        void smallPose();
+
+        void pose();
+        void applyTo();
+};
+
+typedef SceneGraph::Object<SceneGraph::MatrixTransformation3D> Object3D;
+typedef SceneGraph::Object<SceneGraph::DualQuaternionTransformation> DualQuaternionObject3D;
+typedef SceneGraph::Scene<SceneGraph::MatrixTransformation3D> Scene3D;
+typedef SceneGraph::FlatObject<SceneGraph::MatrixTransformation3D> FlatObject3D;
+typedef SceneGraph::FlatScene<SceneGraph::MatrixTransformation3D> FlatScene3D;
+
+AnimationClipTest::AnimationClipTest() {
+    addTests({&AnimationClipTest::construct,
+              &AnimationClipTest::invalidTrack,
+              &AnimationClipTest::translation,
+              &AnimationClipTest::rotation,
+              &AnimationClipTest::scaling,
+              &AnimationClipTest::transformation,
+              &AnimationClipTest::cursors,
+              &AnimationClipTest::manyTracks,
+              &AnimationClipTest::smallPose,
+
+              &AnimationClipTest::pose,
+              &AnimationClipTest::applyTo});
+}
+
+void AnimationClipTest::construct() {
+    AnimationClip3D clip;
+    CORRADE_COMPARE(clip.trackCount(), 0);
+    CORRADE_COMPARE(clip.targetCount(), 0);
+    CORRADE_COMPARE(clip.duration(), 0.0f);
+
+    clip.addTranslationTrack(3, {0.0f, 1.5f}, {{}, Vector3::xAxis()})
+        .addRotationTrack(0, {0.5f, 4.0f}, {{}, Quaternion::rotation(Deg(90.0f), Vector3::zAxis())})
+        .addScalingTrack(1, {2.0f}, {Vector3(2.0f)});
+    CORRADE_COMPARE(clip.trackCount(), 3);
+    CORRADE_COMPARE(clip.targetCount(), 4);
+    CORRADE_COMPARE(clip.duration(), 4.0f);
+}
+
+void AnimationClipTest::invalidTrack() {
+    std::ostringstream o;
+    Error::setOutput(&o);
+
+    AnimationClip3D clip;
+    clip.addTranslationTrack(0, {}, {})
+        .addScalingTrack(0, {0.0f, 1.0f}, {Vector3()})
+        .addRotationTrack(0, {1.0f, 1.0f}, {Quaternion(), Quaternion()})
+        .addRotationTrack(0, {0.0f}, {Quaternion({}, 2.0f)})
+        .addTransformationTrack(0, {0.0f}, {DualQuaternion({}, {{1.0f, 0.0f, 0.0f}, 1.0f})});
+    CORRADE_COMPARE(clip.trackCount(), 0);
+    CORRADE_COMPARE(o.str(),
+        "SceneGraph::AnimationClip::addTranslationTrack(): expected non-empty strictly increasing times with the same count as values\n"
+        "SceneGraph::AnimationClip::addScalingTrack(): expected non-empty strictly increasing times with the same count as values\n"
+        "SceneGraph::AnimationClip::addRotationTrack(): expected non-empty strictly increasing times with the same count as values\n"
+        "SceneGraph::AnimationClip::addRotationTrack(): the rotations are not normalized\n"
+        "SceneGraph::AnimationClip::addTransformationTrack(): the transformations are not normalized\n");
+}
+
+void AnimationClipTest::translation() {
+    AnimationClip3D clip;
+    clip.addTranslationTrack(1, {1.0f, 2.0f, 4.0f}, {{1.0f, 0.0f, 0.0f}, {3.0f, 2.0f, 0.0f}, {3.0f, 2.0f, -4.0f}});
+
+    std::vector<UnsignedInt> cursors;
+    Pose3D pose(2);
+
+    /* Before first keyframe, first segment, second segment */
+    clip.evaluate(0.0f, cursors, pose);
+    CORRADE_COMPARE(cursors.size(), 1);
+    CORRADE_COMPARE(pose.translations()[1], Vector3(1.0f, 0.0f, 0.0f));
+    clip.evaluate(1.5f, cursors, pose);
+    CORRADE_COMPARE(pose.translations()[1], Vector3(2.0f, 1.0f, 0.0f));
+    clip.evaluate(3.5f, cursors, pose);
+    CORRADE_COMPARE(pose.translations()[1], Vector3(3.0f, 2.0f, -3.0f));
+
+    /* After last keyframe */
+    clip.evaluate(10.0f, cursors, pose);
+    CORRADE_COMPARE(pose.translations()[1], Vector3(3.0f, 2.0f, -4.0f));
+
+    /* Other targets and properties are untouched */
+    CORRADE_COMPARE(pose.translations()[0], Vector3());
+    CORRADE_COMPARE(pose.rotations()[1], Quaternion());
+    CORRADE_COMPARE(pose.scalings()[1], Vector3(1.0f));
+}
+
+void AnimationClipTest::rotation() {
+    const Quaternion a = Quaternion::rotation(Deg(15.0f), Vector3::xAxis());
+    const Quaternion b = Quaternion::rotation(Deg(75.0f), Vector3::xAxis());
+
+    /* Second track has the same rotation with opposite sign, third one has
+       two identical keyframes */
+    AnimationClip3D clip;
+    clip.addRotationTrack(0, {0.0f, 2.0f}, {a, b})
+        .addRotationTrack(1, {0.0f, 2.0f}, {a, -b})
+        .addRotationTrack(2, {0.0f, 2.0f}, {a, a});
+
+    std::vector<UnsignedInt> cursors;
+    Pose3D pose(3);
+    clip.evaluate(0.5f, cursors, pose);
+    CORRADE_COMPARE(pose.rotations()[0], Quaternion::rotation(Deg(30.0f), Vector3::xAxis()));
+    CORRADE_COMPARE(pose.rotations()[1], Quaternion::rotation(Deg(30.0f), Vector3::xAxis()));
+    CORRADE_COMPARE(pose.rotations()[2], a);
+}
+
+void AnimationClipTest::scaling() {
+    AnimationClip3D clip;
+    clip.addScalingTrack(0, {0.0f, 2.0f}, {Vector3(1.0f), {3.0f, 1.0f, 0.5f}});
+
+    std::vector<UnsignedInt> cursors;
+    Pose3D pose(1);
+    clip.evaluate(1.0f, cursors, pose);
+    CORRADE_COMPARE(pose.scalings()[0], Vector3(2.0f, 1.0f, 0.75f));
+}
+
+void AnimationClipTest::transformation() {
+    AnimationClip3D clip;
+    clip.addTransformationTrack(0, {0.0f, 1.0f}, {
+        DualQuaternion::translation({1.0f, 2.0f, 0.0f})*DualQuaternion::rotation(Deg(15.0f), Vector3::zAxis()),
+        DualQuaternion::translation({1.0f, 2.0f, 4.0f})*DualQuaternion::rotation(Deg(105.0f), Vector3::zAxis())});
+
+    /* Screw motion along Z axis */
+    std::vector<UnsignedInt> cursors;
+    Pose3D pose(1);
+    clip.evaluate(0.25f, cursors, pose);
+    CORRADE_COMPARE(pose.translations()[0], Vector3(1.0f, 2.0f, 1.0f));
+    CORRADE_COMPARE(pose.rotations()[0], Quaternion::rotation(Deg(37.5f), Vector3::zAxis()));
+}
+
+void AnimationClipTest::cursors() {
+    std::vector<Float> times;
+    std::vector<Vector3> translations;
+    for(std::size_t i = 0; i != 100; ++i) {
+        times.push_back(i*0.5f);
+        translations.push_back(Vector3::xAxis(Float(i%7)));
+    }
+
+    AnimationClip3D clip;
+    clip.addTranslationTrack(0, times, translations);
+
+    /* Sequential playback, jumps forward and backward all give the same
+       result as evaluation with fresh cursors */
+    std::vector<UnsignedInt> cursors;
+    Pose3D pose(1), expected(1);
+    for(Float time: {0.1f, 0.2f, 0.6f, 1.1f, 1.2f, 30.3f, 30.4f, 2.7f, 49.4f, 60.0f, 49.6f, -1.0f, 0.7f}) {
+        std::vector<UnsignedInt> freshCursors;
+        clip.evaluate(time, freshCursors, expected);
+        clip.evaluate(time, cursors, pose);
+        CORRADE_COMPARE(pose.translations()[0], expected.translations()[0]);
+    }
+
+    /* Cursor points to the segment */
+    clip.evaluate(30.4f, cursors, pose);
+    CORRADE_COMPARE(cursors[0], 60);
+    CORRADE_COMPARE(pose.translations()[0], Vector3::xAxis(4.8f));
+}
+
+void AnimationClipTest::manyTracks() {
+    /* More tracks than is interpolated at once, every fifth track is
+       constant, every third rotation goes the other way around */
+    AnimationClip3D clip;
+    for(UnsignedInt i = 0; i != 150; ++i) {
+        const Vector3 translation(Float(i), -Float(i%7), 0.5f);
+        const Quaternion rotation = Quaternion::rotation(Deg(Float(i%90)), Vector3(1.0f, Float(i%3), 2.0f).normalized());
+        if(i % 5 == 0) {
+            clip.addTranslationTrack(i, {1.0f}, {translation})
+                .addRotationTrack(i, {1.0f}, {rotation});
+        } else {
+            clip.addTranslationTrack(i, {0.0f, 1.0f, 2.0f}, {{}, translation, translation*2.0f})
+                .addRotationTrack(i, {0.0f, 2.0f}, {Quaternion(), i % 3 ? rotation : -rotation});
+        }
+    }
+
+    std::vector<UnsignedInt> cursors;
+    Pose3D pose(150);
+    clip.evaluate(1.25f, cursors, pose);
+    for(UnsignedInt i = 0; i != 150; ++i) {
+        const Vector3 translation(Float(i), -Float(i%7), 0.5f);
+        const Quaternion rotation = Quaternion::rotation(Deg(Float(i%90)), Vector3(1.0f, Float(i%3), 2.0f).normalized());
+        if(i % 5 == 0) {
+            CORRADE_COMPARE(pose.translations()[i], translation);
+            CORRADE_COMPARE(pose.rotations()[i], rotation);
+        } else {
+            CORRADE_COMPARE(pose.translations()[i], translation*1.25f);
+            CORRADE_COMPARE(pose.rotations()[i], Quaternion::rotation(Deg(Float(i%90)*0.625f), Vector3(1.0f, Float(i%3), 2.0f).normalized()));
+        }
+    }
+}
+
+void AnimationClipTest::smallPose() {
+    std::ostringstream o;
+    Error::setOutput(&o);
+
+    AnimationClip3D clip;
+    clip.addTranslationTrack(3, {0.0f}, {Vector3()});
+
+    std::vector<UnsignedInt> cursors;
+    Pose3D pose(2);
+    clip.evaluate(0.0f, cursors, pose);
+    CORRADE_COMPARE(o.str(), "SceneGraph::AnimationClip::evaluate(): expected pose with at least 4 targets, got 2\n");
+}
+
+void AnimationClipTest::pose() {
+    Pose3D pose(2);
+    CORRADE_COMPARE(pose.size(), 2);
+    CORRADE_COMPARE(pose.transformationMatrix(1), Matrix4());
+
+    pose.translations()[1] = {1.0f, -2.0f, 3.0f};
+    pose.rotations()[1] = Quaternion::rotation(Deg(35.0f), Vector3::yAxis());
+    pose.scalings()[1] = {2.0f, 0.5f, 1.5f};
+    CORRADE_COMPARE(pose.transformationMatrix(1),
+        Matrix4::translation({1.0f, -2.0f, 3.0f})*Matrix4::rotationY(Deg(35.0f))*Matrix4::scaling({2.0f, 0.5f, 1.5f}));
+    CORRADE_COMPARE(pose.dualQuaternion(1),
+        DualQuaternion::translation({1.0f, -2.0f, 3.0f})*DualQuaternion::rotation(Deg(35.0f), Vector3::yAxis()));
+
+    pose.reset();
+    CORRADE_COMPARE(pose.transformationMatrix(1), Matrix4());
+}
+
+void AnimationClipTest::applyTo() {
+    Pose3D pose(3);
+    pose.translations()[0] = {1.0f, -2.0f, 3.0f};
+    pose.rotations()[2] = Quaternion::rotation(Deg(35.0f), Vector3::yAxis());
+
+    /* Matrix transformation, skipping null objects */
+    Scene3D scene;
+    Object3D a(&scene), c(&scene);
+    pose.applyTo(std::vector<Object3D*>{&a, nullptr, &c});
+    CORRADE_COMPARE(a.transformation(), Matrix4::translation({1.0f, -2.0f, 3.0f}));
+    CORRADE_COMPARE(c.transformation(), Matrix4::rotationY(Deg(35.0f)));
+
+    /* Dual quaternion transformation */
+    DualQuaternionObject3D d;
+    pose.applyTo(std::vector<DualQuaternionObject3D*>{&d});
+    CORRADE_COMPARE(d.transformation(), DualQuaternion::translation({1.0f, -2.0f, 3.0f}));
+
+    /* Flat scene */
+    FlatScene3D flatScene;
+    FlatObject3D e(flatScene), f(flatScene), g(flatScene);
+    pose.applyTo(std::vector<FlatObject3D*>{&e, &f, &g});
+    CORRADE_COMPARE(e.transformation(), Matrix4::translation({1.0f, -2.0f, 3.0f}));
+    CORRADE_COMPARE(g.transformation(), Matrix4::rotationY(Deg(35.0f)));
+
+    /* Too many objects */
+    std::ostringstream o;
+    Error::setOutput(&o);
+    pose.applyTo(std::vector<Object3D*>{&a, &a, &a, &a});
+    CORRADE_COMPARE(o.str(), "SceneGraph::Pose::applyTo(): expected at most 3 objects, got 4\n");
+}
+
+}}}
+
+CORRADE_TEST_MAIN(Magnum::SceneGraph::Test::AnimationClipTest)
@@ -0,0 +1,199 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <chrono>
+#include <random>
+#include <TestSuite/Tester.h>
+
+#include "SceneGraph/BoundingVolume.h"
+#include "SceneGraph/BoundingVolumeHierarchy.h"
+#include "SceneGraph/MatrixTransformation3D.h"
+#include "SceneGraph/Scene.h"
+
+namespace Magnum { namespace SceneGraph { namespace Test {
+
+class BoundingVolumeHierarchyBenchmark: public TestSuite::Tester {
+    public:
+        BoundingVolumeHierarchyBenchmark();
+
+        void insert();
+        void refit();
+        void intersecting();
+        void visible();
+        void raycast();
+        void overlappingPairs();
+};
+
+typedef SceneGraph::Object<SceneGraph::MatrixTransformation3D> Object3D;
+typedef SceneGraph::Scene<SceneGraph::MatrixTransformation3D> Scene3D;
+
+namespace {
+    enum: std::size_t { VolumeCount = 100000, QueryCount = 1000 };
+
+    typedef std::chrono::high_resolution_clock Clock;
+
+    Double nanoseconds(Clock::duration time) {
+        return std::chrono::duration<Double, std::nano>(time).count();
+    }
+
+    /* Unit boxes randomly placed in a cube, about one per 27 units of
+       volume */
+    struct RandomScene {
+        explicit RandomScene(Float margin = 0.0f) {
+            hierarchy.setMargin(margin);
+            std::uniform_real_distribution<Float> position(-70.0f, 70.0f);
+            for(std::size_t i = 0; i != VolumeCount; ++i) {
+                objects.push_back(new Object3D(&scene));
+                objects.back()->translate({position(random), position(random), position(random)});
+                volumes.push_back(new BoundingVolume3D(*objects.back(), hierarchy, {Vector3(-0.5f), Vector3(0.5f)}));
+            }
+        }
+
+        BoundingVolumeHierarchy3D hierarchy;
+        Scene3D scene;
+        std::vector<Object3D*> objects;
+        std::vector<BoundingVolume3D*> volumes;
+        std::mt19937 random;
+    };
+}
+
+BoundingVolumeHierarchyBenchmark::BoundingVolumeHierarchyBenchmark() {
+    addTests({&BoundingVolumeHierarchyBenchmark::insert,
+              &BoundingVolumeHierarchyBenchmark::refit,
+              &BoundingVolumeHierarchyBenchmark::intersecting,
+              &BoundingVolumeHierarchyBenchmark::visible,
+              &BoundingVolumeHierarchyBenchmark::raycast,
+              &BoundingVolumeHierarchyBenchmark::overlappingPairs});
+}
+
+void BoundingVolumeHierarchyBenchmark::insert() {
+    RandomScene s;
+
+    /* Includes computing absolute transformations */
+    const auto begin = Clock::now();
+    s.hierarchy.update();
+    const Double time = nanoseconds(Clock::now() - begin)/VolumeCount;
+
+    Debug() << "Inserting" << std::size_t(VolumeCount) << "volumes:" << time << "ns per volume, tree height" << s.hierarchy.height();
+}
+
+void BoundingVolumeHierarchyBenchmark::refit() {
+    /* Each frame one tenth of the objects moves a bit */
+    for(const Float margin: {0.0f, 0.2f}) {
+        RandomScene s(margin);
+        s.hierarchy.update();
+
+        std::uniform_real_distribution<Float> offset(-0.05f, 0.05f);
+        Clock::duration time{};
+        for(std::size_t frame = 0; frame != 10; ++frame) {
+            for(std::size_t i = frame; i < VolumeCount; i += 10)
+                s.objects[i]->translate({offset(s.random), offset(s.random), offset(s.random)});
+
+            const auto begin = Clock::now();
+            s.hierarchy.update();
+            time += Clock::now() - begin;
+        }
+
+        Debug() << "Refitting" << std::size_t(VolumeCount/10) << "moved volumes with margin" << margin << "took" << nanoseconds(time)/VolumeCount << "ns per volume, tree height" << s.hierarchy.height();
+    }
+}
+
+void BoundingVolumeHierarchyBenchmark::intersecting() {
+    RandomScene s;
+    s.hierarchy.update();
+
+    std::uniform_real_distribution<Float> position(-70.0f, 70.0f);
+    std::size_t found = 0;
+    const auto begin = Clock::now();
+    for(std::size_t i = 0; i != QueryCount; ++i) {
+        const Vector3 center(position(s.random), position(s.random), position(s.random));
+        found += s.hierarchy.intersecting({center - Vector3(3.0f), center + Vector3(3.0f)}).size();
+    }
+    const Double time = nanoseconds(Clock::now() - begin)/QueryCount;
+
+    /* Testing all volumes for comparison */
+    std::size_t foundBruteForce = 0;
+    const auto beginBruteForce = Clock::now();
+    for(std::size_t i = 0; i != QueryCount/10; ++i) {
+        const Vector3 center(position(s.random), position(s.random), position(s.random));
+        const Range3D range(center - Vector3(3.0f), center + Vector3(3.0f));
+        for(BoundingVolume3D* volume: s.volumes) {
+            const Range3D volumeRange = volume->absoluteRange();
+            if(volumeRange.min().x() <= range.max().x() && volumeRange.max().x() >= range.min().x() &&
+               volumeRange.min().y() <= range.max().y() && volumeRange.max().y() >= range.min().y() &&
+               volumeRange.min().z() <= range.max().z() && volumeRange.max().z() >= range.min().z())
+                ++foundBruteForce;
+        }
+    }
+    const Double timeBruteForce = nanoseconds(Clock::now() - beginBruteForce)/(QueryCount/10);
+
+    Debug() << "Box query with" << Double(found)/QueryCount << "results on average:" << time << "ns per query";
+    Debug() << "Box query testing all volumes with" << Double(foundBruteForce)/(QueryCount/10) << "results on average:" << timeBruteForce << "ns per query";
+}
+
+void BoundingVolumeHierarchyBenchmark::visible() {
+    RandomScene s;
+    s.hierarchy.update();
+
+    const Matrix4 projection = Matrix4::perspectiveProjection(Deg(60.0f), 1.0f, 0.1f, 50.0f);
+    std::uniform_real_distribution<Float> angle(0.0f, 360.0f);
+    std::size_t found = 0;
+    const auto begin = Clock::now();
+    for(std::size_t i = 0; i != QueryCount/10; ++i) {
+        const Matrix4 camera = Matrix4::rotationY(Deg(angle(s.random))).inverted();
+        found += s.hierarchy.visible(projection*camera).size();
+    }
+    const Double time = nanoseconds(Clock::now() - begin)/(QueryCount/10);
+
+    Debug() << "Frustum query with" << Double(found)/(QueryCount/10) << "results on average:" << time << "ns per query";
+}
+
+void BoundingVolumeHierarchyBenchmark::raycast() {
+    RandomScene s;
+    s.hierarchy.update();
+
+    std::uniform_real_distribution<Float> direction(-1.0f, 1.0f);
+    std::size_t found = 0;
+    const auto begin = Clock::now();
+    for(std::size_t i = 0; i != QueryCount; ++i)
+        found += s.hierarchy.raycast({}, {direction(s.random), direction(s.random), direction(s.random)}).size();
+    const Double time = nanoseconds(Clock::now() - begin)/QueryCount;
+
+    Debug() << "Ray query with" << Double(found)/QueryCount << "results on average:" << time << "ns per query";
+}
+
+void BoundingVolumeHierarchyBenchmark::overlappingPairs() {
+    RandomScene s;
+    s.hierarchy.update();
+
+    const auto begin = Clock::now();
+    const std::size_t found = s.hierarchy.overlappingPairs().size();
+    const Double time = nanoseconds(Clock::now() - begin)/VolumeCount;
+
+    Debug() << "Overlapping pairs of" << std::size_t(VolumeCount) << "volumes," << found << "pairs found:" << time << "ns per volume";
+}
+
+}}}
+
+CORRADE_TEST_MAIN(Magnum::SceneGraph::Test::BoundingVolumeHierarchyBenchmark)
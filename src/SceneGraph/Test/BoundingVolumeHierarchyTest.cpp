@@ -0,0 +1,383 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <algorithm>
+#include <memory>
+#include <random>
+#include <TestSuite/Tester.h>
+
+#include "Math/Geometry/Intersection.h"
+#include "SceneGraph/BoundingVolume.h"
+#include "SceneGraph/BoundingVolumeHierarchy.h"
+#include "SceneGraph/MatrixTransformation2D.h"
+#include "SceneGraph/MatrixTransformation3D.h"
+#include "SceneGraph/Scene.h"
+
+namespace Magnum { namespace SceneGraph { namespace Test {
+
+class BoundingVolumeHierarchyTest: public TestSuite::Tester {
+    public:
+        BoundingVolumeHierarchyTest();
+
+        void absoluteRange();
+        void intersecting();
+        void move();
+        void margin();
+        void remove();
+        void balance();
+        void visible();
+        void raycast();
+        void overlappingPairs();
+        void hierarchyDestroyed();
+        void twoDimensions();
+};
+
+typedef SceneGraph::Object<SceneGraph::MatrixTransformation2D> Object2D;
+typedef SceneGraph::Scene<SceneGraph::MatrixTransformation2D> Scene2D;
+typedef SceneGraph::Object<SceneGraph::MatrixTransformation3D> Object3D;
+typedef SceneGraph::Scene<SceneGraph::MatrixTransformation3D> Scene3D;
+
+namespace {
+
+bool intersects(const Range3D& a, const Range3D& b) {
+    for(std::size_t i = 0; i != 3; ++i)
+        if(b.max()[i] < a.min()[i] || b.min()[i] > a.max()[i]) return false;
+    return true;
+}
+
+/* Scene with random unit boxes in a cube of given size */
+struct RandomScene {
+    explicit RandomScene(std::size_t count, Float size) {
+        std::mt19937 random;
+        std::uniform_real_distribution<Float> position(-size, size);
+        for(std::size_t i = 0; i != count; ++i) {
+            objects.push_back(new Object3D(&scene));
+            objects.back()->translate({position(random), position(random), position(random)});
+            volumes.push_back(new BoundingVolume3D(*objects.back(), hierarchy, {Vector3(-0.5f), Vector3(0.5f)}));
+        }
+    }
+
+    std::vector<BoundingVolume3D*> bruteForce(const Range3D& range) const {
+        std::vector<BoundingVolume3D*> result;
+        for(BoundingVolume3D* volume: volumes)
+            if(intersects(volume->absoluteRange(), range)) result.push_back(volume);
+        return result;
+    }
+
+    BoundingVolumeHierarchy3D hierarchy;
+    Scene3D scene;
+    std::vector<Object3D*> objects;
+    std::vector<BoundingVolume3D*> volumes;
+};
+
+template<class T> std::vector<T> sorted(std::vector<T> values) {
+    std::sort(values.begin(), values.end());
+    return values;
+}
+
+}
+
+BoundingVolumeHierarchyTest::BoundingVolumeHierarchyTest() {
+    addTests({&BoundingVolumeHierarchyTest::absoluteRange,
+              &BoundingVolumeHierarchyTest::intersecting,
+              &BoundingVolumeHierarchyTest::move,
+              &BoundingVolumeHierarchyTest::margin,
+              &BoundingVolumeHierarchyTest::remove,
+              &BoundingVolumeHierarchyTest::balance,
+              &BoundingVolumeHierarchyTest::visible,
+              &BoundingVolumeHierarchyTest::raycast,
+              &BoundingVolumeHierarchyTest::overlappingPairs,
+              &BoundingVolumeHierarchyTest::hierarchyDestroyed,
+              &BoundingVolumeHierarchyTest::twoDimensions});
+}
+
+void BoundingVolumeHierarchyTest::absoluteRange() {
+    BoundingVolumeHierarchy3D hierarchy;
+    Scene3D scene;
+    Object3D parent(&scene);
+    parent.scale({2.0f, 1.0f, 1.0f})
+        .translate(Vector3::xAxis(10.0f));
+    Object3D o(&parent);
+    o.rotateZ(Deg(90.0f));
+    BoundingVolume3D volume(o, hierarchy, {{0.0f, 1.0f, 2.0f}, {1.0f, 3.0f, 5.0f}});
+
+    /* Not in the hierarchy until updated */
+    CORRADE_COMPARE(hierarchy.size(), 0);
+    hierarchy.update();
+    CORRADE_COMPARE(hierarchy.size(), 1);
+    CORRADE_VERIFY(!o.isDirty());
+
+    /* Rotated (1, 2, 3) box at (0.5, 2, 3.5) becomes (2, 1, 3) box at
+       (-2, 0.5, 3.5), then it is scaled and translated */
+    CORRADE_COMPARE(volume.absoluteRange(), Range3D({4.0f, 0.0f, 2.0f}, {8.0f, 1.0f, 5.0f}));
+
+    /* Changing the range updates it */
+    volume.setRange({Vector3(0.0f), Vector3(1.0f)});
+    CORRADE_COMPARE(hierarchy.intersecting({{9.5f, 0.5f, 0.5f}, {9.6f, 0.6f, 0.6f}}).size(), 1);
+    CORRADE_COMPARE(volume.absoluteRange(), Range3D({8.0f, 0.0f, 0.0f}, {10.0f, 1.0f, 1.0f}));
+}
+
+void BoundingVolumeHierarchyTest::intersecting() {
+    RandomScene s(1000, 20.0f);
+
+    std::mt19937 random;
+    std::uniform_real_distribution<Float> position(-25.0f, 25.0f);
+    for(std::size_t i = 0; i != 50; ++i) {
+        const Vector3 center(position(random), position(random), position(random));
+        const Range3D range(center - Vector3(3.0f), center + Vector3(3.0f));
+        const std::vector<BoundingVolume3D*> result = s.hierarchy.intersecting(range);
+        CORRADE_COMPARE(sorted(result), sorted(s.bruteForce(range)));
+    }
+
+    CORRADE_COMPARE(s.hierarchy.size(), 1000);
+    CORRADE_COMPARE(s.hierarchy.intersecting({Vector3(-100.0f), Vector3(100.0f)}).size(), 1000);
+}
+
+void BoundingVolumeHierarchyTest::move() {
+    RandomScene s(1000, 20.0f);
+    s.hierarchy.update();
+
+    /* Move half of the objects, the hierarchy is updated implicitly */
+    std::mt19937 random;
+    std::uniform_real_distribution<Float> offset(-5.0f, 5.0f);
+    for(std::size_t i = 0; i < s.objects.size(); i += 2)
+        s.objects[i]->translate({offset(random), offset(random), offset(random)});
+
+    const Range3D range({-10.0f, -10.0f, -10.0f}, {5.0f, 5.0f, 5.0f});
+    const std::vector<BoundingVolume3D*> result = s.hierarchy.intersecting(range);
+    CORRADE_COMPARE(sorted(result), sorted(s.bruteForce(range)));
+
+    /* The same if cleaned explicitly */
+    for(std::size_t i = 1; i < s.objects.size(); i += 2)
+        s.objects[i]->translate({offset(random), offset(random), offset(random)});
+    s.scene.setClean();
+    CORRADE_COMPARE(sorted(s.hierarchy.intersecting(range)), sorted(s.bruteForce(range)));
+}
+
+void BoundingVolumeHierarchyTest::margin() {
+    BoundingVolumeHierarchy3D hierarchy;
+    hierarchy.setMargin(1.0f);
+    CORRADE_COMPARE(hierarchy.margin(), 1.0f);
+
+    Scene3D scene;
+    Object3D a(&scene);
+    Object3D b(&scene);
+    b.translate(Vector3::xAxis(3.0f));
+    BoundingVolume3D volumeA(a, hierarchy, {Vector3(-0.5f), Vector3(0.5f)});
+    BoundingVolume3D volumeB(b, hierarchy, {Vector3(-0.5f), Vector3(0.5f)});
+
+    /* Enlarged boxes overlap, but the exact ones are tested */
+    CORRADE_VERIFY(hierarchy.overlappingPairs().empty());
+    CORRADE_COMPARE(hierarchy.intersecting({{1.0f, -0.1f, -0.1f}, {2.0f, 0.1f, 0.1f}}).size(), 0);
+
+    /* Moving inside the margin */
+    a.translate(Vector3::xAxis(0.9f));
+    CORRADE_COMPARE(hierarchy.intersecting({{1.0f, -0.1f, -0.1f}, {2.0f, 0.1f, 0.1f}}),
+        std::vector<BoundingVolume3D*>{&volumeA});
+
+    /* Moving outside of the margin */
+    a.translate(Vector3::xAxis(1.2f));
+    CORRADE_COMPARE(sorted(hierarchy.intersecting({{2.0f, -0.1f, -0.1f}, {2.6f, 0.1f, 0.1f}})),
+        sorted(std::vector<BoundingVolume3D*>{&volumeA, &volumeB}));
+    CORRADE_COMPARE(hierarchy.overlappingPairs().size(), 1);
+}
+
+void BoundingVolumeHierarchyTest::remove() {
+    RandomScene s(1000, 20.0f);
+    s.hierarchy.update();
+
+    /* Delete every third object, delete every other volume of the rest */
+    std::vector<BoundingVolume3D*> volumes;
+    for(std::size_t i = 0; i != s.objects.size(); ++i) {
+        if(i%3 == 0) delete s.objects[i];
+        else if(i%2 == 0) delete s.volumes[i];
+        else volumes.push_back(s.volumes[i]);
+    }
+    s.volumes = volumes;
+
+    CORRADE_COMPARE(s.hierarchy.size(), volumes.size());
+    const Range3D range({-10.0f, -10.0f, -10.0f}, {15.0f, 15.0f, 15.0f});
+    CORRADE_COMPARE(sorted(s.hierarchy.intersecting(range)), sorted(s.bruteForce(range)));
+
+    /* Volumes which were never added to the tree or are marked dirty are
+       removed from the list of dirty volumes */
+    Object3D* o = new Object3D(&s.scene);
+    new BoundingVolume3D(*o, s.hierarchy, {});
+    s.volumes[0]->object().setDirty();
+    delete o;
+    delete s.volumes[0];
+    s.volumes.erase(s.volumes.begin());
+    CORRADE_COMPARE(sorted(s.hierarchy.intersecting(range)), sorted(s.bruteForce(range)));
+
+    /* Dirty volumes removed in arbitrary order */
+    RandomScene dirty(1000, 20.0f);
+    volumes.clear();
+    for(std::size_t i = 0; i != dirty.volumes.size(); ++i) {
+        if(i%3 == 1) delete dirty.volumes[i];
+        else volumes.push_back(dirty.volumes[i]);
+    }
+    dirty.volumes = volumes;
+
+    dirty.hierarchy.update();
+    CORRADE_COMPARE(sorted(dirty.hierarchy.intersecting(range)), sorted(dirty.bruteForce(range)));
+    CORRADE_COMPARE(dirty.hierarchy.size(), volumes.size());
+}
+
+void BoundingVolumeHierarchyTest::balance() {
+    /* Objects inserted in order along a line, worst case for unbalanced tree */
+    BoundingVolumeHierarchy3D hierarchy;
+    Scene3D scene;
+    for(std::size_t i = 0; i != 1024; ++i) {
+        Object3D* o = new Object3D(&scene);
+        o->translate(Vector3::xAxis(i));
+        new BoundingVolume3D(*o, hierarchy, {Vector3(-0.4f), Vector3(0.4f)});
+        hierarchy.update();
+    }
+
+    CORRADE_COMPARE(hierarchy.size(), 1024);
+    CORRADE_VERIFY(hierarchy.height() >= 10);
+    CORRADE_VERIFY(hierarchy.height() <= 15);
+}
+
+void BoundingVolumeHierarchyTest::visible() {
+    RandomScene s(1000, 20.0f);
+
+    const Matrix4 projection = Matrix4::perspectiveProjection(Deg(60.0f), 1.0f, 1.0f, 30.0f);
+    const Matrix4 camera = Matrix4::rotationY(Deg(30.0f)).inverted();
+    const std::vector<BoundingVolume3D*> result = s.hierarchy.visible(projection*camera);
+
+    /* Brute force, test all corners in clip space */
+    std::vector<BoundingVolume3D*> expected;
+    const Matrix4 transformationProjection = projection*camera;
+    for(BoundingVolume3D* volume: s.volumes) {
+        bool outside = false;
+        for(std::size_t i = 0; i != 6 && !outside; ++i) {
+            outside = true;
+            for(std::size_t corner = 0; corner != 8; ++corner) {
+                const Vector3 p(corner & 1 ? volume->absoluteRange().max().x() : volume->absoluteRange().min().x(),
+                                corner & 2 ? volume->absoluteRange().max().y() : volume->absoluteRange().min().y(),
+                                corner & 4 ? volume->absoluteRange().max().z() : volume->absoluteRange().min().z());
+                const Vector4 clip = transformationProjection*Vector4(p, 1.0f);
+                const Float value = i%2 ? clip.w() - clip[i/2] : clip.w() + clip[i/2];
+                if(value >= 0.0f) outside = false;
+            }
+        }
+        if(!outside) expected.push_back(volume);
+    }
+
+    CORRADE_VERIFY(!result.empty());
+    CORRADE_VERIFY(result.size() < s.volumes.size()/4);
+    CORRADE_COMPARE(sorted(result), sorted(expected));
+}
+
+void BoundingVolumeHierarchyTest::raycast() {
+    RandomScene s(1000, 20.0f);
+
+    const Vector3 origin(-30.0f, 1.0f, 2.0f);
+    const Vector3 direction = Vector3(1.0f, 0.1f, -0.05f).normalized();
+    const std::vector<std::pair<BoundingVolume3D*, Float>> result = s.hierarchy.raycast(origin, direction);
+
+    std::vector<std::pair<BoundingVolume3D*, Float>> expected;
+    for(BoundingVolume3D* volume: s.volumes) {
+        const std::pair<Float, Float> tu = Math::Geometry::Intersection::rangeLine(volume->absoluteRange(), origin, direction);
+        if(tu.first <= tu.second && tu.second >= 0.0f)
+            expected.emplace_back(volume, std::max(tu.first, 0.0f));
+    }
+    std::sort(expected.begin(), expected.end(), [](const std::pair<BoundingVolume3D*, Float>& a, const std::pair<BoundingVolume3D*, Float>& b) {
+        return a.second < b.second;
+    });
+
+    CORRADE_VERIFY(!result.empty());
+    CORRADE_COMPARE(result, expected);
+
+    /* Origin inside the volume */
+    const Vector3 inside = s.volumes[0]->absoluteRange().center();
+    const std::vector<std::pair<BoundingVolume3D*, Float>> insideResult = s.hierarchy.raycast(inside, Vector3::yAxis());
+    CORRADE_VERIFY(!insideResult.empty());
+    CORRADE_COMPARE(insideResult.front().second, 0.0f);
+}
+
+void BoundingVolumeHierarchyTest::overlappingPairs() {
+    RandomScene s(1000, 10.0f);
+
+    std::vector<std::pair<BoundingVolume3D*, BoundingVolume3D*>> result = s.hierarchy.overlappingPairs();
+    for(auto& pair: result) if(pair.first > pair.second) std::swap(pair.first, pair.second);
+
+    std::vector<std::pair<BoundingVolume3D*, BoundingVolume3D*>> expected;
+    for(std::size_t i = 0; i != s.volumes.size(); ++i)
+        for(std::size_t j = i + 1; j != s.volumes.size(); ++j)
+            if(intersects(s.volumes[i]->absoluteRange(), s.volumes[j]->absoluteRange()))
+                expected.push_back(std::minmax(s.volumes[i], s.volumes[j]));
+
+    CORRADE_VERIFY(!expected.empty());
+    CORRADE_COMPARE(sorted(result), sorted(expected));
+}
+
+void BoundingVolumeHierarchyTest::hierarchyDestroyed() {
+    Scene3D scene;
+    Object3D a(&scene);
+    Object3D b(&scene);
+    std::unique_ptr<BoundingVolume3D> volumeA, volumeB;
+    {
+        BoundingVolumeHierarchy3D hierarchy;
+        volumeA.reset(new BoundingVolume3D(a, hierarchy, {}));
+        hierarchy.update();
+        volumeB.reset(new BoundingVolume3D(b, hierarchy, {}));
+        CORRADE_COMPARE(volumeA->hierarchy(), &hierarchy);
+    }
+
+    CORRADE_VERIFY(!volumeA->hierarchy());
+    CORRADE_VERIFY(!volumeB->hierarchy());
+
+    /* Moving the objects doesn't crash */
+    a.translate(Vector3::xAxis());
+    scene.setClean();
+}
+
+void BoundingVolumeHierarchyTest::twoDimensions() {
+    BoundingVolumeHierarchy2D hierarchy;
+    Scene2D scene;
+    Object2D a(&scene);
+    a.translate({2.3f, 1.0f});
+    Object2D b(&scene);
+    b.rotate(Deg(45.0f));
+    BoundingVolume2D volumeA(a, hierarchy, {Vector2(-1.0f), Vector2(1.0f)});
+    BoundingVolume2D volumeB(b, hierarchy, {Vector2(-1.0f), Vector2(1.0f)});
+
+    CORRADE_COMPARE(hierarchy.intersecting({{1.0f, 0.5f}, {1.2f, 0.6f}}),
+        std::vector<BoundingVolume2D*>{&volumeB});
+    CORRADE_COMPARE(hierarchy.overlappingPairs().size(), 1);
+    CORRADE_COMPARE(hierarchy.visible(Matrix3::projection({2.0f, 2.0f})*Matrix3::translation({-3.5f, 0.0f})),
+        std::vector<BoundingVolume2D*>{&volumeA});
+
+    const std::vector<std::pair<BoundingVolume2D*, Float>> hits = hierarchy.raycast({-5.0f, 0.5f}, Vector2::xAxis());
+    CORRADE_COMPARE(hits.size(), 2);
+    CORRADE_COMPARE(hits[0].first, &volumeB);
+    CORRADE_COMPARE(hits[1].first, &volumeA);
+    CORRADE_COMPARE(hits[1].second, 6.3f);
+}
+
+}}}
+
+CORRADE_TEST_MAIN(Magnum::SceneGraph::Test::BoundingVolumeHierarchyTest)
@@ -0,0 +1,119 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <chrono>
+#include <random>
+#include <TestSuite/Tester.h>
+
+#include "SceneGraph/Camera3D.h"
+#include "SceneGraph/Drawable.h"
+#include "SceneGraph/MatrixTransformation3D.h"
+#include "SceneGraph/Scene.h"
+
+namespace Magnum { namespace SceneGraph { namespace Test {
+
+class CameraBenchmark: public TestSuite::Tester {
+    public:
+        CameraBenchmark();
+
+        void drawableTransformations();
+        void drawableTransformationsCulled();
+        void drawableTransformationsSorted();
+};
+
+typedef SceneGraph::Object<SceneGraph::MatrixTransformation3D> Object3D;
+typedef SceneGraph::Scene<SceneGraph::MatrixTransformation3D> Scene3D;
+
+namespace {
+    enum: std::size_t { Repeats = 10, DrawableCount = 100000 };
+
+    typedef std::chrono::high_resolution_clock Clock;
+
+    class NullDrawable: public SceneGraph::Drawable3D {
+        public:
+            NullDrawable(AbstractObject3D& object, DrawableGroup3D& group): SceneGraph::Drawable3D(object, &group) {}
+
+        protected:
+            void draw(const Matrix4&, AbstractCamera3D&) override {}
+    };
+
+    /* Creates drawables randomly placed in a cube around the camera, about
+       one sixth of them is in the frustum. Returns time per drawable and
+       count of drawables in the last list. */
+    Double benchmark(const bool boundingVolumes, const DrawOrder order, std::size_t& drawnCount) {
+        Scene3D scene;
+        DrawableGroup3D group;
+        std::mt19937 random;
+        std::uniform_real_distribution<Float> position(-100.0f, 100.0f);
+        for(std::size_t i = 0; i != DrawableCount; ++i) {
+            Object3D* object = new Object3D(&scene);
+            object->translate({position(random), position(random), position(random)});
+            NullDrawable* drawable = new NullDrawable(*object, group);
+            if(boundingVolumes) drawable->setBoundingSphere({}, 1.0f);
+            drawable->setSortKey(i%16);
+        }
+
+        Object3D cameraObject(&scene);
+        Camera3D camera(cameraObject);
+        camera.setPerspective(Deg(90.0f), 1.0f, 0.1f, 100.0f)
+            .setDrawOrder(order);
+
+        Clock::duration time{};
+        for(std::size_t r = 0; r != Repeats; ++r) {
+            const auto begin = Clock::now();
+            drawnCount = camera.drawableTransformations(group).size();
+            time += Clock::now() - begin;
+        }
+
+        return std::chrono::duration<Double, std::nano>(time).count()/(Repeats*DrawableCount);
+    }
+}
+
+CameraBenchmark::CameraBenchmark() {
+    addTests({&CameraBenchmark::drawableTransformations,
+              &CameraBenchmark::drawableTransformationsCulled,
+              &CameraBenchmark::drawableTransformationsSorted});
+}
+
+void CameraBenchmark::drawableTransformations() {
+    std::size_t drawnCount;
+    const Double time = benchmark(false, DrawOrder::Group, drawnCount);
+    Debug() << "Draw list of" << drawnCount << "drawables without culling:" << time << "ns per drawable";
+}
+
+void CameraBenchmark::drawableTransformationsCulled() {
+    std::size_t drawnCount;
+    const Double time = benchmark(true, DrawOrder::Group, drawnCount);
+    Debug() << "Draw list of" << drawnCount << "drawables out of" << std::size_t(DrawableCount) << "after culling:" << time << "ns per drawable";
+}
+
+void CameraBenchmark::drawableTransformationsSorted() {
+    std::size_t drawnCount;
+    const Double time = benchmark(true, DrawOrder::FrontToBack, drawnCount);
+    Debug() << "Sorted draw list of" << drawnCount << "drawables out of" << std::size_t(DrawableCount) << "after culling:" << time << "ns per drawable";
+}
+
+}}}
+
+CORRADE_TEST_MAIN(Magnum::SceneGraph::Test::CameraBenchmark)
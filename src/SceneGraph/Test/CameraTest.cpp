@@ -22,6 +22,7 @@
     DEALINGS IN THE SOFTWARE.
 */
 
+#include <memory>
 #include <TestSuite/Tester.h>
 
 #include "SceneGraph/AbstractCamera.hpp" /* only for aspectRatioFix(), so it doesn't have to be exported */
@@ -46,10 +47,15 @@ class CameraTest: public TestSuite::Tester {
         void projectionSizePerspective();
         void projectionSizeViewport();
         void draw();
+        void cullPerspective();
+        void cullOrthographic();
+        void cull2D();
+        void drawOrder();
 };
 
 typedef SceneGraph::Object<SceneGraph::MatrixTransformation2D> Object2D;
 typedef SceneGraph::Object<SceneGraph::MatrixTransformation3D> Object3D;
+typedef SceneGraph::Scene<SceneGraph::MatrixTransformation2D> Scene2D;
 typedef SceneGraph::Scene<SceneGraph::MatrixTransformation3D> Scene3D;
 
 CameraTest::CameraTest() {
@@ -60,7 +66,11 @@ CameraTest::CameraTest() {
               &CameraTest::projectionSizeOrthographic,
               &CameraTest::projectionSizePerspective,
               &CameraTest::projectionSizeViewport,
-              &CameraTest::draw});
+              &CameraTest::draw,
+              &CameraTest::cullPerspective,
+              &CameraTest::cullOrthographic,
+              &CameraTest::cull2D,
+              &CameraTest::drawOrder});
 }
 
 void CameraTest::fixAspectRatio() {
@@ -195,6 +205,193 @@ void CameraTest::draw() {
     CORRADE_COMPARE(thirdTransformation, Matrix4());
 }
 
+namespace {
+
+template<UnsignedInt dimensions> class IdDrawable: public SceneGraph::Drawable<dimensions, Float> {
+    public:
+        IdDrawable(AbstractObject<dimensions, Float>& object, DrawableGroup<dimensions, Float>& group, Int id, std::vector<Int>& drawn): SceneGraph::Drawable<dimensions, Float>(object, &group), id(id), drawn(drawn) {}
+
+    protected:
+        void draw(const typename DimensionTraits<dimensions, Float>::MatrixType&, AbstractCamera<dimensions, Float>&) override {
+            drawn.push_back(id);
+        }
+
+    private:
+        Int id;
+        std::vector<Int>& drawn;
+};
+
+}
+
+void CameraTest::cullPerspective() {
+    Scene3D scene;
+    DrawableGroup3D group;
+    std::vector<Int> drawn;
+
+    Object3D cameraObject(&scene);
+    cameraObject.translate(Vector3::zAxis(10.0f));
+    Camera3D camera(cameraObject);
+    camera.setPerspective(Deg(90.0f), 1.0f, 1.0f, 100.0f);
+
+    /* Without bounding volume, always drawn */
+    Object3D a(&scene);
+    a.translate(Vector3::zAxis(20.0f));
+    new IdDrawable<3>(a, group, 0, drawn);
+
+    /* Inside */
+    Object3D b(&scene);
+    new IdDrawable<3>(b, group, 1, drawn);
+    group[1].setBoundingSphere({}, 1.0f);
+
+    /* Behind the camera */
+    Object3D c(&scene);
+    c.translate(Vector3::zAxis(12.0f));
+    new IdDrawable<3>(c, group, 2, drawn);
+    group[2].setBoundingSphere({}, 1.0f);
+
+    /* Left of the frustum 10 units in front of the camera, where the plane
+       is at x = -10, intersecting it only if scaled up twice */
+    Object3D d(&scene);
+    d.translate(Vector3::xAxis(-11.5f));
+    new IdDrawable<3>(d, group, 3, drawn);
+    group[3].setBoundingSphere({}, 1.0f);
+    Object3D e(&scene);
+    e.scale(Vector3(2.0f))
+     .translate(Vector3::xAxis(-11.5f));
+    new IdDrawable<3>(e, group, 4, drawn);
+    group[4].setBoundingSphere({}, 1.0f);
+
+    /* Beyond far plane, box with center outside but touching it */
+    Object3D f(&scene);
+    f.translate(Vector3::zAxis(-85.0f));
+    new IdDrawable<3>(f, group, 5, drawn);
+    group[5].setBoundingBox({{-1.0f, -1.0f, -8.0f}, {1.0f, 1.0f, -6.0f}});
+    Object3D g(&scene);
+    g.translate(Vector3::zAxis(-85.0f));
+    new IdDrawable<3>(g, group, 6, drawn);
+    group[6].setBoundingBox({{-1.0f, -1.0f, -6.5f}, {1.0f, 1.0f, -4.0f}});
+
+    /* Box rotated so its corner reaches into the frustum */
+    Object3D h(&scene);
+    h.rotateZ(Deg(45.0f))
+     .translate(Vector3::yAxis(11.3f));
+    new IdDrawable<3>(h, group, 7, drawn);
+    group[7].setBoundingBox({Vector3(-1.0f), Vector3(1.0f)});
+
+    camera.draw(group);
+    CORRADE_COMPARE(drawn, (std::vector<Int>{0, 1, 4, 6, 7}));
+
+    /* Move the camera, transformations are updated */
+    drawn.clear();
+    cameraObject.translate(Vector3::xAxis(-3.0f));
+    camera.draw(group);
+    CORRADE_COMPARE(drawn, (std::vector<Int>{0, 1, 3, 4, 6, 7}));
+
+    /* Reset bounding volume, drawn again */
+    drawn.clear();
+    group[2].resetBoundingVolume();
+    CORRADE_COMPARE(camera.drawableTransformations(group).size(), 7);
+}
+
+void CameraTest::cullOrthographic() {
+    Scene3D scene;
+    DrawableGroup3D group;
+    std::vector<Int> drawn;
+
+    Object3D cameraObject(&scene);
+    Camera3D camera(cameraObject);
+    camera.setOrthographic({4.0f, 2.0f}, 1.0f, 10.0f);
+
+    Object3D a(&scene);
+    a.translate({1.5f, 0.0f, -5.0f});
+    new IdDrawable<3>(a, group, 0, drawn);
+    group[0].setBoundingSphere({}, 0.6f);
+
+    Object3D b(&scene);
+    b.translate({0.0f, 1.5f, -5.0f});
+    new IdDrawable<3>(b, group, 1, drawn);
+    group[1].setBoundingSphere({}, 0.4f);
+
+    Object3D c(&scene);
+    c.translate({0.0f, 0.0f, -0.5f});
+    new IdDrawable<3>(c, group, 2, drawn);
+    group[2].setBoundingBox({Vector3(-0.4f), Vector3(0.4f)});
+
+    Object3D d(&scene);
+    d.translate({0.0f, 0.0f, -0.5f});
+    new IdDrawable<3>(d, group, 3, drawn);
+    group[3].setBoundingBox({Vector3(-0.6f), Vector3(0.6f)});
+
+    camera.draw(group);
+    CORRADE_COMPARE(drawn, (std::vector<Int>{0, 3}));
+}
+
+void CameraTest::cull2D() {
+    Scene2D scene;
+    DrawableGroup2D group;
+    std::vector<Int> drawn;
+
+    Object2D cameraObject(&scene);
+    Camera2D camera(cameraObject);
+    camera.setProjection({4.0f, 2.0f});
+
+    Object2D a(&scene);
+    a.translate({2.5f, 0.0f});
+    new IdDrawable<2>(a, group, 0, drawn);
+    group[0].setBoundingSphere({}, 0.6f);
+
+    Object2D b(&scene);
+    b.translate({0.0f, -1.5f});
+    new IdDrawable<2>(b, group, 1, drawn);
+    group[1].setBoundingBox({Vector2(-0.4f), Vector2(0.4f)});
+
+    Object2D c(&scene);
+    new IdDrawable<2>(c, group, 2, drawn);
+    group[2].setBoundingBox({Vector2(-0.4f), Vector2(0.4f)});
+
+    camera.draw(group);
+    CORRADE_COMPARE(drawn, (std::vector<Int>{0, 2}));
+}
+
+void CameraTest::drawOrder() {
+    Scene3D scene;
+    DrawableGroup3D group;
+    std::vector<Int> drawn;
+
+    Object3D cameraObject(&scene);
+    Camera3D camera(cameraObject);
+    camera.setPerspective(Deg(90.0f), 1.0f, 1.0f, 100.0f);
+
+    const Float depths[]{5.0f, 3.0f, 8.0f, 4.0f, 6.0f};
+    const UnsignedInt keys[]{1, 0, 1, 0, 1};
+    std::vector<std::unique_ptr<Object3D>> objects;
+    for(Int i = 0; i != 5; ++i) {
+        objects.emplace_back(new Object3D(&scene));
+        objects.back()->translate(Vector3::zAxis(-depths[i]));
+        (new IdDrawable<3>(*objects.back(), group, i, drawn))
+            ->setSortKey(keys[i]);
+    }
+
+    CORRADE_VERIFY(camera.drawOrder() == DrawOrder::Group);
+    camera.draw(group);
+    CORRADE_COMPARE(drawn, (std::vector<Int>{0, 1, 2, 3, 4}));
+
+    drawn.clear();
+    camera.setDrawOrder(DrawOrder::SortKey)
+        .draw(group);
+    CORRADE_COMPARE(drawn, (std::vector<Int>{1, 3, 0, 2, 4}));
+
+    drawn.clear();
+    camera.setDrawOrder(DrawOrder::FrontToBack)
+        .draw(group);
+    CORRADE_COMPARE(drawn, (std::vector<Int>{1, 3, 0, 4, 2}));
+
+    drawn.clear();
+    camera.setDrawOrder(DrawOrder::BackToFront)
+        .draw(group);
+    CORRADE_COMPARE(drawn, (std::vector<Int>{3, 1, 2, 4, 0}));
+}
+
 }}}
 
 CORRADE_TEST_MAIN(Magnum::SceneGraph::Test::CameraTest)
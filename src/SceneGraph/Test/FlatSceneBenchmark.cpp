@@ -0,0 +1,144 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <chrono>
+#include <random>
+#include <TestSuite/Tester.h>
+
+#include "SceneGraph/FlatScene.h"
+#include "SceneGraph/MatrixTransformation3D.h"
+#include "SceneGraph/Scene.h"
+
+namespace Magnum { namespace SceneGraph { namespace Test {
+
+class FlatSceneBenchmark: public TestSuite::Tester {
+    public:
+        FlatSceneBenchmark();
+
+        void transformations();
+        void partialUpdate();
+
+    private:
+        std::vector<UnsignedInt> parents;
+        std::vector<Matrix4> localTransformations;
+};
+
+typedef SceneGraph::Object<SceneGraph::MatrixTransformation3D> Object3D;
+typedef SceneGraph::Scene<SceneGraph::MatrixTransformation3D> Scene3D;
+typedef SceneGraph::FlatObject<SceneGraph::MatrixTransformation3D> FlatObject3D;
+typedef SceneGraph::FlatScene<SceneGraph::MatrixTransformation3D> FlatScene3D;
+
+namespace {
+    enum: std::size_t { ObjectCount = 131072, Repeats = 10, ChangedObjectCount = ObjectCount/100 };
+
+    typedef std::chrono::high_resolution_clock Clock;
+}
+
+FlatSceneBenchmark::FlatSceneBenchmark() {
+    addTests({&FlatSceneBenchmark::transformations,
+              &FlatSceneBenchmark::partialUpdate});
+
+    /* Random tree, each object has parent among objects created before it
+       (or the scene, which is ~0u), with random local transformation */
+    std::mt19937 random;
+    std::uniform_real_distribution<Float> distribution(-1.0f, 1.0f);
+    parents.reserve(ObjectCount);
+    localTransformations.reserve(ObjectCount);
+    for(std::size_t i = 0; i != ObjectCount; ++i) {
+        parents.push_back(i ? UnsignedInt(std::uniform_int_distribution<std::size_t>(0, i)(random)) - 1 : ~UnsignedInt(0));
+        localTransformations.push_back(Matrix4::translation({distribution(random), distribution(random), distribution(random)})*
+            Matrix4::rotationZ(Rad(distribution(random))));
+    }
+}
+
+void FlatSceneBenchmark::transformations() {
+    /* Pointer-based hierarchy */
+    Scene3D scene;
+    std::vector<Object3D*> objects;
+    objects.reserve(ObjectCount);
+    for(std::size_t i = 0; i != ObjectCount; ++i) {
+        objects.push_back(new Object3D(parents[i] == ~UnsignedInt(0) ? &scene : objects[parents[i]]));
+        objects.back()->setTransformation(localTransformations[i]);
+    }
+
+    std::vector<Matrix4> objectTransformations;
+    Clock::duration objectTime{};
+    for(std::size_t r = 0; r != Repeats; ++r) {
+        const auto begin = Clock::now();
+        objectTransformations = scene.transformations(objects);
+        objectTime += Clock::now() - begin;
+    }
+
+    /* Flat scene, all objects are changed before each computation */
+    FlatScene3D flatScene;
+    flatScene.reserve(ObjectCount);
+    std::vector<FlatObject3D*> flatObjects;
+    flatObjects.reserve(ObjectCount);
+    for(std::size_t i = 0; i != ObjectCount; ++i)
+        flatObjects.push_back(new FlatObject3D(parents[i] == ~UnsignedInt(0) ? flatScene : *flatObjects[parents[i]]));
+
+    std::vector<Matrix4> flatTransformations;
+    Clock::duration flatTime{};
+    for(std::size_t r = 0; r != Repeats; ++r) {
+        for(std::size_t i = 0; i != ObjectCount; ++i)
+            flatObjects[i]->setTransformation(localTransformations[i]);
+
+        const auto begin = Clock::now();
+        flatTransformations = flatScene.transformations(flatObjects);
+        flatTime += Clock::now() - begin;
+    }
+
+    Debug() << "Absolute transformations of" << ObjectCount << "objects, Object:" << std::chrono::duration<Double, std::milli>(objectTime).count()/Repeats << "ms, FlatObject:" << std::chrono::duration<Double, std::milli>(flatTime).count()/Repeats << "ms";
+}
+
+void FlatSceneBenchmark::partialUpdate() {
+    FlatScene3D scene;
+    scene.reserve(ObjectCount);
+    std::vector<FlatObject3D*> objects;
+    objects.reserve(ObjectCount);
+    for(std::size_t i = 0; i != ObjectCount; ++i) {
+        objects.push_back(new FlatObject3D(parents[i] == ~UnsignedInt(0) ? scene : *objects[parents[i]]));
+        objects.back()->setTransformation(localTransformations[i]);
+    }
+    scene.setClean();
+
+    /* Change few random objects each time */
+    std::mt19937 random;
+    std::uniform_int_distribution<std::size_t> distribution(0, ObjectCount - 1);
+    Clock::duration time{};
+    for(std::size_t r = 0; r != Repeats; ++r) {
+        for(std::size_t i = 0; i != ChangedObjectCount; ++i)
+            objects[distribution(random)]->transform(Matrix4::translation(Vector3::xAxis()));
+
+        const auto begin = Clock::now();
+        scene.setClean();
+        time += Clock::now() - begin;
+    }
+
+    Debug() << "Cleaning" << ObjectCount << "objects with" << ChangedObjectCount << "changed:" << std::chrono::duration<Double, std::milli>(time).count()/Repeats << "ms";
+}
+
+}}}
+
+CORRADE_TEST_MAIN(Magnum::SceneGraph::Test::FlatSceneBenchmark)
@@ -0,0 +1,449 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <algorithm>
+#include <random>
+#include <sstream>
+#include <TestSuite/Tester.h>
+
+#include "Math/Functions.h"
+#include "SceneGraph/AbstractFeature.h"
+#include "SceneGraph/FlatScene.h"
+#include "SceneGraph/MatrixTransformation3D.h"
+#include "SceneGraph/Scene.h"
+
+namespace Magnum { namespace SceneGraph { namespace Test {
+
+class FlatSceneTest: public TestSuite::Tester {
+    public:
+        FlatSceneTest();
+
+        void parenting();
+        void parentingCycle();
+        void destroy();
+        void scene();
+        void transformation();
+        void absoluteTransformation();
+        void transformations();
+        void transformationsReordered();
+        void transformationsObject();
+        void setDirty();
+        void setDirtyChildren();
+        void setClean();
+        void setCleanPartial();
+};
+
+typedef SceneGraph::FlatObject<SceneGraph::MatrixTransformation3D> FlatObject3D;
+typedef SceneGraph::FlatScene<SceneGraph::MatrixTransformation3D> FlatScene3D;
+
+class CachingFeature: public AbstractFeature3D {
+    public:
+        CachingFeature(AbstractObject3D& object): AbstractFeature3D(object), dirtyCount(0) {
+            setCachedTransformations(CachedTransformation::Absolute);
+        }
+
+        Matrix4 cleanedAbsoluteTransformation;
+        Int dirtyCount;
+
+    protected:
+        void markDirty() override { ++dirtyCount; }
+
+        void clean(const Matrix4& absoluteTransformation) override {
+            cleanedAbsoluteTransformation = absoluteTransformation;
+        }
+};
+
+FlatSceneTest::FlatSceneTest() {
+    addTests({&FlatSceneTest::parenting,
+              &FlatSceneTest::parentingCycle,
+              &FlatSceneTest::destroy,
+              &FlatSceneTest::scene,
+              &FlatSceneTest::transformation,
+              &FlatSceneTest::absoluteTransformation,
+              &FlatSceneTest::transformations,
+              &FlatSceneTest::transformationsReordered,
+              &FlatSceneTest::transformationsObject,
+              &FlatSceneTest::setDirty,
+              &FlatSceneTest::setDirtyChildren,
+              &FlatSceneTest::setClean,
+              &FlatSceneTest::setCleanPartial});
+}
+
+void FlatSceneTest::parenting() {
+    FlatScene3D scene;
+
+    FlatObject3D* childOne = new FlatObject3D(scene);
+    FlatObject3D* childTwo = new FlatObject3D(scene);
+    CORRADE_COMPARE(scene.size(), 2);
+    CORRADE_VERIFY(scene.hasChildren());
+    CORRADE_VERIFY(scene.parent() == nullptr);
+    CORRADE_VERIFY(childOne->parent() == &scene);
+    CORRADE_VERIFY(childTwo->parent() == &scene);
+    CORRADE_VERIFY(!childOne->hasChildren());
+
+    /* Reparent to another */
+    childOne->setParent(*childTwo);
+    CORRADE_VERIFY(childOne->parent() == childTwo);
+    CORRADE_VERIFY(childTwo->hasChildren());
+
+    /* Scene parent cannot be changed */
+    scene.setParent(*childOne);
+    CORRADE_VERIFY(scene.parent() == nullptr);
+
+    /* Delete child */
+    delete childOne;
+    CORRADE_COMPARE(scene.size(), 1);
+    CORRADE_VERIFY(!childTwo->hasChildren());
+}
+
+void FlatSceneTest::parentingCycle() {
+    std::stringstream o;
+    Error::setOutput(&o);
+
+    FlatScene3D scene;
+    FlatObject3D* childOne = new FlatObject3D(scene);
+    FlatObject3D* childTwo = new FlatObject3D(*childOne);
+
+    childOne->setParent(*childOne);
+    CORRADE_VERIFY(childOne->parent() == &scene);
+    CORRADE_COMPARE(o.str(), "SceneGraph::FlatObject::setParent(): the object cannot be parented to itself or its child\n");
+
+    o.str({});
+    childOne->setParent(*childTwo);
+    CORRADE_VERIFY(childOne->parent() == &scene);
+    CORRADE_COMPARE(o.str(), "SceneGraph::FlatObject::setParent(): the object cannot be parented to itself or its child\n");
+
+    o.str({});
+    FlatScene3D another;
+    childTwo->setParent(another);
+    CORRADE_VERIFY(childTwo->parent() == childOne);
+    CORRADE_COMPARE(o.str(), "SceneGraph::FlatObject::setParent(): the parent is not part of the same scene\n");
+}
+
+void FlatSceneTest::destroy() {
+    FlatScene3D scene;
+
+    FlatObject3D* a = new FlatObject3D(scene);
+    FlatObject3D* b = new FlatObject3D(*a);
+    new FlatObject3D(*b);
+    FlatObject3D* c = new FlatObject3D(scene);
+    new FlatObject3D(*c);
+
+    /* Child created before the parent */
+    FlatObject3D* d = new FlatObject3D(scene);
+    c->setParent(*d);
+    CORRADE_COMPARE(scene.size(), 6);
+
+    /* Deletes whole subtree */
+    delete a;
+    CORRADE_COMPARE(scene.size(), 3);
+    delete d;
+    CORRADE_COMPARE(scene.size(), 0);
+    CORRADE_VERIFY(!scene.hasChildren());
+
+    /* The rest is deleted by the scene */
+    FlatObject3D* e = new FlatObject3D(scene);
+    new FlatObject3D(*e);
+    CORRADE_COMPARE(scene.size(), 2);
+}
+
+void FlatSceneTest::scene() {
+    FlatScene3D scene;
+    CORRADE_VERIFY(scene.scene() == &scene);
+
+    FlatObject3D* childOne = new FlatObject3D(scene);
+    FlatObject3D* childTwo = new FlatObject3D(*childOne);
+    CORRADE_VERIFY(childTwo->scene() == &scene);
+
+    /* Through the abstract interface */
+    AbstractObject3D& abstract = *childTwo;
+    CORRADE_VERIFY(abstract.scene() == &scene);
+}
+
+void FlatSceneTest::transformation() {
+    FlatScene3D scene;
+
+    /* Scene transformation cannot be changed */
+    scene.setTransformation(Matrix4::translation(Vector3::xAxis()));
+    CORRADE_COMPARE(scene.transformation(), Matrix4());
+
+    FlatObject3D* object = new FlatObject3D(scene);
+    object->setTransformation(Matrix4::translation(Vector3::xAxis()))
+        .transform(Matrix4::rotationZ(Deg(90.0f)))
+        .transform(Matrix4::scaling(Vector3(2.0f)), TransformationType::Local);
+    CORRADE_COMPARE(object->transformation(), Matrix4::rotationZ(Deg(90.0f))*
+                                              Matrix4::translation(Vector3::xAxis())*
+                                              Matrix4::scaling(Vector3(2.0f)));
+    CORRADE_COMPARE(object->transformationMatrix(), object->transformation());
+
+    object->resetTransformation();
+    CORRADE_COMPARE(object->transformation(), Matrix4());
+}
+
+void FlatSceneTest::absoluteTransformation() {
+    FlatScene3D scene;
+
+    FlatObject3D* a = new FlatObject3D(scene);
+    a->setTransformation(Matrix4::translation(Vector3::xAxis()));
+    FlatObject3D* b = new FlatObject3D(*a);
+    b->setTransformation(Matrix4::rotationZ(Deg(35.0f)));
+    FlatObject3D* c = new FlatObject3D(*b);
+    c->setTransformation(Matrix4::scaling(Vector3(2.0f)));
+
+    const Matrix4 expected = Matrix4::translation(Vector3::xAxis())*
+                             Matrix4::rotationZ(Deg(35.0f))*
+                             Matrix4::scaling(Vector3(2.0f));
+
+    /* Computed by going up the hierarchy */
+    CORRADE_COMPARE(c->absoluteTransformation(), expected);
+
+    /* Cached */
+    scene.setClean();
+    CORRADE_COMPARE(c->absoluteTransformation(), expected);
+
+    /* Only middle object changed */
+    b->setTransformation(Matrix4::rotationZ(Deg(15.0f)));
+    CORRADE_COMPARE(c->absoluteTransformation(), Matrix4::translation(Vector3::xAxis())*
+                                                 Matrix4::rotationZ(Deg(15.0f))*
+                                                 Matrix4::scaling(Vector3(2.0f)));
+
+    /* Through the abstract interface */
+    const AbstractObject3D& abstract = *c;
+    CORRADE_COMPARE(abstract.absoluteTransformationMatrix(), c->absoluteTransformation());
+    CORRADE_COMPARE(scene.absoluteTransformation(), Matrix4());
+}
+
+void FlatSceneTest::transformations() {
+    FlatScene3D scene;
+
+    FlatObject3D* a = new FlatObject3D(scene);
+    a->setTransformation(Matrix4::translation(Vector3::xAxis()));
+    FlatObject3D* b = new FlatObject3D(*a);
+    b->setTransformation(Matrix4::rotationZ(Deg(35.0f)));
+    FlatObject3D* c = new FlatObject3D(scene);
+    c->setTransformation(Matrix4::scaling(Vector3(2.0f)));
+
+    const Matrix4 initial = Matrix4::translation(Vector3::zAxis());
+    std::vector<Matrix4> transformations = scene.transformations({b, &scene, c, b}, initial);
+    CORRADE_COMPARE(transformations.size(), 4);
+    CORRADE_COMPARE(transformations[0], initial*Matrix4::translation(Vector3::xAxis())*Matrix4::rotationZ(Deg(35.0f)));
+    CORRADE_COMPARE(transformations[1], initial);
+    CORRADE_COMPARE(transformations[2], initial*Matrix4::scaling(Vector3(2.0f)));
+    CORRADE_COMPARE(transformations[3], transformations[0]);
+
+    /* Features are not cleaned by this */
+    CORRADE_VERIFY(b->isDirty());
+
+    /* Through the abstract interface */
+    const AbstractObject3D& abstract = scene;
+    CORRADE_COMPARE(abstract.transformationMatrices({c}), std::vector<Matrix4>{Matrix4::scaling(Vector3(2.0f))});
+}
+
+void FlatSceneTest::transformationsReordered() {
+    FlatScene3D scene;
+
+    /* Chain with parents created after children */
+    std::vector<FlatObject3D*> objects;
+    for(Int i = 0; i != 10; ++i) {
+        objects.push_back(new FlatObject3D(scene));
+        objects.back()->setTransformation(Matrix4::translation(Vector3::xAxis()*Float(i + 1)));
+    }
+    for(std::size_t i = 0; i != 9; ++i)
+        objects[i]->setParent(*objects[i + 1]);
+
+    /* Remove few in the middle, moving the rest to the top */
+    objects[7]->setParent(scene);
+    delete objects[9];
+    objects.erase(objects.begin() + 8, objects.end());
+    CORRADE_COMPARE(scene.size(), 8);
+
+    std::vector<Matrix4> transformations = scene.transformations(objects);
+    Vector3 translation;
+    for(std::size_t i = objects.size(); i != 0; --i) {
+        translation += Vector3::xAxis()*Float(i);
+        CORRADE_COMPARE(transformations[i - 1], Matrix4::translation(translation));
+        CORRADE_VERIFY(objects[i - 1]->parent() == (i == objects.size() ? static_cast<FlatObject3D*>(&scene) : objects[i]));
+    }
+}
+
+void FlatSceneTest::transformationsObject() {
+    /* Random tree, each object has parent among objects created before it */
+    std::mt19937 random;
+    std::uniform_real_distribution<Float> distribution(-1.0f, 1.0f);
+    Scene<MatrixTransformation3D> scene;
+    FlatScene3D flatScene;
+    std::vector<Object<MatrixTransformation3D>*> objects;
+    std::vector<FlatObject3D*> flatObjects;
+    for(std::size_t i = 0; i != 256; ++i) {
+        const std::size_t parent = std::uniform_int_distribution<std::size_t>(0, i)(random);
+        const Matrix4 transformation = Matrix4::translation({distribution(random), distribution(random), distribution(random)})*
+            Matrix4::rotationZ(Rad(distribution(random)));
+        objects.push_back(new Object<MatrixTransformation3D>(parent ? objects[parent - 1] : &scene));
+        objects.back()->setTransformation(transformation);
+        flatObjects.push_back(new FlatObject3D(parent ? *flatObjects[parent - 1] : flatScene));
+        flatObjects.back()->setTransformation(transformation);
+    }
+
+    /* Object composes the transformations in different order, so the
+       rounding errors differ slightly */
+    const std::vector<Matrix4> expected = scene.transformations(objects);
+    const std::vector<Matrix4> transformations = flatScene.transformations(flatObjects);
+    CORRADE_COMPARE(transformations.size(), expected.size());
+    Float maxDifference = 0.0f;
+    for(std::size_t i = 0; i != expected.size(); ++i) for(std::size_t col = 0; col != 4; ++col)
+        maxDifference = std::max(maxDifference, Math::abs(transformations[i][col] - expected[i][col]).max());
+    CORRADE_VERIFY(maxDifference < 1.0e-4f);
+}
+
+void FlatSceneTest::setDirty() {
+    FlatScene3D scene;
+
+    FlatObject3D* a = new FlatObject3D(scene);
+    FlatObject3D* b = new FlatObject3D(*a);
+    CachingFeature* feature = new CachingFeature(*b);
+
+    /* All objects are dirty by default, the scene never */
+    CORRADE_VERIFY(!scene.isDirty());
+    CORRADE_VERIFY(a->isDirty());
+    CORRADE_VERIFY(b->isDirty());
+
+    scene.setClean();
+    CORRADE_VERIFY(!a->isDirty());
+    CORRADE_VERIFY(!b->isDirty());
+
+    /* Children are dirty too, their features are notified */
+    a->setDirty();
+    CORRADE_VERIFY(a->isDirty());
+    CORRADE_VERIFY(b->isDirty());
+    CORRADE_COMPARE(feature->dirtyCount, 1);
+
+    /* Features are notified only once */
+    b->setDirty();
+    b->setDirty();
+    a->setDirty();
+    CORRADE_COMPARE(feature->dirtyCount, 1);
+
+    /* Dirty subtree is not notified again */
+    scene.setClean();
+    b->setDirty();
+    a->setDirty();
+    CORRADE_COMPARE(feature->dirtyCount, 2);
+}
+
+void FlatSceneTest::setDirtyChildren() {
+    FlatScene3D scene;
+
+    FlatObject3D* a = new FlatObject3D(scene);
+    FlatObject3D* b = new FlatObject3D(*a);
+    FlatObject3D* c = new FlatObject3D(*b);
+    FlatObject3D* d = new FlatObject3D(scene);
+    CachingFeature* featureB = new CachingFeature(*b);
+    CachingFeature* featureC = new CachingFeature(*c);
+    CachingFeature* featureD = new CachingFeature(*d);
+    scene.setClean();
+
+    /* All descendants are notified, other objects not */
+    a->setDirty();
+    CORRADE_COMPARE(featureB->dirtyCount, 1);
+    CORRADE_COMPARE(featureC->dirtyCount, 1);
+    CORRADE_COMPARE(featureD->dirtyCount, 0);
+
+    /* Subtree moved under object which is later in the storage */
+    scene.setClean();
+    a->setParent(*d);
+    CORRADE_COMPARE(featureB->dirtyCount, 2);
+    CORRADE_COMPARE(featureC->dirtyCount, 2);
+    CORRADE_COMPARE(featureD->dirtyCount, 0);
+
+    scene.setClean();
+    d->setDirty();
+    CORRADE_COMPARE(featureB->dirtyCount, 3);
+    CORRADE_COMPARE(featureC->dirtyCount, 3);
+    CORRADE_COMPARE(featureD->dirtyCount, 1);
+
+    /* Cleaned with the new transformation */
+    d->setTransformation(Matrix4::translation(Vector3::xAxis(10.0f)));
+    scene.setClean();
+    CORRADE_COMPARE(featureC->cleanedAbsoluteTransformation, Matrix4::translation(Vector3::xAxis(10.0f)));
+}
+
+void FlatSceneTest::setClean() {
+    FlatScene3D scene;
+
+    FlatObject3D* a = new FlatObject3D(scene);
+    a->setTransformation(Matrix4::translation(Vector3::xAxis()));
+    FlatObject3D* b = new FlatObject3D(*a);
+    b->setTransformation(Matrix4::rotationZ(Deg(35.0f)));
+    CachingFeature* featureA = new CachingFeature(*a);
+    CachingFeature* featureB = new CachingFeature(*b);
+
+    b->setClean();
+    CORRADE_VERIFY(!a->isDirty());
+    CORRADE_VERIFY(!b->isDirty());
+    CORRADE_COMPARE(featureA->cleanedAbsoluteTransformation, Matrix4::translation(Vector3::xAxis()));
+    CORRADE_COMPARE(featureB->cleanedAbsoluteTransformation, Matrix4::translation(Vector3::xAxis())*Matrix4::rotationZ(Deg(35.0f)));
+
+    /* Transformation of parent is propagated to children, even if it was
+       recomputed in between */
+    a->setTransformation(Matrix4::translation(Vector3::yAxis()));
+    scene.transformations({b});
+    CORRADE_VERIFY(b->isDirty());
+    AbstractObject3D::setClean({b});
+    CORRADE_VERIFY(!b->isDirty());
+    CORRADE_COMPARE(featureA->cleanedAbsoluteTransformation, Matrix4::translation(Vector3::yAxis()));
+    CORRADE_COMPARE(featureB->cleanedAbsoluteTransformation, Matrix4::translation(Vector3::yAxis())*Matrix4::rotationZ(Deg(35.0f)));
+}
+
+void FlatSceneTest::setCleanPartial() {
+    std::mt19937 random;
+    FlatScene3D scene;
+    std::vector<FlatObject3D*> objects;
+    std::vector<CachingFeature*> features;
+    for(std::size_t i = 0; i != 256; ++i) {
+        const std::size_t parent = std::uniform_int_distribution<std::size_t>(0, i)(random);
+        objects.push_back(new FlatObject3D(parent ? *objects[parent - 1] : scene));
+        objects.back()->setTransformation(Matrix4::rotationZ(Deg(Float(i))));
+        features.push_back(new CachingFeature(*objects.back()));
+    }
+    scene.setClean();
+
+    /* Change few random objects, cleaned transformations match the computed
+       ones */
+    std::uniform_int_distribution<std::size_t> distribution(0, objects.size() - 1);
+    for(std::size_t r = 0; r != 3; ++r) {
+        for(std::size_t i = 0; i != 5; ++i)
+            objects[distribution(random)]->transform(Matrix4::translation(Vector3::xAxis()));
+        scene.setClean();
+
+        const std::vector<Matrix4> transformations = scene.transformations(objects);
+        for(std::size_t i = 0; i != objects.size(); ++i) {
+            CORRADE_VERIFY(!objects[i]->isDirty());
+            CORRADE_COMPARE(features[i]->cleanedAbsoluteTransformation, transformations[i]);
+        }
+    }
+}
+
+}}}
+
+CORRADE_TEST_MAIN(Magnum::SceneGraph::Test::FlatSceneTest)
@@ -0,0 +1,163 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <chrono>
+#include <random>
+#include <thread>
+#include <TestSuite/Tester.h>
+
+#include "SceneGraph/MatrixTransformation3D.h"
+#include "SceneGraph/Scene.h"
+
+namespace Magnum { namespace SceneGraph { namespace Test {
+
+class ObjectBenchmark: public TestSuite::Tester {
+    public:
+        ObjectBenchmark();
+
+        void flat();
+        void random();
+        void deep();
+        void parallel();
+        void setClean();
+};
+
+typedef SceneGraph::Object<SceneGraph::MatrixTransformation3D> Object3D;
+typedef SceneGraph::Scene<SceneGraph::MatrixTransformation3D> Scene3D;
+
+namespace {
+    enum: std::size_t { Repeats = 3, ChainLength = 1000 };
+    constexpr std::size_t ObjectCounts[]{10000, 100000, 1000000};
+
+    typedef std::chrono::high_resolution_clock Clock;
+
+    /* Creates the hierarchy with given parent indices (~0u is the scene),
+       computes transformations of all objects and returns time per object */
+    template<class Parent> Double benchmark(const std::size_t objectCount, Parent parent, const std::size_t threadCount = 1) {
+        Scene3D scene;
+        scene.setThreadCount(threadCount);
+        std::vector<Object3D*> objects;
+        objects.reserve(objectCount);
+        for(std::size_t i = 0; i != objectCount; ++i) {
+            const std::size_t p = parent(i);
+            objects.push_back(new Object3D(p == ~std::size_t(0) ? &scene : objects[p]));
+            objects.back()->translate(Vector3::xAxis());
+        }
+
+        Clock::duration time{};
+        for(std::size_t r = 0; r != Repeats; ++r) {
+            const auto begin = Clock::now();
+            const std::vector<Matrix4> transformations = scene.transformations(objects);
+            time += Clock::now() - begin;
+
+            if(transformations.size() != objectCount) return 0.0;
+        }
+
+        return std::chrono::duration<Double, std::nano>(time).count()/(Repeats*objectCount);
+    }
+}
+
+ObjectBenchmark::ObjectBenchmark() {
+    addTests({&ObjectBenchmark::flat,
+              &ObjectBenchmark::random,
+              &ObjectBenchmark::deep,
+              &ObjectBenchmark::parallel,
+              &ObjectBenchmark::setClean});
+}
+
+void ObjectBenchmark::flat() {
+    /* All objects are direct children of the scene */
+    for(const std::size_t objectCount: ObjectCounts) {
+        const Double time = benchmark(objectCount, [](std::size_t) { return ~std::size_t(0); });
+        Debug() << "Flat hierarchy of" << objectCount << "objects:" << time << "ns per object";
+    }
+}
+
+void ObjectBenchmark::random() {
+    /* Each object has random parent among objects created before it, the
+       tree has logarithmic depth on average */
+    for(const std::size_t objectCount: ObjectCounts) {
+        std::mt19937 random;
+        const Double time = benchmark(objectCount, [&random](std::size_t i) {
+            return std::uniform_int_distribution<std::size_t>(0, i)(random) - 1;
+        });
+        Debug() << "Random hierarchy of" << objectCount << "objects:" << time << "ns per object";
+    }
+}
+
+void ObjectBenchmark::deep() {
+    /* Chains of ChainLength objects, each object is joint */
+    for(const std::size_t objectCount: ObjectCounts) {
+        const Double time = benchmark(objectCount, [](std::size_t i) {
+            return i%ChainLength ? i - 1 : ~std::size_t(0);
+        });
+        Debug() << "Chains of" << ChainLength << "objects," << objectCount << "objects total:" << time << "ns per object";
+    }
+}
+
+void ObjectBenchmark::parallel() {
+    /* Random hierarchy on one and on all hardware threads */
+    for(const std::size_t threadCount: {1, 0}) {
+        std::mt19937 random;
+        const Double time = benchmark(ObjectCounts[2], [&random](std::size_t i) {
+            return std::uniform_int_distribution<std::size_t>(0, i)(random) - 1;
+        }, threadCount);
+        Debug() << "Random hierarchy of" << ObjectCounts[2] << "objects on" << (threadCount ? threadCount : std::thread::hardware_concurrency()) << "threads:" << time << "ns per object";
+    }
+}
+
+void ObjectBenchmark::setClean() {
+    /* Random hierarchy */
+    std::mt19937 random;
+    Scene3D scene;
+    std::vector<Object3D*> objects;
+    objects.reserve(ObjectCounts[1]);
+    for(std::size_t i = 0; i != ObjectCounts[1]; ++i) {
+        const std::size_t parent = std::uniform_int_distribution<std::size_t>(0, i)(random);
+        objects.push_back(new Object3D(parent ? objects[parent - 1] : &scene));
+        objects.back()->translate(Vector3::xAxis());
+    }
+    scene.setClean();
+
+    /* Move few random objects each frame, or nothing at all */
+    std::uniform_int_distribution<std::size_t> distribution(0, ObjectCounts[1] - 1);
+    for(const std::size_t movedCount: {std::size_t(0), ObjectCounts[1]/1000, ObjectCounts[1]/100}) {
+        Clock::duration time{};
+        scene.resetCleanedObjectCount();
+        for(std::size_t r = 0; r != Repeats; ++r) {
+            for(std::size_t i = 0; i != movedCount; ++i)
+                objects[distribution(random)]->translate(Vector3::xAxis());
+
+            const auto begin = Clock::now();
+            scene.setClean();
+            time += Clock::now() - begin;
+        }
+
+        Debug() << "Cleaning" << ObjectCounts[1] << "objects with" << movedCount << "moved:" << std::chrono::duration<Double, std::micro>(time).count()/Repeats << "us," << scene.cleanedObjectCount()/Repeats << "objects recomputed";
+    }
+}
+
+}}}
+
+CORRADE_TEST_MAIN(Magnum::SceneGraph::Test::ObjectBenchmark)
@@ -22,7 +22,9 @@
     DEALINGS IN THE SOFTWARE.
 */
 
+#include <random>
 #include <sstream>
+#include <thread>
 #include <TestSuite/Tester.h>
 
 #include "SceneGraph/MatrixTransformation3D.h"
@@ -42,6 +44,10 @@ class ObjectTest: public TestSuite::Tester {
         void transformationsRelative();
         void transformationsOrphan();
         void transformationsDuplicate();
+        void transformationsLarge();
+        void transformationsDeep();
+        void transformationsParallel();
+        void transformationsConcurrent();
         void setClean();
         void setCleanListHierarchy();
         void setCleanListBulk();
@@ -73,6 +79,10 @@ ObjectTest::ObjectTest() {
               &ObjectTest::transformationsRelative,
               &ObjectTest::transformationsOrphan,
               &ObjectTest::transformationsDuplicate,
+              &ObjectTest::transformationsLarge,
+              &ObjectTest::transformationsDeep,
+              &ObjectTest::transformationsParallel,
+              &ObjectTest::transformationsConcurrent,
               &ObjectTest::setClean,
               &ObjectTest::setCleanListHierarchy,
               &ObjectTest::setCleanListBulk});
@@ -266,6 +276,124 @@ void ObjectTest::transformationsDuplicate() {
     }));
 }
 
+void ObjectTest::transformationsLarge() {
+    Scene3D s;
+
+    /* More objects than fits into 16 bits, with shared parents */
+    std::vector<Object3D*> objects;
+    for(Int i = 0; i != 256; ++i) {
+        Object3D* parent = new Object3D(&s);
+        parent->translate(Vector3::xAxis(Float(i)));
+        for(Int j = 0; j != 256; ++j) {
+            objects.push_back(new Object3D(parent));
+            objects.back()->translate(Vector3::yAxis(Float(j)));
+        }
+        objects.push_back(parent);
+    }
+    CORRADE_VERIFY(objects.size() > 65535);
+
+    std::vector<Matrix4> transformations = s.transformations(objects);
+    CORRADE_COMPARE(transformations.size(), objects.size());
+    CORRADE_COMPARE(transformations[0], Matrix4::translation({0.0f, 0.0f, 0.0f}));
+    CORRADE_COMPARE(transformations[257 + 13], Matrix4::translation({1.0f, 13.0f, 0.0f}));
+    CORRADE_COMPARE(transformations[257*255 + 255], Matrix4::translation({255.0f, 255.0f, 0.0f}));
+    CORRADE_COMPARE(transformations.back(), Matrix4::translation({255.0f, 0.0f, 0.0f}));
+}
+
+void ObjectTest::transformationsDeep() {
+    Scene3D s;
+
+    /* Deep chain, each object is a joint */
+    std::vector<Object3D*> objects;
+    for(Int i = 0; i != 100000; ++i) {
+        objects.push_back(new Object3D(objects.empty() ? &s : objects.back()));
+        objects.back()->translate(Vector3::xAxis());
+    }
+
+    std::vector<Matrix4> transformations = s.transformations(objects);
+    CORRADE_COMPARE(transformations.size(), objects.size());
+    CORRADE_COMPARE(transformations[999], Matrix4::translation(Vector3::xAxis(1000.0f)));
+    CORRADE_COMPARE(transformations.back(), Matrix4::translation(Vector3::xAxis(100000.0f)));
+
+    /* Delete from the bottom to avoid deep recursion in destructors */
+    for(auto it = objects.rbegin(); it != objects.rend(); ++it) delete *it;
+}
+
+void ObjectTest::transformationsParallel() {
+    Scene3D s;
+    CORRADE_COMPARE(s.threadCount(), 1);
+
+    /* Random tree, each object has parent among objects created before it */
+    std::mt19937 random;
+    std::vector<Object3D*> objects;
+    for(std::size_t i = 0; i != 65536; ++i) {
+        const std::size_t parent = std::uniform_int_distribution<std::size_t>(0, i)(random);
+        objects.push_back(new Object3D(parent ? objects[parent - 1] : &s));
+        objects.back()->rotateZ(Deg(Float(i%7)))
+            .translate(Vector3::xAxis(Float(i%5)));
+    }
+
+    /* Request only every third object, some of them twice */
+    std::vector<Object3D*> requested;
+    for(std::size_t i = 0; i < objects.size(); i += 3) {
+        requested.push_back(objects[i]);
+        if(i % 11 == 0) requested.push_back(objects[i/2]);
+    }
+
+    const std::vector<Matrix4> expected = s.transformationMatrices(requested, Matrix4::translation(Vector3::yAxis()));
+
+    /* The result is exactly the same regardless of thread count */
+    CORRADE_COMPARE(s.setThreadCount(4).threadCount(), 4);
+    std::vector<Matrix4> transformations = s.transformationMatrices(requested, Matrix4::translation(Vector3::yAxis()));
+    CORRADE_VERIFY(transformations == expected);
+
+    /* The worker threads are kept for subsequent computations */
+    transformations = s.transformationMatrices(requested, Matrix4::translation(Vector3::yAxis()));
+    CORRADE_VERIFY(transformations == expected);
+
+    s.setThreadCount(0);
+    transformations = s.transformationMatrices(requested, Matrix4::translation(Vector3::yAxis()));
+    CORRADE_VERIFY(transformations == expected);
+
+    CORRADE_COMPARE(transformations[42], Matrix4::translation(Vector3::yAxis())*requested[42]->absoluteTransformation());
+}
+
+void ObjectTest::transformationsConcurrent() {
+    Scene3D s;
+
+    std::mt19937 random;
+    std::vector<Object3D*> objects;
+    for(std::size_t i = 0; i != 65536; ++i) {
+        const std::size_t parent = std::uniform_int_distribution<std::size_t>(0, i)(random);
+        objects.push_back(new Object3D(parent ? objects[parent - 1] : &s));
+        objects.back()->rotateZ(Deg(Float(i%7)))
+            .translate(Vector3::xAxis(Float(i%5)));
+    }
+
+    /* Two different object sets */
+    std::vector<Object3D*> even, odd;
+    for(std::size_t i = 0; i != objects.size(); ++i)
+        (i % 2 ? odd : even).push_back(objects[i]);
+
+    const std::vector<Matrix4> expectedEven = s.transformationMatrices(even);
+    const std::vector<Matrix4> expectedOdd = s.transformationMatrices(odd);
+
+    /* Both threads want the workers, one of them gets them and the other
+       computes everything on its own, the result is the same */
+    s.setThreadCount(4);
+    std::vector<Matrix4> transformationsEven, transformationsOdd;
+    std::thread thread([&]() {
+        for(std::size_t i = 0; i != 5; ++i)
+            transformationsEven = s.transformationMatrices(even);
+    });
+    for(std::size_t i = 0; i != 5; ++i)
+        transformationsOdd = s.transformationMatrices(odd);
+    thread.join();
+
+    CORRADE_VERIFY(transformationsEven == expectedEven);
+    CORRADE_VERIFY(transformationsOdd == expectedOdd);
+}
+
 void ObjectTest::setClean() {
     Scene3D scene;
 
@@ -35,6 +35,10 @@ class SceneTest: public TestSuite::Tester {
 
         void transformation();
         void parent();
+        void setClean();
+        void setCleanPartial();
+        void dirtyListRemove();
+        void dirtyListRemoveOrder();
 };
 
 typedef SceneGraph::Scene<SceneGraph::MatrixTransformation3D> Scene3D;
@@ -42,7 +46,11 @@ typedef SceneGraph::Object<SceneGraph::MatrixTransformation3D> Object3D;
 
 SceneTest::SceneTest() {
     addTests({&SceneTest::transformation,
-              &SceneTest::parent});
+              &SceneTest::parent,
+              &SceneTest::setClean,
+              &SceneTest::setCleanPartial,
+              &SceneTest::dirtyListRemove,
+              &SceneTest::dirtyListRemoveOrder});
 }
 
 void SceneTest::transformation() {
@@ -65,6 +73,133 @@ void SceneTest::parent() {
     CORRADE_VERIFY(!object.hasChildren());
 }
 
+void SceneTest::setClean() {
+    Scene3D scene;
+    Object3D* a = new Object3D(&scene);
+    a->translate(Vector3::xAxis(1.0f));
+    Object3D* b = new Object3D(a);
+    b->scale(Vector3(2.0f));
+    Object3D* c = new Object3D(b);
+    c->translate(Vector3::yAxis(3.0f));
+    Object3D* d = new Object3D(&scene);
+    d->translate(Vector3::zAxis(-1.0f));
+
+    /* Everything is cleaned, including the scene */
+    scene.setClean();
+    CORRADE_COMPARE(scene.cleanedObjectCount(), 5);
+    CORRADE_VERIFY(!scene.isDirty());
+    CORRADE_VERIFY(!c->isDirty());
+    CORRADE_VERIFY(!d->isDirty());
+    CORRADE_COMPARE(c->absoluteTransformation(), Matrix4::translation({1.0f, 6.0f, 0.0f})*Matrix4::scaling(Vector3(2.0f)));
+
+    /* Nothing moved, nothing to do */
+    scene.resetCleanedObjectCount().setClean();
+    CORRADE_COMPARE(scene.cleanedObjectCount(), 0);
+
+    /* Only the moved subtree is recomputed */
+    b->translate(Vector3::xAxis(1.0f));
+    CORRADE_VERIFY(c->isDirty());
+    CORRADE_VERIFY(!a->isDirty());
+    scene.setClean();
+    CORRADE_COMPARE(scene.cleanedObjectCount(), 2);
+    CORRADE_VERIFY(!c->isDirty());
+    CORRADE_COMPARE(c->absoluteTransformation(), Matrix4::translation({2.0f, 6.0f, 0.0f})*Matrix4::scaling(Vector3(2.0f)));
+
+    /* Transformations of clean objects are taken from cache */
+    CORRADE_COMPARE(scene.transformationMatrices({c, d}, Matrix4::translation(Vector3::xAxis(1.0f))), (std::vector<Matrix4>{
+        Matrix4::translation({3.0f, 6.0f, 0.0f})*Matrix4::scaling(Vector3(2.0f)),
+        Matrix4::translation({1.0f, 0.0f, -1.0f})
+    }));
+}
+
+void SceneTest::setCleanPartial() {
+    Scene3D scene;
+    Object3D* a = new Object3D(&scene);
+    Object3D* b = new Object3D(a);
+    Object3D* c = new Object3D(a);
+    Object3D* d = new Object3D(c);
+    scene.setClean();
+    scene.resetCleanedObjectCount();
+
+    /* Cleaning one object in the subtree leaves its sibling and children
+       dirty, these are cleaned by the scene */
+    a->translate(Vector3::xAxis(1.0f));
+    b->setClean();
+    CORRADE_COMPARE(scene.cleanedObjectCount(), 2);
+    CORRADE_VERIFY(!a->isDirty());
+    CORRADE_VERIFY(c->isDirty());
+    CORRADE_VERIFY(d->isDirty());
+
+    scene.setClean();
+    CORRADE_COMPARE(scene.cleanedObjectCount(), 4);
+    CORRADE_VERIFY(!c->isDirty());
+    CORRADE_VERIFY(!d->isDirty());
+    CORRADE_COMPARE(d->absoluteTransformation(), Matrix4::translation(Vector3::xAxis(1.0f)));
+
+    /* Newly added object under clean parent */
+    Object3D* e = new Object3D(d);
+    e->translate(Vector3::yAxis(1.0f));
+    scene.setClean();
+    CORRADE_COMPARE(scene.cleanedObjectCount(), 5);
+    CORRADE_VERIFY(!e->isDirty());
+    CORRADE_COMPARE(e->absoluteTransformation(), Matrix4::translation({1.0f, 1.0f, 0.0f}));
+}
+
+void SceneTest::dirtyListRemove() {
+    Scene3D scene;
+    Object3D* a = new Object3D(&scene);
+    Object3D* b = new Object3D(a);
+    Object3D* c = new Object3D(&scene);
+    scene.setClean();
+
+    /* Deleted object is removed from the list */
+    b->translate(Vector3::xAxis(1.0f));
+    delete b;
+
+    /* Object moved to another scene is removed from the list of the old one */
+    {
+        Scene3D another;
+        Object3D* d = new Object3D(c);
+        d->setParent(&another);
+        c->translate(Vector3::xAxis(1.0f));
+        scene.setClean();
+
+        new Object3D(d);
+        another.setClean();
+        CORRADE_COMPARE(another.cleanedObjectCount(), 3);
+
+        /* Move back to dirty list of the first scene, the other scene can be
+           safely destroyed */
+        d->setParent(a);
+        d->translate(Vector3::xAxis(1.0f));
+    }
+
+    scene.resetCleanedObjectCount().setClean();
+    CORRADE_COMPARE(scene.cleanedObjectCount(), 2);
+    CORRADE_VERIFY(!a->firstChild()->isDirty());
+}
+
+void SceneTest::dirtyListRemoveOrder() {
+    Scene3D scene;
+    Object3D* a = new Object3D(&scene);
+    scene.setClean();
+
+    /* All new children of clean object are listed */
+    Object3D* children[6];
+    for(Object3D*& child: children) child = new Object3D(a);
+
+    /* The list stays consistent when removing in arbitrary order */
+    delete children[2];
+    delete children[0];
+    delete children[5];
+
+    scene.resetCleanedObjectCount().setClean();
+    CORRADE_COMPARE(scene.cleanedObjectCount(), 3);
+    CORRADE_VERIFY(!children[1]->isDirty());
+    CORRADE_VERIFY(!children[3]->isDirty());
+    CORRADE_VERIFY(!children[4]->isDirty());
+}
+
 }}}
 
 CORRADE_TEST_MAIN(Magnum::SceneGraph::Test::SceneTest)
@@ -0,0 +1,102 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <chrono>
+#include <random>
+#include <TestSuite/Tester.h>
+
+#include "SceneGraph/MatrixTransformation3D.h"
+#include "SceneGraph/Scene.h"
+#include "SceneGraph/Skeleton.h"
+
+namespace Magnum { namespace SceneGraph { namespace Test {
+
+class SkeletonBenchmark: public TestSuite::Tester {
+    public:
+        SkeletonBenchmark();
+
+        void jointMatrices();
+};
+
+typedef SceneGraph::Object<SceneGraph::MatrixTransformation3D> Object3D;
+typedef SceneGraph::Scene<SceneGraph::MatrixTransformation3D> Scene3D;
+
+namespace {
+    enum: std::size_t { CharacterCount = 200, JointCount = 64, Repeats = 10 };
+
+    typedef std::chrono::high_resolution_clock Clock;
+}
+
+SkeletonBenchmark::SkeletonBenchmark() {
+    addTests({&SkeletonBenchmark::jointMatrices});
+}
+
+void SkeletonBenchmark::jointMatrices() {
+    /* Random joint hierarchy and random pose for each character */
+    std::mt19937 random;
+    std::uniform_real_distribution<Float> distribution(-1.0f, 1.0f);
+    std::vector<UnsignedInt> parents{Skeleton3D::NoParent};
+    for(std::size_t i = 1; i != JointCount; ++i)
+        parents.push_back(std::uniform_int_distribution<UnsignedInt>(0, i - 1)(random));
+    const Skeleton3D skeleton(parents);
+
+    std::vector<Pose3D> poses(CharacterCount, Pose3D(JointCount));
+    for(Pose3D& pose: poses) for(std::size_t i = 0; i != JointCount; ++i) {
+        pose.translations()[i] = {distribution(random), distribution(random), distribution(random)};
+        pose.rotations()[i] = Quaternion::rotation(Rad(distribution(random)), Vector3::zAxis());
+    }
+
+    /* Skeleton with one palette per character */
+    std::vector<std::vector<Matrix4>> palettes(CharacterCount);
+    Clock::duration skeletonTime{};
+    for(std::size_t r = 0; r != Repeats; ++r) {
+        const auto begin = Clock::now();
+        for(std::size_t i = 0; i != CharacterCount; ++i)
+            skeleton.jointMatrices(poses[i], palettes[i]);
+        skeletonTime += Clock::now() - begin;
+    }
+
+    /* Object for each joint */
+    Scene3D scene;
+    std::vector<std::vector<Object3D*>> characters(CharacterCount);
+    for(std::vector<Object3D*>& objects: characters) for(std::size_t i = 0; i != JointCount; ++i)
+        objects.push_back(new Object3D(parents[i] == Skeleton3D::NoParent ? &scene : objects[parents[i]]));
+
+    std::vector<std::vector<Matrix4>> objectPalettes(CharacterCount);
+    Clock::duration objectTime{};
+    for(std::size_t r = 0; r != Repeats; ++r) {
+        const auto begin = Clock::now();
+        for(std::size_t i = 0; i != CharacterCount; ++i) {
+            poses[i].applyTo(characters[i]);
+            objectPalettes[i] = scene.transformations(characters[i]);
+        }
+        objectTime += Clock::now() - begin;
+    }
+
+    Debug() << "Joint matrices of" << CharacterCount << "characters with" << JointCount << "joints, Skeleton:" << std::chrono::duration<Double, std::milli>(skeletonTime).count()/Repeats << "ms, Object:" << std::chrono::duration<Double, std::milli>(objectTime).count()/Repeats << "ms";
+}
+
+}}}
+
+CORRADE_TEST_MAIN(Magnum::SceneGraph::Test::SkeletonBenchmark)
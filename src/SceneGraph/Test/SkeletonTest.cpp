@@ -0,0 +1,210 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+
+#include <sstream>
+#include <TestSuite/Tester.h>
+
+#include "SceneGraph/MatrixTransformation3D.h"
+#include "SceneGraph/Scene.h"
+#include "SceneGraph/Skeleton.h"
+
+namespace Magnum { namespace SceneGraph { namespace Test {
+
+class SkeletonTest: public TestSuite::Tester {
+    public:
+        SkeletonTest();
+
+        void construct();
+        void constructInvalid();
+        void absoluteMatrices();
+        void jointMatrices();
+        void jointDualQuaternions();
+        void jointDualQuaternionsNotRigid();
+        void wrongPoseSize();
+        void blend();
+};
+
+typedef SceneGraph::Object<SceneGraph::MatrixTransformation3D> Object3D;
+typedef SceneGraph::Scene<SceneGraph::MatrixTransformation3D> Scene3D;
+
+SkeletonTest::SkeletonTest() {
+    addTests({&SkeletonTest::construct,
+              &SkeletonTest::constructInvalid,
+              &SkeletonTest::absoluteMatrices,
+              &SkeletonTest::jointMatrices,
+              &SkeletonTest::jointDualQuaternions,
+              &SkeletonTest::jointDualQuaternionsNotRigid,
+              &SkeletonTest::wrongPoseSize,
+              &SkeletonTest::blend});
+}
+
+namespace {
+
+/* Two chains of joints sharing the root */
+std::vector<UnsignedInt> parents() {
+    return {Skeleton3D::NoParent, 0, 1, 0, 3};
+}
+
+Pose3D pose() {
+    Pose3D pose(5);
+    pose.translations()[0] = {0.0f, 1.0f, 0.0f};
+    pose.rotations()[0] = Quaternion::rotation(Deg(90.0f), Vector3::zAxis());
+    pose.translations()[1] = {1.0f, 0.0f, 0.0f};
+    pose.scalings()[1] = Vector3(2.0f);
+    pose.translations()[2] = {0.0f, 0.5f, 0.0f};
+    pose.translations()[3] = {-1.0f, 0.0f, 0.0f};
+    pose.rotations()[4] = Quaternion::rotation(Deg(30.0f), Vector3::xAxis());
+    return pose;
+}
+
+/* The same hierarchy using objects */
+std::vector<Matrix4> objectTransformations(const Pose3D& pose, const std::vector<UnsignedInt>& parents) {
+    Scene3D scene;
+    std::vector<Object3D*> objects;
+    for(std::size_t i = 0; i != parents.size(); ++i)
+        objects.push_back(new Object3D(parents[i] == Skeleton3D::NoParent ? &scene : objects[parents[i]]));
+    pose.applyTo(objects);
+    return scene.transformations(objects);
+}
+
+}
+
+void SkeletonTest::construct() {
+    Skeleton3D skeleton(parents());
+    CORRADE_COMPARE(skeleton.jointCount(), 5);
+    CORRADE_COMPARE(skeleton.parents(), parents());
+    CORRADE_COMPARE(skeleton.inverseBindMatrices(), std::vector<Matrix4>(5));
+}
+
+void SkeletonTest::constructInvalid() {
+    std::ostringstream o;
+    Error::setOutput(&o);
+
+    Skeleton3D a({Skeleton3D::NoParent, 2, 0});
+    Skeleton3D b({Skeleton3D::NoParent, 1});
+    Skeleton3D c({Skeleton3D::NoParent, 0}, {Matrix4()});
+    CORRADE_COMPARE(o.str(),
+        "SceneGraph::Skeleton::Skeleton(): joint 1 has parent 2 which is not before it\n"
+        "SceneGraph::Skeleton::Skeleton(): joint 1 has parent 1 which is not before it\n"
+        "SceneGraph::Skeleton::Skeleton(): expected 2 inverse bind matrices, got 1\n");
+}
+
+void SkeletonTest::absoluteMatrices() {
+    Skeleton3D skeleton(parents());
+
+    /* The output has wrong size initially, it will be resized */
+    std::vector<Matrix4> matrices(2);
+    skeleton.absoluteMatrices(pose(), matrices);
+    CORRADE_COMPARE(matrices, objectTransformations(pose(), parents()));
+    CORRADE_COMPARE(matrices[2].translation(), Vector3(-1.0f, 2.0f, 0.0f));
+}
+
+void SkeletonTest::jointMatrices() {
+    std::vector<Matrix4> inverseBindMatrices;
+    for(std::size_t i = 0; i != 5; ++i)
+        inverseBindMatrices.push_back(Matrix4::translation(Vector3::yAxis(-Float(i))));
+    Skeleton3D skeleton(parents(), inverseBindMatrices);
+
+    std::vector<Matrix4> matrices;
+    skeleton.jointMatrices(pose(), matrices);
+    const std::vector<Matrix4> expected = objectTransformations(pose(), parents());
+    CORRADE_COMPARE(matrices.size(), 5);
+    for(std::size_t i = 0; i != 5; ++i)
+        CORRADE_COMPARE(matrices[i], expected[i]*inverseBindMatrices[i]);
+}
+
+void SkeletonTest::jointDualQuaternions() {
+    std::vector<Matrix4> inverseBindMatrices;
+    for(std::size_t i = 0; i != 5; ++i)
+        inverseBindMatrices.push_back(Matrix4::rotationX(Deg(10.0f*i))*Matrix4::translation(Vector3::yAxis(-Float(i))));
+    Skeleton3D skeleton(parents(), inverseBindMatrices);
+
+    /* Scaling is ignored in dual quaternions */
+    Pose3D rigidPose = pose();
+    rigidPose.scalings()[1] = Vector3(1.0f);
+
+    std::vector<Matrix4> matrices;
+    std::vector<DualQuaternion> dualQuaternions;
+    skeleton.jointMatrices(rigidPose, matrices);
+    skeleton.jointDualQuaternions(rigidPose, dualQuaternions);
+    CORRADE_COMPARE(dualQuaternions.size(), 5);
+    for(std::size_t i = 0; i != 5; ++i)
+        CORRADE_COMPARE(dualQuaternions[i].toMatrix(), matrices[i]);
+}
+
+void SkeletonTest::jointDualQuaternionsNotRigid() {
+    std::ostringstream o;
+    Error::setOutput(&o);
+
+    Skeleton3D skeleton({Skeleton3D::NoParent}, {Matrix4::scaling(Vector3(2.0f))});
+    std::vector<DualQuaternion> dualQuaternions;
+    skeleton.jointDualQuaternions(Pose3D(1), dualQuaternions);
+    CORRADE_VERIFY(dualQuaternions.empty());
+    CORRADE_COMPARE(o.str(), "SceneGraph::Skeleton::jointDualQuaternions(): the inverse bind matrices are not rigid\n");
+}
+
+void SkeletonTest::wrongPoseSize() {
+    std::ostringstream o;
+    Error::setOutput(&o);
+
+    Skeleton3D skeleton(parents());
+    std::vector<Matrix4> matrices;
+    std::vector<DualQuaternion> dualQuaternions;
+    skeleton.absoluteMatrices(Pose3D(4), matrices);
+    skeleton.jointMatrices(Pose3D(4), matrices);
+    skeleton.jointDualQuaternions(Pose3D(4), dualQuaternions);
+    CORRADE_COMPARE(o.str(),
+        "SceneGraph::Skeleton::absoluteMatrices(): expected pose with 5 targets, got 4\n"
+        "SceneGraph::Skeleton::jointMatrices(): expected pose with 5 targets, got 4\n"
+        "SceneGraph::Skeleton::jointDualQuaternions(): expected pose with 5 targets, got 4\n");
+}
+
+void SkeletonTest::blend() {
+    Pose3D a(2), b(2);
+    a.translations()[0] = {1.0f, 0.0f, 0.0f};
+    a.rotations()[1] = Quaternion::rotation(Deg(20.0f), Vector3::yAxis());
+    b.translations()[0] = {3.0f, 2.0f, 0.0f};
+    b.scalings()[0] = Vector3(3.0f);
+
+    /* Rotation with opposite sign is blended along the shortest path */
+    b.rotations()[1] = -Quaternion::rotation(Deg(40.0f), Vector3::yAxis());
+
+    a.blend(b, 0.25f);
+    CORRADE_COMPARE(a.translations()[0], Vector3(1.5f, 0.5f, 0.0f));
+    CORRADE_COMPARE(a.scalings()[0], Vector3(1.5f));
+    CORRADE_COMPARE(a.rotations()[0], Quaternion());
+    CORRADE_VERIFY(a.rotations()[1].isNormalized());
+    CORRADE_VERIFY(a.rotations()[1].angle() > Rad(Deg(20.0f)));
+    CORRADE_VERIFY(a.rotations()[1].angle() < Rad(Deg(30.0f)));
+
+    std::ostringstream o;
+    Error::setOutput(&o);
+    a.blend(Pose3D(3), 0.5f);
+    CORRADE_COMPARE(o.str(), "SceneGraph::Pose::blend(): expected pose with 2 targets, got 3\n");
+}
+
+}}}
+
+CORRADE_TEST_MAIN(Magnum::SceneGraph::Test::SkeletonTest)
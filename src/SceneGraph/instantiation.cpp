@@ -24,16 +24,20 @@
 
 #include "SceneGraph/AbstractFeature.hpp"
 #include "SceneGraph/Animable.hpp"
+#include "SceneGraph/AnimationClip.hpp"
+#include "SceneGraph/BoundingVolumeHierarchy.hpp"
 #include "SceneGraph/Camera2D.hpp"
 #include "SceneGraph/Camera3D.hpp"
 #include "SceneGraph/DualComplexTransformation.h"
 #include "SceneGraph/DualQuaternionTransformation.h"
 #include "SceneGraph/FeatureGroup.hpp"
+#include "SceneGraph/FlatScene.hpp"
 #include "SceneGraph/MatrixTransformation2D.h"
 #include "SceneGraph/MatrixTransformation3D.h"
 #include "SceneGraph/Object.hpp"
 #include "SceneGraph/RigidMatrixTransformation2D.h"
 #include "SceneGraph/RigidMatrixTransformation3D.h"
+#include "SceneGraph/Skeleton.hpp"
 #include "SceneGraph/TranslationTransformation.h"
 
 namespace Magnum { namespace SceneGraph {
@@ -60,12 +64,20 @@ template class MAGNUM_SCENEGRAPH_EXPORT_HPP Animable<2, Float>;
 template class MAGNUM_SCENEGRAPH_EXPORT_HPP Animable<3, Float>;
 template class MAGNUM_SCENEGRAPH_EXPORT_HPP AnimableGroup<2, Float>;
 template class MAGNUM_SCENEGRAPH_EXPORT_HPP AnimableGroup<3, Float>;
+template class MAGNUM_SCENEGRAPH_EXPORT_HPP BasicAnimationClip3D<Float>;
+
+template class MAGNUM_SCENEGRAPH_EXPORT_HPP BoundingVolume<2, Float>;
+template class MAGNUM_SCENEGRAPH_EXPORT_HPP BoundingVolume<3, Float>;
+template class MAGNUM_SCENEGRAPH_EXPORT_HPP BoundingVolumeHierarchy<2, Float>;
+template class MAGNUM_SCENEGRAPH_EXPORT_HPP BoundingVolumeHierarchy<3, Float>;
 
 template class MAGNUM_SCENEGRAPH_EXPORT_HPP AbstractCamera<2, Float>;
 template class MAGNUM_SCENEGRAPH_EXPORT_HPP AbstractCamera<3, Float>;
 template class MAGNUM_SCENEGRAPH_EXPORT_HPP BasicCamera2D<Float>;
 template class MAGNUM_SCENEGRAPH_EXPORT_HPP BasicCamera3D<Float>;
 
+template class MAGNUM_SCENEGRAPH_EXPORT_HPP BasicSkeleton3D<Float>;
+
 template class MAGNUM_SCENEGRAPH_EXPORT_HPP Object<BasicDualComplexTransformation<Float>>;
 template class MAGNUM_SCENEGRAPH_EXPORT_HPP Object<BasicDualQuaternionTransformation<Float>>;
 template class MAGNUM_SCENEGRAPH_EXPORT_HPP Object<BasicMatrixTransformation2D<Float>>;
@@ -74,6 +86,23 @@ template class MAGNUM_SCENEGRAPH_EXPORT_HPP Object<BasicRigidMatrixTransformatio
 template class MAGNUM_SCENEGRAPH_EXPORT_HPP Object<BasicRigidMatrixTransformation3D<Float>>;
 template class MAGNUM_SCENEGRAPH_EXPORT_HPP Object<TranslationTransformation<2, Float>>;
 template class MAGNUM_SCENEGRAPH_EXPORT_HPP Object<TranslationTransformation<3, Float>>;
+
+template class MAGNUM_SCENEGRAPH_EXPORT_HPP FlatObject<BasicDualComplexTransformation<Float>>;
+template class MAGNUM_SCENEGRAPH_EXPORT_HPP FlatObject<BasicDualQuaternionTransformation<Float>>;
+template class MAGNUM_SCENEGRAPH_EXPORT_HPP FlatObject<BasicMatrixTransformation2D<Float>>;
+template class MAGNUM_SCENEGRAPH_EXPORT_HPP FlatObject<BasicMatrixTransformation3D<Float>>;
+template class MAGNUM_SCENEGRAPH_EXPORT_HPP FlatObject<BasicRigidMatrixTransformation2D<Float>>;
+template class MAGNUM_SCENEGRAPH_EXPORT_HPP FlatObject<BasicRigidMatrixTransformation3D<Float>>;
+template class MAGNUM_SCENEGRAPH_EXPORT_HPP FlatObject<TranslationTransformation<2, Float>>;
+template class MAGNUM_SCENEGRAPH_EXPORT_HPP FlatObject<TranslationTransformation<3, Float>>;
+template class MAGNUM_SCENEGRAPH_EXPORT_HPP FlatScene<BasicDualComplexTransformation<Float>>;
+template class MAGNUM_SCENEGRAPH_EXPORT_HPP FlatScene<BasicDualQuaternionTransformation<Float>>;
+template class MAGNUM_SCENEGRAPH_EXPORT_HPP FlatScene<BasicMatrixTransformation2D<Float>>;
+template class MAGNUM_SCENEGRAPH_EXPORT_HPP FlatScene<BasicMatrixTransformation3D<Float>>;
+template class MAGNUM_SCENEGRAPH_EXPORT_HPP FlatScene<BasicRigidMatrixTransformation2D<Float>>;
+template class MAGNUM_SCENEGRAPH_EXPORT_HPP FlatScene<BasicRigidMatrixTransformation3D<Float>>;
+template class MAGNUM_SCENEGRAPH_EXPORT_HPP FlatScene<TranslationTransformation<2, Float>>;
+template class MAGNUM_SCENEGRAPH_EXPORT_HPP FlatScene<TranslationTransformation<3, Float>>;
 #endif
 
 }}
@@ -33,6 +33,14 @@ namespace Magnum { namespace Shapes {
 
 template<UnsignedInt dimensions> AbstractShape<dimensions>::AbstractShape(SceneGraph::AbstractObject<dimensions, Float>& object, ShapeGroup<dimensions>* group): SceneGraph::AbstractGroupedFeature<dimensions, AbstractShape<dimensions>, Float>(object, group) {
     SceneGraph::AbstractFeature<dimensions, Float>::setCachedTransformations(SceneGraph::CachedTransformation::Absolute);
+
+    /* The group was populated from the base constructor, update the
+       broadphase */
+    if(group) group->dirty = group->rebuildBroadphase = true;
+}
+
+template<UnsignedInt dimensions> AbstractShape<dimensions>::~AbstractShape() {
+    if(group()) group()->dirty = group()->rebuildBroadphase = true;
 }
 
 template<UnsignedInt dimensions> ShapeGroup<dimensions>* AbstractShape<dimensions>::group() {
@@ -51,6 +59,10 @@ template<UnsignedInt dimensions> bool AbstractShape<dimensions>::collides(const
     return Implementation::collides(abstractTransformedShape(), other.abstractTransformedShape());
 }
 
+template<UnsignedInt dimensions> Collision<dimensions> AbstractShape<dimensions>::collision(const AbstractShape<dimensions>& other) const {
+    return Implementation::collision(abstractTransformedShape(), other.abstractTransformedShape());
+}
+
 template<UnsignedInt dimensions> void AbstractShape<dimensions>::markDirty() {
     if(group()) group()->setDirty();
 }
@@ -30,6 +30,7 @@
 
 #include "Magnum.h"
 #include "DimensionTraits.h"
+#include "Shapes/Collision.h"
 #include "Shapes/magnumShapesVisibility.h"
 #include "Shapes/shapeImplementation.h"
 #include "SceneGraph/AbstractGroupedFeature.h"
@@ -81,6 +82,13 @@ template<UnsignedInt dimensions> class MAGNUM_SHAPES_EXPORT AbstractShape: publi
          */
         explicit AbstractShape(SceneGraph::AbstractObject<dimensions, Float>& object, ShapeGroup<dimensions>* group = nullptr);
 
+        /**
+         * @brief Destructor
+         *
+         * Marks the group as dirty.
+         */
+        ~AbstractShape();
+
         /**
          * @brief Shape group containing this shape
          *
@@ -101,6 +109,17 @@ template<UnsignedInt dimensions> class MAGNUM_SHAPES_EXPORT AbstractShape: publi
          */
         bool collides(const AbstractShape<dimensions>& other) const;
 
+        /**
+         * @brief %Collision with other shape
+         *
+         * Returns collision with position, separation normal and distance
+         * for moving this shape out of @p other. If the pair of shapes has
+         * only collision occurence implemented (see @ref shapes-collisions),
+         * returns empty collision even if the shapes collide, use
+         * collides() in that case.
+         */
+        Collision<dimensions> collision(const AbstractShape<dimensions>& other) const;
+
     protected:
         /** Marks also the group as dirty */
         void markDirty() override;
@@ -24,12 +24,159 @@
 
 #include "Box.h"
 
+#include <limits>
+#include <utility>
+
+#include "Math/Functions.h"
+#include "Magnum.h"
+#include "Shapes/Sphere.h"
+
 namespace Magnum { namespace Shapes {
 
+namespace {
+
+/* Candidate separating axes of two boxes given by their normalized axes */
+std::size_t separatingAxes(const Math::Matrix<2, Float>& a, const Math::Matrix<2, Float>& b, Math::Vector<2, Float>* axes) {
+    axes[0] = a[0];
+    axes[1] = a[1];
+    axes[2] = b[0];
+    axes[3] = b[1];
+    return 4;
+}
+
+std::size_t separatingAxes(const Math::Matrix<3, Float>& a, const Math::Matrix<3, Float>& b, Math::Vector<3, Float>* axes) {
+    std::size_t count = 0;
+    for(std::size_t i = 0; i != 3; ++i) axes[count++] = a[i];
+    for(std::size_t i = 0; i != 3; ++i) axes[count++] = b[i];
+
+    /* Cross products of edges, skipping the (nearly) parallel ones, as the
+       separation along them is already covered by face normals */
+    for(std::size_t i = 0; i != 3; ++i) for(std::size_t j = 0; j != 3; ++j) {
+        const Vector3 axis = Vector3::cross(a[i], b[j]);
+        const Float dot = axis.dot();
+        if(dot < Math::TypeTraits<Float>::epsilon()) continue;
+        axes[count++] = axis/Math::sqrt(dot);
+    }
+
+    return count;
+}
+
+/* Half-size of box projection onto normalized axis */
+template<std::size_t size> Float projectedRadius(const Math::Matrix<size, Float>& axes, const Math::Vector<size, Float>& axis) {
+    Float radius = 0.0f;
+    for(std::size_t i = 0; i != size; ++i)
+        radius += Math::abs(Math::Vector<size, Float>::dot(axes[i], axis));
+    return radius;
+}
+
+/* Axis with smallest penetration of two boxes, oriented from the second box
+   to the first one, zero depth if the boxes are separated */
+template<UnsignedInt dimensions> std::pair<Math::Vector<dimensions, Float>, Float> penetration(const Box<dimensions>& a, const Box<dimensions>& b) {
+    const Math::Matrix<dimensions, Float> aAxes = a.transformation().rotationScaling();
+    const Math::Matrix<dimensions, Float> bAxes = b.transformation().rotationScaling();
+    Math::Matrix<dimensions, Float> aNormalized, bNormalized;
+    for(std::size_t i = 0; i != dimensions; ++i) {
+        aNormalized[i] = aAxes[i].normalized();
+        bNormalized[i] = bAxes[i].normalized();
+    }
+
+    Math::Vector<dimensions, Float> axes[dimensions == 2 ? 4 : 15];
+    const std::size_t count = separatingAxes(aNormalized, bNormalized, axes);
+
+    const Math::Vector<dimensions, Float> distance = a.transformation().translation() - b.transformation().translation();
+    std::pair<Math::Vector<dimensions, Float>, Float> result{{}, std::numeric_limits<Float>::max()};
+    for(std::size_t i = 0; i != count; ++i) {
+        const Float projected = Math::Vector<dimensions, Float>::dot(distance, axes[i]);
+        const Float depth = projectedRadius(aAxes, axes[i]) + projectedRadius(bAxes, axes[i]) - Math::abs(projected);
+
+        /* Found separating axis */
+        if(depth <= 0.0f) return {{}, 0.0f};
+
+        if(depth < result.second)
+            result = {projected < 0.0f ? -axes[i] : axes[i], depth};
+    }
+
+    return result;
+}
+
+/* Point of the box closest to given point */
+template<UnsignedInt dimensions> typename DimensionTraits<dimensions, Float>::VectorType closestPoint(const Box<dimensions>& box, const typename DimensionTraits<dimensions, Float>::VectorType& point) {
+    const Math::Matrix<dimensions, Float> axes = box.transformation().rotationScaling();
+    const typename DimensionTraits<dimensions, Float>::VectorType distance = point - box.transformation().translation();
+
+    typename DimensionTraits<dimensions, Float>::VectorType closest = box.transformation().translation();
+    for(std::size_t i = 0; i != dimensions; ++i)
+        closest += axes[i]*Math::clamp(Math::Vector<dimensions, Float>::dot(distance, axes[i])/axes[i].dot(), -1.0f, 1.0f);
+
+    return closest;
+}
+
+}
+
 template<UnsignedInt dimensions> Box<dimensions> Box<dimensions>::transformed(const typename DimensionTraits<dimensions, Float>::MatrixType& matrix) const {
     return Box<dimensions>(matrix*_transformation);
 }
 
+template<UnsignedInt dimensions> bool Box<dimensions>::operator%(const Sphere<dimensions>& other) const {
+    return (closestPoint(*this, other.position()) - other.position()).dot() < Math::pow<2>(other.radius());
+}
+
+template<UnsignedInt dimensions> Collision<dimensions> Box<dimensions>::operator/(const Sphere<dimensions>& other) const {
+    const typename DimensionTraits<dimensions, Float>::VectorType separating = closestPoint(*this, other.position()) - other.position();
+    const Float dot = separating.dot();
+
+    /* No collision occured */
+    if(dot > Math::pow<2>(other.radius())) return {};
+
+    /* Sphere center is outside the box, separate along the line from it to
+       the closest point. Contact position is on the surface of `other`. */
+    if(!Math::TypeTraits<Float>::equals(dot, 0.0f)) {
+        const Float distance = Math::sqrt(dot);
+        const typename DimensionTraits<dimensions, Float>::VectorType separatingNormal = separating/distance;
+        return Collision<dimensions>(other.position() + separatingNormal*other.radius(), separatingNormal, other.radius() - distance);
+    }
+
+    /* Sphere center is inside the box, separate through the nearest face */
+    const Math::Matrix<dimensions, Float> axes = _transformation.rotationScaling();
+    const typename DimensionTraits<dimensions, Float>::VectorType distance = other.position() - _transformation.translation();
+    Float faceDistance = std::numeric_limits<Float>::max();
+    typename DimensionTraits<dimensions, Float>::VectorType separatingNormal;
+    for(std::size_t i = 0; i != dimensions; ++i) {
+        const Float length = axes[i].length();
+        const Float projected = Math::Vector<dimensions, Float>::dot(distance, axes[i])/length;
+        if(length - Math::abs(projected) >= faceDistance) continue;
+
+        faceDistance = length - Math::abs(projected);
+        separatingNormal = (projected < 0.0f ? axes[i] : -axes[i])/length;
+    }
+
+    return Collision<dimensions>(other.position() + separatingNormal*other.radius(), separatingNormal, other.radius() + faceDistance);
+}
+
+template<UnsignedInt dimensions> bool Box<dimensions>::operator%(const Box<dimensions>& other) const {
+    return penetration(*this, other).second > 0.0f;
+}
+
+template<UnsignedInt dimensions> Collision<dimensions> Box<dimensions>::operator/(const Box<dimensions>& other) const {
+    const std::pair<Math::Vector<dimensions, Float>, Float> p = penetration(*this, other);
+
+    /* No collision occured */
+    if(p.second <= 0.0f) return {};
+
+    /* Deepest point of this box in the direction of `other`, edges and faces
+       perpendicular to the normal are represented by their center */
+    const Math::Matrix<dimensions, Float> axes = _transformation.rotationScaling();
+    typename DimensionTraits<dimensions, Float>::VectorType position = _transformation.translation();
+    for(std::size_t i = 0; i != dimensions; ++i) {
+        const Float projected = Math::Vector<dimensions, Float>::dot(axes[i].normalized(), p.first);
+        if(projected > Math::TypeTraits<Float>::epsilon()) position -= axes[i];
+        else if(projected < -Math::TypeTraits<Float>::epsilon()) position += axes[i];
+    }
+
+    /* Contact position is that point moved to the surface of `other` */
+    return Collision<dimensions>(position + p.first*p.second, p.first, p.second);
+}
+
 template class Box<2>;
 template class Box<3>;
 
@@ -31,6 +31,8 @@
 #include "Math/Matrix3.h"
 #include "Math/Matrix4.h"
 #include "DimensionTraits.h"
+#include "Shapes/Collision.h"
+#include "Shapes/Shapes.h"
 #include "Shapes/magnumShapesVisibility.h"
 
 namespace Magnum { namespace Shapes {
@@ -39,7 +41,9 @@ namespace Magnum { namespace Shapes {
 @brief Unit-size box with assigned transformation matrix
 
 Unit-size means that half extents are equal to 1, equivalent to e.g. sphere
-radius. See @ref shapes for brief introduction.
+radius. The box axes are expected to be orthogonal, i.e. the transformation
+can contain rotation, translation and non-uniform scaling, but no skew. See
+@ref shapes for brief introduction.
 @todo Use quat + position + size instead?
 @see Box2D, Box3D
 @todo Assert for skew
@@ -73,6 +77,35 @@ template<UnsignedInt dimensions> class MAGNUM_SHAPES_EXPORT Box {
             _transformation = transformation;
         }
 
+        /** @brief %Collision occurence with sphere */
+        bool operator%(const Sphere<dimensions>& other) const;
+
+        /**
+         * @brief %Collision with sphere
+         *
+         * If the sphere center is inside the box, the box is separated
+         * through the nearest face.
+         */
+        Collision<dimensions> operator/(const Sphere<dimensions>& other) const;
+
+        /**
+         * @brief %Collision occurence with box
+         *
+         * Uses separating axis test on face normals of both boxes and, in
+         * 3D, on cross products of their edges.
+         */
+        bool operator%(const Box<dimensions>& other) const;
+
+        /**
+         * @brief %Collision with box
+         *
+         * The separation normal is the separating axis with smallest
+         * penetration, contact position is the deepest point of this box
+         * moved onto surface of @p other along the normal.
+         * @see operator%(const Box<dimensions>&) const
+         */
+        Collision<dimensions> operator/(const Box<dimensions>& other) const;
+
     private:
         typename DimensionTraits<dimensions, Float>::MatrixType _transformation;
 };
@@ -83,6 +116,12 @@ typedef Box<2> Box2D;
 /** @brief Three-dimensional box */
 typedef Box<3> Box3D;
 
+/** @collisionoccurenceoperator{Sphere,Box} */
+template<UnsignedInt dimensions> inline bool operator%(const Sphere<dimensions>& a, const Box<dimensions>& b) { return b % a; }
+
+/** @collisionoperator{Sphere,Box} */
+template<UnsignedInt dimensions> inline Collision<dimensions> operator/(const Sphere<dimensions>& a, const Box<dimensions>& b) { return (b/a).flipped(); }
+
 }}
 
 #endif
@@ -24,6 +24,8 @@
 
 #include "Capsule.h"
 
+#include <utility>
+
 #include "Math/Functions.h"
 #include "Math/Matrix3.h"
 #include "Math/Matrix4.h"
@@ -31,11 +33,38 @@
 #include "Magnum.h"
 #include "Shapes/Point.h"
 #include "Shapes/Sphere.h"
+#include "Shapes/Implementation/ClosestPoints.h"
 
 using namespace Magnum::Math::Geometry;
 
 namespace Magnum { namespace Shapes {
 
+namespace {
+
+/* Collision of two rounded shapes given their closest points */
+template<UnsignedInt dimensions> Collision<dimensions> collision(const typename DimensionTraits<dimensions, Float>::VectorType& a, const Float aRadius, const typename DimensionTraits<dimensions, Float>::VectorType& b, const Float bRadius) {
+    const Float minDistance = aRadius + bRadius;
+    const typename DimensionTraits<dimensions, Float>::VectorType separating = a - b;
+    const Float dot = separating.dot();
+
+    /* No collision occured */
+    if(dot > Math::pow<2>(minDistance)) return {};
+
+    /* Actual distance */
+    const Float distance = Math::sqrt(dot);
+
+    /* Separating normal. If can't decide on direction, just move up. */
+    const typename DimensionTraits<dimensions, Float>::VectorType separatingNormal =
+        Math::TypeTraits<Float>::equals(dot, 0.0f) ?
+        DimensionTraits<dimensions, Float>::VectorType::yAxis() :
+        separating/distance;
+
+    /* Contact position is on the surface of `b`, minDistace > distance */
+    return Collision<dimensions>(b + separatingNormal*bRadius, separatingNormal, minDistance - distance);
+}
+
+}
+
 template<UnsignedInt dimensions> Capsule<dimensions> Capsule<dimensions>::transformed(const typename DimensionTraits<dimensions, Float>::MatrixType& matrix) const {
     return Capsule<dimensions>(matrix.transformPoint(_a), matrix.transformPoint(_b), matrix.uniformScaling()*_radius);
 }
@@ -50,6 +79,24 @@ template<UnsignedInt dimensions> bool Capsule<dimensions>::operator%(const Spher
         Math::pow<2>(_radius+other.radius());
 }
 
+template<UnsignedInt dimensions> Collision<dimensions> Capsule<dimensions>::operator/(const Point<dimensions>& other) const {
+    return collision<dimensions>(Implementation::closestPoint<dimensions>(_a, _b, other.position()), _radius, other.position(), 0.0f);
+}
+
+template<UnsignedInt dimensions> Collision<dimensions> Capsule<dimensions>::operator/(const Sphere<dimensions>& other) const {
+    return collision<dimensions>(Implementation::closestPoint<dimensions>(_a, _b, other.position()), _radius, other.position(), other.radius());
+}
+
+template<UnsignedInt dimensions> bool Capsule<dimensions>::operator%(const Capsule<dimensions>& other) const {
+    const auto points = Implementation::closestPoints(*this, other);
+    return (points.first - points.second).dot() < Math::pow<2>(_radius + other._radius);
+}
+
+template<UnsignedInt dimensions> Collision<dimensions> Capsule<dimensions>::operator/(const Capsule<dimensions>& other) const {
+    const auto points = Implementation::closestPoints(*this, other);
+    return collision<dimensions>(points.first, _radius, points.second, other._radius);
+}
+
 #ifndef DOXYGEN_GENERATING_OUTPUT
 template class MAGNUM_SHAPES_EXPORT Capsule<2>;
 template class MAGNUM_SHAPES_EXPORT Capsule<3>;
@@ -30,6 +30,7 @@
 
 #include "Math/Vector3.h"
 #include "DimensionTraits.h"
+#include "Shapes/Collision.h"
 #include "Shapes/Shapes.h"
 #include "Shapes/magnumShapesVisibility.h"
 
@@ -92,9 +93,21 @@ template<UnsignedInt dimensions> class MAGNUM_SHAPES_EXPORT Capsule {
         /** @brief %Collision occurence with point */
         bool operator%(const Point<dimensions>& other) const;
 
+        /** @brief %Collision with point */
+        Collision<dimensions> operator/(const Point<dimensions>& other) const;
+
         /** @brief %Collision occurence with sphere */
         bool operator%(const Sphere<dimensions>& other) const;
 
+        /** @brief %Collision with sphere */
+        Collision<dimensions> operator/(const Sphere<dimensions>& other) const;
+
+        /** @brief %Collision occurence with capsule */
+        bool operator%(const Capsule<dimensions>& other) const;
+
+        /** @brief %Collision with capsule */
+        Collision<dimensions> operator/(const Capsule<dimensions>& other) const;
+
     private:
         typename DimensionTraits<dimensions, Float>::VectorType _a, _b;
         Float _radius;
@@ -109,9 +122,15 @@ typedef Capsule<3> Capsule3D;
 /** @collisionoccurenceoperator{Point,Capsule} */
 template<UnsignedInt dimensions> inline bool operator%(const Point<dimensions>& a, const Capsule<dimensions>& b) { return b % a; }
 
+/** @collisionoperator{Point,Capsule} */
+template<UnsignedInt dimensions> inline Collision<dimensions> operator/(const Point<dimensions>& a, const Capsule<dimensions>& b) { return (b/a).flipped(); }
+
 /** @collisionoccurenceoperator{Sphere,Capsule} */
 template<UnsignedInt dimensions> inline bool operator%(const Sphere<dimensions>& a, const Capsule<dimensions>& b) { return b % a; }
 
+/** @collisionoperator{Sphere,Capsule} */
+template<UnsignedInt dimensions> inline Collision<dimensions> operator/(const Sphere<dimensions>& a, const Capsule<dimensions>& b) { return (b/a).flipped(); }
+
 }}
 
 #endif
@@ -25,8 +25,11 @@
 #include "Composition.h"
 
 #include <algorithm>
+#include <limits>
 #include <Utility/Assert.h>
 
+#include "Math/Functions.h"
+
 #include "Shapes/Implementation/CollisionDispatch.h"
 
 namespace Magnum { namespace Shapes {
@@ -34,116 +37,226 @@ namespace Magnum { namespace Shapes {
 /*
 Hierarchy implementation notes:
 
-The hierarchy is stored in flat array to provide easy access for the user and
-to save some allocations. Each node has zero, one or two subnodes. Value of
-`Node::rightNode` describes which child nodes exist:
-
- *  0 - no child subnodes
- *  1 - only left subnode exists
- *  2 - only right subnode exists
- * >2 - both child nodes exist
-
-If left node exists, it is right next to current one. If right node exists, it
-is at position `Node::rightNode-1` relative to current one (this applies also
-when `rightNode` is equal to 2, right node is right next to current one,
-because there are no left nodes).
-
-The node also specifies which shapes belong to it. Root node owns whole shape
-array and `Node::rightShape` marks first shape belonging to the right child
-node, relatively to begin. This recurses into child nodes, thus left child node
-has shapes from parent's begin to parent's `rightShape`.
-
-Shapes are merged together by concatenating its node and shape list and adding
-new node at the beginning with properly set `rightNode` and `rightShape`.
-Because these values are relative to parent, they don't need to be modified
-when concatenating.
+Shapes are stored by value in one contiguous buffer, each aligned to
+`Alignment`, the `_shapes` array contains type and location of each of them.
+Shape objects are polymorphic and thus can't be simply memcpy'd, they are
+copied with AbstractShape::clone() instead.
+
+Operations are stored in postfix order in `_nodes`, the leaf nodes take
+shapes one after another. Because no values in the node list depend on
+position in the whole list, two compositions can be merged by concatenating
+their node lists and appending the operation node. Empty composition used as
+operand is represented with a single False node, so each operation node has
+all its operands.
+
+For collision detection the node list is compiled into a branching program:
+each shape has index of the shape evaluated next, if it does or doesn't
+collide, pointing after the end of the shape list if that result decides the
+whole composition. The evaluation thus needs no stack, touches only the
+shapes and skips all shapes which can't affect the result. The links are
+computed by link() with backwards walk through the node list -- the right
+operand of AND/OR is linked first, then the left one is linked to its first
+shape (NOT just swaps the targets, False links directly to the false target).
+Because of constant operands the evaluation doesn't need to start at the
+first shape (or at any shape at all), thus the starting index is saved in
+`_first`.
 */
 
-template<UnsignedInt dimensions> Composition<dimensions>::Composition(const Composition<dimensions>& other): _shapes(other._shapes.size()), _nodes(other._nodes.size()) {
-    copyShapes(0, other);
+template<UnsignedInt dimensions> Composition<dimensions>::Composition(const Composition<dimensions>& other): _data(other._data.size()), _shapes(other._shapes.size()), _nodes(other._nodes.size()), _first(other._first) {
+    copyShapes(0, 0, other);
     copyNodes(0, other);
 }
 
-template<UnsignedInt dimensions> Composition<dimensions>::Composition(Composition<dimensions>&& other): _shapes(std::move(other._shapes)), _nodes(std::move(other._nodes)) {
+template<UnsignedInt dimensions> Composition<dimensions>::Composition(Composition<dimensions>&& other): _data(std::move(other._data)), _shapes(std::move(other._shapes)), _nodes(std::move(other._nodes)), _first(other._first) {
+    other._data = nullptr;
     other._shapes = nullptr;
     other._nodes = nullptr;
+    other._first = 0;
 }
 
 template<UnsignedInt dimensions> Composition<dimensions>::~Composition() {
-    for(std::size_t i = 0; i != _shapes.size(); ++i)
-        delete _shapes[i];
+    destroyShapes();
 }
 
 template<UnsignedInt dimensions> Composition<dimensions>& Composition<dimensions>::operator=(const Composition<dimensions>& other) {
-    for(std::size_t i = 0; i != _shapes.size(); ++i)
-        delete _shapes[i];
+    if(&other == this) return *this;
+
+    destroyShapes();
+
+    /* Reuse the memory if possible */
+    if(_data.size() != other._data.size())
+        _data = Containers::Array<char>(other._data.size());
 
     if(_shapes.size() != other._shapes.size())
-        _shapes = Containers::Array<Implementation::AbstractShape<dimensions>*>(other._shapes.size());
+        _shapes = Containers::Array<Element>(other._shapes.size());
 
     if(_nodes.size() != other._nodes.size())
-        _nodes = Containers::Array<Node>(other._nodes.size());
+        _nodes = Containers::Array<NodeType>(other._nodes.size());
 
-    copyShapes(0, other);
+    copyShapes(0, 0, other);
     copyNodes(0, other);
+    _first = other._first;
     return *this;
 }
 
 template<UnsignedInt dimensions> Composition<dimensions>& Composition<dimensions>::operator=(Composition<dimensions>&& other) {
+    std::swap(other._data, _data);
     std::swap(other._shapes, _shapes);
     std::swap(other._nodes, _nodes);
+    std::swap(other._first, _first);
     return *this;
 }
 
-template<UnsignedInt dimensions> void Composition<dimensions>::copyShapes(const std::size_t offset, Composition<dimensions>&& other) {
-    CORRADE_INTERNAL_ASSERT(_shapes.size() >= other._shapes.size()+offset);
-    std::move(other._shapes.begin(), other._shapes.end(), _shapes.begin()+offset);
-    other._shapes = nullptr;
+template<UnsignedInt dimensions> void Composition<dimensions>::destroyShapes() {
+    for(std::size_t i = 0; i != _shapes.size(); ++i)
+        _shapes[i].shape->~AbstractShape();
 }
 
-template<UnsignedInt dimensions> void Composition<dimensions>::copyShapes(const std::size_t offset, const Composition<dimensions>& other) {
-    CORRADE_INTERNAL_ASSERT(_shapes.size() >= other._shapes.size()+offset);
-    for(Implementation::AbstractShape<dimensions> * const* i = other._shapes.begin(), ** o = _shapes.begin()+offset; i != other._shapes.end(); ++i, ++o)
-        *o = (*i)->clone();
+template<UnsignedInt dimensions> void Composition<dimensions>::copyShapes(const std::size_t offset, const std::size_t dataOffset, const Composition<dimensions>& other) {
+    CORRADE_INTERNAL_ASSERT(_shapes.size() >= other._shapes.size()+offset && _data.size() >= other._data.size()+dataOffset);
+    for(const Element *i = other._shapes.begin(), *end = other._shapes.end(); i != end; ++i) {
+        Element& o = _shapes[offset + (i - other._shapes.begin())];
+        o.shape = i->shape->clone(_data + dataOffset + i->offset);
+        o.offset = dataOffset + i->offset;
+        o.type = i->type;
+        o.next[0] = i->next[0];
+        o.next[1] = i->next[1];
+    }
 }
 
 template<UnsignedInt dimensions> void Composition<dimensions>::copyNodes(std::size_t offset, const Composition<dimensions>& other) {
     CORRADE_INTERNAL_ASSERT(_nodes.size() >= other._nodes.size()+offset);
+
+    /* Empty composition used as operand is a constant, when copying the
+       whole empty composition there is nothing to copy */
+    if(other._nodes.empty()) {
+        if(offset != _nodes.size()) _nodes[offset] = NodeType::False;
+        return;
+    }
+
     std::copy(other._nodes.begin(), other._nodes.end(), _nodes.begin()+offset);
 }
 
 template<UnsignedInt dimensions> Composition<dimensions> Composition<dimensions>::transformed(const typename DimensionTraits<dimensions, Float>::MatrixType& matrix) const {
-    Composition<dimensions> out(*this);
-    for(Implementation::AbstractShape<dimensions> * const* i = _shapes.begin(), * const* o = out._shapes.begin(); i != _shapes.end(); ++i, ++o)
-        (*i)->transform(matrix, *o);
+    Composition<dimensions> out;
+    transform(matrix, out);
     return out;
 }
 
-template<UnsignedInt dimensions> bool Composition<dimensions>::collides(const Implementation::AbstractShape<dimensions>& a, const std::size_t node, const std::size_t shapeBegin, const std::size_t shapeEnd) const {
-    /* Empty group */
-    if(shapeBegin == shapeEnd) return false;
+template<UnsignedInt dimensions> void Composition<dimensions>::transform(const typename DimensionTraits<dimensions, Float>::MatrixType& matrix, Composition<dimensions>& result) const {
+    /* Make the result a copy of this composition, if the shapes differ.
+       Otherwise just update the operations, as the shape layout in the
+       buffer depends only on the types. */
+    bool sameShapes = _shapes.size() == result._shapes.size() && _nodes.size() == result._nodes.size();
+    for(std::size_t i = 0; sameShapes && i != _shapes.size(); ++i)
+        sameShapes = _shapes[i].type == result._shapes[i].type;
+    if(!sameShapes) result = *this;
+    else if(&result != this) {
+        std::copy(_nodes.begin(), _nodes.end(), result._nodes.begin());
+        result._first = _first;
+        for(std::size_t i = 0; i != _shapes.size(); ++i) {
+            result._shapes[i].next[0] = _shapes[i].next[0];
+            result._shapes[i].next[1] = _shapes[i].next[1];
+        }
+    }
+
+    for(std::size_t i = 0; i != _shapes.size(); ++i)
+        _shapes[i].shape->transform(matrix, result._shapes[i].shape);
+}
+
+template<UnsignedInt dimensions> bool Composition<dimensions>::collides(const Implementation::AbstractShape<dimensions>& a) const {
+    std::size_t i = _first;
+    while(i < _shapes.size())
+        i = _shapes[i].next[Implementation::collides(a, *_shapes[i].shape)];
+
+    return i == _shapes.size() + 1;
+}
+
+template<UnsignedInt dimensions> void Composition<dimensions>::link() {
+    /* Empty composition doesn't collide with anything */
+    if(_nodes.empty()) {
+        _first = 0;
+        return;
+    }
+
+    std::size_t node = _nodes.size();
+    std::size_t shape = _shapes.size();
+    _first = link(node, shape, UnsignedInt(_shapes.size()), UnsignedInt(_shapes.size() + 1));
+    CORRADE_INTERNAL_ASSERT(node == 0 && shape == 0);
+}
+
+template<UnsignedInt dimensions> UnsignedInt Composition<dimensions>::link(std::size_t& node, std::size_t& shape, const UnsignedInt onFalse, const UnsignedInt onTrue) {
+    /* Going backwards through the postfix list as in bounds(), returns index
+       of first shape evaluated in the subtree (or the final result, if the
+       subtree has no shapes) */
+    CORRADE_INTERNAL_ASSERT(node != 0);
+    switch(_nodes[--node]) {
+        case NodeType::Shape:
+            _shapes[--shape].next[0] = onFalse;
+            _shapes[shape].next[1] = onTrue;
+            return shape;
+        case NodeType::False:
+            return onFalse;
+        case NodeType::Not:
+            return link(node, shape, onTrue, onFalse);
+
+        /* If left operand of AND collides, right operand is evaluated,
+           similarly for OR */
+        case NodeType::And: {
+            const UnsignedInt right = link(node, shape, onFalse, onTrue);
+            return link(node, shape, onFalse, right);
+        }
+        case NodeType::Or: {
+            const UnsignedInt right = link(node, shape, onFalse, onTrue);
+            return link(node, shape, right, onTrue);
+        }
+    }
+
+    CORRADE_ASSERT_UNREACHABLE();
+}
+
+template<UnsignedInt dimensions> Math::Range<dimensions, Float> Composition<dimensions>::bounds() const {
+    typedef typename DimensionTraits<dimensions, Float>::VectorType VectorType;
+
+    /* Empty group doesn't collide with anything */
+    if(_nodes.empty())
+        return {VectorType(std::numeric_limits<Float>::infinity()), VectorType(-std::numeric_limits<Float>::infinity())};
+
+    std::size_t node = _nodes.size();
+    std::size_t shape = _shapes.size();
+    return bounds(node, shape);
+}
+
+template<UnsignedInt dimensions> Math::Range<dimensions, Float> Composition<dimensions>::bounds(std::size_t& node, std::size_t& shape) const {
+    typedef typename DimensionTraits<dimensions, Float>::VectorType VectorType;
+
+    /* Going backwards through the postfix list, `node` and `shape` are one
+       past the subtree on input and at its beginning on output */
+    CORRADE_INTERNAL_ASSERT(node != 0);
+    const NodeType type = _nodes[--node];
+
+    if(type == NodeType::Shape)
+        return _shapes[--shape].shape->bounds();
 
-    CORRADE_INTERNAL_ASSERT(node < _nodes.size() && shapeBegin < shapeEnd);
+    /* Empty composition doesn't collide with anything */
+    if(type == NodeType::False)
+        return {VectorType(std::numeric_limits<Float>::infinity()), VectorType(-std::numeric_limits<Float>::infinity())};
 
-    /* Collision on the left child. If the node is leaf one (no left child
-       exists), do it directly, recurse instead. */
-    const bool collidesLeft = (_nodes[node].rightNode == 0 || _nodes[node].rightNode == 2) ?
-        Implementation::collides(a, *_shapes[shapeBegin]) :
-        collides(a, node+1, shapeBegin, shapeBegin+_nodes[node].rightShape);
+    /* Right operand (or the only operand of NOT), then the left one */
+    const Math::Range<dimensions, Float> right = bounds(node, shape);
 
-    /* NOT operation */
-    if(_nodes[node].operation == CompositionOperation::Not)
-        return !collidesLeft;
+    /* Complement of anything is unbounded */
+    if(type == NodeType::Not)
+        return {VectorType(-std::numeric_limits<Float>::infinity()), VectorType(std::numeric_limits<Float>::infinity())};
 
-    /* Short-circuit evaluation for AND/OR */
-    if((_nodes[node].operation == CompositionOperation::Or) == collidesLeft)
-        return collidesLeft;
+    const Math::Range<dimensions, Float> left = bounds(node, shape);
 
-    /* Now the collision result depends only on the right child. Similar to
-       collision on the left child. */
-    return (_nodes[node].rightNode < 2) ?
-        Implementation::collides(a, *_shapes[shapeBegin+_nodes[node].rightShape]) :
-        collides(a, node+_nodes[node].rightNode-1, shapeBegin+_nodes[node].rightShape, shapeEnd);
+    /* Shape colliding with AND must collide with both children, so it must
+       overlap the smaller of both bounds (but not necessarily their
+       intersection). OR is bounded by union. */
+    if(type == NodeType::And)
+        return left.size().sum() <= right.size().sum() ? left : right;
+    return {Math::min(left.min(), right.min()), Math::max(left.max(), right.max())};
 }
 
 #ifndef DOXYGEN_GENERATING_OUTPUT
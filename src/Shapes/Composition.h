@@ -28,6 +28,7 @@
  * @brief Class Magnum::Shapes::Composition, enum Magnum::Shapes::CompositionOperation
  */
 
+#include <new>
 #include <type_traits>
 #include <utility>
 #include <Containers/Array.h>
@@ -44,10 +45,10 @@ namespace Implementation {
     template<class> struct ShapeHelper;
 
     template<UnsignedInt dimensions> inline AbstractShape<dimensions>& getAbstractShape(Composition<dimensions>& group, std::size_t i) {
-        return *group._shapes[i];
+        return *group._shapes[i].shape;
     }
     template<UnsignedInt dimensions> inline const AbstractShape<dimensions>& getAbstractShape(const Composition<dimensions>& group, std::size_t i) {
-        return *group._shapes[i];
+        return *group._shapes[i].shape;
     }
 }
 
@@ -62,11 +63,22 @@ enum class CompositionOperation: UnsignedByte {
 @brief Composition of shapes
 
 Result of logical operations on shapes. See @ref shapes for brief introduction.
+
+All shapes are stored by value in one contiguous buffer and the operations are
+evaluated iteratively, so the collision detection doesn't allocate and copying
+or transforming the composition needs at most three allocations. If the
+composition is repeatedly transformed, use transform() with reused target
+composition, which then doesn't allocate at all.
+
+Empty composition doesn't collide with anything and it behaves as such also
+when used as operand, i.e. `a && Shapes::Composition3D()` never collides and
+`!Shapes::Composition3D()` collides with everything.
 */
 template<UnsignedInt dimensions> class MAGNUM_SHAPES_EXPORT Composition {
     friend Implementation::AbstractShape<dimensions>& Implementation::getAbstractShape<>(Composition<dimensions>&, std::size_t);
     friend const Implementation::AbstractShape<dimensions>& Implementation::getAbstractShape<>(const Composition<dimensions>&, std::size_t);
     friend struct Implementation::ShapeHelper<Composition<dimensions>>;
+    friend Math::Range<dimensions, Float> Implementation::bounds<>(const Composition<dimensions>&);
 
     public:
         enum: UnsignedInt {
@@ -96,7 +108,7 @@ template<UnsignedInt dimensions> class MAGNUM_SHAPES_EXPORT Composition {
          *
          * Creates empty hierarchy.
          */
-        explicit Composition() {}
+        explicit Composition(): _first(0) {}
 
         /**
          * @brief Unary operation constructor
@@ -127,14 +139,29 @@ template<UnsignedInt dimensions> class MAGNUM_SHAPES_EXPORT Composition {
         /** @brief Move assignment operator */
         Composition<dimensions>& operator=(Composition<dimensions>&& other);
 
-        /** @brief Transformed shape */
+        /**
+         * @brief Transformed shape
+         *
+         * @see transform()
+         */
         Composition<dimensions> transformed(const typename DimensionTraits<dimensions, Float>::MatrixType& matrix) const;
 
+        /**
+         * @brief Transform shape into another composition
+         *
+         * Equivalent to `result = transformed(matrix)`, but if @p result
+         * has the same shape types as this composition (e.g. it is result
+         * of previous call to this function), the shapes are transformed
+         * in-place without any allocations. @p result can be also this
+         * composition.
+         */
+        void transform(const typename DimensionTraits<dimensions, Float>::MatrixType& matrix, Composition<dimensions>& result) const;
+
         /** @brief Count of shapes in the hierarchy */
         std::size_t size() const { return _shapes.size(); }
 
         /** @brief Type of shape at given position */
-        Type type(std::size_t i) const { return _shapes[i]->type(); }
+        Type type(std::size_t i) const { return _shapes[i].type; }
 
         /** @brief Shape at given position */
         template<class T> const T& get(std::size_t i) const;
@@ -149,16 +176,36 @@ template<UnsignedInt dimensions> class MAGNUM_SHAPES_EXPORT Composition {
         }
 
     private:
-        struct Node {
-            std::size_t rightNode, rightShape;
-            CompositionOperation operation;
+        enum: std::size_t {
+            /* All shapes in the buffer are aligned to this */
+            Alignment = std::alignment_of<Implementation::AbstractShape<dimensions>>::value
         };
 
-        bool collides(const Implementation::AbstractShape<dimensions>& a) const {
-            return collides(a, 0, 0, _shapes.size());
-        }
+        /* False is in place of empty composition operand */
+        enum class NodeType: UnsignedByte {
+            Shape, False, Not, And, Or
+        };
 
-        bool collides(const Implementation::AbstractShape<dimensions>& a, std::size_t node, std::size_t shapeBegin, std::size_t shapeEnd) const;
+        struct Element {
+            Implementation::AbstractShape<dimensions>* shape;
+            std::size_t offset; /* Offset of the shape storage in the buffer */
+            Type type;
+
+            /* Shape evaluated next if this one doesn't / does collide, or
+               `size()` for final false and `size() + 1` for final true
+               result */
+            UnsignedInt next[2];
+        };
+
+        bool collides(const Implementation::AbstractShape<dimensions>& a) const;
+
+        Math::Range<dimensions, Float> bounds() const;
+        Math::Range<dimensions, Float> bounds(std::size_t& node, std::size_t& shape) const;
+
+        void link();
+        UnsignedInt link(std::size_t& node, std::size_t& shape, UnsignedInt onFalse, UnsignedInt onTrue);
+
+        void destroyShapes();
 
         template<class T> constexpr static std::size_t shapeCount(const T&) {
             return 1;
@@ -167,23 +214,35 @@ template<UnsignedInt dimensions> class MAGNUM_SHAPES_EXPORT Composition {
             return hierarchy._shapes.size();
         }
         template<class T> constexpr static std::size_t nodeCount(const T&) {
-            return 0;
+            return 1;
         }
         constexpr static std::size_t nodeCount(const Composition<dimensions>& hierarchy) {
-            return hierarchy._nodes.size();
+            return hierarchy._nodes.empty() ? 1 : hierarchy._nodes.size();
+        }
+        template<class T> constexpr static std::size_t dataSize(const T&) {
+            static_assert(std::alignment_of<Implementation::Shape<T>>::value <= Alignment, "shape has unsupported alignment");
+            return (sizeof(Implementation::Shape<T>) + Alignment - 1)/Alignment*Alignment;
+        }
+        constexpr static std::size_t dataSize(const Composition<dimensions>& hierarchy) {
+            return hierarchy._data.size();
         }
 
-        template<class T> void copyShapes(std::size_t offset, const T& shape) {
-            _shapes[offset] = new Implementation::Shape<T>(shape);
+        template<class T> void copyShapes(std::size_t offset, std::size_t dataOffset, const T& shape) {
+            _shapes[offset].shape = new(_data + dataOffset) Implementation::Shape<T>(shape);
+            _shapes[offset].offset = dataOffset;
+            _shapes[offset].type = Implementation::TypeOf<T>::type();
         }
-        void copyShapes(std::size_t offset, Composition<dimensions>&& other);
-        void copyShapes(std::size_t offset, const Composition<dimensions>& other);
+        void copyShapes(std::size_t offset, std::size_t dataOffset, const Composition<dimensions>& other);
 
-        template<class T> void copyNodes(std::size_t, const T&) {}
+        template<class T> void copyNodes(std::size_t offset, const T&) {
+            _nodes[offset] = NodeType::Shape;
+        }
         void copyNodes(std::size_t offset, const Composition<dimensions>& other);
 
-        Containers::Array<Implementation::AbstractShape<dimensions>*> _shapes;
-        Containers::Array<Node> _nodes;
+        Containers::Array<char> _data;
+        Containers::Array<Element> _shapes;
+        Containers::Array<NodeType> _nodes;
+        UnsignedInt _first; /* Shape evaluated first, same meaning as Element::next */
 };
 
 /** @brief Two-dimensional shape hierarchy */
@@ -255,42 +314,33 @@ template<class T, class U> inline auto operator||(T&& a, U&& b) -> enableIfAreSh
 #undef enableIfAreShapeType
 #endif
 
-template<UnsignedInt dimensions> template<class T> Composition<dimensions>::Composition(CompositionOperation operation, T&& a): _shapes(shapeCount(a)), _nodes(nodeCount(a)+1) {
+template<UnsignedInt dimensions> template<class T> Composition<dimensions>::Composition(CompositionOperation operation, T&& a): _data(dataSize(a)), _shapes(shapeCount(a)), _nodes(nodeCount(a) + 1) {
     CORRADE_ASSERT(operation == CompositionOperation::Not,
         "Shapes::Composition::Composition(): unary operation expected", );
-    _nodes[0].operation = operation;
 
-    /* 0 = no children, 1 = left child only */
-    _nodes[0].rightNode = (nodeCount(a) == 0 ? 0 : 1);
-    _nodes[0].rightShape = shapeCount(a);
-    copyNodes(1, a);
-    copyShapes(0, std::forward<T>(a));
+    copyNodes(0, a);
+    _nodes[nodeCount(a)] = NodeType::Not;
+    copyShapes(0, 0, a);
+    link();
 }
 
-template<UnsignedInt dimensions> template<class T, class U> Composition<dimensions>::Composition(CompositionOperation operation, T&& a, U&& b): _shapes(shapeCount(a) + shapeCount(b)), _nodes(nodeCount(a) + nodeCount(b) + 1) {
+template<UnsignedInt dimensions> template<class T, class U> Composition<dimensions>::Composition(CompositionOperation operation, T&& a, U&& b): _data(dataSize(a) + dataSize(b)), _shapes(shapeCount(a) + shapeCount(b)), _nodes(nodeCount(a) + nodeCount(b) + 1) {
     CORRADE_ASSERT(operation != CompositionOperation::Not,
         "Shapes::Composition::Composition(): binary operation expected", );
-    _nodes[0].operation = operation;
-
-    /* 0 = no children, 1 = left child only, 2 = right child only, >2 = both */
-    if(nodeCount(a) == 0 && nodeCount(b) == 0)
-        _nodes[0].rightNode = 0;
-    else if(nodeCount(b) == 0)
-        _nodes[0].rightNode = 1;
-    else _nodes[0].rightNode = nodeCount(a) + 2;
-
-    _nodes[0].rightShape = shapeCount(a);
-    copyNodes(1, a);
-    copyNodes(nodeCount(a) + 1, b);
-    copyShapes(shapeCount(a), std::forward<U>(b));
-    copyShapes(0, std::forward<T>(a));
+
+    copyNodes(0, a);
+    copyNodes(nodeCount(a), b);
+    _nodes[nodeCount(a) + nodeCount(b)] = operation == CompositionOperation::And ? NodeType::And : NodeType::Or;
+    copyShapes(0, 0, a);
+    copyShapes(shapeCount(a), dataSize(a), b);
+    link();
 }
 
 template<UnsignedInt dimensions> template<class T> inline const T& Composition<dimensions>::get(std::size_t i) const {
-    CORRADE_ASSERT(_shapes[i]->type() == Implementation::TypeOf<T>::type(),
+    CORRADE_ASSERT(_shapes[i].type == Implementation::TypeOf<T>::type(),
         "Shapes::Composition::get(): given shape is not of type" << Implementation::TypeOf<T>::type() <<
-        "but" << _shapes[i]->type(), *static_cast<T*>(nullptr));
-    return static_cast<Implementation::Shape<T>*>(_shapes[i])->shape;
+        "but" << _shapes[i].type, *static_cast<T*>(nullptr));
+    return static_cast<const Implementation::Shape<T>*>(_shapes[i].shape)->shape;
 }
 
 }}
@@ -0,0 +1,231 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "BatchCollision.h"
+
+/* SSE2 is baseline on all x86-64 CPUs, AVX is picked at runtime. Target
+   attributes usable together with intrinsics headers need GCC 4.9. */
+#if (defined(__GNUC__) || defined(__clang__)) && !defined(CORRADE_TARGET_NACL) && (defined(__x86_64__) || (defined(__i386__) && defined(__SSE2__)))
+#define MAGNUM_SHAPES_USE_SSE2
+#include <emmintrin.h>
+#if !defined(__clang__) && __GNUC__*100 + __GNUC_MINOR__ >= 409
+#define MAGNUM_SHAPES_USE_AVX
+#include <immintrin.h>
+#endif
+#endif
+
+namespace Magnum { namespace Shapes { namespace Implementation {
+
+namespace {
+
+/* Fallbacks, everything is processed by the scalar loops */
+template<UnsignedInt dimensions> std::size_t spheresScalar(const Float* const*, const Float*, const Float*, Float, std::size_t, UnsignedByte*) { return 0; }
+template<UnsignedInt dimensions> std::size_t pointsInBoxScalar(const Float* const*, const Float*, const Float*, std::size_t, UnsignedByte*) { return 0; }
+template<UnsignedInt dimensions> std::size_t pointsInSphereScalar(const Float* const*, const Float*, Float, std::size_t, UnsignedByte*) { return 0; }
+
+#ifdef MAGNUM_SHAPES_USE_SSE2
+/* Comparison masks of 16 elements are packed to bytes with signed saturation,
+   which keeps all ones as -1 and zeros as 0 */
+inline void storeMasks(UnsignedByte* const out, const __m128 a, const __m128 b, const __m128 c, const __m128 d) {
+    const __m128i packed = _mm_packs_epi16(
+        _mm_packs_epi32(_mm_castps_si128(a), _mm_castps_si128(b)),
+        _mm_packs_epi32(_mm_castps_si128(c), _mm_castps_si128(d)));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(out), _mm_and_si128(packed, _mm_set1_epi8(1)));
+}
+
+template<UnsignedInt dimensions> inline __m128 distanceSse2(const Float* const* const positions, const __m128* const center, const std::size_t i) {
+    __m128 distance = _mm_setzero_ps();
+    for(UnsignedInt j = 0; j != dimensions; ++j) {
+        const __m128 d = _mm_sub_ps(_mm_loadu_ps(positions[j] + i), center[j]);
+        distance = _mm_add_ps(distance, _mm_mul_ps(d, d));
+    }
+    return distance;
+}
+
+template<UnsignedInt dimensions> inline __m128 spheresSse2(const Float* const* const positions, const Float* const radii, const __m128* const center, const __m128 radius, const std::size_t i) {
+    const __m128 maxDistance = _mm_add_ps(_mm_loadu_ps(radii + i), radius);
+    return _mm_cmplt_ps(distanceSse2<dimensions>(positions, center, i), _mm_mul_ps(maxDistance, maxDistance));
+}
+
+template<UnsignedInt dimensions> std::size_t spheresSse2(const Float* const* const positions, const Float* const radii, const Float* const center, const Float radius, const std::size_t count, UnsignedByte* const result) {
+    __m128 vcenter[dimensions];
+    for(UnsignedInt j = 0; j != dimensions; ++j)
+        vcenter[j] = _mm_set1_ps(center[j]);
+    const __m128 vradius = _mm_set1_ps(radius);
+
+    std::size_t i = 0;
+    for(; i + 16 <= count; i += 16) storeMasks(result + i,
+        spheresSse2<dimensions>(positions, radii, vcenter, vradius, i),
+        spheresSse2<dimensions>(positions, radii, vcenter, vradius, i + 4),
+        spheresSse2<dimensions>(positions, radii, vcenter, vradius, i + 8),
+        spheresSse2<dimensions>(positions, radii, vcenter, vradius, i + 12));
+
+    return i;
+}
+
+template<UnsignedInt dimensions> inline __m128 pointsInBoxSse2(const Float* const* const positions, const __m128* const min, const __m128* const max, const std::size_t i) {
+    __m128 inside = _mm_castsi128_ps(_mm_set1_epi32(-1));
+    for(UnsignedInt j = 0; j != dimensions; ++j) {
+        const __m128 p = _mm_loadu_ps(positions[j] + i);
+        inside = _mm_and_ps(inside, _mm_and_ps(_mm_cmpge_ps(p, min[j]), _mm_cmplt_ps(p, max[j])));
+    }
+    return inside;
+}
+
+template<UnsignedInt dimensions> std::size_t pointsInBoxSse2(const Float* const* const positions, const Float* const min, const Float* const max, const std::size_t count, UnsignedByte* const result) {
+    __m128 vmin[dimensions], vmax[dimensions];
+    for(UnsignedInt j = 0; j != dimensions; ++j) {
+        vmin[j] = _mm_set1_ps(min[j]);
+        vmax[j] = _mm_set1_ps(max[j]);
+    }
+
+    std::size_t i = 0;
+    for(; i + 16 <= count; i += 16) storeMasks(result + i,
+        pointsInBoxSse2<dimensions>(positions, vmin, vmax, i),
+        pointsInBoxSse2<dimensions>(positions, vmin, vmax, i + 4),
+        pointsInBoxSse2<dimensions>(positions, vmin, vmax, i + 8),
+        pointsInBoxSse2<dimensions>(positions, vmin, vmax, i + 12));
+
+    return i;
+}
+
+template<UnsignedInt dimensions> std::size_t pointsInSphereSse2(const Float* const* const positions, const Float* const center, const Float radiusSquared, const std::size_t count, UnsignedByte* const result) {
+    __m128 vcenter[dimensions];
+    for(UnsignedInt j = 0; j != dimensions; ++j)
+        vcenter[j] = _mm_set1_ps(center[j]);
+    const __m128 vradius = _mm_set1_ps(radiusSquared);
+
+    std::size_t i = 0;
+    for(; i + 16 <= count; i += 16) storeMasks(result + i,
+        _mm_cmplt_ps(distanceSse2<dimensions>(positions, vcenter, i), vradius),
+        _mm_cmplt_ps(distanceSse2<dimensions>(positions, vcenter, i + 4), vradius),
+        _mm_cmplt_ps(distanceSse2<dimensions>(positions, vcenter, i + 8), vradius),
+        _mm_cmplt_ps(distanceSse2<dimensions>(positions, vcenter, i + 12), vradius));
+
+    return i;
+}
+#endif
+
+#ifdef MAGNUM_SHAPES_USE_AVX
+/* Masks of two 8-element vectors are stored using the SSE2 packing */
+__attribute__((target("avx"))) inline void storeMasks(UnsignedByte* const out, const __m256 a, const __m256 b) {
+    storeMasks(out, _mm256_castps256_ps128(a), _mm256_extractf128_ps(a, 1),
+                    _mm256_castps256_ps128(b), _mm256_extractf128_ps(b, 1));
+}
+
+template<UnsignedInt dimensions> __attribute__((target("avx"))) inline __m256 distanceAvx(const Float* const* const positions, const __m256* const center, const std::size_t i) {
+    __m256 distance = _mm256_setzero_ps();
+    for(UnsignedInt j = 0; j != dimensions; ++j) {
+        const __m256 d = _mm256_sub_ps(_mm256_loadu_ps(positions[j] + i), center[j]);
+        distance = _mm256_add_ps(distance, _mm256_mul_ps(d, d));
+    }
+    return distance;
+}
+
+template<UnsignedInt dimensions> __attribute__((target("avx"))) inline __m256 spheresAvx(const Float* const* const positions, const Float* const radii, const __m256* const center, const __m256 radius, const std::size_t i) {
+    const __m256 maxDistance = _mm256_add_ps(_mm256_loadu_ps(radii + i), radius);
+    return _mm256_cmp_ps(distanceAvx<dimensions>(positions, center, i), _mm256_mul_ps(maxDistance, maxDistance), _CMP_LT_OQ);
+}
+
+template<UnsignedInt dimensions> __attribute__((target("avx"))) std::size_t spheresAvx(const Float* const* const positions, const Float* const radii, const Float* const center, const Float radius, const std::size_t count, UnsignedByte* const result) {
+    __m256 vcenter[dimensions];
+    for(UnsignedInt j = 0; j != dimensions; ++j)
+        vcenter[j] = _mm256_set1_ps(center[j]);
+    const __m256 vradius = _mm256_set1_ps(radius);
+
+    std::size_t i = 0;
+    for(; i + 16 <= count; i += 16) storeMasks(result + i,
+        spheresAvx<dimensions>(positions, radii, vcenter, vradius, i),
+        spheresAvx<dimensions>(positions, radii, vcenter, vradius, i + 8));
+
+    return i;
+}
+
+template<UnsignedInt dimensions> __attribute__((target("avx"))) inline __m256 pointsInBoxAvx(const Float* const* const positions, const __m256* const min, const __m256* const max, const std::size_t i) {
+    __m256 inside = _mm256_castsi256_ps(_mm256_set1_epi32(-1));
+    for(UnsignedInt j = 0; j != dimensions; ++j) {
+        const __m256 p = _mm256_loadu_ps(positions[j] + i);
+        inside = _mm256_and_ps(inside, _mm256_and_ps(_mm256_cmp_ps(p, min[j], _CMP_GE_OQ), _mm256_cmp_ps(p, max[j], _CMP_LT_OQ)));
+    }
+    return inside;
+}
+
+template<UnsignedInt dimensions> __attribute__((target("avx"))) std::size_t pointsInBoxAvx(const Float* const* const positions, const Float* const min, const Float* const max, const std::size_t count, UnsignedByte* const result) {
+    __m256 vmin[dimensions], vmax[dimensions];
+    for(UnsignedInt j = 0; j != dimensions; ++j) {
+        vmin[j] = _mm256_set1_ps(min[j]);
+        vmax[j] = _mm256_set1_ps(max[j]);
+    }
+
+    std::size_t i = 0;
+    for(; i + 16 <= count; i += 16) storeMasks(result + i,
+        pointsInBoxAvx<dimensions>(positions, vmin, vmax, i),
+        pointsInBoxAvx<dimensions>(positions, vmin, vmax, i + 8));
+
+    return i;
+}
+
+template<UnsignedInt dimensions> __attribute__((target("avx"))) std::size_t pointsInSphereAvx(const Float* const* const positions, const Float* const center, const Float radiusSquared, const std::size_t count, UnsignedByte* const result) {
+    __m256 vcenter[dimensions];
+    for(UnsignedInt j = 0; j != dimensions; ++j)
+        vcenter[j] = _mm256_set1_ps(center[j]);
+    const __m256 vradius = _mm256_set1_ps(radiusSquared);
+
+    std::size_t i = 0;
+    for(; i + 16 <= count; i += 16) storeMasks(result + i,
+        _mm256_cmp_ps(distanceAvx<dimensions>(positions, vcenter, i), vradius, _CMP_LT_OQ),
+        _mm256_cmp_ps(distanceAvx<dimensions>(positions, vcenter, i + 8), vradius, _CMP_LT_OQ));
+
+    return i;
+}
+#endif
+
+}
+
+template<UnsignedInt dimensions> BatchCollision<dimensions>::BatchCollision(): spheres(spheresScalar<dimensions>), pointsInBox(pointsInBoxScalar<dimensions>), pointsInSphere(pointsInSphereScalar<dimensions>) {
+    #ifdef MAGNUM_SHAPES_USE_SSE2
+    spheres = spheresSse2<dimensions>;
+    pointsInBox = pointsInBoxSse2<dimensions>;
+    pointsInSphere = pointsInSphereSse2<dimensions>;
+    #endif
+
+    #ifdef MAGNUM_SHAPES_USE_AVX
+    __builtin_cpu_init();
+    if(__builtin_cpu_supports("avx")) {
+        spheres = spheresAvx<dimensions>;
+        pointsInBox = pointsInBoxAvx<dimensions>;
+        pointsInSphere = pointsInSphereAvx<dimensions>;
+    }
+    #endif
+}
+
+template<UnsignedInt dimensions> const BatchCollision<dimensions>& batchCollision() {
+    static const BatchCollision<dimensions> instance;
+    return instance;
+}
+
+template const BatchCollision<2>& batchCollision();
+template const BatchCollision<3>& batchCollision();
+
+}}}
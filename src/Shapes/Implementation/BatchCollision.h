@@ -0,0 +1,62 @@
+#ifndef Magnum_Shapes_Implementation_BatchCollision_h
+#define Magnum_Shapes_Implementation_BatchCollision_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <cstddef>
+
+#include "Types.h"
+
+namespace Magnum { namespace Shapes { namespace Implementation {
+
+/*
+Batch collision kernels:
+
+Positions are passed as one array per dimension, result of i-th element is
+written to `result[i]`. The kernels use SSE2 or AVX (picked at runtime based
+on CPU features on first use) and process only the longest prefix which is a
+multiple of their vector width, returning its size. The remaining elements
+(or all of them, if SIMD isn't available) are processed with scalar loops in
+SphereBatch and PointBatch.
+*/
+template<UnsignedInt dimensions> struct BatchCollision {
+    BatchCollision();
+
+    /* Distance of the center from the position is less than sum of the
+       radii */
+    std::size_t(*spheres)(const Float* const* positions, const Float* radii, const Float* center, Float radius, std::size_t count, UnsignedByte* result);
+
+    /* Position is inside [min, max) */
+    std::size_t(*pointsInBox)(const Float* const* positions, const Float* min, const Float* max, std::size_t count, UnsignedByte* result);
+
+    /* Squared distance of the center from the position is less than
+       `radiusSquared` */
+    std::size_t(*pointsInSphere)(const Float* const* positions, const Float* center, Float radiusSquared, std::size_t count, UnsignedByte* result);
+};
+
+template<UnsignedInt dimensions> const BatchCollision<dimensions>& batchCollision();
+
+}}}
+
+#endif
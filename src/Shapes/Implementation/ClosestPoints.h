@@ -0,0 +1,94 @@
+#ifndef Magnum_Shapes_Implementation_ClosestPoints_h
+#define Magnum_Shapes_Implementation_ClosestPoints_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <utility>
+
+#include "DimensionTraits.h"
+#include "Math/Functions.h"
+#include "Math/Vector3.h"
+#include "Shapes/Capsule.h"
+
+namespace Magnum { namespace Shapes { namespace Implementation {
+
+/* Point on line segment `a`, `b` closest to given point */
+template<UnsignedInt dimensions> inline typename DimensionTraits<dimensions, Float>::VectorType closestPoint(const typename DimensionTraits<dimensions, Float>::VectorType& a, const typename DimensionTraits<dimensions, Float>::VectorType& b, const typename DimensionTraits<dimensions, Float>::VectorType& point) {
+    const typename DimensionTraits<dimensions, Float>::VectorType direction = b - a;
+    const Float length = direction.dot();
+
+    /* Degenerate segment */
+    if(length < Math::TypeTraits<Float>::epsilon()) return a;
+
+    return a + direction*Math::clamp(Math::Vector<dimensions, Float>::dot(point - a, direction)/length, 0.0f, 1.0f);
+}
+
+/* Closest points on two line segments, see Ericson: Real-Time Collision
+   Detection, chapter 5.1.9 */
+template<UnsignedInt dimensions> inline std::pair<typename DimensionTraits<dimensions, Float>::VectorType, typename DimensionTraits<dimensions, Float>::VectorType> closestPoints(const Capsule<dimensions>& first, const Capsule<dimensions>& second) {
+    const typename DimensionTraits<dimensions, Float>::VectorType d1 = first.b() - first.a();
+    const typename DimensionTraits<dimensions, Float>::VectorType d2 = second.b() - second.a();
+    const typename DimensionTraits<dimensions, Float>::VectorType r = first.a() - second.a();
+    const Float a = d1.dot();
+    const Float e = d2.dot();
+    const Float f = Math::Vector<dimensions, Float>::dot(d2, r);
+
+    /* Both segments degenerate into points */
+    if(a < Math::TypeTraits<Float>::epsilon() && e < Math::TypeTraits<Float>::epsilon())
+        return {first.a(), second.a()};
+
+    /* First segment degenerates into point */
+    if(a < Math::TypeTraits<Float>::epsilon())
+        return {first.a(), closestPoint<dimensions>(second.a(), second.b(), first.a())};
+
+    /* Second segment degenerates into point */
+    if(e < Math::TypeTraits<Float>::epsilon())
+        return {closestPoint<dimensions>(first.a(), first.b(), second.a()), second.a()};
+
+    const Float b = Math::Vector<dimensions, Float>::dot(d1, d2);
+    const Float c = Math::Vector<dimensions, Float>::dot(d1, r);
+    const Float denominator = a*e - b*b;
+
+    /* Closest point on the first segment to the second line, arbitrary point
+       if the segments are parallel */
+    Float s = denominator < Math::TypeTraits<Float>::epsilon()*a*e ? 0.0f :
+        Math::clamp((b*f - c*e)/denominator, 0.0f, 1.0f);
+
+    /* Closest point on the second segment, if it is outside, clamp it and
+       recompute the point on the first segment */
+    Float t = (b*s + f)/e;
+    if(t < 0.0f) {
+        t = 0.0f;
+        s = Math::clamp(-c/a, 0.0f, 1.0f);
+    } else if(t > 1.0f) {
+        t = 1.0f;
+        s = Math::clamp((b - c)/a, 0.0f, 1.0f);
+    }
+
+    return {first.a() + d1*s, second.a() + d2*t};
+}
+
+}}}
+
+#endif
@@ -24,75 +24,174 @@
 
 #include "CollisionDispatch.h"
 
+#include <limits>
+#include <tuple>
+
+#include "Math/BoolVector.h"
 #include "Shapes/AxisAlignedBox.h"
 #include "Shapes/Box.h"
 #include "Shapes/Capsule.h"
+#include "Shapes/Composition.h"
 #include "Shapes/Cylinder.h"
 #include "Shapes/LineSegment.h"
 #include "Shapes/Plane.h"
 #include "Shapes/Point.h"
 #include "Shapes/Sphere.h"
+#include "Shapes/TimeOfImpact.h"
 #include "Shapes/shapeImplementation.h"
 
 namespace Magnum { namespace Shapes { namespace Implementation {
 
-template<> bool collides(const AbstractShape<2>& a, const AbstractShape<2>& b) {
-    if(a.type() < b.type()) return collides(b, a);
+namespace {
 
-    switch(UnsignedInt(a.type())*UnsignedInt(b.type())) {
-        #define _c(aType, aClass, bType, bClass) \
-            case UnsignedInt(ShapeDimensionTraits<2>::Type::aType)*UnsignedInt(ShapeDimensionTraits<2>::Type::bType): \
-                return static_cast<const Shape<aClass>&>(a).shape % static_cast<const Shape<bClass>&>(b).shape;
-        _c(Sphere, Sphere2D, Point, Point2D)
-        _c(Sphere, Sphere2D, Line, Line2D)
-        _c(Sphere, Sphere2D, LineSegment, LineSegment2D)
-        _c(Sphere, Sphere2D, Sphere, Sphere2D)
+/* Tag for ordering the implementation candidates, higher is preferred */
+template<std::size_t priority> struct Priority: Priority<priority - 1> {};
+template<> struct Priority<0> {};
 
-        _c(InvertedSphere, InvertedSphere2D, Point, Point2D)
-        _c(InvertedSphere, InvertedSphere2D, Sphere, Sphere2D)
+/* Collision occurence, either `a % b`, `b % a` or none */
+template<class T, class U> inline auto collides(const T& a, const U& b, Priority<2>) -> decltype(a % b) {
+    return a % b;
+}
+template<class T, class U> inline auto collides(const T& a, const U& b, Priority<1>) -> decltype(b % a) {
+    return b % a;
+}
+template<class T, class U> inline bool collides(const T&, const U&, Priority<0>) {
+    return false;
+}
 
-        _c(Cylinder, Cylinder2D, Point, Point2D)
-        _c(Cylinder, Cylinder2D, Sphere, Sphere2D)
+/* Member and free operator would be ambiguous for two compositions */
+template<UnsignedInt dimensions> inline bool collides(const Composition<dimensions>& a, const Composition<dimensions>& b, Priority<2>) {
+    return a.operator%(b);
+}
 
-        _c(Capsule, Capsule2D, Point, Point2D)
-        _c(Capsule, Capsule2D, Sphere, Sphere2D)
+/* Collision, either `a / b`, flipped `b / a` or none */
+template<class T, class U> inline auto collision(const T& a, const U& b, Priority<2>) -> decltype(a / b) {
+    return a / b;
+}
+template<class T, class U> inline auto collision(const T& a, const U& b, Priority<1>) -> decltype(b / a) {
+    return (b / a).flipped();
+}
+template<class T, class U> inline Collision<T::Dimensions> collision(const T&, const U&, Priority<0>) {
+    return {};
+}
 
-        _c(AxisAlignedBox, AxisAlignedBox2D, Point, Point2D)
-        #undef _c
-    }
+/* Time of impact, either exact or occurence of collision at the beginning
+   and at the end of the motion. Inverted sphere would be converted to sphere
+   for the exact variant, so it is excluded. */
+template<class T> struct IsInvertedSphere: std::false_type {};
+template<UnsignedInt dimensions> struct IsInvertedSphere<InvertedSphere<dimensions>>: std::true_type {};
 
-    return false;
+template<class T, class U> inline auto timeOfImpact(const T& aStart, const T& aEnd, const U& bStart, const U& bEnd, Priority<1>) -> typename std::enable_if<!IsInvertedSphere<T>::value && !IsInvertedSphere<U>::value, decltype(Shapes::timeOfImpact(aStart, aEnd, bStart, bEnd))>::type {
+    return Shapes::timeOfImpact(aStart, aEnd, bStart, bEnd);
+}
+template<class T, class U> inline Float timeOfImpact(const T& aStart, const T& aEnd, const U& bStart, const U& bEnd, Priority<0>) {
+    if(collides(aStart, bStart, Priority<2>())) return 0.0f;
+    if(collides(aEnd, bEnd, Priority<2>())) return 1.0f;
+    return std::numeric_limits<Float>::infinity();
 }
 
-template<> bool collides(const AbstractShape<3>& a, const AbstractShape<3>& b) {
-    if(a.type() < b.type()) return collides(b, a);
+/* Table entries for given pair of types */
+template<class T, class U> bool collidesEntry(const AbstractShape<T::Dimensions>& a, const AbstractShape<T::Dimensions>& b) {
+    return collides(static_cast<const Shape<T>&>(a).shape, static_cast<const Shape<U>&>(b).shape, Priority<2>());
+}
+template<class T, class U> Collision<T::Dimensions> collisionEntry(const AbstractShape<T::Dimensions>& a, const AbstractShape<T::Dimensions>& b) {
+    return collision(static_cast<const Shape<T>&>(a).shape, static_cast<const Shape<U>&>(b).shape, Priority<2>());
+}
 
-    switch(UnsignedInt(a.type())*UnsignedInt(b.type())) {
-        #define _c(aType, aClass, bType, bClass) \
-            case UnsignedInt(ShapeDimensionTraits<3>::Type::aType)*UnsignedInt(ShapeDimensionTraits<3>::Type::bType): \
-                return static_cast<const Shape<aClass>&>(a).shape % static_cast<const Shape<bClass>&>(b).shape;
-        _c(Sphere, Sphere3D, Point, Point3D)
-        _c(Sphere, Sphere3D, Line, Line3D)
-        _c(Sphere, Sphere3D, LineSegment, LineSegment3D)
-        _c(Sphere, Sphere3D, Sphere, Sphere3D)
+template<class T, class U> Float timeOfImpactEntry(const AbstractShape<T::Dimensions>& aStart, const AbstractShape<T::Dimensions>& aEnd, const AbstractShape<T::Dimensions>& bStart, const AbstractShape<T::Dimensions>& bEnd) {
+    return timeOfImpact(static_cast<const Shape<T>&>(aStart).shape, static_cast<const Shape<T>&>(aEnd).shape, static_cast<const Shape<U>&>(bStart).shape, static_cast<const Shape<U>&>(bEnd).shape, Priority<1>());
+}
 
-        _c(InvertedSphere, InvertedSphere3D, Point, Point3D)
-        _c(InvertedSphere, InvertedSphere3D, Sphere, Sphere3D)
+/* Index of given type enum value in the type list */
+template<UnsignedInt dimensions> constexpr UnsignedByte typeIndex(std::size_t, UnsignedByte) {
+    return 0xff;
+}
+template<UnsignedInt dimensions, class T, class ...Types> constexpr UnsignedByte typeIndex(std::size_t type, UnsignedByte index) {
+    return std::size_t(TypeOf<T>::type()) == type ? index : typeIndex<dimensions, Types...>(type, index + 1);
+}
 
-        _c(Cylinder, Cylinder3D, Point, Point3D)
-        _c(Cylinder, Cylinder3D, Sphere, Sphere3D)
+template<UnsignedInt dimensions, class ...Types> class Dispatch {
+    public:
+        static bool collides(const AbstractShape<dimensions>& a, const AbstractShape<dimensions>& b) {
+            return collidesTable(Table())[index(a.type())*sizeof...(Types) + index(b.type())](a, b);
+        }
+
+        static Collision<dimensions> collision(const AbstractShape<dimensions>& a, const AbstractShape<dimensions>& b) {
+            return collisionTable(Table())[index(a.type())*sizeof...(Types) + index(b.type())](a, b);
+        }
+
+        static Float timeOfImpact(const AbstractShape<dimensions>& aStart, const AbstractShape<dimensions>& aEnd, const AbstractShape<dimensions>& bStart, const AbstractShape<dimensions>& bEnd) {
+            CORRADE_INTERNAL_ASSERT(aStart.type() == aEnd.type() && bStart.type() == bEnd.type());
+            return timeOfImpactTable(Table())[index(aStart.type())*sizeof...(Types) + index(bStart.type())](aStart, aEnd, bStart, bEnd);
+        }
+
+    private:
+        typedef typename ShapeDimensionTraits<dimensions>::Type Type;
+        typedef typename Math::Implementation::GenerateSequence<sizeof...(Types)*sizeof...(Types)>::Type Table;
+        typedef typename Math::Implementation::GenerateSequence<std::size_t(Type::Composition) + 1>::Type Indices;
+
+        template<std::size_t i> struct TypeAt {
+            typedef typename std::tuple_element<i, std::tuple<Types...>>::type Type;
+        };
+
+        static UnsignedByte index(Type type) {
+            return indexTable(Indices())[std::size_t(type)];
+        }
+
+        template<std::size_t ...sequence> static const UnsignedByte* indexTable(Math::Implementation::Sequence<sequence...>) {
+            static const UnsignedByte table[]{typeIndex<dimensions, Types...>(sequence, 0)...};
+            return table;
+        }
+
+        template<std::size_t ...sequence> static auto collidesTable(Math::Implementation::Sequence<sequence...>) -> bool(* const*)(const AbstractShape<dimensions>&, const AbstractShape<dimensions>&) {
+            static bool(* const table[])(const AbstractShape<dimensions>&, const AbstractShape<dimensions>&){
+                collidesEntry<typename TypeAt<sequence/sizeof...(Types)>::Type, typename TypeAt<sequence%sizeof...(Types)>::Type>...
+            };
+            return table;
+        }
+
+        template<std::size_t ...sequence> static auto collisionTable(Math::Implementation::Sequence<sequence...>) -> Collision<dimensions>(* const*)(const AbstractShape<dimensions>&, const AbstractShape<dimensions>&) {
+            static Collision<dimensions>(* const table[])(const AbstractShape<dimensions>&, const AbstractShape<dimensions>&){
+                collisionEntry<typename TypeAt<sequence/sizeof...(Types)>::Type, typename TypeAt<sequence%sizeof...(Types)>::Type>...
+            };
+            return table;
+        }
+
+        template<std::size_t ...sequence> static auto timeOfImpactTable(Math::Implementation::Sequence<sequence...>) -> Float(* const*)(const AbstractShape<dimensions>&, const AbstractShape<dimensions>&, const AbstractShape<dimensions>&, const AbstractShape<dimensions>&) {
+            static Float(* const table[])(const AbstractShape<dimensions>&, const AbstractShape<dimensions>&, const AbstractShape<dimensions>&, const AbstractShape<dimensions>&){
+                timeOfImpactEntry<typename TypeAt<sequence/sizeof...(Types)>::Type, typename TypeAt<sequence%sizeof...(Types)>::Type>...
+            };
+            return table;
+        }
+};
+
+typedef Dispatch<2, Point2D, Line2D, LineSegment2D, Sphere2D, InvertedSphere2D, Cylinder2D, Capsule2D, AxisAlignedBox2D, Box2D, Composition2D> Dispatch2D;
+typedef Dispatch<3, Point3D, Line3D, LineSegment3D, Sphere3D, InvertedSphere3D, Cylinder3D, Capsule3D, AxisAlignedBox3D, Box3D, Plane, Composition3D> Dispatch3D;
 
-        _c(Capsule, Capsule3D, Point, Point3D)
-        _c(Capsule, Capsule3D, Sphere, Sphere3D)
+}
 
-        _c(AxisAlignedBox, AxisAlignedBox3D, Point, Point3D)
+template<> bool collides(const AbstractShape<2>& a, const AbstractShape<2>& b) {
+    return Dispatch2D::collides(a, b);
+}
 
-        _c(Plane, Plane, Line, Line3D)
-        _c(Plane, Plane, LineSegment, LineSegment3D)
-        #undef _c
-    }
+template<> bool collides(const AbstractShape<3>& a, const AbstractShape<3>& b) {
+    return Dispatch3D::collides(a, b);
+}
 
-    return false;
+template<> Collision2D collision(const AbstractShape<2>& a, const AbstractShape<2>& b) {
+    return Dispatch2D::collision(a, b);
+}
+
+template<> Collision3D collision(const AbstractShape<3>& a, const AbstractShape<3>& b) {
+    return Dispatch3D::collision(a, b);
+}
+
+template<> Float timeOfImpact(const AbstractShape<2>& aStart, const AbstractShape<2>& aEnd, const AbstractShape<2>& bStart, const AbstractShape<2>& bEnd) {
+    return Dispatch2D::timeOfImpact(aStart, aEnd, bStart, bEnd);
+}
+
+template<> Float timeOfImpact(const AbstractShape<3>& aStart, const AbstractShape<3>& aEnd, const AbstractShape<3>& bStart, const AbstractShape<3>& bEnd) {
+    return Dispatch3D::timeOfImpact(aStart, aEnd, bStart, bEnd);
 }
 
 }}}
@@ -25,6 +25,7 @@
 */
 
 #include "Types.h"
+#include "Shapes/Shapes.h"
 
 namespace Magnum { namespace Shapes { namespace Implementation {
 
@@ -33,14 +34,21 @@ template<UnsignedInt> struct AbstractShape;
 /*
 Shape collision double-dispatch:
 
-The collision is symmetric, i.e. it doesn't matter if we test Point vs. Sphere
-or Sphere vs. Point. Each type is specified by unique prime number. Then we
-multiply the two numbers together and switch() on the result. Because of
-multiplying two prime numbers, there is no ambiguity (the result is unique for
-each combination).
+Each shape type is mapped to dense index and the function for given pair is
+looked up in two-dimensional table. The table is generated at compile time
+from list of all shape types, each entry calls `a % b` or `a / b` if the pair
+has it implemented, the reversed variant (`b % a` or flipped `b / a`) if only
+that one is available and returns no collision otherwise. Time of impact
+entries call timeOfImpact() if the pair has it implemented, otherwise they
+return `0` if the shapes collide at the beginning of the motion, `1` if they
+collide at the end and infinity if not at all.
 */
 template<UnsignedInt dimensions> bool collides(const AbstractShape<dimensions>& a, const AbstractShape<dimensions>& b);
 
+template<UnsignedInt dimensions> Collision<dimensions> collision(const AbstractShape<dimensions>& a, const AbstractShape<dimensions>& b);
+
+template<UnsignedInt dimensions> Float timeOfImpact(const AbstractShape<dimensions>& aStart, const AbstractShape<dimensions>& aEnd, const AbstractShape<dimensions>& bStart, const AbstractShape<dimensions>& bEnd);
+
 }}}
 
 #endif
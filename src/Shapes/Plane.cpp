@@ -26,9 +26,11 @@
 
 #include <limits>
 
+#include "Math/Functions.h"
 #include "Math/Matrix4.h"
 #include "Math/Geometry/Intersection.h"
 #include "Shapes/LineSegment.h"
+#include "Shapes/Sphere.h"
 
 using namespace Magnum::Math::Geometry;
 
@@ -52,4 +54,19 @@ bool Plane::operator%(const LineSegment3D& other) const {
     return t > 0.0f && t < 1.0f;
 }
 
+bool Plane::operator%(const Sphere3D& other) const {
+    return Math::abs(Vector3::dot(other.position() - _position, _normal)) < other.radius();
+}
+
+Collision3D Plane::operator/(const Sphere3D& other) const {
+    const Float distance = Vector3::dot(other.position() - _position, _normal);
+
+    /* No collision occured */
+    if(Math::abs(distance) > other.radius()) return {};
+
+    /* Contact position is on the surface of `other` */
+    const Vector3 separatingNormal = distance < 0.0f ? _normal : -_normal;
+    return Collision3D(other.position() + separatingNormal*other.radius(), separatingNormal, other.radius() - Math::abs(distance));
+}
+
 }}
@@ -30,6 +30,7 @@
 
 #include "Math/Vector3.h"
 #include "Magnum.h"
+#include "Shapes/Collision.h"
 #include "Shapes/Shapes.h"
 #include "Shapes/magnumShapesVisibility.h"
 
@@ -82,6 +83,17 @@ class MAGNUM_SHAPES_EXPORT Plane {
         /** @brief %Collision occurence with line segment */
         bool operator%(const LineSegment3D& other) const;
 
+        /** @brief %Collision occurence with sphere */
+        bool operator%(const Sphere3D& other) const;
+
+        /**
+         * @brief %Collision with sphere
+         *
+         * The plane is separated to the side opposite to sphere center.
+         * Expects that the plane normal is normalized.
+         */
+        Collision3D operator/(const Sphere3D& other) const;
+
     private:
         Vector3 _position, _normal;
 };
@@ -92,6 +104,12 @@ inline bool operator%(const Line3D& a, const Plane& b) { return b % a; }
 /** @collisionoccurenceoperator{LineSegment,Plane} */
 inline bool operator%(const LineSegment3D& a, const Plane& b) { return b % a; }
 
+/** @collisionoccurenceoperator{Sphere,Plane} */
+inline bool operator%(const Sphere3D& a, const Plane& b) { return b % a; }
+
+/** @collisionoperator{Sphere,Plane} */
+inline Collision3D operator/(const Sphere3D& a, const Plane& b) { return (b/a).flipped(); }
+
 
 }}
 
@@ -0,0 +1,109 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "PointBatch.h"
+
+#include <Utility/Assert.h>
+
+#include "Shapes/AxisAlignedBox.h"
+#include "Shapes/Sphere.h"
+#include "Shapes/Implementation/BatchCollision.h"
+
+namespace Magnum { namespace Shapes {
+
+/* The bulk of the arrays is processed with SSE2 or AVX kernels, the remaining
+   elements with plain loops, which are also the fallback if SIMD isn't
+   available */
+
+template<UnsignedInt dimensions> void PointBatch<dimensions>::reserve(const std::size_t size) {
+    for(std::vector<Float>& positions: _positions) positions.reserve(size);
+}
+
+template<UnsignedInt dimensions> void PointBatch<dimensions>::clear() {
+    for(std::vector<Float>& positions: _positions) positions.clear();
+}
+
+template<UnsignedInt dimensions> PointBatch<dimensions>& PointBatch<dimensions>::add(const Point<dimensions>& point) {
+    for(UnsignedInt i = 0; i != dimensions; ++i)
+        _positions[i].push_back(point.position()[i]);
+    return *this;
+}
+
+template<UnsignedInt dimensions> Point<dimensions> PointBatch<dimensions>::operator[](const std::size_t i) const {
+    typename DimensionTraits<dimensions, Float>::VectorType position;
+    for(UnsignedInt j = 0; j != dimensions; ++j)
+        position[j] = _positions[j][i];
+    return {position};
+}
+
+template<UnsignedInt dimensions> void PointBatch<dimensions>::collides(const AxisAlignedBox<dimensions>& other, const std::size_t begin, const std::size_t end, UnsignedByte* const result) const {
+    CORRADE_ASSERT(begin <= end && end <= size(),
+        "Shapes::PointBatch::collides(): range from" << begin << "to" << end << "out of bounds for" << size() << "points", );
+
+    const Float* positions[dimensions];
+    Float min[dimensions], max[dimensions];
+    for(UnsignedInt j = 0; j != dimensions; ++j) {
+        positions[j] = _positions[j].data() + begin;
+        min[j] = other.min()[j];
+        max[j] = other.max()[j];
+    }
+
+    const std::size_t count = end - begin;
+    for(std::size_t i = Implementation::batchCollision<dimensions>().pointsInBox(positions, min, max, count, result); i != count; ++i) {
+        UnsignedByte inside = 1;
+        for(UnsignedInt j = 0; j != dimensions; ++j)
+            inside &= (positions[j][i] >= min[j]) & (positions[j][i] < max[j]);
+        result[i] = inside;
+    }
+}
+
+template<UnsignedInt dimensions> void PointBatch<dimensions>::collides(const Sphere<dimensions>& other, const std::size_t begin, const std::size_t end, UnsignedByte* const result) const {
+    CORRADE_ASSERT(begin <= end && end <= size(),
+        "Shapes::PointBatch::collides(): range from" << begin << "to" << end << "out of bounds for" << size() << "points", );
+
+    const Float* positions[dimensions];
+    Float center[dimensions];
+    for(UnsignedInt j = 0; j != dimensions; ++j) {
+        positions[j] = _positions[j].data() + begin;
+        center[j] = other.position()[j];
+    }
+    const Float radius = other.radius()*other.radius();
+
+    const std::size_t count = end - begin;
+    for(std::size_t i = Implementation::batchCollision<dimensions>().pointsInSphere(positions, center, radius, count, result); i != count; ++i) {
+        Float distance = 0.0f;
+        for(UnsignedInt j = 0; j != dimensions; ++j) {
+            const Float d = center[j] - positions[j][i];
+            distance += d*d;
+        }
+        result[i] = distance < radius;
+    }
+}
+
+#ifndef DOXYGEN_GENERATING_OUTPUT
+template class MAGNUM_SHAPES_EXPORT PointBatch<2>;
+template class MAGNUM_SHAPES_EXPORT PointBatch<3>;
+#endif
+
+}}
@@ -0,0 +1,134 @@
+#ifndef Magnum_Shapes_PointBatch_h
+#define Magnum_Shapes_PointBatch_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Class Magnum::Shapes::PointBatch, typedef Magnum::Shapes::PointBatch2D, Magnum::Shapes::PointBatch3D
+ */
+
+#include <vector>
+
+#include "Shapes/Point.h"
+#include "Shapes/Shapes.h"
+
+namespace Magnum { namespace Shapes {
+
+/**
+@brief Batch of points
+
+Stores positions of many points as structure of arrays, so collision of one
+shape with all of them can be done in one tight loop using SSE2 or AVX, if
+available. The results are the same as with AxisAlignedBox::operator%()
+and Sphere::operator%(). ShapeGroup uses the batch internally if all its
+bounded shapes are points. See @ref shapes for brief introduction.
+@see PointBatch2D, PointBatch3D, SphereBatch
+*/
+template<UnsignedInt dimensions> class MAGNUM_SHAPES_EXPORT PointBatch {
+    public:
+        enum: UnsignedInt {
+            Dimensions = dimensions /**< Dimension count */
+        };
+
+        /**
+         * @brief Default constructor
+         *
+         * Creates empty batch.
+         */
+        explicit PointBatch() = default;
+
+        /** @brief Count of points in the batch */
+        std::size_t size() const { return _positions[0].size(); }
+
+        /** @brief Whether the batch is empty */
+        bool isEmpty() const { return _positions[0].empty(); }
+
+        /** @brief Reserve memory for given count of points */
+        void reserve(std::size_t size);
+
+        /** @brief Remove all points from the batch */
+        void clear();
+
+        /**
+         * @brief Add point
+         * @return Reference to self (for method chaining)
+         */
+        PointBatch<dimensions>& add(const Point<dimensions>& point);
+
+        /** @brief Point at given position */
+        Point<dimensions> operator[](std::size_t i) const;
+
+        /**
+         * @brief Collision occurence with axis-aligned box
+         * @param other     Axis-aligned box
+         * @param begin     First point to test
+         * @param end       One past last point to test
+         * @param result    Result array of size `end - begin`, `1` is written
+         *      for each point inside the box, `0` otherwise
+         */
+        void collides(const AxisAlignedBox<dimensions>& other, std::size_t begin, std::size_t end, UnsignedByte* result) const;
+
+        /**
+         * @brief Collision occurence of all points with axis-aligned box
+         *
+         * The @p result is resized to size().
+         */
+        void collides(const AxisAlignedBox<dimensions>& other, std::vector<UnsignedByte>& result) const {
+            result.resize(size());
+            collides(other, 0, size(), result.data());
+        }
+
+        /**
+         * @brief Collision occurence with sphere
+         * @param other     Sphere
+         * @param begin     First point to test
+         * @param end       One past last point to test
+         * @param result    Result array of size `end - begin`, `1` is written
+         *      for each point inside the sphere, `0` otherwise
+         */
+        void collides(const Sphere<dimensions>& other, std::size_t begin, std::size_t end, UnsignedByte* result) const;
+
+        /**
+         * @brief Collision occurence of all points with sphere
+         *
+         * The @p result is resized to size().
+         */
+        void collides(const Sphere<dimensions>& other, std::vector<UnsignedByte>& result) const {
+            result.resize(size());
+            collides(other, 0, size(), result.data());
+        }
+
+    private:
+        std::vector<Float> _positions[dimensions];
+};
+
+/** @brief Batch of two-dimensional points */
+typedef PointBatch<2> PointBatch2D;
+
+/** @brief Batch of three-dimensional points */
+typedef PointBatch<3> PointBatch3D;
+
+}}
+
+#endif
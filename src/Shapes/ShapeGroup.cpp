@@ -24,11 +24,31 @@
 
 #include "ShapeGroup.h"
 
+#include <algorithm>
+#include <limits>
+
+#include "Math/Functions.h"
 #include "Shapes/AbstractShape.h"
+#include "Shapes/AxisAlignedBox.h"
+#include "Shapes/Implementation/CollisionDispatch.h"
 
 namespace Magnum { namespace Shapes {
 
+namespace {
+    template<UnsignedInt dimensions> inline bool overlaps(const Math::Range<dimensions, Float>& a, const Math::Range<dimensions, Float>& b) {
+        return (a.min() <= b.max()).all() && (b.min() <= a.max()).all();
+    }
+
+    template<UnsignedInt dimensions> inline bool isUnbounded(const Math::Range<dimensions, Float>& bounds, const UnsignedInt axis) {
+        return bounds.min()[axis] == -std::numeric_limits<Float>::infinity() ||
+               bounds.max()[axis] == std::numeric_limits<Float>::infinity();
+    }
+}
+
 template<UnsignedInt dimensions> void ShapeGroup<dimensions>::setClean() {
+    /* Nothing changed since last time */
+    if(!dirty) return;
+
     /* Clean all objects */
     if(!this->isEmpty()) {
         std::vector<SceneGraph::AbstractObject<dimensions, Float>*> objects(this->size());
@@ -38,16 +58,271 @@ template<UnsignedInt dimensions> void ShapeGroup<dimensions>::setClean() {
         SceneGraph::AbstractObject<dimensions, Float>::setClean(objects);
     }
 
+    updateBroadphase();
     dirty = false;
 }
 
+template<UnsignedInt dimensions> void ShapeGroup<dimensions>::updateBroadphase() {
+    /* Group contents changed, put everything into bounded list and classify
+       it below */
+    const bool rebuild = rebuildBroadphase;
+    if(rebuild) {
+        bounded.clear();
+        unbounded.clear();
+        for(std::size_t i = 0; i != this->size(); ++i)
+            bounded.push_back({&(*this)[i], i, {}});
+        rebuildBroadphase = false;
+    }
+
+    /* Update bounds of all shapes, move shapes which became (un)bounded to the
+       other list */
+    std::size_t out = 0;
+    for(std::size_t i = 0; i != unbounded.size(); ++i) {
+        Entry entry = unbounded[i];
+        entry.bounds = Implementation::getAbstractShape(*entry.shape).bounds();
+        if(isUnbounded(entry.bounds, axis)) unbounded[out++] = entry;
+        else bounded.push_back(entry);
+    }
+    unbounded.resize(out);
+    out = 0;
+    for(std::size_t i = 0; i != bounded.size(); ++i) {
+        Entry entry = bounded[i];
+        entry.bounds = Implementation::getAbstractShape(*entry.shape).bounds();
+        if(isUnbounded(entry.bounds, axis)) unbounded.push_back(entry);
+        else bounded[out++] = entry;
+    }
+    bounded.resize(out);
+
+    /* Shapes are unordered after rebuild, pick the axis along which the shapes
+       are spread the most and sort them */
+    if(rebuild) {
+        if(!bounded.empty()) {
+            typename DimensionTraits<dimensions, Float>::VectorType min = bounded.front().bounds.center(),
+                max = bounded.front().bounds.center();
+            for(const Entry& entry: bounded) {
+                min = Math::min(min, entry.bounds.center());
+                max = Math::max(max, entry.bounds.center());
+            }
+            const typename DimensionTraits<dimensions, Float>::VectorType spread = max - min;
+            const UnsignedInt previousAxis = axis;
+            for(UnsignedInt i = 0; i != dimensions; ++i)
+                if(spread[i] > spread[axis]) axis = i;
+
+            /* Reclassify the shapes if the axis changed */
+            if(axis != previousAxis) {
+                rebuildBroadphase = true;
+                return updateBroadphase();
+            }
+        }
+
+        std::sort(bounded.begin(), bounded.end(), [this](const Entry& a, const Entry& b) {
+            return a.bounds.min()[axis] < b.bounds.min()[axis];
+        });
+
+    /* Otherwise the shapes moved only a bit since last time, insertion sort is
+       linear on nearly sorted data */
+    } else for(std::size_t i = 1; i < bounded.size(); ++i) {
+        const Entry entry = bounded[i];
+        std::size_t j = i;
+        for(; j != 0 && bounded[j - 1].bounds.min()[axis] > entry.bounds.min()[axis]; --j)
+            bounded[j] = bounded[j - 1];
+        bounded[j] = entry;
+    }
+
+    /* Lower bounds and running maximum of upper bounds, used for finding
+       candidate range in firstCollision() and collisions() */
+    minima.resize(bounded.size());
+    maxima.resize(bounded.size());
+    Float maximum = -std::numeric_limits<Float>::infinity();
+    for(std::size_t i = 0; i != bounded.size(); ++i) {
+        minima[i] = bounded[i].bounds.min()[axis];
+        maxima[i] = maximum = std::max(maximum, bounded[i].bounds.max()[axis]);
+    }
+
+    /* If all bounded shapes are spheres or points, copy them into batch in
+       the sorted order */
+    spheres.clear();
+    points.clear();
+    if(bounded.empty()) return;
+    const typename AbstractShape<dimensions>::Type type = bounded.front().shape->type();
+    if(type != AbstractShape<dimensions>::Type::Sphere && type != AbstractShape<dimensions>::Type::Point)
+        return;
+    for(const Entry& entry: bounded)
+        if(entry.shape->type() != type) return;
+
+    if(type == AbstractShape<dimensions>::Type::Sphere) {
+        spheres.reserve(bounded.size());
+        for(const Entry& entry: bounded)
+            spheres.add(static_cast<const Implementation::Shape<Sphere<dimensions>>&>(Implementation::getAbstractShape(*entry.shape)).shape);
+    } else {
+        points.reserve(bounded.size());
+        for(const Entry& entry: bounded)
+            points.add(static_cast<const Implementation::Shape<Point<dimensions>>&>(Implementation::getAbstractShape(*entry.shape)).shape);
+    }
+}
+
+template<UnsignedInt dimensions> bool ShapeGroup<dimensions>::batchCollides(const Implementation::AbstractShape<dimensions>& shape, const std::size_t begin, const std::size_t end) {
+    batchResult.resize(end - begin);
+
+    if(!spheres.isEmpty()) {
+        if(shape.type() == AbstractShape<dimensions>::Type::Sphere)
+            spheres.collides(static_cast<const Implementation::Shape<Sphere<dimensions>>&>(shape).shape, begin, end, batchResult.data());
+        else if(shape.type() == AbstractShape<dimensions>::Type::Point)
+            spheres.collides(static_cast<const Implementation::Shape<Point<dimensions>>&>(shape).shape, begin, end, batchResult.data());
+        else return false;
+        return true;
+    }
+
+    if(!points.isEmpty()) {
+        if(shape.type() == AbstractShape<dimensions>::Type::Sphere)
+            points.collides(static_cast<const Implementation::Shape<Sphere<dimensions>>&>(shape).shape, begin, end, batchResult.data());
+        else if(shape.type() == AbstractShape<dimensions>::Type::AxisAlignedBox)
+            points.collides(static_cast<const Implementation::Shape<AxisAlignedBox<dimensions>>&>(shape).shape, begin, end, batchResult.data());
+        else return false;
+        return true;
+    }
+
+    return false;
+}
+
+template<UnsignedInt dimensions> ShapeGroup<dimensions>& ShapeGroup<dimensions>::add(AbstractShape<dimensions>& shape) {
+    /* The shape will be removed from the previous group */
+    if(shape.group() && shape.group() != this)
+        shape.group()->dirty = shape.group()->rebuildBroadphase = true;
+
+    SceneGraph::FeatureGroup<dimensions, AbstractShape<dimensions>, Float>::add(shape);
+    dirty = rebuildBroadphase = true;
+    return *this;
+}
+
+template<UnsignedInt dimensions> ShapeGroup<dimensions>& ShapeGroup<dimensions>::remove(AbstractShape<dimensions>& shape) {
+    SceneGraph::FeatureGroup<dimensions, AbstractShape<dimensions>, Float>::remove(shape);
+    dirty = rebuildBroadphase = true;
+    return *this;
+}
+
 template<UnsignedInt dimensions> AbstractShape<dimensions>* ShapeGroup<dimensions>::firstCollision(const AbstractShape<dimensions>& shape) {
     setClean();
-    for(std::size_t i = 0; i != this->size(); ++i)
-        if(&(*this)[i] != &shape && (*this)[i].collides(shape))
-            return &(*this)[i];
 
-    return nullptr;
+    const Math::Range<dimensions, Float> bounds = Implementation::getAbstractShape(shape).bounds();
+    AbstractShape<dimensions>* first = nullptr;
+    std::size_t firstIndex = ~std::size_t(0);
+    auto test = [&](const Entry& entry) {
+        if(entry.index < firstIndex && entry.shape != &shape && overlaps(entry.bounds, bounds) && entry.shape->collides(shape)) {
+            first = entry.shape;
+            firstIndex = entry.index;
+        }
+    };
+
+    for(const Entry& entry: unbounded) test(entry);
+
+    /* Unbounded query needs to be tested against everything */
+    if(isUnbounded(bounds, axis)) {
+        for(const Entry& entry: bounded) test(entry);
+
+    /* Otherwise test only shapes which can overlap the query along the axis.
+       Shapes before the first running maximum larger than query minimum end
+       before the query, shapes after the first minimum larger than query
+       maximum begin after it. */
+    } else {
+        const std::size_t begin = std::lower_bound(maxima.begin(), maxima.end(), bounds.min()[axis]) - maxima.begin();
+        const std::size_t end = std::upper_bound(minima.begin() + begin, minima.end(), bounds.max()[axis]) - minima.begin();
+
+        /* Test the whole range at once if possible */
+        if(batchCollides(Implementation::getAbstractShape(shape), begin, end)) {
+            for(std::size_t i = begin; i != end; ++i) {
+                const Entry& entry = bounded[i];
+                if(batchResult[i - begin] && entry.index < firstIndex && entry.shape != &shape) {
+                    first = entry.shape;
+                    firstIndex = entry.index;
+                }
+            }
+
+        } else for(std::size_t i = begin; i != end; ++i) test(bounded[i]);
+    }
+
+    return first;
+}
+
+template<UnsignedInt dimensions> std::pair<AbstractShape<dimensions>*, Float> ShapeGroup<dimensions>::firstImpactImplementation(const Implementation::AbstractShape<dimensions>& startShape, const Implementation::AbstractShape<dimensions>& endShape, const AbstractShape<dimensions>* const ignored) {
+    setClean();
+
+    /* Bounds of the whole motion */
+    const Math::Range<dimensions, Float> startBounds = startShape.bounds();
+    const Math::Range<dimensions, Float> endBounds = endShape.bounds();
+    const Math::Range<dimensions, Float> bounds{Math::min(startBounds.min(), endBounds.min()), Math::max(startBounds.max(), endBounds.max())};
+
+    AbstractShape<dimensions>* first = nullptr;
+    std::size_t firstIndex = ~std::size_t(0);
+    Float firstTime = std::numeric_limits<Float>::infinity();
+    auto test = [&](const Entry& entry) {
+        if(entry.shape == ignored || !overlaps(entry.bounds, bounds)) return;
+
+        /* The other shape is static */
+        const Implementation::AbstractShape<dimensions>& other = Implementation::getAbstractShape(*entry.shape);
+        const Float time = Implementation::timeOfImpact(startShape, endShape, other, other);
+        if(time > 1.0f || time > firstTime || (time == firstTime && entry.index > firstIndex)) return;
+
+        first = entry.shape;
+        firstIndex = entry.index;
+        firstTime = time;
+    };
+
+    for(const Entry& entry: unbounded) test(entry);
+
+    /* Candidate range the same as in firstCollision() */
+    if(isUnbounded(bounds, axis)) {
+        for(const Entry& entry: bounded) test(entry);
+    } else {
+        const std::size_t begin = std::lower_bound(maxima.begin(), maxima.end(), bounds.min()[axis]) - maxima.begin();
+        const std::size_t end = std::upper_bound(minima.begin() + begin, minima.end(), bounds.max()[axis]) - minima.begin();
+        for(std::size_t i = begin; i != end; ++i) test(bounded[i]);
+    }
+
+    return {first, firstTime};
+}
+
+template<UnsignedInt dimensions> std::vector<std::pair<AbstractShape<dimensions>*, AbstractShape<dimensions>*>> ShapeGroup<dimensions>::collisions() {
+    setClean();
+
+    std::vector<std::pair<std::size_t, std::size_t>> pairs;
+    auto test = [&pairs](const Entry& a, const Entry& b) {
+        if(!overlaps(a.bounds, b.bounds)) return;
+        const Entry& first = a.index < b.index ? a : b;
+        const Entry& second = a.index < b.index ? b : a;
+        if(first.shape->collides(*second.shape))
+            pairs.emplace_back(first.index, second.index);
+    };
+
+    /* Sweep along the axis, each shape is tested only with shapes beginning
+       before its end */
+    for(std::size_t i = 0; i != bounded.size(); ++i) {
+        const Float max = bounded[i].bounds.max()[axis];
+        std::size_t end = i + 1;
+        while(end != bounded.size() && minima[end] <= max) ++end;
+
+        /* Test the whole range at once if possible */
+        if(batchCollides(Implementation::getAbstractShape(*bounded[i].shape), i + 1, end)) {
+            for(std::size_t j = i + 1; j != end; ++j) if(batchResult[j - i - 1])
+                pairs.emplace_back(std::min(bounded[i].index, bounded[j].index), std::max(bounded[i].index, bounded[j].index));
+
+        } else for(std::size_t j = i + 1; j != end; ++j) test(bounded[i], bounded[j]);
+    }
+
+    /* Unbounded shapes with everything */
+    for(std::size_t i = 0; i != unbounded.size(); ++i) {
+        for(const Entry& entry: bounded) test(unbounded[i], entry);
+        for(std::size_t j = i + 1; j != unbounded.size(); ++j)
+            test(unbounded[i], unbounded[j]);
+    }
+
+    std::sort(pairs.begin(), pairs.end());
+
+    std::vector<std::pair<AbstractShape<dimensions>*, AbstractShape<dimensions>*>> out;
+    out.reserve(pairs.size());
+    for(const auto& pair: pairs)
+        out.emplace_back(&(*this)[pair.first], &(*this)[pair.second]);
+    return out;
 }
 
 #ifndef DOXYGEN_GENERATING_OUTPUT
@@ -28,9 +28,13 @@
  * @brief Class Magnum::Shapes::ShapeGroup, typedef Magnum::Shapes::ShapeGroup2D, Magnum::Shapes::ShapeGroup3D
  */
 
+#include <utility>
 #include <vector>
 
+#include "Math/Range.h"
 #include "Shapes/AbstractShape.h"
+#include "Shapes/PointBatch.h"
+#include "Shapes/SphereBatch.h"
 #include "SceneGraph/FeatureGroup.h"
 
 #include "magnumShapesVisibility.h"
@@ -41,6 +45,25 @@ namespace Magnum { namespace Shapes {
 @brief Group of shapes
 
 See Shape for more information. See @ref shapes for brief introduction.
+
+@section ShapeGroup-broadphase Broadphase
+
+The group keeps axis-aligned bounds of all its shapes sorted along one axis
+(sweep and prune). The bounds are recomputed in setClean() if the group is
+dirty, the order from previous call is kept and only fixed with insertion
+sort, so for shapes which don't move much between calls the update is
+linear. firstCollision() and firstImpact() then test only shapes with
+overlapping bounds and collisions() finds all colliding pairs in about
+`O(n + k)` time, where `k` is count of pairs with overlapping bounds.
+Unbounded shapes (lines, planes, cylinders, inverted spheres and compositions
+with boolean NOT) are tested always.
+
+If all bounded shapes in the group are spheres or all are points, they are
+additionally copied into SphereBatch or PointBatch in the sorted order and
+the candidates are tested in batches. That is done for sphere and point
+queries in groups of spheres and for sphere and axis-aligned box queries in
+groups of points.
+
 @see @ref scenegraph, ShapeGroup2D, ShapeGroup3D
 */
 template<UnsignedInt dimensions> class MAGNUM_SHAPES_EXPORT ShapeGroup: public SceneGraph::FeatureGroup<dimensions, AbstractShape<dimensions>, Float> {
@@ -52,7 +75,7 @@ template<UnsignedInt dimensions> class MAGNUM_SHAPES_EXPORT ShapeGroup: public S
          *
          * Marks the group as dirty.
          */
-        explicit ShapeGroup(): dirty(true) {}
+        explicit ShapeGroup(): dirty(true), rebuildBroadphase(true), axis(0) {}
 
         /**
          * @brief Whether the group is dirty
@@ -75,21 +98,112 @@ template<UnsignedInt dimensions> class MAGNUM_SHAPES_EXPORT ShapeGroup: public S
          * @brief Set the group and all bodies as clean
          *
          * This function is called before computing any collisions to ensure
-         * all objects are cleaned.
+         * all objects are cleaned. If the group is dirty, also updates the
+         * broadphase.
          */
         void setClean();
 
+        /**
+         * @brief Add shape to the group
+         * @return Reference to self (for method chaining)
+         *
+         * Marks the group as dirty. If the shape is part of another group, it
+         * is removed from it.
+         */
+        ShapeGroup<dimensions>& add(AbstractShape<dimensions>& shape);
+
+        /**
+         * @brief Remove shape from the group
+         * @return Reference to self (for method chaining)
+         *
+         * The shape must be part of the group. Marks the group as dirty.
+         */
+        ShapeGroup<dimensions>& remove(AbstractShape<dimensions>& shape);
+
         /**
          * @brief First collision of given shape with other shapes in the group
          *
-         * Returns first shape colliding with given one. If there aren't any
-         * collisions, returns `nullptr`. Calls setClean() before the
-         * operation.
+         * Returns first shape (in order in which they were added to the
+         * group) colliding with given one. If there aren't any collisions,
+         * returns `nullptr`. Calls setClean() before the operation.
          */
         AbstractShape<dimensions>* firstCollision(const AbstractShape<dimensions>& shape);
 
+        /**
+         * @brief All collisions in the group
+         *
+         * Returns all pairs of colliding shapes in the group. In each pair the
+         * first shape is the one added to the group earlier, the pairs are
+         * ordered by the first and then by the second shape. Calls
+         * setClean() before the operation.
+         */
+        std::vector<std::pair<AbstractShape<dimensions>*, AbstractShape<dimensions>*>> collisions();
+
+        /**
+         * @brief First impact of moving shape with other shapes in the group
+         * @param shape     Shape in its own coordinate system
+         * @param start     Absolute transformation of the shape at the
+         *      beginning of the motion
+         * @param end       Absolute transformation of the shape at the end
+         *      of the motion
+         * @return Shape hit first and time of impact as fraction of the
+         *      motion, or `nullptr` and infinity if the shape doesn't hit
+         *      anything.
+         *
+         * Other shapes in the group are considered to be static at their
+         * current absolute transformation. Uses timeOfImpact() for pairs
+         * which have it implemented, other pairs are tested only for
+         * collision at the beginning and at the end of the motion, which
+         * gives time `0` or `1`. If more shapes are hit at the same time,
+         * returns the one which was added to the group first. Only shapes
+         * overlapping union of bounds of the shape at the beginning and at
+         * the end of the motion are tested. Calls setClean() before the
+         * operation. Example usage, moving the object only as far as it
+         * can go:
+         * @code
+         * Shapes::ShapeGroup3D shapes;
+         * Object3D* bullet;
+         * Matrix4 end = bullet->absoluteTransformationMatrix()*Matrix4::translation(velocity*timestep);
+         *
+         * auto impact = shapes.firstImpact(Shapes::Sphere3D({}, 0.05f), bullet->absoluteTransformationMatrix(), end);
+         * if(impact.first) {
+         *     // move only to the time of impact and resolve the hit
+         * }
+         * @endcode
+         */
+        template<class T> std::pair<AbstractShape<dimensions>*, Float> firstImpact(const T& shape, const typename DimensionTraits<dimensions, Float>::MatrixType& start, const typename DimensionTraits<dimensions, Float>::MatrixType& end) {
+            return firstImpactImplementation(Implementation::Shape<T>(shape.transformed(start)), Implementation::Shape<T>(shape.transformed(end)), nullptr);
+        }
+
+        /**
+         * @brief First impact of moving shape feature with other shapes in the group
+         *
+         * Same as above, but the shape is taken from given feature and the
+         * feature itself is not tested if it is part of the group.
+         */
+        template<class T> std::pair<AbstractShape<dimensions>*, Float> firstImpact(const Shape<T>& shape, const typename DimensionTraits<dimensions, Float>::MatrixType& start, const typename DimensionTraits<dimensions, Float>::MatrixType& end) {
+            return firstImpactImplementation(Implementation::Shape<T>(shape.shape().transformed(start)), Implementation::Shape<T>(shape.shape().transformed(end)), &shape);
+        }
+
     private:
-        bool dirty;
+        struct Entry {
+            AbstractShape<dimensions>* shape;
+            std::size_t index;
+            Math::Range<dimensions, Float> bounds;
+        };
+
+        std::pair<AbstractShape<dimensions>*, Float> firstImpactImplementation(const Implementation::AbstractShape<dimensions>& startShape, const Implementation::AbstractShape<dimensions>& endShape, const AbstractShape<dimensions>* ignored);
+
+        void MAGNUM_SHAPES_LOCAL updateBroadphase();
+        bool MAGNUM_SHAPES_LOCAL batchCollides(const Implementation::AbstractShape<dimensions>& shape, std::size_t begin, std::size_t end);
+
+        bool dirty, rebuildBroadphase;
+        UnsignedInt axis;
+        std::vector<Entry> bounded, unbounded;
+        std::vector<Float> minima, maxima;
+        SphereBatch<dimensions> spheres;
+        PointBatch<dimensions> points;
+        std::vector<UnsignedByte> batchResult;
 };
 
 /**
@@ -78,6 +78,10 @@ template<UnsignedInt> class Sphere;
 typedef Sphere<2> Sphere2D;
 typedef Sphere<3> Sphere3D;
 
+template<UnsignedInt> class SphereBatch;
+typedef SphereBatch<2> SphereBatch2D;
+typedef SphereBatch<3> SphereBatch3D;
+
 template<UnsignedInt> class InvertedSphere;
 typedef InvertedSphere<2> InvertedSphere2D;
 typedef InvertedSphere<3> InvertedSphere3D;
@@ -88,6 +92,10 @@ template<UnsignedInt> class Point;
 typedef Point<2> Point2D;
 typedef Point<3> Point3D;
 
+template<UnsignedInt> class PointBatch;
+typedef PointBatch<2> PointBatch2D;
+typedef PointBatch<3> PointBatch3D;
+
 }}
 
 #endif
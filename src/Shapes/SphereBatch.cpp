@@ -0,0 +1,115 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "SphereBatch.h"
+
+#include <Utility/Assert.h>
+
+#include "Shapes/Point.h"
+#include "Shapes/Implementation/BatchCollision.h"
+
+namespace Magnum { namespace Shapes {
+
+/* The bulk of the arrays is processed with SSE2 or AVX kernels, the remaining
+   elements with plain loops, which are also the fallback if SIMD isn't
+   available */
+
+template<UnsignedInt dimensions> void SphereBatch<dimensions>::reserve(const std::size_t size) {
+    for(std::vector<Float>& positions: _positions) positions.reserve(size);
+    _radii.reserve(size);
+}
+
+template<UnsignedInt dimensions> void SphereBatch<dimensions>::clear() {
+    for(std::vector<Float>& positions: _positions) positions.clear();
+    _radii.clear();
+}
+
+template<UnsignedInt dimensions> SphereBatch<dimensions>& SphereBatch<dimensions>::add(const Sphere<dimensions>& sphere) {
+    for(UnsignedInt i = 0; i != dimensions; ++i)
+        _positions[i].push_back(sphere.position()[i]);
+    _radii.push_back(sphere.radius());
+    return *this;
+}
+
+template<UnsignedInt dimensions> Sphere<dimensions> SphereBatch<dimensions>::operator[](const std::size_t i) const {
+    typename DimensionTraits<dimensions, Float>::VectorType position;
+    for(UnsignedInt j = 0; j != dimensions; ++j)
+        position[j] = _positions[j][i];
+    return {position, _radii[i]};
+}
+
+template<UnsignedInt dimensions> void SphereBatch<dimensions>::collides(const Point<dimensions>& other, const std::size_t begin, const std::size_t end, UnsignedByte* const result) const {
+    CORRADE_ASSERT(begin <= end && end <= size(),
+        "Shapes::SphereBatch::collides(): range from" << begin << "to" << end << "out of bounds for" << size() << "spheres", );
+
+    const Float* positions[dimensions];
+    Float point[dimensions];
+    for(UnsignedInt j = 0; j != dimensions; ++j) {
+        positions[j] = _positions[j].data() + begin;
+        point[j] = other.position()[j];
+    }
+    const Float* const radii = _radii.data() + begin;
+
+    const std::size_t count = end - begin;
+    for(std::size_t i = Implementation::batchCollision<dimensions>().spheres(positions, radii, point, 0.0f, count, result); i != count; ++i) {
+        Float distance = 0.0f;
+        for(UnsignedInt j = 0; j != dimensions; ++j) {
+            const Float d = positions[j][i] - point[j];
+            distance += d*d;
+        }
+        result[i] = distance < radii[i]*radii[i];
+    }
+}
+
+template<UnsignedInt dimensions> void SphereBatch<dimensions>::collides(const Sphere<dimensions>& other, const std::size_t begin, const std::size_t end, UnsignedByte* const result) const {
+    CORRADE_ASSERT(begin <= end && end <= size(),
+        "Shapes::SphereBatch::collides(): range from" << begin << "to" << end << "out of bounds for" << size() << "spheres", );
+
+    const Float* positions[dimensions];
+    Float center[dimensions];
+    for(UnsignedInt j = 0; j != dimensions; ++j) {
+        positions[j] = _positions[j].data() + begin;
+        center[j] = other.position()[j];
+    }
+    const Float* const radii = _radii.data() + begin;
+    const Float radius = other.radius();
+
+    const std::size_t count = end - begin;
+    for(std::size_t i = Implementation::batchCollision<dimensions>().spheres(positions, radii, center, radius, count, result); i != count; ++i) {
+        Float distance = 0.0f;
+        for(UnsignedInt j = 0; j != dimensions; ++j) {
+            const Float d = positions[j][i] - center[j];
+            distance += d*d;
+        }
+        const Float maxDistance = radii[i] + radius;
+        result[i] = distance < maxDistance*maxDistance;
+    }
+}
+
+#ifndef DOXYGEN_GENERATING_OUTPUT
+template class MAGNUM_SHAPES_EXPORT SphereBatch<2>;
+template class MAGNUM_SHAPES_EXPORT SphereBatch<3>;
+#endif
+
+}}
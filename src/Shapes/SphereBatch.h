@@ -0,0 +1,142 @@
+#ifndef Magnum_Shapes_SphereBatch_h
+#define Magnum_Shapes_SphereBatch_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Class Magnum::Shapes::SphereBatch, typedef Magnum::Shapes::SphereBatch2D, Magnum::Shapes::SphereBatch3D
+ */
+
+#include <vector>
+
+#include "Shapes/Sphere.h"
+
+namespace Magnum { namespace Shapes {
+
+/**
+@brief Batch of spheres
+
+Stores positions and radii of many spheres as structure of arrays, so
+collision of one shape with all of them can be done in one tight loop using
+SSE2 or AVX, if available. The results are the same as with
+Sphere::operator%(). ShapeGroup uses the batch internally if all its bounded
+shapes are spheres. See @ref shapes for brief introduction.
+@code
+Shapes::SphereBatch3D spheres;
+spheres.add({{1.0f, 0.0f, 0.0f}, 0.5f})
+       .add({{3.0f, 1.0f, 0.0f}, 1.0f});
+
+std::vector<UnsignedByte> colliding;
+spheres.collides(Shapes::Sphere3D({}, 1.0f), colliding); // {1, 0}
+@endcode
+@see SphereBatch2D, SphereBatch3D, PointBatch
+*/
+template<UnsignedInt dimensions> class MAGNUM_SHAPES_EXPORT SphereBatch {
+    public:
+        enum: UnsignedInt {
+            Dimensions = dimensions /**< Dimension count */
+        };
+
+        /**
+         * @brief Default constructor
+         *
+         * Creates empty batch.
+         */
+        explicit SphereBatch() = default;
+
+        /** @brief Count of spheres in the batch */
+        std::size_t size() const { return _radii.size(); }
+
+        /** @brief Whether the batch is empty */
+        bool isEmpty() const { return _radii.empty(); }
+
+        /** @brief Reserve memory for given count of spheres */
+        void reserve(std::size_t size);
+
+        /** @brief Remove all spheres from the batch */
+        void clear();
+
+        /**
+         * @brief Add sphere
+         * @return Reference to self (for method chaining)
+         */
+        SphereBatch<dimensions>& add(const Sphere<dimensions>& sphere);
+
+        /** @brief Sphere at given position */
+        Sphere<dimensions> operator[](std::size_t i) const;
+
+        /**
+         * @brief Collision occurence with point
+         * @param other     Point
+         * @param begin     First sphere to test
+         * @param end       One past last sphere to test
+         * @param result    Result array of size `end - begin`, `1` is written
+         *      for each sphere containing the point, `0` otherwise
+         */
+        void collides(const Point<dimensions>& other, std::size_t begin, std::size_t end, UnsignedByte* result) const;
+
+        /**
+         * @brief Collision occurence of all spheres with point
+         *
+         * The @p result is resized to size().
+         */
+        void collides(const Point<dimensions>& other, std::vector<UnsignedByte>& result) const {
+            result.resize(size());
+            collides(other, 0, size(), result.data());
+        }
+
+        /**
+         * @brief Collision occurence with sphere
+         * @param other     Sphere
+         * @param begin     First sphere to test
+         * @param end       One past last sphere to test
+         * @param result    Result array of size `end - begin`, `1` is written
+         *      for each sphere colliding with @p other, `0` otherwise
+         */
+        void collides(const Sphere<dimensions>& other, std::size_t begin, std::size_t end, UnsignedByte* result) const;
+
+        /**
+         * @brief Collision occurence of all spheres with sphere
+         *
+         * The @p result is resized to size().
+         */
+        void collides(const Sphere<dimensions>& other, std::vector<UnsignedByte>& result) const {
+            result.resize(size());
+            collides(other, 0, size(), result.data());
+        }
+
+    private:
+        std::vector<Float> _positions[dimensions];
+        std::vector<Float> _radii;
+};
+
+/** @brief Batch of two-dimensional spheres */
+typedef SphereBatch<2> SphereBatch2D;
+
+/** @brief Batch of three-dimensional spheres */
+typedef SphereBatch<3> SphereBatch3D;
+
+}}
+
+#endif
@@ -0,0 +1,124 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <chrono>
+#include <memory>
+#include <random>
+#include <TestSuite/Tester.h>
+
+#include "Magnum.h"
+#include "Shapes/AxisAlignedBox.h"
+#include "Shapes/PointBatch.h"
+#include "Shapes/SphereBatch.h"
+#include "Shapes/shapeImplementation.h"
+#include "Shapes/Implementation/CollisionDispatch.h"
+
+namespace Magnum { namespace Shapes { namespace Test {
+
+class BatchBenchmark: public TestSuite::Tester {
+    public:
+        BatchBenchmark();
+
+        void sphereSpheres();
+        void boxPoints();
+};
+
+namespace {
+    enum: std::size_t { Count = 100000, Repeats = 20 };
+
+    typedef std::chrono::high_resolution_clock Clock;
+}
+
+BatchBenchmark::BatchBenchmark() {
+    addTests({&BatchBenchmark::sphereSpheres,
+              &BatchBenchmark::boxPoints});
+}
+
+void BatchBenchmark::sphereSpheres() {
+    std::mt19937 random;
+    std::uniform_real_distribution<Float> position(-50.0f, 50.0f);
+
+    SphereBatch3D batch;
+    std::vector<std::unique_ptr<Implementation::AbstractShape<3>>> shapes;
+    for(std::size_t i = 0; i != Count; ++i) {
+        const Sphere3D sphere({position(random), position(random), position(random)}, 1.0f);
+        batch.add(sphere);
+        shapes.emplace_back(new Implementation::Shape<Sphere3D>(sphere));
+    }
+
+    const Implementation::Shape<Sphere3D> query(Sphere3D({}, 20.0f));
+
+    /* Per-pair dispatch, as done by ShapeGroup */
+    std::vector<UnsignedByte> dispatchResult(Count);
+    const auto dispatchBegin = Clock::now();
+    for(std::size_t r = 0; r != Repeats; ++r)
+        for(std::size_t i = 0; i != Count; ++i)
+            dispatchResult[i] = Implementation::collides(*shapes[i], query);
+    const auto dispatchTime = Clock::now() - dispatchBegin;
+
+    /* Batch */
+    std::vector<UnsignedByte> batchResult;
+    const auto batchBegin = Clock::now();
+    for(std::size_t r = 0; r != Repeats; ++r)
+        batch.collides(query.shape, batchResult);
+    const auto batchTime = Clock::now() - batchBegin;
+
+    Debug() << "Sphere with" << Count << "spheres, dispatch:" << std::chrono::duration<Double, std::micro>(dispatchTime).count()/Repeats << "us, batch:" << std::chrono::duration<Double, std::micro>(batchTime).count()/Repeats << "us";
+}
+
+void BatchBenchmark::boxPoints() {
+    std::mt19937 random;
+    std::uniform_real_distribution<Float> position(-50.0f, 50.0f);
+
+    PointBatch3D batch;
+    std::vector<std::unique_ptr<Implementation::AbstractShape<3>>> shapes;
+    for(std::size_t i = 0; i != Count; ++i) {
+        const Point3D point({position(random), position(random), position(random)});
+        batch.add(point);
+        shapes.emplace_back(new Implementation::Shape<Point3D>(point));
+    }
+
+    const Implementation::Shape<AxisAlignedBox3D> query(AxisAlignedBox3D({-10.0f, -20.0f, -30.0f}, {30.0f, 20.0f, 10.0f}));
+
+    /* Per-pair dispatch, as done by ShapeGroup */
+    std::vector<UnsignedByte> dispatchResult(Count);
+    const auto dispatchBegin = Clock::now();
+    for(std::size_t r = 0; r != Repeats; ++r)
+        for(std::size_t i = 0; i != Count; ++i)
+            dispatchResult[i] = Implementation::collides(*shapes[i], query);
+    const auto dispatchTime = Clock::now() - dispatchBegin;
+
+    /* Batch */
+    std::vector<UnsignedByte> batchResult;
+    const auto batchBegin = Clock::now();
+    for(std::size_t r = 0; r != Repeats; ++r)
+        batch.collides(query.shape, batchResult);
+    const auto batchTime = Clock::now() - batchBegin;
+
+    Debug() << "Box with" << Count << "points, dispatch:" << std::chrono::duration<Double, std::micro>(dispatchTime).count()/Repeats << "us, batch:" << std::chrono::duration<Double, std::micro>(batchTime).count()/Repeats << "us";
+}
+
+}}}
+
+CORRADE_TEST_MAIN(Magnum::Shapes::Test::BatchBenchmark)
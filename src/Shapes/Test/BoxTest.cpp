@@ -22,11 +22,13 @@
     DEALINGS IN THE SOFTWARE.
 */
 
-#include <TestSuite/Tester.h>
-
+#include "Math/Matrix3.h"
 #include "Math/Matrix4.h"
 #include "Magnum.h"
 #include "Shapes/Box.h"
+#include "Shapes/Sphere.h"
+
+#include "ShapeTestBase.h"
 
 namespace Magnum { namespace Shapes { namespace Test {
 
@@ -35,10 +37,14 @@ class BoxTest: public TestSuite::Tester {
         BoxTest();
 
         void transformed();
+        void collisionSphere();
+        void collisionBox();
 };
 
 BoxTest::BoxTest() {
-    addTests({&BoxTest::transformed});
+    addTests({&BoxTest::transformed,
+              &BoxTest::collisionSphere,
+              &BoxTest::collisionBox});
 }
 
 void BoxTest::transformed() {
@@ -47,6 +53,78 @@ void BoxTest::transformed() {
     CORRADE_COMPARE(box.transformation(), Matrix4::scaling({2.0f, -1.0f, 1.5f})*Matrix4::translation({1.0f, 2.0f, -3.0f}));
 }
 
+void BoxTest::collisionSphere() {
+    const Shapes::Box3D box(Matrix4::translation({1.0f, 0.0f, 0.0f})*Matrix4::scaling({1.0f, 2.0f, 1.0f}));
+    const Shapes::Sphere3D sphere({2.5f, 0.0f, 0.0f}, 1.0f);
+    const Shapes::Sphere3D sphere1({1.8f, 0.5f, 0.0f}, 0.25f);
+    const Shapes::Sphere3D sphere2({3.5f, 0.0f, 0.0f}, 1.0f);
+
+    VERIFY_COLLIDES(box, sphere);
+    VERIFY_COLLIDES(box, sphere1);
+    VERIFY_NOT_COLLIDES(box, sphere2);
+
+    /* Sphere center outside */
+    const Shapes::Collision3D collision = box/sphere;
+    CORRADE_COMPARE(collision.position(), Vector3(1.5f, 0.0f, 0.0f));
+    CORRADE_COMPARE(collision.separationNormal(), -Vector3::xAxis());
+    CORRADE_COMPARE(collision.separationDistance(), 0.5f);
+
+    /* Collision, flipped */
+    CORRADE_COMPARE((sphere/box).separationNormal(), Vector3::xAxis());
+
+    /* Sphere center inside, separated through the nearest face */
+    const Shapes::Collision3D collision1 = box/sphere1;
+    CORRADE_COMPARE(collision1.position(), Vector3(1.55f, 0.5f, 0.0f));
+    CORRADE_COMPARE(collision1.separationNormal(), -Vector3::xAxis());
+    CORRADE_COMPARE(collision1.separationDistance(), 0.45f);
+
+    /* No collision */
+    CORRADE_VERIFY(!(box/sphere2));
+
+    /* Rotated box, the sphere is inside its axis-aligned bounds */
+    const Shapes::Box2D box2(Matrix3::rotation(Deg(45.0f)));
+    const Shapes::Sphere2D sphere3({1.2f, 1.2f}, 0.3f);
+    const Shapes::Sphere2D sphere4({Constants::sqrt2() + 0.5f, 0.0f}, 1.0f);
+    VERIFY_NOT_COLLIDES(box2, sphere3);
+    VERIFY_COLLIDES(box2, sphere4);
+    CORRADE_COMPARE((box2/sphere4).separationNormal(), -Vector2::xAxis());
+    CORRADE_COMPARE((box2/sphere4).separationDistance(), 0.5f);
+}
+
+void BoxTest::collisionBox() {
+    const Shapes::Box3D box(Matrix4{});
+    const Shapes::Box3D box1(Matrix4::translation({1.5f, 0.5f, 0.0f}));
+    const Shapes::Box3D box2(Matrix4::translation({2.3f, 0.0f, 0.0f})*Matrix4::rotationZ(Deg(45.0f)));
+    const Shapes::Box3D box3(Matrix4::translation({2.5f, 0.0f, 0.0f})*Matrix4::rotationZ(Deg(45.0f)));
+
+    VERIFY_COLLIDES(box, box1);
+    VERIFY_COLLIDES(box, box2);
+    VERIFY_NOT_COLLIDES(box, box3);
+
+    /* Contact on face of the other box */
+    const Shapes::Collision3D collision = box/box1;
+    CORRADE_COMPARE(collision.position(), Vector3(0.5f, 0.0f, 0.0f));
+    CORRADE_COMPARE(collision.separationNormal(), -Vector3::xAxis());
+    CORRADE_COMPARE(collision.separationDistance(), 0.5f);
+
+    /* Collision, flipped */
+    CORRADE_COMPARE((box1/box).separationNormal(), Vector3::xAxis());
+
+    /* Corner of rotated box */
+    const Shapes::Collision3D collision1 = box/box2;
+    CORRADE_COMPARE(collision1.separationNormal(), -Vector3::xAxis());
+    CORRADE_COMPARE(collision1.separationDistance(), Constants::sqrt2() - 1.3f);
+
+    /* No collision */
+    CORRADE_VERIFY(!(box/box3));
+
+    /* The boxes overlap on axes of the first box, but are separated along
+       the second box axis */
+    const Shapes::Box2D box4(Matrix3{});
+    const Shapes::Box2D box5(Matrix3::translation({1.9f, 1.9f})*Matrix3::rotation(Deg(45.0f)));
+    VERIFY_NOT_COLLIDES(box4, box5);
+}
+
 }}}
 
 CORRADE_TEST_MAIN(Magnum::Shapes::Test::BoxTest)
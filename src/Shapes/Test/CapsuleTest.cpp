@@ -41,12 +41,14 @@ class CapsuleTest: public TestSuite::Tester {
         void transformedAverageScaling();
         void collisionPoint();
         void collisionSphere();
+        void collisionCapsule();
 };
 
 CapsuleTest::CapsuleTest() {
     addTests({&CapsuleTest::transformed,
               &CapsuleTest::collisionPoint,
-              &CapsuleTest::collisionSphere});
+              &CapsuleTest::collisionSphere,
+              &CapsuleTest::collisionCapsule});
 }
 
 void CapsuleTest::transformed() {
@@ -67,6 +69,20 @@ void CapsuleTest::collisionPoint() {
     VERIFY_COLLIDES(capsule, point);
     VERIFY_COLLIDES(capsule, point1);
     VERIFY_NOT_COLLIDES(capsule, point2);
+
+    /* Collision */
+    const Shapes::Capsule3D capsule2({-1.0f, 0.0f, 0.0f}, {1.0f, 0.0f, 0.0f}, 1.0f);
+    const Shapes::Point3D point3({0.5f, 0.75f, 0.0f});
+    const Shapes::Collision3D collision = capsule2/point3;
+    CORRADE_COMPARE(collision.position(), point3.position());
+    CORRADE_COMPARE(collision.separationNormal(), -Vector3::yAxis());
+    CORRADE_COMPARE(collision.separationDistance(), 0.25f);
+
+    /* Collision, flipped */
+    CORRADE_COMPARE((point3/capsule2).separationNormal(), Vector3::yAxis());
+
+    /* No collision */
+    CORRADE_VERIFY(!(capsule2/point2));
 }
 
 void CapsuleTest::collisionSphere() {
@@ -78,6 +94,52 @@ void CapsuleTest::collisionSphere() {
     VERIFY_COLLIDES(capsule, sphere);
     VERIFY_COLLIDES(capsule, sphere1);
     VERIFY_NOT_COLLIDES(capsule, sphere2);
+
+    /* Collision with the cap */
+    const Shapes::Capsule3D capsule2({-1.0f, 0.0f, 0.0f}, {1.0f, 0.0f, 0.0f}, 1.0f);
+    const Shapes::Sphere3D sphere3({2.5f, 0.0f, 0.0f}, 1.0f);
+    const Shapes::Collision3D collision = capsule2/sphere3;
+    CORRADE_COMPARE(collision.position(), Vector3(1.5f, 0.0f, 0.0f));
+    CORRADE_COMPARE(collision.separationNormal(), -Vector3::xAxis());
+    CORRADE_COMPARE(collision.separationDistance(), 0.5f);
+
+    /* Collision, flipped */
+    CORRADE_COMPARE((sphere3/capsule2).separationNormal(), Vector3::xAxis());
+
+    /* No collision */
+    CORRADE_VERIFY(!(capsule2/sphere2));
+}
+
+void CapsuleTest::collisionCapsule() {
+    const Shapes::Capsule3D capsule({-1.0f, 0.0f, 0.0f}, {1.0f, 0.0f, 0.0f}, 1.0f);
+    const Shapes::Capsule3D capsule1({0.0f, 1.5f, -1.0f}, {0.0f, 1.5f, 1.0f}, 1.0f);
+    const Shapes::Capsule3D capsule2({0.0f, 2.5f, -1.0f}, {0.0f, 2.5f, 1.0f}, 1.0f);
+    const Shapes::Capsule3D capsule3({-3.0f, 1.5f, 0.0f}, {3.0f, 1.5f, 0.0f}, 0.75f);
+
+    VERIFY_COLLIDES(capsule, capsule1);
+    VERIFY_NOT_COLLIDES(capsule, capsule2);
+
+    /* Crossing capsules */
+    const Shapes::Collision3D collision = capsule/capsule1;
+    CORRADE_COMPARE(collision.position(), Vector3(0.0f, 0.5f, 0.0f));
+    CORRADE_COMPARE(collision.separationNormal(), -Vector3::yAxis());
+    CORRADE_COMPARE(collision.separationDistance(), 0.5f);
+
+    /* Parallel capsules */
+    VERIFY_COLLIDES(capsule, capsule3);
+    const Shapes::Collision3D collision1 = capsule3/capsule;
+    CORRADE_COMPARE(collision1.separationNormal(), Vector3::yAxis());
+    CORRADE_COMPARE(collision1.separationDistance(), 0.25f);
+
+    /* Intersecting axes, the direction is ambiguous */
+    const Shapes::Capsule2D a({-1.0f, -1.0f}, {1.0f, 1.0f}, 0.1f);
+    const Shapes::Capsule2D b({-1.0f, 1.0f}, {1.0f, -1.0f}, 0.1f);
+    const Shapes::Collision2D collision2 = a/b;
+    CORRADE_COMPARE(collision2.separationNormal(), Vector2::yAxis());
+    CORRADE_COMPARE(collision2.separationDistance(), 0.2f);
+
+    /* No collision */
+    CORRADE_VERIFY(!(capsule/capsule2));
 }
 
 }}}
@@ -0,0 +1,112 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <chrono>
+#include <random>
+#include <TestSuite/Tester.h>
+
+#include "Magnum.h"
+#include "Math/Matrix4.h"
+#include "Shapes/AxisAlignedBox.h"
+#include "Shapes/Box.h"
+#include "Shapes/Composition.h"
+#include "Shapes/Point.h"
+#include "Shapes/Sphere.h"
+
+namespace Magnum { namespace Shapes { namespace Test {
+
+class CompositionBenchmark: public TestSuite::Tester {
+    public:
+        CompositionBenchmark();
+
+        void transform();
+        void collides();
+};
+
+namespace {
+    enum: std::size_t { Frames = 100000, Count = 1000000 };
+
+    typedef std::chrono::high_resolution_clock Clock;
+
+    /* Compound collider, e.g. a character -- body with head and arms, with
+       a hole cut out */
+    Composition3D collider() {
+        return ((Sphere3D({0.0f, 1.0f, 0.0f}, 0.5f) || Box3D(Matrix4::scaling(Vector3(0.5f)))) ||
+                (Sphere3D({-1.0f, 0.0f, 0.0f}, 0.25f) || Sphere3D({1.0f, 0.0f, 0.0f}, 0.25f))) &&
+               !AxisAlignedBox3D({-0.1f, -0.1f, -0.1f}, {0.1f, 0.1f, 0.1f});
+    }
+}
+
+CompositionBenchmark::CompositionBenchmark() {
+    addTests({&CompositionBenchmark::transform,
+              &CompositionBenchmark::collides});
+}
+
+void CompositionBenchmark::transform() {
+    const Composition3D a = collider();
+
+    /* New composition each frame */
+    Float transformedSum = 0.0f;
+    const auto transformedBegin = Clock::now();
+    for(std::size_t f = 0; f != Frames; ++f) {
+        const Composition3D transformed = a.transformed(Matrix4::translation(Vector3::xAxis(Float(f%10))));
+        transformedSum += transformed.get<Sphere3D>(0).position().x();
+    }
+    const auto transformedTime = Clock::now() - transformedBegin;
+
+    /* Reused target */
+    Float transformSum = 0.0f;
+    Composition3D target;
+    const auto transformBegin = Clock::now();
+    for(std::size_t f = 0; f != Frames; ++f) {
+        a.transform(Matrix4::translation(Vector3::xAxis(Float(f%10))), target);
+        transformSum += target.get<Sphere3D>(0).position().x();
+    }
+    const auto transformTime = Clock::now() - transformBegin;
+
+    Debug() << "Composition of" << a.size() << "shapes, transformed():" << std::chrono::duration<Double, std::nano>(transformedTime).count()/Frames << "ns, transform():" << std::chrono::duration<Double, std::nano>(transformTime).count()/Frames << "ns, position sums" << transformedSum << transformSum;
+}
+
+void CompositionBenchmark::collides() {
+    std::mt19937 random;
+    std::uniform_real_distribution<Float> position(-1.5f, 1.5f);
+
+    std::vector<Point3D> points;
+    for(std::size_t i = 0; i != Count; ++i)
+        points.push_back(Point3D({position(random), position(random), position(random)}));
+
+    const Composition3D a = collider();
+
+    std::size_t collisionCount = 0;
+    const auto begin = Clock::now();
+    for(const Point3D& point: points)
+        if(a % point) ++collisionCount;
+    const auto time = Clock::now() - begin;
+
+    Debug() << "Composition of" << a.size() << "shapes with" << Count << "points:" << std::chrono::duration<Double, std::milli>(time).count() << "ms," << collisionCount << "collisions";
+}
+
+}}}
+
+CORRADE_TEST_MAIN(Magnum::Shapes::Test::CompositionBenchmark)
@@ -44,11 +44,13 @@ class CompositionTest: public TestSuite::Tester {
         void ored();
         void multipleUnary();
         void hierarchy();
+        void hierarchyShortCircuit();
         void empty();
 
         void copy();
         void move();
         void transformed();
+        void transform();
 };
 
 CompositionTest::CompositionTest() {
@@ -57,11 +59,13 @@ CompositionTest::CompositionTest() {
               &CompositionTest::ored,
               &CompositionTest::multipleUnary,
               &CompositionTest::hierarchy,
+              &CompositionTest::hierarchyShortCircuit,
               &CompositionTest::empty,
 
               &CompositionTest::copy,
               &CompositionTest::move,
-              &CompositionTest::transformed});
+              &CompositionTest::transformed,
+              &CompositionTest::transform});
 }
 
 void CompositionTest::negated() {
@@ -72,6 +76,27 @@ void CompositionTest::negated() {
     CORRADE_COMPARE(a.get<Shapes::Point2D>(0).position(), Vector2::xAxis(0.5f));
 
     VERIFY_NOT_COLLIDES(a, Shapes::Sphere2D({}, 1.0f));
+
+    /* Negated empty composition collides with everything */
+    const Shapes::Composition2D b = !Shapes::Composition2D();
+    CORRADE_COMPARE(b.size(), 0);
+    VERIFY_COLLIDES(b, Shapes::Point2D({100.0f, 0.0f}));
+    VERIFY_NOT_COLLIDES(!!Shapes::Composition2D(), Shapes::Point2D({100.0f, 0.0f}));
+
+    /* Empty composition is false, its negation true */
+    const Shapes::Composition2D c = Shapes::Composition2D() ||
+        (Shapes::Sphere2D({}, 1.0f) && !Shapes::Composition2D());
+    CORRADE_COMPARE(c.size(), 1);
+    VERIFY_COLLIDES(c, Shapes::Point2D({0.5f, 0.0f}));
+    VERIFY_NOT_COLLIDES(c, Shapes::Point2D({1.5f, 0.0f}));
+
+    const Shapes::Composition2D d = Shapes::Sphere2D({}, 1.0f) && Shapes::Composition2D();
+    CORRADE_COMPARE(d.size(), 1);
+    VERIFY_NOT_COLLIDES(d, Shapes::Point2D({0.5f, 0.0f}));
+
+    const Shapes::Composition2D e = !Shapes::Composition2D() || Shapes::Sphere2D({}, 1.0f);
+    CORRADE_COMPARE(e.size(), 1);
+    VERIFY_COLLIDES(e, Shapes::Point2D({1.5f, 0.0f}));
 }
 
 void CompositionTest::anded() {
@@ -126,6 +151,30 @@ void CompositionTest::hierarchy() {
     VERIFY_NOT_COLLIDES(a, Shapes::Point3D(Vector3(0.25f)));
 }
 
+void CompositionTest::hierarchyShortCircuit() {
+    const Shapes::Sphere2D a({-1.0f, 0.0f}, 1.5f);
+    const Shapes::Sphere2D b({1.0f, 0.0f}, 1.5f);
+    const Shapes::Sphere2D c({0.0f, 1.0f}, 1.5f);
+    const Shapes::Sphere2D d({0.0f, -1.0f}, 1.5f);
+
+    /* Nested operations, in which decided left operand skips over
+       differently sized right operands */
+    const Shapes::Composition2D ab_c = (Shapes::Sphere2D(a) && Shapes::Sphere2D(b)) || Shapes::Sphere2D(c);
+    const Shapes::Composition2D a_bc = Shapes::Sphere2D(a) || (Shapes::Sphere2D(b) && !Shapes::Sphere2D(c));
+    const Shapes::Composition2D ab_cd = (Shapes::Sphere2D(a) || Shapes::Sphere2D(b)) && (Shapes::Sphere2D(c) || !Shapes::Sphere2D(d));
+    const Shapes::Composition2D a_b_c_d =
+        ((Shapes::Sphere2D(a) && (Shapes::Sphere2D(b) || Shapes::Sphere2D(c))) || !Shapes::Sphere2D(d)) &&
+        (Shapes::Sphere2D(a) || (Shapes::Sphere2D(b) && (Shapes::Sphere2D(c) || Shapes::Sphere2D(d))));
+
+    for(Float x = -3.0f; x <= 3.0f; x += 0.5f) for(Float y = -3.0f; y <= 3.0f; y += 0.5f) {
+        const Shapes::Point2D p({x, y});
+        CORRADE_COMPARE(ab_c % p, (a % p && b % p) || c % p);
+        CORRADE_COMPARE(a_bc % p, a % p || (b % p && !(c % p)));
+        CORRADE_COMPARE(ab_cd % p, (a % p || b % p) && (c % p || !(d % p)));
+        CORRADE_COMPARE(a_b_c_d % p, ((a % p && (b % p || c % p)) || !(d % p)) && (a % p || (b % p && (c % p || d % p))));
+    }
+}
+
 void CompositionTest::empty() {
     const Shapes::Composition2D a;
 
@@ -148,6 +197,15 @@ void CompositionTest::copy() {
     c = a;
     CORRADE_COMPARE(c.size(), 3);
     CORRADE_COMPARE(c.get<Shapes::Point3D>(1).position(), Vector3::xAxis(1.5f));
+
+    /* Copy assignment to composition with the same structure reuses the
+       storage */
+    c = a.transformed(Matrix4::translation(Vector3::zAxis()));
+    CORRADE_COMPARE(c.get<Shapes::Point3D>(1).position(), Vector3(1.5f, 0.0f, 1.0f));
+    const Shapes::Point3D* point = &c.get<Shapes::Point3D>(1);
+    c = a;
+    CORRADE_VERIFY(&c.get<Shapes::Point3D>(1) == point);
+    CORRADE_COMPARE(c.get<Shapes::Point3D>(1).position(), Vector3::xAxis(1.5f));
 }
 
 void CompositionTest::move() {
@@ -185,6 +243,42 @@ void CompositionTest::transformed() {
     CORRADE_COMPARE(b.get<Shapes::AxisAlignedBox2D>(2).max(), Vector2(2.0f, -6.5f));
 }
 
+void CompositionTest::transform() {
+    const Shapes::Composition2D a = Shapes::Sphere2D({}, 1.0f) &&
+        (Shapes::Point2D(Vector2::xAxis(1.5f)) || !Shapes::AxisAlignedBox2D({}, Vector2(0.5f)));
+
+    /* Different structure, the result is replaced */
+    Shapes::Composition2D b = Shapes::Point2D() || Shapes::Point2D();
+    a.transform(Matrix3::translation({1.5f, -7.0f}), b);
+    CORRADE_COMPARE(b.size(), 3);
+    CORRADE_COMPARE(b.get<Shapes::Sphere2D>(0).position(), Vector2(1.5f, -7.0f));
+    CORRADE_COMPARE(b.get<Shapes::Point2D>(1).position(), Vector2(3.0f, -7.0f));
+    CORRADE_COMPARE(b.get<Shapes::AxisAlignedBox2D>(2).max(), Vector2(2.0f, -6.5f));
+    VERIFY_COLLIDES(b, Shapes::Sphere2D({3.0f, -7.0f}, 0.6f));
+
+    /* Same structure, transformed in-place */
+    const Shapes::Sphere2D* sphere = &b.get<Shapes::Sphere2D>(0);
+    a.transform(Matrix3::translation({-1.0f, 2.0f}), b);
+    CORRADE_VERIFY(&b.get<Shapes::Sphere2D>(0) == sphere);
+    CORRADE_COMPARE(b.get<Shapes::Sphere2D>(0).position(), Vector2(-1.0f, 2.0f));
+    CORRADE_COMPARE(b.get<Shapes::Point2D>(1).position(), Vector2(0.5f, 2.0f));
+    CORRADE_COMPARE(b.get<Shapes::AxisAlignedBox2D>(2).max(), Vector2(-0.5f, 2.5f));
+    VERIFY_COLLIDES(b, Shapes::Sphere2D({0.5f, 2.0f}, 0.6f));
+    VERIFY_NOT_COLLIDES(b, Shapes::Sphere2D({3.0f, -7.0f}, 0.6f));
+
+    /* Same shapes, different operations */
+    const Shapes::Composition2D c = Shapes::Sphere2D({}, 1.0f) ||
+        (Shapes::Point2D(Vector2::xAxis(1.5f)) && !Shapes::AxisAlignedBox2D({}, Vector2(0.5f)));
+    c.transform(Matrix3::translation({-1.0f, 2.0f}), b);
+    CORRADE_VERIFY(&b.get<Shapes::Sphere2D>(0) == sphere);
+    VERIFY_COLLIDES(b, Shapes::Point2D({-1.0f, 2.0f}));
+
+    /* Into itself */
+    b.transform(Matrix3::translation({1.0f, -2.0f}), b);
+    CORRADE_COMPARE(b.get<Shapes::Sphere2D>(0).position(), Vector2());
+    CORRADE_COMPARE(b.get<Shapes::Point2D>(1).position(), Vector2::xAxis(1.5f));
+}
+
 }}}
 
 CORRADE_TEST_MAIN(Magnum::Shapes::Test::CompositionTest)
@@ -26,6 +26,7 @@
 #include "Shapes/LineSegment.h"
 #include "Shapes/Point.h"
 #include "Shapes/Plane.h"
+#include "Shapes/Sphere.h"
 
 #include "ShapeTestBase.h"
 
@@ -38,12 +39,14 @@ class PlaneTest: public TestSuite::Tester {
         void transformed();
         void collisionLine();
         void collisionLineSegment();
+        void collisionSphere();
 };
 
 PlaneTest::PlaneTest() {
     addTests({&PlaneTest::transformed,
               &PlaneTest::collisionLine,
-              &PlaneTest::collisionLineSegment});
+              &PlaneTest::collisionLineSegment,
+              &PlaneTest::collisionSphere});
 }
 
 void PlaneTest::transformed() {
@@ -77,6 +80,35 @@ void PlaneTest::collisionLineSegment() {
     VERIFY_NOT_COLLIDES(plane, line3);
 }
 
+void PlaneTest::collisionSphere() {
+    const Shapes::Plane plane(Vector3(), Vector3::yAxis());
+    const Shapes::Sphere3D sphere({0.0f, 0.5f, 0.0f}, 1.0f);
+    const Shapes::Sphere3D sphere1({0.0f, -0.75f, 0.0f}, 1.0f);
+    const Shapes::Sphere3D sphere2({0.0f, 2.0f, 0.0f}, 1.0f);
+
+    VERIFY_COLLIDES(plane, sphere);
+    VERIFY_COLLIDES(plane, sphere1);
+    VERIFY_NOT_COLLIDES(plane, sphere2);
+
+    /* Sphere center above */
+    const Shapes::Collision3D collision = plane/sphere;
+    CORRADE_COMPARE(collision.position(), Vector3(0.0f, -0.5f, 0.0f));
+    CORRADE_COMPARE(collision.separationNormal(), -Vector3::yAxis());
+    CORRADE_COMPARE(collision.separationDistance(), 0.5f);
+
+    /* Sphere center below */
+    const Shapes::Collision3D collision1 = plane/sphere1;
+    CORRADE_COMPARE(collision1.position(), Vector3(0.0f, 0.25f, 0.0f));
+    CORRADE_COMPARE(collision1.separationNormal(), Vector3::yAxis());
+    CORRADE_COMPARE(collision1.separationDistance(), 0.25f);
+
+    /* Collision, flipped */
+    CORRADE_COMPARE((sphere/plane).separationNormal(), Vector3::yAxis());
+
+    /* No collision */
+    CORRADE_VERIFY(!(plane/sphere2));
+}
+
 }}}
 
 CORRADE_TEST_MAIN(Magnum::Shapes::Test::PlaneTest)
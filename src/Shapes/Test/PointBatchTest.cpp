@@ -0,0 +1,145 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <random>
+#include <sstream>
+#include <TestSuite/Tester.h>
+
+#include "Magnum.h"
+#include "Shapes/AxisAlignedBox.h"
+#include "Shapes/PointBatch.h"
+#include "Shapes/Sphere.h"
+
+namespace Magnum { namespace Shapes { namespace Test {
+
+class PointBatchTest: public TestSuite::Tester {
+    public:
+        PointBatchTest();
+
+        void construct();
+        void collisionAxisAlignedBox();
+        void collisionSphere();
+        void collisionRange();
+        void collisionRangeOutOfBounds();
+};
+
+PointBatchTest::PointBatchTest() {
+    addTests({&PointBatchTest::construct,
+              &PointBatchTest::collisionAxisAlignedBox,
+              &PointBatchTest::collisionSphere,
+              &PointBatchTest::collisionRange,
+              &PointBatchTest::collisionRangeOutOfBounds});
+}
+
+namespace {
+
+PointBatch3D randomPoints(std::size_t count) {
+    std::mt19937 random;
+    std::uniform_real_distribution<Float> position(-5.0f, 5.0f);
+
+    PointBatch3D points;
+    for(std::size_t i = 0; i != count; ++i)
+        points.add({{position(random), position(random), position(random)}});
+    return points;
+}
+
+}
+
+void PointBatchTest::construct() {
+    PointBatch2D points;
+    CORRADE_VERIFY(points.isEmpty());
+
+    points.add({{1.0f, 2.0f}})
+          .add({{-3.0f, 4.0f}});
+    CORRADE_VERIFY(!points.isEmpty());
+    CORRADE_COMPARE(points.size(), 2);
+    CORRADE_COMPARE(points[1].position(), Vector2(-3.0f, 4.0f));
+
+    points.clear();
+    CORRADE_VERIFY(points.isEmpty());
+}
+
+void PointBatchTest::collisionAxisAlignedBox() {
+    PointBatch2D points;
+    points.add({{}})
+          .add({{1.0f, 0.5f}})
+          .add({{0.5f, 1.0f}})
+          .add({{0.5f, -0.5f}});
+
+    /* Minimum is inclusive, maximum exclusive */
+    std::vector<UnsignedByte> result;
+    points.collides(Shapes::AxisAlignedBox2D({}, {1.0f, 2.0f}), result);
+    CORRADE_COMPARE(result, (std::vector<UnsignedByte>{1, 0, 1, 0}));
+
+    /* Same as scalar version */
+    const PointBatch3D random = randomPoints(1000);
+    const Shapes::AxisAlignedBox3D box({-1.0f, -2.0f, 0.0f}, {2.0f, 1.0f, 3.0f});
+    random.collides(box, result);
+    CORRADE_COMPARE(result.size(), 1000);
+    for(std::size_t i = 0; i != random.size(); ++i)
+        CORRADE_COMPARE(bool(result[i]), box % random[i]);
+}
+
+void PointBatchTest::collisionSphere() {
+    PointBatch2D points;
+    points.add({{}})
+          .add({{1.0f, 0.5f}})
+          .add({{0.5f, 1.0f}});
+
+    std::vector<UnsignedByte> result;
+    points.collides(Shapes::Sphere2D({1.0f, 1.0f}, 0.75f), result);
+    CORRADE_COMPARE(result, (std::vector<UnsignedByte>{0, 1, 1}));
+
+    /* Same as scalar version */
+    const PointBatch3D random = randomPoints(1000);
+    const Shapes::Sphere3D sphere({0.5f, -1.0f, 2.0f}, 2.5f);
+    random.collides(sphere, result);
+    CORRADE_COMPARE(result.size(), 1000);
+    for(std::size_t i = 0; i != random.size(); ++i)
+        CORRADE_COMPARE(bool(result[i]), sphere % random[i]);
+}
+
+void PointBatchTest::collisionRange() {
+    const PointBatch3D points = randomPoints(100);
+    const Shapes::Sphere3D sphere({0.5f, -1.0f, 2.0f}, 2.5f);
+
+    std::vector<UnsignedByte> all, range(30);
+    points.collides(sphere, all);
+    points.collides(sphere, 50, 80, range.data());
+    CORRADE_COMPARE(range, std::vector<UnsignedByte>(all.begin() + 50, all.begin() + 80));
+}
+
+void PointBatchTest::collisionRangeOutOfBounds() {
+    std::ostringstream out;
+    Error::setOutput(&out);
+
+    const PointBatch3D points = randomPoints(10);
+    UnsignedByte result[10];
+    points.collides(Shapes::AxisAlignedBox3D(), 7, 6, result);
+    CORRADE_COMPARE(out.str(), "Shapes::PointBatch::collides(): range from 7 to 6 out of bounds for 10 points\n");
+}
+
+}}}
+
+CORRADE_TEST_MAIN(Magnum::Shapes::Test::PointBatchTest)
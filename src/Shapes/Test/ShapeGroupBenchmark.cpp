@@ -0,0 +1,110 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <chrono>
+#include <memory>
+#include <random>
+#include <TestSuite/Tester.h>
+
+#include "SceneGraph/MatrixTransformation3D.h"
+#include "SceneGraph/Scene.h"
+#include "Shapes/Shape.h"
+#include "Shapes/ShapeGroup.h"
+#include "Shapes/Sphere.h"
+
+namespace Magnum { namespace Shapes { namespace Test {
+
+class ShapeGroupBenchmark: public TestSuite::Tester {
+    public:
+        ShapeGroupBenchmark();
+
+        void collisions();
+};
+
+typedef SceneGraph::Object<SceneGraph::MatrixTransformation3D> Object3D;
+typedef SceneGraph::Scene<SceneGraph::MatrixTransformation3D> Scene3D;
+
+namespace {
+    enum: std::size_t { ShapeCount = 4000, Frames = 10 };
+
+    typedef std::chrono::high_resolution_clock Clock;
+}
+
+ShapeGroupBenchmark::ShapeGroupBenchmark() {
+    addTests({&ShapeGroupBenchmark::collisions});
+}
+
+void ShapeGroupBenchmark::collisions() {
+    /* Randomly placed unit spheres slowly moving around */
+    std::mt19937 random;
+    std::uniform_real_distribution<Float> position(-50.0f, 50.0f);
+    std::uniform_real_distribution<Float> velocity(-0.1f, 0.1f);
+
+    Scene3D scene;
+    ShapeGroup3D shapes;
+    std::vector<std::unique_ptr<Object3D>> objects;
+    std::vector<std::unique_ptr<Shape<Shapes::Sphere3D>>> spheres;
+    std::vector<Vector3> velocities;
+    for(std::size_t i = 0; i != ShapeCount; ++i) {
+        objects.emplace_back(new Object3D(&scene));
+        objects.back()->translate({position(random), position(random), position(random)});
+        spheres.emplace_back(new Shape<Shapes::Sphere3D>(*objects.back(), {{}, 1.0f}, &shapes));
+        velocities.push_back({velocity(random), velocity(random), velocity(random)});
+    }
+
+    Clock::duration broadphaseTime{}, bruteForceTime{};
+    std::size_t collisionCount = 0, bruteForceCount = 0;
+    for(std::size_t frame = 0; frame != Frames; ++frame) {
+        for(std::size_t i = 0; i != ShapeCount; ++i)
+            objects[i]->translate(velocities[i]);
+
+        /* Broadphase, including the update */
+        const auto broadphaseBegin = Clock::now();
+        collisionCount += shapes.collisions().size();
+        broadphaseTime += Clock::now() - broadphaseBegin;
+
+        /* Testing all pairs */
+        const auto bruteForceBegin = Clock::now();
+        for(std::size_t i = 0; i != ShapeCount; ++i)
+            for(std::size_t j = i + 1; j != ShapeCount; ++j)
+                if(shapes[i].collides(shapes[j])) ++bruteForceCount;
+        bruteForceTime += Clock::now() - bruteForceBegin;
+    }
+
+    Debug() << "All collisions of" << ShapeCount << "spheres, broadphase:" << std::chrono::duration<Double, std::milli>(broadphaseTime).count()/Frames << "ms," << collisionCount/Frames << "pairs, all pairs:" << std::chrono::duration<Double, std::milli>(bruteForceTime).count()/Frames << "ms," << bruteForceCount/Frames << "pairs";
+
+    /* First collision for each shape */
+    Clock::duration firstCollisionTime{};
+    std::size_t collidingCount = 0;
+    const auto firstCollisionBegin = Clock::now();
+    for(std::size_t i = 0; i != ShapeCount; ++i)
+        if(shapes.firstCollision(*spheres[i])) ++collidingCount;
+    firstCollisionTime += Clock::now() - firstCollisionBegin;
+
+    Debug() << "First collision of each of" << ShapeCount << "spheres, broadphase:" << std::chrono::duration<Double, std::milli>(firstCollisionTime).count() << "ms," << collidingCount << "colliding";
+}
+
+}}}
+
+CORRADE_TEST_MAIN(Magnum::Shapes::Test::ShapeGroupBenchmark)
@@ -22,9 +22,20 @@
     DEALINGS IN THE SOFTWARE.
 */
 
+#include <limits>
 #include <sstream>
 #include <TestSuite/Tester.h>
 
+#include "Math/Matrix3.h"
+#include "Math/Matrix4.h"
+#include "Shapes/AxisAlignedBox.h"
+#include "Shapes/Box.h"
+#include "Shapes/Capsule.h"
+#include "Shapes/Composition.h"
+#include "Shapes/LineSegment.h"
+#include "Shapes/Plane.h"
+#include "Shapes/Point.h"
+#include "Shapes/Sphere.h"
 #include "Shapes/shapeImplementation.h"
 
 namespace Magnum { namespace Shapes { namespace Test {
@@ -34,10 +45,28 @@ class ShapeImplementationTest: public TestSuite::Tester {
         ShapeImplementationTest();
 
         void debug();
+        void bounds();
+        void boundsUnbounded();
+        void boundsComposition();
 };
 
+namespace {
+
+/* Fuzzy compare doesn't work for infinity */
+template<UnsignedInt dimensions> bool isInfinite(const Math::Range<dimensions, Float>& range) {
+    for(UnsignedInt i = 0; i != dimensions; ++i)
+        if(range.min()[i] != -std::numeric_limits<Float>::infinity() || range.max()[i] != std::numeric_limits<Float>::infinity())
+            return false;
+    return true;
+}
+
+}
+
 ShapeImplementationTest::ShapeImplementationTest() {
-    addTests({&ShapeImplementationTest::debug});
+    addTests({&ShapeImplementationTest::debug,
+              &ShapeImplementationTest::bounds,
+              &ShapeImplementationTest::boundsUnbounded,
+              &ShapeImplementationTest::boundsComposition});
 }
 
 void ShapeImplementationTest::debug() {
@@ -50,6 +79,53 @@ void ShapeImplementationTest::debug() {
     CORRADE_COMPARE(o.str(), "Shapes::Shape3D::Type::Plane\n");
 }
 
+void ShapeImplementationTest::bounds() {
+    CORRADE_COMPARE(Implementation::bounds(Shapes::Point3D({1.0f, -2.0f, 3.0f})),
+        Range3D({1.0f, -2.0f, 3.0f}, {1.0f, -2.0f, 3.0f}));
+    CORRADE_COMPARE(Implementation::bounds(Shapes::LineSegment2D({1.0f, -2.0f}, {-3.0f, 4.0f})),
+        Range2D({-3.0f, -2.0f}, {1.0f, 4.0f}));
+    CORRADE_COMPARE(Implementation::bounds(Shapes::Sphere3D({1.0f, -2.0f, 3.0f}, 0.5f)),
+        Range3D({0.5f, -2.5f, 2.5f}, {1.5f, -1.5f, 3.5f}));
+    CORRADE_COMPARE(Implementation::bounds(Shapes::Capsule2D({1.0f, -2.0f}, {-3.0f, 4.0f}, 0.5f)),
+        Range2D({-3.5f, -2.5f}, {1.5f, 4.5f}));
+    CORRADE_COMPARE(Implementation::bounds(Shapes::AxisAlignedBox3D({-1.0f, -2.0f, -3.0f}, {1.0f, 2.0f, 3.0f})),
+        Range3D({-1.0f, -2.0f, -3.0f}, {1.0f, 2.0f, 3.0f}));
+
+    /* Box rotated by 90 degrees has the extents swapped */
+    CORRADE_COMPARE(Implementation::bounds(Shapes::Box2D(Matrix3::translation({1.0f, 2.0f})*Matrix3::rotation(Deg(90.0f))*Matrix3::scaling({2.0f, 0.5f}))),
+        Range2D({0.5f, 0.0f}, {1.5f, 4.0f}));
+}
+
+void ShapeImplementationTest::boundsUnbounded() {
+    CORRADE_VERIFY(isInfinite(Implementation::bounds(Shapes::Plane({}, Vector3::yAxis()))));
+    CORRADE_VERIFY(isInfinite(Implementation::bounds(Shapes::InvertedSphere2D({}, 1.0f))));
+    CORRADE_VERIFY(isInfinite(Implementation::bounds(Shapes::Line2D({}, Vector2::xAxis()))));
+}
+
+void ShapeImplementationTest::boundsComposition() {
+    /* OR is union */
+    CORRADE_COMPARE(Implementation::bounds(Shapes::Sphere2D({}, 1.0f) || Shapes::Point2D({3.0f, -2.0f})),
+        Range2D({-1.0f, -2.0f}, {3.0f, 1.0f}));
+
+    /* AND is the smaller one, NOT is unbounded */
+    CORRADE_COMPARE(Implementation::bounds(Shapes::Sphere2D({}, 1.0f) && Shapes::Point2D({0.5f, 0.0f})),
+        Range2D({0.5f, 0.0f}, {0.5f, 0.0f}));
+    CORRADE_COMPARE(Implementation::bounds(Shapes::Sphere2D({}, 1.0f) && !Shapes::Point2D({0.5f, 0.0f})),
+        Range2D({-1.0f, -1.0f}, {1.0f, 1.0f}));
+    CORRADE_VERIFY(isInfinite(Implementation::bounds(!Shapes::Point2D({0.5f, 0.0f}))));
+
+    /* Empty composition doesn't overlap anything */
+    const Range2D empty = Implementation::bounds(Shapes::Composition2D());
+    CORRADE_VERIFY((empty.min() > empty.max()).all());
+
+    /* ... also when used as operand */
+    const Range2D emptyAnd = Implementation::bounds(Shapes::Sphere2D({}, 1.0f) && Shapes::Composition2D());
+    CORRADE_VERIFY((emptyAnd.min() > emptyAnd.max()).all());
+    CORRADE_COMPARE(Implementation::bounds(Shapes::Sphere2D({}, 1.0f) || Shapes::Composition2D()),
+        Range2D({-1.0f, -1.0f}, {1.0f, 1.0f}));
+    CORRADE_VERIFY(isInfinite(Implementation::bounds(!Shapes::Composition2D())));
+}
+
 }}}
 
 CORRADE_TEST_MAIN(Magnum::Shapes::Test::ShapeImplementationTest)
@@ -22,12 +22,20 @@
     DEALINGS IN THE SOFTWARE.
 */
 
+#include <memory>
+#include <random>
 #include <TestSuite/Tester.h>
 
 #include "Shapes/ShapeGroup.h"
 #include "Shapes/Shape.h"
 #include "Shapes/Point.h"
+#include "Shapes/AxisAlignedBox.h"
+#include "Shapes/Box.h"
+#include "Shapes/Capsule.h"
 #include "Shapes/Composition.h"
+#include "Shapes/Cylinder.h"
+#include "Shapes/LineSegment.h"
+#include "Shapes/Plane.h"
 #include "Shapes/Sphere.h"
 #include "SceneGraph/MatrixTransformation2D.h"
 #include "SceneGraph/MatrixTransformation3D.h"
@@ -40,7 +48,17 @@ class ShapeTest: public TestSuite::Tester {
         ShapeTest();
 
         void clean();
+        void collision();
+        void collisionComposition();
         void firstCollision();
+        void firstCollisionOrder();
+        void firstImpact();
+        void collisions();
+        void collisionsMoved();
+        void collisionsUnbounded();
+        void collisionsPoints();
+        void collisionsRandom();
+        void groupMembership();
         void shapeGroup();
 };
 
@@ -51,7 +69,17 @@ typedef SceneGraph::Object<SceneGraph::MatrixTransformation3D> Object3D;
 
 ShapeTest::ShapeTest() {
     addTests({&ShapeTest::clean,
+              &ShapeTest::collision,
+              &ShapeTest::collisionComposition,
               &ShapeTest::firstCollision,
+              &ShapeTest::firstCollisionOrder,
+              &ShapeTest::firstImpact,
+              &ShapeTest::collisions,
+              &ShapeTest::collisionsMoved,
+              &ShapeTest::collisionsUnbounded,
+              &ShapeTest::collisionsPoints,
+              &ShapeTest::collisionsRandom,
+              &ShapeTest::groupMembership,
               &ShapeTest::shapeGroup});
 }
 
@@ -95,6 +123,86 @@ void ShapeTest::clean() {
     CORRADE_VERIFY(b.isDirty());
 }
 
+void ShapeTest::collision() {
+    Scene3D scene;
+    ShapeGroup3D shapes;
+
+    Object3D a(&scene);
+    Shape<Shapes::Box3D> aShape(a, {Matrix4::scaling({1.0f, 2.0f, 1.0f})}, &shapes);
+
+    Object3D b(&scene);
+    Shape<Shapes::Sphere3D> bShape(b, {{}, 1.0f}, &shapes);
+    b.translate(Vector3::xAxis(1.5f));
+    shapes.setClean();
+
+    /* Both directions */
+    CORRADE_VERIFY(aShape.collides(bShape));
+    CORRADE_VERIFY(bShape.collides(aShape));
+    const Collision3D collision = aShape.collision(bShape);
+    CORRADE_COMPARE(collision.position(), Vector3(0.5f, 0.0f, 0.0f));
+    CORRADE_COMPARE(collision.separationNormal(), -Vector3::xAxis());
+    CORRADE_COMPARE(collision.separationDistance(), 0.5f);
+    CORRADE_COMPARE(bShape.collision(aShape).separationNormal(), Vector3::xAxis());
+
+    /* Capsules */
+    Object3D c(&scene);
+    Shape<Shapes::Capsule3D> cShape(c, {{0.0f, -1.0f, 0.0f}, {0.0f, 1.0f, 0.0f}, 0.5f}, &shapes);
+    c.translate(Vector3::xAxis(2.75f));
+    Object3D d(&scene);
+    Shape<Shapes::Capsule3D> dShape(d, {{0.0f, -1.0f, 0.0f}, {0.0f, 1.0f, 0.0f}, 0.5f}, &shapes);
+    d.translate(Vector3::xAxis(3.5f));
+    shapes.setClean();
+    CORRADE_VERIFY(cShape.collides(dShape));
+    CORRADE_COMPARE(cShape.collision(dShape).separationNormal(), -Vector3::xAxis());
+    CORRADE_COMPARE(cShape.collision(dShape).separationDistance(), 0.25f);
+
+    /* Pair with only collision occurence implemented */
+    Object3D e(&scene);
+    Shape<Shapes::AxisAlignedBox3D> eShape(e, {{-1.0f, -1.0f, -1.0f}, {1.0f, 1.0f, 1.0f}}, &shapes);
+    Object3D f(&scene);
+    Shape<Shapes::Point3D> fShape(f, {{0.5f, 0.0f, 0.0f}}, &shapes);
+    shapes.setClean();
+    CORRADE_VERIFY(eShape.collides(fShape));
+    CORRADE_VERIFY(!eShape.collision(fShape));
+
+    /* Pair with no collision implemented */
+    Object3D g(&scene);
+    Shape<Shapes::Cylinder3D> gShape(g, {{}, Vector3::yAxis(), 1.0f}, &shapes);
+    shapes.setClean();
+    CORRADE_VERIFY(!gShape.collides(aShape));
+    CORRADE_VERIFY(!aShape.collision(gShape));
+}
+
+void ShapeTest::collisionComposition() {
+    Scene3D scene;
+    ShapeGroup3D shapes;
+
+    Object3D a(&scene);
+    Shape<Shapes::Composition3D> aShape(a, Shapes::Sphere3D({}, 1.0f) || Shapes::Point3D({3.0f, 0.0f, 0.0f}), &shapes);
+
+    Object3D b(&scene);
+    Shape<Shapes::Composition3D> bShape(b, Shapes::Sphere3D({}, 0.5f) && Shapes::Sphere3D({0.25f, 0.0f, 0.0f}, 0.5f), &shapes);
+
+    /* Composition against composition */
+    b.translate(Vector3::xAxis(3.0f));
+    shapes.setClean();
+    CORRADE_VERIFY(aShape.collides(bShape));
+    CORRADE_VERIFY(bShape.collides(aShape));
+
+    b.translate(Vector3::yAxis(2.0f));
+    shapes.setClean();
+    CORRADE_VERIFY(!aShape.collides(bShape));
+    CORRADE_VERIFY(!bShape.collides(aShape));
+
+    /* Composition against simple shape */
+    Object3D c(&scene);
+    Shape<Shapes::Sphere3D> cShape(c, {{}, 0.25f}, &shapes);
+    c.translate(Vector3::xAxis(1.0f));
+    shapes.setClean();
+    CORRADE_VERIFY(aShape.collides(cShape));
+    CORRADE_VERIFY(cShape.collides(aShape));
+}
+
 void ShapeTest::firstCollision() {
     Scene3D scene;
     ShapeGroup3D shapes;
@@ -123,6 +231,271 @@ void ShapeTest::firstCollision() {
     CORRADE_VERIFY(!shapes.isDirty());
 }
 
+void ShapeTest::firstCollisionOrder() {
+    Scene3D scene;
+    ShapeGroup3D shapes;
+
+    /* Spheres sorted along X in reverse order */
+    Object3D a(&scene);
+    Shape<Shapes::Sphere3D> aShape(a, {{2.0f, 0.0f, 0.0f}, 1.5f}, &shapes);
+    Object3D b(&scene);
+    Shape<Shapes::Sphere3D> bShape(b, {{1.0f, 0.0f, 0.0f}, 1.5f}, &shapes);
+    Object3D c(&scene);
+    Shape<Shapes::Sphere3D> cShape(c, {{0.0f, 0.0f, 0.0f}, 1.5f}, &shapes);
+
+    /* The shape which was added first is returned. The query shape isn't
+       part of the group, so it needs to be cleaned explicitly. */
+    Object3D d(&scene);
+    Shape<Shapes::Point3D> dShape(d, {{1.5f, 0.0f, 0.0f}});
+    d.setClean();
+    CORRADE_VERIFY(shapes.firstCollision(dShape) == &aShape);
+    CORRADE_VERIFY(shapes.firstCollision(cShape) == &aShape);
+    CORRADE_VERIFY(shapes.firstCollision(aShape) == &bShape);
+
+    d.translate(Vector3::xAxis(-1.0f)).setClean();
+    CORRADE_VERIFY(shapes.firstCollision(dShape) == &bShape);
+
+    d.translate(Vector3::xAxis(-5.0f)).setClean();
+    CORRADE_VERIFY(!shapes.firstCollision(dShape));
+}
+
+void ShapeTest::firstImpact() {
+    Scene3D scene;
+    ShapeGroup3D shapes;
+
+    /* Thin wall, sphere behind it and floor */
+    Object3D a(&scene);
+    Shape<Shapes::Box3D> aShape(a, {Matrix4::translation(Vector3::xAxis(2.0f))*Matrix4::scaling({0.01f, 1.0f, 1.0f})}, &shapes);
+    Object3D b(&scene);
+    Shape<Shapes::Sphere3D> bShape(b, {{6.0f, 0.0f, 0.0f}, 1.0f}, &shapes);
+    Object3D c(&scene);
+    Shape<Shapes::Plane> cShape(c, {{0.0f, -3.0f, 0.0f}, Vector3::yAxis()}, &shapes);
+
+    /* Passing through the wall, static test wouldn't detect it */
+    const Shapes::Sphere3D sphere({}, 0.5f);
+    std::pair<AbstractShape3D*, Float> impact = shapes.firstImpact(sphere, Matrix4::translation(Vector3::xAxis(-4.0f)), Matrix4::translation(Vector3::xAxis(4.0f)));
+    CORRADE_VERIFY(impact.first == &aShape);
+    CORRADE_VERIFY(impact.second <= 0.68625f && impact.second > 0.6861f);
+
+    /* Not reaching the wall */
+    impact = shapes.firstImpact(sphere, Matrix4::translation(Vector3::xAxis(-4.0f)), Matrix4());
+    CORRADE_VERIFY(!impact.first);
+    CORRADE_VERIFY(impact.second > 1.0f);
+
+    /* Falling down to the floor */
+    impact = shapes.firstImpact(sphere, Matrix4(), Matrix4::translation(Vector3::yAxis(-10.0f)));
+    CORRADE_VERIFY(impact.first == &cShape);
+    CORRADE_COMPARE(impact.second, 0.25f);
+
+    /* Moving shape in the group doesn't hit itself */
+    Object3D d(&scene);
+    Shape<Shapes::Sphere3D> dShape(d, {{}, 0.5f}, &shapes);
+    impact = shapes.firstImpact(dShape, Matrix4::translation(Vector3::xAxis(-1.0f)), Matrix4::translation(Vector3::xAxis(1.0f)));
+    CORRADE_VERIFY(!impact.first);
+    impact = shapes.firstImpact(dShape, Matrix4::translation(Vector3::xAxis(3.0f)), Matrix4::translation(Vector3::xAxis(7.0f)));
+    CORRADE_VERIFY(impact.first == &bShape);
+    CORRADE_COMPARE(impact.second, 0.375f);
+
+    /* Pair without time of impact implementation is tested only at the
+       beginning and at the end */
+    impact = shapes.firstImpact(Shapes::Point3D(), Matrix4::translation({6.0f, 0.0f, 5.0f}), Matrix4::translation({6.0f, 0.0f, 0.0f}));
+    CORRADE_VERIFY(impact.first == &bShape);
+    CORRADE_COMPARE(impact.second, 1.0f);
+}
+
+void ShapeTest::collisions() {
+    Scene2D scene;
+    ShapeGroup2D shapes;
+
+    Object2D a(&scene);
+    Shape<Shapes::Sphere2D> aShape(a, {{}, 1.0f}, &shapes);
+    Object2D b(&scene);
+    Shape<Shapes::Point2D> bShape(b, {{0.5f, 0.5f}}, &shapes);
+    Object2D c(&scene);
+    Shape<Shapes::Sphere2D> cShape(c, {{3.0f, 0.0f}, 2.6f}, &shapes);
+
+    /* Overlapping bounds, but not colliding */
+    Object2D d(&scene);
+    Shape<Shapes::Point2D> dShape(d, {{4.5f, 2.4f}}, &shapes);
+
+    /* Pairs ordered by the first shape, then by the second */
+    const std::vector<std::pair<AbstractShape2D*, AbstractShape2D*>> collisions = shapes.collisions();
+    CORRADE_COMPARE(collisions.size(), 3);
+    CORRADE_VERIFY(collisions[0].first == &aShape && collisions[0].second == &bShape);
+    CORRADE_VERIFY(collisions[1].first == &aShape && collisions[1].second == &cShape);
+    CORRADE_VERIFY(collisions[2].first == &bShape && collisions[2].second == &cShape);
+    CORRADE_VERIFY(!shapes.isDirty());
+
+    /* Empty group */
+    CORRADE_VERIFY(ShapeGroup2D().collisions().empty());
+}
+
+void ShapeTest::collisionsMoved() {
+    Scene2D scene;
+    ShapeGroup2D shapes;
+
+    std::vector<std::unique_ptr<Object2D>> objects;
+    std::vector<std::unique_ptr<Shape<Shapes::Sphere2D>>> spheres;
+    for(std::size_t i = 0; i != 10; ++i) {
+        objects.emplace_back(new Object2D(&scene));
+        objects.back()->translate(Vector2::xAxis(i*2.0f));
+        spheres.emplace_back(new Shape<Shapes::Sphere2D>(*objects.back(), {{}, 0.75f}, &shapes));
+    }
+    CORRADE_VERIFY(shapes.collisions().empty());
+
+    /* Move the first sphere through the others, the order is updated */
+    for(std::size_t i = 0; i != 10; ++i) {
+        objects.front()->translate(Vector2::xAxis(2.0f));
+        const std::vector<std::pair<AbstractShape2D*, AbstractShape2D*>> collisions = shapes.collisions();
+        if(i == 9) {
+            CORRADE_VERIFY(collisions.empty());
+        } else {
+            CORRADE_COMPARE(collisions.size(), 1);
+            CORRADE_VERIFY(collisions[0].first == spheres[0].get());
+            CORRADE_VERIFY(collisions[0].second == spheres[i + 1].get());
+            CORRADE_VERIFY(shapes.firstCollision(*spheres[i + 1]) == spheres[0].get());
+        }
+    }
+}
+
+void ShapeTest::collisionsUnbounded() {
+    Scene3D scene;
+    ShapeGroup3D shapes;
+
+    Object3D a(&scene);
+    Shape<Shapes::LineSegment3D> aShape(a, {{5.0f, -1.0f, 0.0f}, {5.0f, 1.0f, 0.0f}}, &shapes);
+    Object3D b(&scene);
+    Shape<Shapes::Plane> bShape(b, {{}, Vector3::yAxis()}, &shapes);
+    Object3D c(&scene);
+    Shape<Shapes::InvertedSphere3D> cShape(c, {{}, 1.0f}, &shapes);
+    Object3D d(&scene);
+    Shape<Shapes::Point3D> dShape(d, {{-0.5f, 0.0f, 0.5f}}, &shapes);
+    Object3D e(&scene);
+    Shape<Shapes::Point3D> eShape(e, {{3.0f, 0.0f, 0.0f}}, &shapes);
+
+    const std::vector<std::pair<AbstractShape3D*, AbstractShape3D*>> collisions = shapes.collisions();
+    CORRADE_COMPARE(collisions.size(), 2);
+    CORRADE_VERIFY(collisions[0].first == &aShape && collisions[0].second == &bShape);
+    CORRADE_VERIFY(collisions[1].first == &cShape && collisions[1].second == &eShape);
+
+    CORRADE_VERIFY(shapes.firstCollision(aShape) == &bShape);
+    CORRADE_VERIFY(shapes.firstCollision(bShape) == &aShape);
+    CORRADE_VERIFY(shapes.firstCollision(eShape) == &cShape);
+    CORRADE_VERIFY(!shapes.firstCollision(dShape));
+
+    /* Plane moved out of the way */
+    b.translate(Vector3::yAxis(-2.0f));
+    CORRADE_VERIFY(!shapes.firstCollision(aShape));
+}
+
+void ShapeTest::collisionsPoints() {
+    Scene2D scene;
+    ShapeGroup2D shapes;
+
+    /* Group of points only, tested in batches */
+    std::vector<std::unique_ptr<Object2D>> objects;
+    std::vector<std::unique_ptr<Shape<Shapes::Point2D>>> points;
+    for(std::size_t i = 0; i != 10; ++i) {
+        objects.emplace_back(new Object2D(&scene));
+        points.emplace_back(new Shape<Shapes::Point2D>(*objects.back(), {{9.0f - i, 0.5f}}, &shapes));
+    }
+    CORRADE_VERIFY(shapes.collisions().empty());
+
+    Object2D a(&scene);
+    Shape<Shapes::AxisAlignedBox2D> aShape(a, {{2.5f, 0.0f}, {5.0f, 1.0f}});
+    a.setClean();
+    CORRADE_VERIFY(shapes.firstCollision(aShape) == points[5].get());
+
+    Object2D b(&scene);
+    Shape<Shapes::Sphere2D> bShape(b, {{3.0f, 0.5f}, 1.5f});
+    b.setClean();
+    CORRADE_VERIFY(shapes.firstCollision(bShape) == points[5].get());
+
+    /* Mixed group, not tested in batches */
+    shapes.add(bShape);
+    CORRADE_VERIFY(shapes.firstCollision(aShape) == points[5].get());
+    const std::vector<std::pair<AbstractShape2D*, AbstractShape2D*>> collisions = shapes.collisions();
+    CORRADE_COMPARE(collisions.size(), 3);
+    CORRADE_VERIFY(collisions[0].first == points[5].get() && collisions[0].second == &bShape);
+    CORRADE_VERIFY(collisions[2].first == points[7].get() && collisions[2].second == &bShape);
+}
+
+void ShapeTest::collisionsRandom() {
+    Scene3D scene;
+    ShapeGroup3D shapes;
+
+    /* Randomly placed unit spheres moving around, the broadphase finds the
+       same pairs as testing all of them */
+    std::mt19937 random;
+    std::uniform_real_distribution<Float> position(-8.0f, 8.0f);
+    std::uniform_real_distribution<Float> velocity(-0.5f, 0.5f);
+    std::vector<std::unique_ptr<Object3D>> objects;
+    std::vector<std::unique_ptr<Shape<Shapes::Sphere3D>>> spheres;
+    std::vector<Vector3> velocities;
+    for(std::size_t i = 0; i != 200; ++i) {
+        objects.emplace_back(new Object3D(&scene));
+        objects.back()->translate({position(random), position(random), position(random)});
+        spheres.emplace_back(new Shape<Shapes::Sphere3D>(*objects.back(), {{}, 1.0f}, &shapes));
+        velocities.push_back({velocity(random), velocity(random), velocity(random)});
+    }
+
+    for(std::size_t frame = 0; frame != 5; ++frame) {
+        for(std::size_t i = 0; i != objects.size(); ++i)
+            objects[i]->translate(velocities[i]);
+
+        const std::vector<std::pair<AbstractShape3D*, AbstractShape3D*>> collisions = shapes.collisions();
+        std::vector<std::pair<AbstractShape3D*, AbstractShape3D*>> expected;
+        for(std::size_t i = 0; i != shapes.size(); ++i)
+            for(std::size_t j = i + 1; j != shapes.size(); ++j)
+                if(shapes[i].collides(shapes[j])) expected.emplace_back(&shapes[i], &shapes[j]);
+        CORRADE_VERIFY(!expected.empty());
+        CORRADE_COMPARE(collisions.size(), expected.size());
+        CORRADE_VERIFY(collisions == expected);
+    }
+}
+
+void ShapeTest::groupMembership() {
+    Scene3D scene;
+    ShapeGroup3D shapes, other;
+
+    Object3D a(&scene);
+    Shape<Shapes::Sphere3D> aShape(a, {{}, 1.0f}, &shapes);
+    Object3D b(&scene);
+    Shape<Shapes::Point3D> bShape(b, {{0.5f, 0.0f, 0.0f}}, &shapes);
+    CORRADE_COMPARE(shapes.collisions().size(), 1);
+    CORRADE_VERIFY(!shapes.isDirty());
+
+    /* Removing marks the group as dirty */
+    shapes.remove(bShape);
+    CORRADE_VERIFY(shapes.isDirty());
+    CORRADE_VERIFY(shapes.collisions().empty());
+    CORRADE_VERIFY(!shapes.firstCollision(aShape));
+
+    /* Adding too */
+    shapes.add(bShape);
+    CORRADE_VERIFY(shapes.isDirty());
+    CORRADE_VERIFY(shapes.firstCollision(aShape) == &bShape);
+
+    /* Moving to another group marks both groups */
+    other.add(bShape);
+    CORRADE_VERIFY(shapes.isDirty());
+    CORRADE_VERIFY(other.isDirty());
+    CORRADE_VERIFY(!shapes.firstCollision(aShape));
+    CORRADE_VERIFY(other.firstCollision(aShape) == &bShape);
+
+    /* New shape */
+    {
+        Object3D c(&scene);
+        Shape<Shapes::Point3D> cShape(c, {{0.0f, 0.5f, 0.0f}}, &shapes);
+        CORRADE_VERIFY(shapes.isDirty());
+        CORRADE_VERIFY(shapes.firstCollision(aShape) == &cShape);
+    }
+
+    /* Destroyed shape */
+    CORRADE_VERIFY(shapes.isDirty());
+    CORRADE_VERIFY(!shapes.firstCollision(aShape));
+}
+
 void ShapeTest::shapeGroup() {
     Scene2D scene;
     ShapeGroup2D shapes;
@@ -0,0 +1,144 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <random>
+#include <sstream>
+#include <TestSuite/Tester.h>
+
+#include "Magnum.h"
+#include "Shapes/SphereBatch.h"
+#include "Shapes/Point.h"
+
+namespace Magnum { namespace Shapes { namespace Test {
+
+class SphereBatchTest: public TestSuite::Tester {
+    public:
+        SphereBatchTest();
+
+        void construct();
+        void collisionPoint();
+        void collisionSphere();
+        void collisionRange();
+        void collisionRangeOutOfBounds();
+};
+
+SphereBatchTest::SphereBatchTest() {
+    addTests({&SphereBatchTest::construct,
+              &SphereBatchTest::collisionPoint,
+              &SphereBatchTest::collisionSphere,
+              &SphereBatchTest::collisionRange,
+              &SphereBatchTest::collisionRangeOutOfBounds});
+}
+
+namespace {
+
+SphereBatch3D randomSpheres(std::size_t count) {
+    std::mt19937 random;
+    std::uniform_real_distribution<Float> position(-5.0f, 5.0f);
+    std::uniform_real_distribution<Float> radius(0.0f, 2.0f);
+
+    SphereBatch3D spheres;
+    for(std::size_t i = 0; i != count; ++i)
+        spheres.add({{position(random), position(random), position(random)}, radius(random)});
+    return spheres;
+}
+
+}
+
+void SphereBatchTest::construct() {
+    SphereBatch2D spheres;
+    CORRADE_VERIFY(spheres.isEmpty());
+
+    spheres.add({{1.0f, 2.0f}, 0.5f})
+           .add({{-3.0f, 4.0f}, 1.5f});
+    CORRADE_VERIFY(!spheres.isEmpty());
+    CORRADE_COMPARE(spheres.size(), 2);
+    CORRADE_COMPARE(spheres[1].position(), Vector2(-3.0f, 4.0f));
+    CORRADE_COMPARE(spheres[1].radius(), 1.5f);
+
+    spheres.clear();
+    CORRADE_VERIFY(spheres.isEmpty());
+}
+
+void SphereBatchTest::collisionPoint() {
+    SphereBatch2D spheres;
+    spheres.add({{}, 1.0f})
+           .add({{2.0f, 0.0f}, 0.5f})
+           .add({{1.0f, 1.0f}, 1.0f});
+
+    std::vector<UnsignedByte> result;
+    spheres.collides(Shapes::Point2D({0.5f, 0.5f}), result);
+    CORRADE_COMPARE(result, (std::vector<UnsignedByte>{1, 0, 1}));
+
+    /* Same as scalar version */
+    const SphereBatch3D random = randomSpheres(1000);
+    const Shapes::Point3D point({0.5f, -1.0f, 2.0f});
+    random.collides(point, result);
+    CORRADE_COMPARE(result.size(), 1000);
+    for(std::size_t i = 0; i != random.size(); ++i)
+        CORRADE_COMPARE(bool(result[i]), random[i] % point);
+}
+
+void SphereBatchTest::collisionSphere() {
+    SphereBatch2D spheres;
+    spheres.add({{}, 1.0f})
+           .add({{3.0f, 0.0f}, 0.5f})
+           .add({{0.0f, 2.5f}, 1.0f});
+
+    std::vector<UnsignedByte> result;
+    spheres.collides(Shapes::Sphere2D({2.0f, 0.0f}, 1.25f), result);
+    CORRADE_COMPARE(result, (std::vector<UnsignedByte>{1, 1, 0}));
+
+    /* Same as scalar version */
+    const SphereBatch3D random = randomSpheres(1000);
+    const Shapes::Sphere3D sphere({0.5f, -1.0f, 2.0f}, 1.5f);
+    random.collides(sphere, result);
+    CORRADE_COMPARE(result.size(), 1000);
+    for(std::size_t i = 0; i != random.size(); ++i)
+        CORRADE_COMPARE(bool(result[i]), random[i] % sphere);
+}
+
+void SphereBatchTest::collisionRange() {
+    const SphereBatch3D spheres = randomSpheres(100);
+    const Shapes::Sphere3D sphere({0.5f, -1.0f, 2.0f}, 1.5f);
+
+    std::vector<UnsignedByte> all, range(30);
+    spheres.collides(sphere, all);
+    spheres.collides(sphere, 50, 80, range.data());
+    CORRADE_COMPARE(range, std::vector<UnsignedByte>(all.begin() + 50, all.begin() + 80));
+}
+
+void SphereBatchTest::collisionRangeOutOfBounds() {
+    std::ostringstream out;
+    Error::setOutput(&out);
+
+    const SphereBatch3D spheres = randomSpheres(10);
+    UnsignedByte result[10];
+    spheres.collides(Shapes::Sphere3D(), 5, 11, result);
+    CORRADE_COMPARE(out.str(), "Shapes::SphereBatch::collides(): range from 5 to 11 out of bounds for 10 spheres\n");
+}
+
+}}}
+
+CORRADE_TEST_MAIN(Magnum::Shapes::Test::SphereBatchTest)
@@ -0,0 +1,235 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <limits>
+#include <TestSuite/Tester.h>
+
+#include "Math/Matrix3.h"
+#include "Math/Matrix4.h"
+#include "Magnum.h"
+#include "Shapes/Box.h"
+#include "Shapes/Capsule.h"
+#include "Shapes/Plane.h"
+#include "Shapes/Sphere.h"
+#include "Shapes/TimeOfImpact.h"
+
+namespace Magnum { namespace Shapes { namespace Test {
+
+class TimeOfImpactTest: public TestSuite::Tester {
+    public:
+        TimeOfImpactTest();
+
+        void sphereSphere();
+        void sphereSphere2D();
+        void spherePlane();
+        void sphereBox();
+        void sphereBoxRotated();
+        void capsuleCapsule();
+        void capsuleSphere();
+        void capsuleSphereRotating();
+        void transformed();
+};
+
+namespace {
+    /* Iteratively computed time is slightly before the actual contact */
+    bool isBefore(const Float time, const Float expected) {
+        return time <= expected + 1.0e-6f && time > expected - 1.0e-3f;
+    }
+}
+
+TimeOfImpactTest::TimeOfImpactTest() {
+    addTests({&TimeOfImpactTest::sphereSphere,
+              &TimeOfImpactTest::sphereSphere2D,
+              &TimeOfImpactTest::spherePlane,
+              &TimeOfImpactTest::sphereBox,
+              &TimeOfImpactTest::sphereBoxRotated,
+              &TimeOfImpactTest::capsuleCapsule,
+              &TimeOfImpactTest::capsuleSphere,
+              &TimeOfImpactTest::capsuleSphereRotating,
+              &TimeOfImpactTest::transformed});
+}
+
+void TimeOfImpactTest::sphereSphere() {
+    const Shapes::Sphere3D a({}, 1.0f);
+
+    /* Moving sphere hitting static one */
+    const Shapes::Sphere3D start({-5.0f, 0.0f, 0.0f}, 1.0f);
+    const Shapes::Sphere3D end({5.0f, 0.0f, 0.0f}, 1.0f);
+    CORRADE_COMPARE(Shapes::timeOfImpact(start, end, a, a), 0.3f);
+    CORRADE_COMPARE(Shapes::timeOfImpact(a, a, start, end), 0.3f);
+
+    /* Both moving */
+    const Shapes::Sphere3D bStart({5.0f, 0.0f, 0.0f}, 1.0f);
+    CORRADE_COMPARE(Shapes::timeOfImpact(start, a, bStart, a), 0.8f);
+
+    /* Colliding at the beginning */
+    CORRADE_COMPARE(Shapes::timeOfImpact(a, end, a, a), 0.0f);
+
+    /* Not reaching, moving away, passing by */
+    CORRADE_VERIFY(Shapes::timeOfImpact(start, Shapes::Sphere3D({-3.0f, 0.0f, 0.0f}, 1.0f), a, a) == std::numeric_limits<Float>::infinity());
+    CORRADE_VERIFY(Shapes::timeOfImpact(end, Shapes::Sphere3D({10.0f, 0.0f, 0.0f}, 1.0f), a, a) == std::numeric_limits<Float>::infinity());
+    CORRADE_VERIFY(Shapes::timeOfImpact(Shapes::Sphere3D({-5.0f, 2.5f, 0.0f}, 1.0f), Shapes::Sphere3D({5.0f, 2.5f, 0.0f}, 1.0f), a, a) == std::numeric_limits<Float>::infinity());
+
+    /* Growing sphere */
+    CORRADE_COMPARE(Shapes::timeOfImpact(Shapes::Sphere3D({-5.0f, 0.0f, 0.0f}, 1.0f), Shapes::Sphere3D({-5.0f, 0.0f, 0.0f}, 5.0f), a, a), 0.75f);
+}
+
+void TimeOfImpactTest::sphereSphere2D() {
+    const Shapes::Sphere2D a({}, 1.0f);
+    const Shapes::Sphere2D start({-3.0f, -4.0f}, 1.0f);
+    const Shapes::Sphere2D end({3.0f, 4.0f}, 1.0f);
+    CORRADE_COMPARE(Shapes::timeOfImpact(start, end, a, a), 0.3f);
+}
+
+void TimeOfImpactTest::spherePlane() {
+    const Shapes::Plane plane({}, Vector3::zAxis());
+
+    /* From both sides */
+    const Shapes::Sphere3D above({0.0f, 0.0f, 5.0f}, 1.0f);
+    const Shapes::Sphere3D below({0.0f, 0.0f, -5.0f}, 1.0f);
+    CORRADE_COMPARE(Shapes::timeOfImpact(above, below, plane, plane), 0.4f);
+    CORRADE_COMPARE(Shapes::timeOfImpact(below, above, plane, plane), 0.4f);
+    CORRADE_COMPARE(Shapes::timeOfImpact(plane, plane, below, above), 0.4f);
+
+    /* Moving plane with non-normalized normal */
+    const Shapes::Plane planeEnd({0.0f, 0.0f, 10.0f}, Vector3::zAxis(2.0f));
+    CORRADE_COMPARE(Shapes::timeOfImpact(above, above, plane, planeEnd), 0.4f);
+
+    /* Colliding at the beginning, not reaching */
+    CORRADE_COMPARE(Shapes::timeOfImpact(Shapes::Sphere3D({}, 1.0f), above, plane, plane), 0.0f);
+    CORRADE_VERIFY(Shapes::timeOfImpact(above, Shapes::Sphere3D({0.0f, 0.0f, 1.5f}, 1.0f), plane, plane) == std::numeric_limits<Float>::infinity());
+}
+
+void TimeOfImpactTest::sphereBox() {
+    /* Thin wall, the sphere is on the other side at the end */
+    const Shapes::Box3D box(Matrix4::scaling({0.01f, 1.0f, 1.0f}));
+    const Shapes::Sphere3D start({-1.0f, 0.0f, 0.0f}, 0.1f);
+    const Shapes::Sphere3D end({1.0f, 0.0f, 0.0f}, 0.1f);
+    CORRADE_VERIFY(!(box % start) && !(box % end));
+    CORRADE_VERIFY(isBefore(Shapes::timeOfImpact(start, end, box, box), 0.445f));
+    CORRADE_VERIFY(isBefore(Shapes::timeOfImpact(box, box, start, end), 0.445f));
+
+    /* Hitting the edge */
+    const Shapes::Sphere3D edgeStart({-1.0f, 1.05f, 0.0f}, 0.1f);
+    const Shapes::Sphere3D edgeEnd({1.0f, 1.05f, 0.0f}, 0.1f);
+    CORRADE_VERIFY(isBefore(Shapes::timeOfImpact(edgeStart, edgeEnd, box, box), 0.451699f));
+
+    /* Center inside at the beginning, passing by */
+    CORRADE_COMPARE(Shapes::timeOfImpact(Shapes::Sphere3D({}, 0.1f), end, box, box), 0.0f);
+    CORRADE_VERIFY(Shapes::timeOfImpact(Shapes::Sphere3D({-1.0f, 1.2f, 0.0f}, 0.1f), Shapes::Sphere3D({1.0f, 1.2f, 0.0f}, 0.1f), box, box) == std::numeric_limits<Float>::infinity());
+}
+
+void TimeOfImpactTest::sphereBoxRotated() {
+    /* Box rotated by 45 degrees, sphere hits its edge */
+    const Shapes::Box3D box(Matrix4::rotationZ(Deg(45.0f)));
+    const Shapes::Sphere3D start({-5.0f, 0.0f, 0.0f}, 0.5f);
+    const Shapes::Sphere3D end({}, 0.5f);
+    CORRADE_VERIFY(isBefore(Shapes::timeOfImpact(start, end, box, box), (5.0f - Constants::sqrt2() - 0.5f)/5.0f));
+
+    /* Rotating box which hits the static sphere with its corner, the sphere
+       is in distance 0.3 from the box face at the beginning and overlaps the
+       corner at the end */
+    const Shapes::Sphere3D sphere({1.8f, 0.0f, 0.0f}, 0.5f);
+    const Shapes::Box3D boxStart(Matrix4::rotationZ(Deg(0.0f)));
+    const Shapes::Box3D boxEnd(Matrix4::rotationZ(Deg(45.0f)));
+    CORRADE_VERIFY(!(boxStart % sphere) && boxEnd % sphere);
+    const Float time = Shapes::timeOfImpact(sphere, sphere, boxStart, boxEnd);
+    CORRADE_VERIFY(time > 0.0f && time < 1.0f);
+}
+
+void TimeOfImpactTest::capsuleCapsule() {
+    const Shapes::Capsule3D a({0.0f, -1.0f, 0.0f}, {0.0f, 1.0f, 0.0f}, 0.1f);
+
+    /* Thin perpendicular capsule crossing the other one */
+    const Shapes::Capsule3D start({-1.0f, 0.0f, -1.0f}, {-1.0f, 0.0f, 1.0f}, 0.1f);
+    const Shapes::Capsule3D end({1.0f, 0.0f, -1.0f}, {1.0f, 0.0f, 1.0f}, 0.1f);
+    CORRADE_VERIFY(!(a % start) && !(a % end));
+    CORRADE_VERIFY(isBefore(Shapes::timeOfImpact(start, end, a, a), 0.4f));
+
+    /* Passing over the end */
+    const Shapes::Capsule3D overStart({-1.0f, 1.3f, -1.0f}, {-1.0f, 1.3f, 1.0f}, 0.1f);
+    const Shapes::Capsule3D overEnd({1.0f, 1.3f, -1.0f}, {1.0f, 1.3f, 1.0f}, 0.1f);
+    CORRADE_VERIFY(Shapes::timeOfImpact(overStart, overEnd, a, a) == std::numeric_limits<Float>::infinity());
+
+    /* Rotating capsule hitting the other one with its end */
+    const Shapes::Capsule3D rotatingStart({0.5f, 0.0f, 0.0f}, {0.5f, 0.0f, 2.0f}, 0.1f);
+    const Shapes::Capsule3D rotatingEnd({0.5f, 0.0f, 0.0f}, {-1.5f, 0.0f, 0.0f}, 0.1f);
+    const Float time = Shapes::timeOfImpact(rotatingStart, rotatingEnd, a, a);
+    CORRADE_VERIFY(isBefore(time, 0.696168f));
+
+    /* Colliding at the beginning */
+    CORRADE_COMPARE(Shapes::timeOfImpact(a, a, start, end), Shapes::timeOfImpact(start, end, a, a));
+    CORRADE_COMPARE(Shapes::timeOfImpact(a, a, a, a), 0.0f);
+}
+
+void TimeOfImpactTest::capsuleSphere() {
+    const Shapes::Capsule3D capsule({0.0f, -1.0f, 0.0f}, {0.0f, 1.0f, 0.0f}, 0.5f);
+    const Shapes::Sphere3D start({-5.0f, 0.5f, 0.0f}, 0.5f);
+    const Shapes::Sphere3D end({5.0f, 0.5f, 0.0f}, 0.5f);
+    CORRADE_VERIFY(isBefore(Shapes::timeOfImpact(capsule, capsule, start, end), 0.4f));
+    CORRADE_VERIFY(isBefore(Shapes::timeOfImpact(start, end, capsule, capsule), 0.4f));
+
+    /* Hitting the rounded end */
+    const Shapes::Sphere3D endStart({-5.0f, 1.6f, 0.0f}, 0.5f);
+    const Shapes::Sphere3D endEnd({5.0f, 1.6f, 0.0f}, 0.5f);
+    CORRADE_VERIFY(isBefore(Shapes::timeOfImpact(endStart, endEnd, capsule, capsule), 0.42f));
+
+    /* Passing by */
+    CORRADE_VERIFY(Shapes::timeOfImpact(capsule, capsule, Shapes::Sphere3D({-5.0f, 2.1f, 0.0f}, 0.5f), Shapes::Sphere3D({5.0f, 2.1f, 0.0f}, 0.5f)) == std::numeric_limits<Float>::infinity());
+
+    /* Passing by very closely, the advancement doesn't converge */
+    CORRADE_VERIFY(Shapes::timeOfImpact(capsule, capsule, Shapes::Sphere3D({-5.0f, 0.0f, 1.003f}, 0.5f), Shapes::Sphere3D({5.0f, 0.0f, 1.003f}, 0.5f)) == std::numeric_limits<Float>::infinity());
+}
+
+void TimeOfImpactTest::capsuleSphereRotating() {
+    /* Endpoints of long capsule rotating by 90 degrees move much faster than
+       the distance to the sphere changes, conservative advancement alone
+       doesn't converge */
+    const Shapes::Capsule3D capsuleStart({-10.0f, 0.0f, 0.0f}, {10.0f, 0.0f, 0.0f}, 0.5f);
+    const Shapes::Capsule3D capsuleEnd({0.0f, -10.0f, 0.0f}, {0.0f, 10.0f, 0.0f}, 0.5f);
+    const Shapes::Sphere3D start({0.0f, 0.0f, 1.5f}, 0.5f);
+    const Shapes::Sphere3D end({0.0f, 0.0f, 0.5f}, 0.5f);
+    CORRADE_VERIFY(isBefore(Shapes::timeOfImpact(capsuleStart, capsuleEnd, start, end), 0.5f));
+
+    /* Passing above */
+    const Shapes::Sphere3D above({0.0f, 0.0f, 1.1f}, 0.5f);
+    CORRADE_VERIFY(Shapes::timeOfImpact(capsuleStart, capsuleEnd, start, above) == std::numeric_limits<Float>::infinity());
+}
+
+void TimeOfImpactTest::transformed() {
+    const Shapes::Sphere3D sphere({}, 0.5f);
+    const Shapes::Box3D box(Matrix4::scaling(Vector3(2.0f)));
+    const Matrix4 start = Matrix4::translation(Vector3::xAxis(-10.0f));
+    const Matrix4 end = Matrix4::translation(Vector3::xAxis(10.0f));
+
+    CORRADE_COMPARE(Shapes::timeOfImpact(sphere, start, end, Shapes::Sphere3D({}, 1.5f), {}, {}), 0.4f);
+    CORRADE_VERIFY(isBefore(Shapes::timeOfImpact(sphere, start, end, box, {}, Matrix4::translation(Vector3::xAxis(-5.0f))), 0.3f));
+
+    /* 2D */
+    CORRADE_COMPARE(Shapes::timeOfImpact(Shapes::Sphere2D({}, 0.5f), Matrix3::translation(Vector2::xAxis(-10.0f)), Matrix3::translation(Vector2::xAxis(10.0f)), Shapes::Sphere2D({}, 1.5f), {}, {}), 0.4f);
+}
+
+}}}
+
+CORRADE_TEST_MAIN(Magnum::Shapes::Test::TimeOfImpactTest)
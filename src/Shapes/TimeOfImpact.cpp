@@ -0,0 +1,206 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "TimeOfImpact.h"
+
+#include <limits>
+#include <vector>
+
+#include "Math/Functions.h"
+#include "Math/Matrix3.h"
+#include "Math/Matrix4.h"
+#include "Magnum.h"
+#include "Shapes/Box.h"
+#include "Shapes/Capsule.h"
+#include "Shapes/Plane.h"
+#include "Shapes/Sphere.h"
+#include "Shapes/Implementation/ClosestPoints.h"
+
+namespace Magnum { namespace Shapes {
+
+namespace {
+
+/* Distance at which the iteration stops, relative to the maximal distance
+   the features can travel during the whole motion */
+constexpr Float TimeEpsilon = 1.0e-4f;
+
+/* Conservative advancement, see Mirtich: Impulse-based Dynamic Simulation of
+   Rigid Body Systems, chapter 2.3.2. The distance function returns distance
+   of the shapes at given time, its derivative must not exceed `bound`, thus
+   the shapes can't touch sooner than after `distance/bound`. */
+template<class Distance> Float conservativeAdvancement(const Distance& distance, const Float bound) {
+    Float time = 0.0f;
+    for(std::size_t i = 0; i != 64; ++i) {
+        const Float current = distance(time);
+
+        /* Touching (or closer than the precision allows) */
+        if(current <= bound*TimeEpsilon) return time;
+
+        time += current/bound;
+        if(time > 1.0f) return std::numeric_limits<Float>::infinity();
+    }
+
+    /* No convergence, the distance changes much slower than the bound (e.g.
+       rotating long shapes) or the shapes are passing by very closely.
+       Search the rest of the motion for the first time the distance drops
+       to zero. Intervals where it can't drop to zero with given bound are
+       skipped, others are halved, the nearest first, until the sign change
+       is found with given precision. */
+    Float start = time, startDistance = distance(time);
+    std::vector<std::pair<Float, Float>> ends{{1.0f, distance(1.0f)}};
+    while(!ends.empty()) {
+        const Float end = ends.back().first;
+        const Float endDistance = ends.back().second;
+
+        /* Not touching in this interval, continue after it */
+        if(startDistance + endDistance > bound*(end - start)) {
+            start = end;
+            startDistance = endDistance;
+            ends.pop_back();
+            continue;
+        }
+
+        /* Touching (or closer than the precision allows) */
+        if(end - start <= TimeEpsilon) return start;
+
+        const Float middle = (start + end)*0.5f;
+        ends.emplace_back(middle, distance(middle));
+    }
+
+    return std::numeric_limits<Float>::infinity();
+}
+
+}
+
+template<UnsignedInt dimensions> Float timeOfImpact(const Sphere<dimensions>& aStart, const Sphere<dimensions>& aEnd, const Sphere<dimensions>& bStart, const Sphere<dimensions>& bEnd) {
+    /* Relative position and sum of radii at the beginning and change of them
+       during the motion */
+    const typename DimensionTraits<dimensions, Float>::VectorType position = aStart.position() - bStart.position();
+    const typename DimensionTraits<dimensions, Float>::VectorType velocity = aEnd.position() - bEnd.position() - position;
+    const Float radius = aStart.radius() + bStart.radius();
+    const Float radiusChange = aEnd.radius() + bEnd.radius() - radius;
+
+    /* Solving |position + t*velocity|^2 = (radius + t*radiusChange)^2, i.e.
+       a*t^2 + 2*b*t + c = 0 */
+    const Float a = velocity.dot() - Math::pow<2>(radiusChange);
+    const Float b = Math::Vector<dimensions, Float>::dot(position, velocity) - radius*radiusChange;
+    const Float c = position.dot() - Math::pow<2>(radius);
+
+    /* Colliding already */
+    if(c <= 0.0f) return 0.0f;
+
+    /* Smaller root, written as c/(-b + sqrt(b^2 - a*c)) for numerical
+       stability. If the discriminant is negative or the denominator isn't
+       positive, the spheres don't touch in positive time. */
+    const Float discriminant = b*b - a*c;
+    if(discriminant < 0.0f) return std::numeric_limits<Float>::infinity();
+    const Float denominator = Math::sqrt(discriminant) - b;
+    if(denominator <= 0.0f) return std::numeric_limits<Float>::infinity();
+
+    const Float time = c/denominator;
+    return time <= 1.0f ? time : std::numeric_limits<Float>::infinity();
+}
+
+Float timeOfImpact(const Sphere3D& aStart, const Sphere3D& aEnd, const Plane& bStart, const Plane& bEnd) {
+    /* Signed distance of sphere center from the plane */
+    const Float startDistance = Vector3::dot(aStart.position() - bStart.position(), bStart.normal())/bStart.normal().length();
+    const Float endDistance = Vector3::dot(aEnd.position() - bEnd.position(), bEnd.normal())/bEnd.normal().length();
+
+    /* Distance of sphere surface on the side where the sphere starts, it
+       changes linearly */
+    const Float side = startDistance < 0.0f ? -1.0f : 1.0f;
+    const Float start = side*startDistance - aStart.radius();
+    const Float end = side*endDistance - aEnd.radius();
+
+    if(start <= 0.0f) return 0.0f;
+    if(end > 0.0f) return std::numeric_limits<Float>::infinity();
+    return start/(start - end);
+}
+
+template<UnsignedInt dimensions> Float timeOfImpact(const Sphere<dimensions>& aStart, const Sphere<dimensions>& aEnd, const Box<dimensions>& bStart, const Box<dimensions>& bEnd) {
+    /* Sphere center and box extents in (orthonormal) coordinate system of the
+       box, in which the box is axis-aligned and centered at origin */
+    Math::Vector<dimensions, Float> startPosition, endPosition, startExtents, endExtents;
+    const Math::Matrix<dimensions, Float> startAxes = bStart.transformation().rotationScaling();
+    const Math::Matrix<dimensions, Float> endAxes = bEnd.transformation().rotationScaling();
+    for(std::size_t i = 0; i != dimensions; ++i) {
+        startExtents[i] = startAxes[i].length();
+        endExtents[i] = endAxes[i].length();
+        startPosition[i] = Math::Vector<dimensions, Float>::dot(aStart.position() - bStart.transformation().translation(), startAxes[i])/startExtents[i];
+        endPosition[i] = Math::Vector<dimensions, Float>::dot(aEnd.position() - bEnd.transformation().translation(), endAxes[i])/endExtents[i];
+    }
+
+    /* Distance of sphere surface from the box, zero or negative if the center
+       is inside */
+    auto distance = [&](const Float time) {
+        const Math::Vector<dimensions, Float> position = Math::lerp(startPosition, endPosition, time);
+        const Math::Vector<dimensions, Float> extents = Math::lerp(startExtents, endExtents, time);
+        return Math::max(Math::abs(position) - extents, Math::Vector<dimensions, Float>()).length() - Math::lerp(aStart.radius(), aEnd.radius(), time);
+    };
+
+    /* Distance of point from the box changes at most as fast as the point
+       and the box faces move */
+    return conservativeAdvancement(distance, (endPosition - startPosition).length() +
+        (endExtents - startExtents).length() + Math::abs(aEnd.radius() - aStart.radius()));
+}
+
+template<UnsignedInt dimensions> Float timeOfImpact(const Capsule<dimensions>& aStart, const Capsule<dimensions>& aEnd, const Capsule<dimensions>& bStart, const Capsule<dimensions>& bEnd) {
+    auto distance = [&](const Float time) {
+        const auto points = Implementation::closestPoints(
+            Capsule<dimensions>(Math::lerp(aStart.a(), aEnd.a(), time), Math::lerp(aStart.b(), aEnd.b(), time), 0.0f),
+            Capsule<dimensions>(Math::lerp(bStart.a(), bEnd.a(), time), Math::lerp(bStart.b(), bEnd.b(), time), 0.0f));
+        return (points.first - points.second).length() - Math::lerp(aStart.radius() + bStart.radius(), aEnd.radius() + bEnd.radius(), time);
+    };
+
+    /* Each point of the segment moves linearly, at most as fast as the
+       faster endpoint */
+    return conservativeAdvancement(distance,
+        std::max((aEnd.a() - aStart.a()).length(), (aEnd.b() - aStart.b()).length()) +
+        std::max((bEnd.a() - bStart.a()).length(), (bEnd.b() - bStart.b()).length()) +
+        Math::abs(aEnd.radius() + bEnd.radius() - aStart.radius() - bStart.radius()));
+}
+
+template<UnsignedInt dimensions> Float timeOfImpact(const Capsule<dimensions>& aStart, const Capsule<dimensions>& aEnd, const Sphere<dimensions>& bStart, const Sphere<dimensions>& bEnd) {
+    auto distance = [&](const Float time) {
+        const typename DimensionTraits<dimensions, Float>::VectorType position = Math::lerp(bStart.position(), bEnd.position(), time);
+        return (Implementation::closestPoint<dimensions>(Math::lerp(aStart.a(), aEnd.a(), time), Math::lerp(aStart.b(), aEnd.b(), time), position) - position).length() -
+            Math::lerp(aStart.radius() + bStart.radius(), aEnd.radius() + bEnd.radius(), time);
+    };
+
+    return conservativeAdvancement(distance,
+        std::max((aEnd.a() - aStart.a()).length(), (aEnd.b() - aStart.b()).length()) +
+        (bEnd.position() - bStart.position()).length() +
+        Math::abs(aEnd.radius() + bEnd.radius() - aStart.radius() - bStart.radius()));
+}
+
+template Float timeOfImpact(const Sphere2D&, const Sphere2D&, const Sphere2D&, const Sphere2D&);
+template Float timeOfImpact(const Sphere3D&, const Sphere3D&, const Sphere3D&, const Sphere3D&);
+template Float timeOfImpact(const Sphere2D&, const Sphere2D&, const Box2D&, const Box2D&);
+template Float timeOfImpact(const Sphere3D&, const Sphere3D&, const Box3D&, const Box3D&);
+template Float timeOfImpact(const Capsule2D&, const Capsule2D&, const Capsule2D&, const Capsule2D&);
+template Float timeOfImpact(const Capsule3D&, const Capsule3D&, const Capsule3D&, const Capsule3D&);
+template Float timeOfImpact(const Capsule2D&, const Capsule2D&, const Sphere2D&, const Sphere2D&);
+template Float timeOfImpact(const Capsule3D&, const Capsule3D&, const Sphere3D&, const Sphere3D&);
+
+}}
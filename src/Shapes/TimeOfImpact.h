@@ -0,0 +1,149 @@
+#ifndef Magnum_Shapes_TimeOfImpact_h
+#define Magnum_Shapes_TimeOfImpact_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Function Magnum::Shapes::timeOfImpact()
+ */
+
+#include "DimensionTraits.h"
+#include "Shapes/Shapes.h"
+#include "Shapes/magnumShapesVisibility.h"
+
+namespace Magnum { namespace Shapes {
+
+/**
+@brief Time of impact of two moving spheres
+@param aStart   First sphere at the beginning of the motion
+@param aEnd     First sphere at the end of the motion
+@param bStart   Second sphere at the beginning of the motion
+@param bEnd     Second sphere at the end of the motion
+@return Fraction of the motion at which the spheres first touch, `0` if
+    they collide already at the beginning or infinity if they don't touch
+    during the motion.
+
+The shapes are expected to be in the same coordinate system. Each sphere
+moves linearly from its start to its end position, the radius is
+interpolated too. Computed analytically. @ref InvertedSphere is not
+supported, it would be handled as ordinary sphere.
+
+Static collision tests detect only overlaps at the end of each simulation
+step, so fast objects may pass through thin geometry unless the step is
+very short. The shapes can be moved to the returned time and the collision
+resolved from there instead. See also the overload taking start and end
+transformations and ShapeGroup::firstImpact().
+@see @ref shapes-collisions
+*/
+template<UnsignedInt dimensions> Float MAGNUM_SHAPES_EXPORT timeOfImpact(const Sphere<dimensions>& aStart, const Sphere<dimensions>& aEnd, const Sphere<dimensions>& bStart, const Sphere<dimensions>& bEnd);
+
+/**
+@brief Time of impact of moving sphere and plane
+
+Plane position and normal are interpolated linearly, the plane is two-sided,
+i.e. the sphere collides with it from both sides. Computed analytically,
+see timeOfImpact(const Sphere<dimensions>&, const Sphere<dimensions>&, const Sphere<dimensions>&, const Sphere<dimensions>&)
+for more information.
+*/
+Float MAGNUM_SHAPES_EXPORT timeOfImpact(const Sphere3D& aStart, const Sphere3D& aEnd, const Plane& bStart, const Plane& bEnd);
+
+/**
+@brief Time of impact of moving sphere and box
+
+Position of the sphere is interpolated linearly in coordinate system of the
+box, so the box can be rotated along the way. Computed iteratively with
+conservative advancement, the returned time is slightly before the actual
+contact, so the shapes don't overlap yet. If the iteration doesn't converge,
+e.g. when the shapes pass by each other very closely, they are treated as not
+colliding. See
+timeOfImpact(const Sphere<dimensions>&, const Sphere<dimensions>&, const Sphere<dimensions>&, const Sphere<dimensions>&)
+for more information.
+*/
+template<UnsignedInt dimensions> Float MAGNUM_SHAPES_EXPORT timeOfImpact(const Sphere<dimensions>& aStart, const Sphere<dimensions>& aEnd, const Box<dimensions>& bStart, const Box<dimensions>& bEnd);
+
+/**
+@brief Time of impact of two moving capsules
+
+Capsule endpoints are interpolated linearly, thus the capsules shorten a bit
+if they rotate along the way. Computed iteratively with conservative
+advancement, see timeOfImpact(const Sphere<dimensions>&, const Sphere<dimensions>&, const Box<dimensions>&, const Box<dimensions>&)
+for more information.
+*/
+template<UnsignedInt dimensions> Float MAGNUM_SHAPES_EXPORT timeOfImpact(const Capsule<dimensions>& aStart, const Capsule<dimensions>& aEnd, const Capsule<dimensions>& bStart, const Capsule<dimensions>& bEnd);
+
+/**
+@brief Time of impact of moving capsule and sphere
+
+See timeOfImpact(const Capsule<dimensions>&, const Capsule<dimensions>&, const Capsule<dimensions>&, const Capsule<dimensions>&)
+for more information.
+*/
+template<UnsignedInt dimensions> Float MAGNUM_SHAPES_EXPORT timeOfImpact(const Capsule<dimensions>& aStart, const Capsule<dimensions>& aEnd, const Sphere<dimensions>& bStart, const Sphere<dimensions>& bEnd);
+
+/** @brief Time of impact of moving plane and sphere */
+inline Float timeOfImpact(const Plane& aStart, const Plane& aEnd, const Sphere3D& bStart, const Sphere3D& bEnd) {
+    return timeOfImpact(bStart, bEnd, aStart, aEnd);
+}
+
+/** @brief Time of impact of moving box and sphere */
+template<UnsignedInt dimensions> inline Float timeOfImpact(const Box<dimensions>& aStart, const Box<dimensions>& aEnd, const Sphere<dimensions>& bStart, const Sphere<dimensions>& bEnd) {
+    return timeOfImpact(bStart, bEnd, aStart, aEnd);
+}
+
+/** @brief Time of impact of moving sphere and capsule */
+template<UnsignedInt dimensions> inline Float timeOfImpact(const Sphere<dimensions>& aStart, const Sphere<dimensions>& aEnd, const Capsule<dimensions>& bStart, const Capsule<dimensions>& bEnd) {
+    return timeOfImpact(bStart, bEnd, aStart, aEnd);
+}
+
+/**
+@brief Time of impact of two shapes moving between given transformations
+@param a            First shape
+@param aStart       Transformation of first shape at the beginning of the
+    motion
+@param aEnd         Transformation of first shape at the end of the motion
+@param b            Second shape
+@param bStart       Transformation of second shape at the beginning of the
+    motion
+@param bEnd         Transformation of second shape at the end of the motion
+
+Transforms the shapes with given matrices and calls one of the functions
+above, thus it is implemented for pairs of spheres, sphere and plane, sphere
+and box, pairs of capsules and capsule and sphere. Example usage:
+@code
+Shapes::Sphere3D bullet({}, 0.05f);
+Shapes::Box3D wall(Matrix4::scaling({5.0f, 5.0f, 0.01f}));
+Matrix4 start, end; // bullet transformation before and after the step
+
+Float t = Shapes::timeOfImpact(bullet, start, end, wall, {}, {});
+if(t <= 1.0f) {
+    // bullet hit the wall in this step
+}
+@endcode
+*/
+template<class T, class U> inline Float timeOfImpact(const T& a, const typename DimensionTraits<T::Dimensions, Float>::MatrixType& aStart, const typename DimensionTraits<T::Dimensions, Float>::MatrixType& aEnd, const U& b, const typename DimensionTraits<U::Dimensions, Float>::MatrixType& bStart, const typename DimensionTraits<U::Dimensions, Float>::MatrixType& bEnd) {
+    return timeOfImpact(a.transformed(aStart), a.transformed(aEnd), b.transformed(bStart), b.transformed(bEnd));
+}
+
+}}
+
+#endif
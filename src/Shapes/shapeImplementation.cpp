@@ -24,8 +24,20 @@
 
 #include "shapeImplementation.h"
 
+#include <limits>
 #include <Utility/Debug.h>
 
+#include "Math/Functions.h"
+#include "Shapes/AxisAlignedBox.h"
+#include "Shapes/Box.h"
+#include "Shapes/Capsule.h"
+#include "Shapes/Composition.h"
+#include "Shapes/Cylinder.h"
+#include "Shapes/LineSegment.h"
+#include "Shapes/Plane.h"
+#include "Shapes/Point.h"
+#include "Shapes/Sphere.h"
+
 namespace Magnum { namespace Shapes { namespace Implementation {
 
 Debug operator<<(Debug debug, ShapeDimensionTraits<2>::Type value) {
@@ -67,6 +79,89 @@ Debug operator<<(Debug debug, ShapeDimensionTraits<3>::Type value) {
     return debug << "Shapes::Shape3D::Type::(unknown)";
 }
 
+namespace {
+    template<UnsignedInt dimensions> inline Math::Range<dimensions, Float> infiniteBounds() {
+        return {typename DimensionTraits<dimensions, Float>::VectorType(-std::numeric_limits<Float>::infinity()),
+                typename DimensionTraits<dimensions, Float>::VectorType(std::numeric_limits<Float>::infinity())};
+    }
+}
+
+template<UnsignedInt dimensions> Math::Range<dimensions, Float> bounds(const Shapes::Point<dimensions>& shape) {
+    return {shape.position(), shape.position()};
+}
+
+template<UnsignedInt dimensions> Math::Range<dimensions, Float> bounds(const Shapes::Line<dimensions>&) {
+    return infiniteBounds<dimensions>();
+}
+
+template<UnsignedInt dimensions> Math::Range<dimensions, Float> bounds(const Shapes::LineSegment<dimensions>& shape) {
+    return {Math::min(shape.a(), shape.b()), Math::max(shape.a(), shape.b())};
+}
+
+template<UnsignedInt dimensions> Math::Range<dimensions, Float> bounds(const Shapes::Sphere<dimensions>& shape) {
+    return {shape.position() - typename DimensionTraits<dimensions, Float>::VectorType(shape.radius()),
+            shape.position() + typename DimensionTraits<dimensions, Float>::VectorType(shape.radius())};
+}
+
+template<UnsignedInt dimensions> Math::Range<dimensions, Float> bounds(const Shapes::InvertedSphere<dimensions>&) {
+    return infiniteBounds<dimensions>();
+}
+
+template<UnsignedInt dimensions> Math::Range<dimensions, Float> bounds(const Shapes::Cylinder<dimensions>&) {
+    return infiniteBounds<dimensions>();
+}
+
+template<UnsignedInt dimensions> Math::Range<dimensions, Float> bounds(const Shapes::Capsule<dimensions>& shape) {
+    const typename DimensionTraits<dimensions, Float>::VectorType radius(shape.radius());
+    return {Math::min(shape.a(), shape.b()) - radius, Math::max(shape.a(), shape.b()) + radius};
+}
+
+template<UnsignedInt dimensions> Math::Range<dimensions, Float> bounds(const Shapes::AxisAlignedBox<dimensions>& shape) {
+    return {shape.min(), shape.max()};
+}
+
+template<UnsignedInt dimensions> Math::Range<dimensions, Float> bounds(const Shapes::Box<dimensions>& shape) {
+    /* Half extent in each direction is sum of absolute values of the
+       transformed unit axes in that direction */
+    typedef typename DimensionTraits<dimensions, Float>::VectorType VectorType;
+    const typename DimensionTraits<dimensions, Float>::MatrixType transformation = shape.transformation();
+    VectorType halfExtent;
+    for(UnsignedInt i = 0; i != dimensions; ++i)
+        halfExtent += Math::abs(VectorType::from(transformation[i].data()));
+
+    const VectorType center = VectorType::from(transformation[dimensions].data());
+    return {center - halfExtent, center + halfExtent};
+}
+
+Range3D bounds(const Shapes::Plane&) {
+    return infiniteBounds<3>();
+}
+
+template<UnsignedInt dimensions> Math::Range<dimensions, Float> bounds(const Shapes::Composition<dimensions>& shape) {
+    return shape.bounds();
+}
+
+template Math::Range<2, Float> bounds(const Shapes::Point<2>&);
+template Math::Range<3, Float> bounds(const Shapes::Point<3>&);
+template Math::Range<2, Float> bounds(const Shapes::Line<2>&);
+template Math::Range<3, Float> bounds(const Shapes::Line<3>&);
+template Math::Range<2, Float> bounds(const Shapes::LineSegment<2>&);
+template Math::Range<3, Float> bounds(const Shapes::LineSegment<3>&);
+template Math::Range<2, Float> bounds(const Shapes::Sphere<2>&);
+template Math::Range<3, Float> bounds(const Shapes::Sphere<3>&);
+template Math::Range<2, Float> bounds(const Shapes::InvertedSphere<2>&);
+template Math::Range<3, Float> bounds(const Shapes::InvertedSphere<3>&);
+template Math::Range<2, Float> bounds(const Shapes::Cylinder<2>&);
+template Math::Range<3, Float> bounds(const Shapes::Cylinder<3>&);
+template Math::Range<2, Float> bounds(const Shapes::Capsule<2>&);
+template Math::Range<3, Float> bounds(const Shapes::Capsule<3>&);
+template Math::Range<2, Float> bounds(const Shapes::AxisAlignedBox<2>&);
+template Math::Range<3, Float> bounds(const Shapes::AxisAlignedBox<3>&);
+template Math::Range<2, Float> bounds(const Shapes::Box<2>&);
+template Math::Range<3, Float> bounds(const Shapes::Box<3>&);
+template Math::Range<2, Float> bounds(const Shapes::Composition<2>&);
+template Math::Range<3, Float> bounds(const Shapes::Composition<3>&);
+
 template<UnsignedInt dimensions> AbstractShape<dimensions>::~AbstractShape() = default;
 template<UnsignedInt dimensions> AbstractShape<dimensions>::AbstractShape() = default;
 
@@ -24,12 +24,14 @@
     DEALINGS IN THE SOFTWARE.
 */
 
+#include <new>
 #include <utility>
 #include <Utility/Assert.h>
 #include <corradeCompatibility.h>
 
 #include "DimensionTraits.h"
 #include "Magnum.h"
+#include "Math/Range.h"
 #include "Shapes/Shapes.h"
 #include "Shapes/magnumShapesVisibility.h"
 
@@ -46,10 +48,18 @@ namespace Magnum { namespace Shapes { namespace Implementation {
     4.  Add the enum value to (documentation-only) enum in Composition
     5.  Update doc/shapes.dox with new type
 
+    6.  Add bounds() overload below and implement it in
+        shapeImplementation.cpp
+
     Adding new collision detection implementation:
 
-    1.  Update Implementation/CollisionDispatch.cpp with newly implemented
-        2D/3D pair
+    1.  Implement operator% (and operator/, if possible) in one of the
+        classes, the reverse variant as inline free function. The dispatch
+        table in Implementation/CollisionDispatch.cpp picks it up
+        automatically, only make sure that the header is included there.
+
+    Newly added type needs to be also added to the type list in
+    Implementation/CollisionDispatch.cpp.
 */
 
 /* Shape type for given dimension count */
@@ -150,6 +160,22 @@ template<UnsignedInt dimensions> struct TypeOf<Shapes::Composition<dimensions>>
     }
 };
 
+/* Axis-aligned bounds of transformed shape used by ShapeGroup broadphase.
+   Unbounded shapes (lines, planes, cylinders, inverted spheres) have infinite
+   bounds, empty compositions have bounds with min larger than max. */
+
+template<UnsignedInt dimensions> Math::Range<dimensions, Float> MAGNUM_SHAPES_EXPORT bounds(const Shapes::Point<dimensions>& shape);
+template<UnsignedInt dimensions> Math::Range<dimensions, Float> MAGNUM_SHAPES_EXPORT bounds(const Shapes::Line<dimensions>& shape);
+template<UnsignedInt dimensions> Math::Range<dimensions, Float> MAGNUM_SHAPES_EXPORT bounds(const Shapes::LineSegment<dimensions>& shape);
+template<UnsignedInt dimensions> Math::Range<dimensions, Float> MAGNUM_SHAPES_EXPORT bounds(const Shapes::Sphere<dimensions>& shape);
+template<UnsignedInt dimensions> Math::Range<dimensions, Float> MAGNUM_SHAPES_EXPORT bounds(const Shapes::InvertedSphere<dimensions>& shape);
+template<UnsignedInt dimensions> Math::Range<dimensions, Float> MAGNUM_SHAPES_EXPORT bounds(const Shapes::Cylinder<dimensions>& shape);
+template<UnsignedInt dimensions> Math::Range<dimensions, Float> MAGNUM_SHAPES_EXPORT bounds(const Shapes::Capsule<dimensions>& shape);
+template<UnsignedInt dimensions> Math::Range<dimensions, Float> MAGNUM_SHAPES_EXPORT bounds(const Shapes::AxisAlignedBox<dimensions>& shape);
+template<UnsignedInt dimensions> Math::Range<dimensions, Float> MAGNUM_SHAPES_EXPORT bounds(const Shapes::Box<dimensions>& shape);
+Range3D MAGNUM_SHAPES_EXPORT bounds(const Shapes::Plane& shape);
+template<UnsignedInt dimensions> Math::Range<dimensions, Float> MAGNUM_SHAPES_EXPORT bounds(const Shapes::Composition<dimensions>& shape);
+
 /* Polymorphic shape wrappers */
 
 template<UnsignedInt dimensions> struct MAGNUM_SHAPES_EXPORT AbstractShape {
@@ -157,8 +183,9 @@ template<UnsignedInt dimensions> struct MAGNUM_SHAPES_EXPORT AbstractShape {
     virtual ~AbstractShape();
 
     virtual typename ShapeDimensionTraits<dimensions>::Type MAGNUM_SHAPES_LOCAL type() const = 0;
-    virtual AbstractShape<dimensions> MAGNUM_SHAPES_LOCAL * clone() const = 0;
+    virtual AbstractShape<dimensions> MAGNUM_SHAPES_LOCAL * clone(void* storage) const = 0;
     virtual void MAGNUM_SHAPES_LOCAL transform(const typename DimensionTraits<dimensions, Float>::MatrixType& matrix, AbstractShape<dimensions>* result) const = 0;
+    virtual Math::Range<dimensions, Float> MAGNUM_SHAPES_LOCAL bounds() const = 0;
 };
 
 template<class T> struct Shape: AbstractShape<T::Dimensions> {
@@ -172,14 +199,19 @@ template<class T> struct Shape: AbstractShape<T::Dimensions> {
         return TypeOf<T>::type();
     }
 
-    AbstractShape<T::Dimensions>* clone() const override {
-        return new Shape<T>(shape);
+    /* Copy-constructs the shape into given storage */
+    AbstractShape<T::Dimensions>* clone(void* storage) const override {
+        return new(storage) Shape<T>(shape);
     }
 
     void transform(const typename DimensionTraits<T::Dimensions, Float>::MatrixType& matrix, AbstractShape<T::Dimensions>* result) const override {
         CORRADE_INTERNAL_ASSERT(result->type() == type());
         static_cast<Shape<T>*>(result)->shape = shape.transformed(matrix);
     }
+
+    Math::Range<T::Dimensions, Float> bounds() const override {
+        return Implementation::bounds(shape);
+    }
 };
 
 }}}